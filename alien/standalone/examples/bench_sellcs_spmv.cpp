@@ -0,0 +1,187 @@
+/*
+ * Copyright 2024 IFPEN-CEA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Compare le produit matrice-vecteur au format SimpleCSR et au format
+ * SELL-C-sigma pour plusieurs tailles de paquets C et de fenêtres de tri
+ * sigma, sur une matrice au format MatrixMarket.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <mpi.h>
+
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+#include <arccore/message_passing_mpi/StandaloneMpiMessagePassingMng.h>
+
+#include <alien/move/AlienMoveSemantic.h>
+
+#include <alien/core/impl/MultiMatrixImpl.h>
+#include <alien/core/impl/MultiVectorImpl.h>
+
+#include <alien/kernels/simple_csr/algebra/SimpleCSRInternalLinearAlgebra.h>
+#include <alien/kernels/simple_csr/algebra/KernelThreadPool.h>
+#include <alien/kernels/sell_cs/algebra/SellCSInternalLinearAlgebra.h>
+
+namespace
+{
+template <typename FuncT>
+double _measure(int nb_iter, const FuncT& f)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < nb_iter; ++i)
+    f();
+  std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+  return d.count() / nb_iter;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  // clang-format off
+  using namespace boost::program_options ;
+  options_description desc;
+  desc.add_options()
+      ("help",                                                           "produce help")
+      ("matrix",    value<std::string>()->default_value("simple.mtx"),   "MatrixMarket file")
+      ("nb-thread", value<int>()->default_value(0),                      "number of threads (0 for all hardware threads)")
+      ("nb-iter",   value<int>()->default_value(100),                    "number of SpMV for each format");
+  // clang-format on
+
+  variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  notify(vm);
+
+  if (vm.count("help")) {
+    std::cout << desc << "\n";
+    return 1;
+  }
+
+  MPI_Init(&argc, &argv);
+  int return_value = 0;
+  {
+    auto* pm = Arccore::MessagePassing::Mpi::StandaloneMpiMessagePassingMng::create(MPI_COMM_WORLD);
+    const bool is_master = pm->commRank() == 0;
+
+    int nb_thread = vm["nb-thread"].as<int>();
+    if (nb_thread <= 0)
+      nb_thread = std::max(1U, std::thread::hardware_concurrency());
+    const int nb_iter = vm["nb-iter"].as<int>();
+
+    auto A = Alien::Move::readFromMatrixMarket(pm, vm["matrix"].as<std::string>());
+    const auto& dist = A.distribution().rowDistribution();
+    Alien::Move::VectorData x(dist);
+    Alien::Move::VectorData y(dist);
+    {
+      Alien::Move::LocalVectorWriter writer(std::move(x));
+      for (int i = 0; i < writer.size(); ++i)
+        writer[i] = 1.0 + 1.0e-3 * (i % 17);
+      x = writer.release();
+    }
+
+    const auto& csr_A = A.impl()->get<Alien::BackEnd::tag::simplecsr>();
+    const auto& csr_x = x.impl()->get<Alien::BackEnd::tag::simplecsr>();
+    auto& csr_y = y.impl()->get<Alien::BackEnd::tag::simplecsr>(true);
+
+    Alien::SimpleCSRInternalLinearAlgebra csr_alg;
+    auto& pool = Alien::SimpleCSRInternal::KernelThreadPool::instance();
+
+    pool.setNbThread(1);
+    csr_alg.mult(csr_A, csr_x, csr_y);
+    Alien::UniqueArray<Alien::Real> ref_y(csr_y.values());
+
+    // Écart relatif maximum avec le résultat du format CSR
+    auto compute_error = [&](Alien::ConstArrayView<Alien::Real> v) {
+      Alien::Real max_error = 0;
+      for (Alien::Integer i = 0; i < ref_y.size(); ++i)
+        max_error = std::max(max_error, std::abs(v[i] - ref_y[i]) / std::max(1.0, std::abs(ref_y[i])));
+      return max_error;
+    };
+
+    bool is_ok = true;
+    auto print = [&](const std::string& name, double t1, double tn, double fill, Alien::Real error) {
+      if (is_master)
+        std::cout << std::setw(22) << name << std::setw(14) << t1 << std::setw(14) << tn
+                  << std::setw(10) << fill << std::setw(14) << error << "\n";
+      if (error > 1.0e-12)
+        is_ok = false;
+    };
+
+    if (is_master) {
+      std::cout << "Matrix: " << vm["matrix"].as<std::string>() << " nb_rank=" << pm->commSize()
+                << " global_size=" << dist.globalSize() << " nb_iter=" << nb_iter
+                << " nb_thread=" << nb_thread << "\n";
+      std::cout << std::setw(22) << "format" << std::setw(14) << "1 thread (s)" << std::setw(14) << "n threads (s)"
+                << std::setw(10) << "fill" << std::setw(14) << "max error" << "\n";
+    }
+
+    {
+      pool.setNbThread(1);
+      double t1 = _measure(nb_iter, [&] { csr_alg.mult(csr_A, csr_x, csr_y); });
+      pool.setNbThread(nb_thread);
+      double tn = _measure(nb_iter, [&] { csr_alg.mult(csr_A, csr_x, csr_y); });
+      print("CSR", t1, tn, 1.0, compute_error(csr_y.values()));
+    }
+
+    // Matrice SELL-C-sigma obtenue par conversion avec les paramètres par défaut.
+    {
+      const auto& sell_A = A.impl()->get<Alien::BackEnd::tag::sellcs>();
+      const auto& sell_x = x.impl()->get<Alien::BackEnd::tag::sellcs>();
+      auto& sell_y = y.impl()->get<Alien::BackEnd::tag::sellcs>(true);
+      Alien::SellCSInternalLinearAlgebra sell_alg;
+      pool.setNbThread(1);
+      double t1 = _measure(nb_iter, [&] { sell_alg.mult(sell_A, sell_x, sell_y); });
+      pool.setNbThread(nb_thread);
+      double tn = _measure(nb_iter, [&] { sell_alg.mult(sell_A, sell_x, sell_y); });
+      double fill = sell_A.localNnz() > 0 ? double(sell_A.paddedNnz()) / sell_A.localNnz() : 1.0;
+      std::ostringstream name;
+      name << "SELL-" << sell_A.chunkSize() << "-" << sell_A.sortWindow() << " (default)";
+      print(name.str(), t1, tn, fill, compute_error(sell_y.values()));
+    }
+
+    for (Alien::Integer chunk_size : { 4, 8 }) {
+      for (Alien::Integer sort_window : { 1, 32, 256, 4096 }) {
+        Alien::SellCSMatrix<Alien::Real> sell_A;
+        sell_A.initFromCSR(csr_A, chunk_size, sort_window);
+        pool.setNbThread(1);
+        double t1 = _measure(nb_iter, [&] { sell_A.mult(csr_x, csr_y); });
+        pool.setNbThread(nb_thread);
+        double tn = _measure(nb_iter, [&] { sell_A.mult(csr_x, csr_y); });
+        double fill = sell_A.localNnz() > 0 ? double(sell_A.paddedNnz()) / sell_A.localNnz() : 1.0;
+        std::ostringstream name;
+        name << "SELL-" << chunk_size << "-" << sell_A.sortWindow();
+        print(name.str(), t1, tn, fill, compute_error(csr_y.values()));
+      }
+    }
+    pool.setNbThread(1);
+
+    if (is_master)
+      std::cout << "Check: " << (is_ok ? "OK" : "FAILED") << "\n";
+    if (!is_ok)
+      return_value = 1;
+  }
+  MPI_Finalize();
+  return return_value;
+}
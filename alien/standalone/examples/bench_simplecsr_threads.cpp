@@ -0,0 +1,164 @@
+/*
+ * Copyright 2024 IFPEN-CEA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Compare les noyaux SimpleCSR (SpMV, axpy, dot, axpy+dot) exécutés
+ * séquentiellement et avec le pool de threads sur une matrice au
+ * format MatrixMarket.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <mpi.h>
+
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+#include <arccore/message_passing_mpi/StandaloneMpiMessagePassingMng.h>
+
+#include <alien/move/AlienMoveSemantic.h>
+
+#include <alien/core/impl/MultiMatrixImpl.h>
+#include <alien/core/impl/MultiVectorImpl.h>
+
+#include <alien/kernels/simple_csr/algebra/SimpleCSRInternalLinearAlgebra.h>
+#include <alien/kernels/simple_csr/algebra/KernelThreadPool.h>
+
+namespace
+{
+struct BenchResult
+{
+  double spmv_time = 0;
+  double axpy_dot_time = 0;
+  double fused_axpy_dot_time = 0;
+  double dot_value = 0;
+  double fused_dot_value = 0;
+};
+
+template <typename FuncT>
+double _measure(int nb_iter, const FuncT& f)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < nb_iter; ++i)
+    f();
+  std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+  return d.count() / nb_iter;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  // clang-format off
+  using namespace boost::program_options ;
+  options_description desc;
+  desc.add_options()
+      ("help",                                                           "produce help")
+      ("matrix",    value<std::string>()->default_value("simple.mtx"),   "MatrixMarket file")
+      ("nb-thread", value<int>()->default_value(0),                      "number of threads (0 for all hardware threads)")
+      ("nb-iter",   value<int>()->default_value(100),                    "number of iterations for each kernel");
+  // clang-format on
+
+  variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  notify(vm);
+
+  if (vm.count("help")) {
+    std::cout << desc << "\n";
+    return 1;
+  }
+
+  MPI_Init(&argc, &argv);
+  int return_value = 0;
+  {
+    auto* pm = Arccore::MessagePassing::Mpi::StandaloneMpiMessagePassingMng::create(MPI_COMM_WORLD);
+    const bool is_master = pm->commRank() == 0;
+
+    int nb_thread = vm["nb-thread"].as<int>();
+    if (nb_thread <= 0)
+      nb_thread = std::max(1U, std::thread::hardware_concurrency());
+    const int nb_iter = vm["nb-iter"].as<int>();
+
+    auto A = Alien::Move::readFromMatrixMarket(pm, vm["matrix"].as<std::string>());
+    const auto& dist = A.distribution().rowDistribution();
+    Alien::Move::VectorData x(dist);
+    Alien::Move::VectorData y(dist);
+    Alien::Move::VectorData z(dist);
+    {
+      Alien::Move::LocalVectorWriter writer(std::move(x));
+      for (int i = 0; i < writer.size(); ++i)
+        writer[i] = 1.0 + 1.0e-3 * (i % 17);
+      x = writer.release();
+    }
+
+    const auto& true_A = A.impl()->get<Alien::BackEnd::tag::simplecsr>();
+    const auto& true_x = x.impl()->get<Alien::BackEnd::tag::simplecsr>();
+    auto& true_y = y.impl()->get<Alien::BackEnd::tag::simplecsr>(true);
+    auto& true_z = z.impl()->get<Alien::BackEnd::tag::simplecsr>(true);
+
+    Alien::SimpleCSRInternalLinearAlgebra alg;
+    auto& pool = Alien::SimpleCSRInternal::KernelThreadPool::instance();
+
+    auto run = [&](int n) {
+      BenchResult r;
+      pool.setNbThread(n);
+      r.spmv_time = _measure(nb_iter, [&] { alg.mult(true_A, true_x, true_y); });
+      alg.copy(true_y, true_z);
+      r.axpy_dot_time = _measure(nb_iter, [&] {
+        alg.axpy(1.0e-3, true_x, true_z);
+        r.dot_value = alg.dot(true_z, true_y);
+      });
+      alg.copy(true_y, true_z);
+      r.fused_axpy_dot_time = _measure(nb_iter, [&] {
+        r.fused_dot_value = alg.axpyDot(1.0e-3, true_x, true_z, true_y);
+      });
+      return r;
+    };
+
+    BenchResult seq = run(1);
+    BenchResult thr = run(nb_thread);
+    pool.setNbThread(1);
+
+    auto is_near = [](double a, double b) {
+      return std::abs(a - b) <= 1.0e-10 * std::max(std::abs(a), std::abs(b));
+    };
+    bool is_ok = is_near(seq.dot_value, thr.dot_value) && is_near(seq.dot_value, seq.fused_dot_value) && is_near(seq.dot_value, thr.fused_dot_value);
+
+    if (is_master) {
+      std::cout << "Matrix: " << vm["matrix"].as<std::string>() << " nb_rank=" << pm->commSize()
+                << " global_size=" << dist.globalSize() << " nb_iter=" << nb_iter << "\n";
+      std::cout << std::setw(16) << "kernel" << std::setw(14) << "1 thread (s)"
+                << std::setw(10) << nb_thread << " thread(s) (s)" << std::setw(10) << "speedup" << "\n";
+      auto print = [&](const char* name, double t1, double tn) {
+        std::cout << std::setw(16) << name << std::setw(14) << t1 << std::setw(24) << tn
+                  << std::setw(10) << (tn > 0 ? t1 / tn : 0.0) << "\n";
+      };
+      print("spmv", seq.spmv_time, thr.spmv_time);
+      print("axpy+dot", seq.axpy_dot_time, thr.axpy_dot_time);
+      print("axpyDot (fused)", seq.fused_axpy_dot_time, thr.fused_axpy_dot_time);
+      std::cout << "Check: " << (is_ok ? "OK" : "FAILED") << " dot=" << seq.dot_value << "\n";
+    }
+    if (!is_ok)
+      return_value = 1;
+  }
+  MPI_Finalize();
+  return return_value;
+}
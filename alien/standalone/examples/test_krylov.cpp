@@ -39,6 +39,7 @@
 
 #include <alien/kernels/simple_csr/algebra/SimpleCSRLinearAlgebra.h>
 #include <alien/kernels/simple_csr/algebra/SimpleCSRInternalLinearAlgebra.h>
+#include <alien/kernels/sell_cs/algebra/SellCSInternalLinearAlgebra.h>
 
 #ifdef ALIEN_USE_SYCL
 #include <alien/kernels/sycl/SYCLPrecomp.h>
@@ -107,6 +108,7 @@ int main(int argc, char** argv)
       ("precond",             value<std::string>()->default_value("diag"),"preconditioner [diag,cheb,neumann,ilu0,filu0]")
       ("output-level",        value<int>()->default_value(0),             "output level")
       ("asynch",              value<int>()->default_value(0),             "Asynch mode synch : 0 or asynch 1")
+      ("pipelined",           value<int>()->default_value(0),             "Pipelined solver with fused non-blocking reductions : 0 or 1")
       ("dot-algo",            value<int>()->default_value(0),             "dot algo choice")
       ("max-iter",            value<int>()->default_value(1000),          "max iterations")
       ("tol",                 value<double>()->default_value(1.e-6),      "tolerance")
@@ -116,7 +118,7 @@ int main(int argc, char** argv)
       ("filu-factor-niter",   value<int>()->default_value(0),             "nb ILU Factorization iter")
       ("filu-solver-niter",   value<int>()->default_value(3),             "nb ILU resolution iter")
       ("filu-tol",            value<double>()->default_value(3),          "nb ILU tolerance")
-      ("kernel",              value<std::string>()->default_value("simplecsr"), "Kernel type [simplecsr sycl]")
+      ("kernel",              value<std::string>()->default_value("simplecsr"), "Kernel type [simplecsr sellcs sycl]")
       ("test",                value<std::string>()->default_value("solver"),    "test [solver,mult,all]");
   // clang-format on
 
@@ -129,6 +131,8 @@ int main(int argc, char** argv)
     return 1;
   }
 
+  int exit_code = 0;
+
   /*
    * Example : LAPLACIAN PROBLEM on a 2D square mesh of size NX x NY
    * Unknowns on nodes (i,j)
@@ -481,6 +485,11 @@ int main(int argc, char** argv)
       SentryType sentry(timer, "CSR-SPMV");
       run(alg);
     }
+    if (kernel.compare("sellcs") == 0) {
+      Alien::SellCSInternalLinearAlgebra alg;
+      SentryType sentry(timer, "SELLCS-SPMV");
+      run(alg);
+    }
     if (kernel.compare("sycl") == 0) {
 #ifdef ALIEN_USE_SYCL
       Alien::SYCLInternalLinearAlgebra alg;
@@ -500,6 +509,7 @@ int main(int argc, char** argv)
     std::string precond       = vm["precond"].as<std::string>();
     int         output_level  = vm["output-level"].as<int>();
     int         asynch        = vm["asynch"].as<int>();
+    int         pipelined     = vm["pipelined"].as<int>();
     // clang-format on
 
     // clang-format off
@@ -532,7 +542,9 @@ int main(int argc, char** argv)
                       PrecondType      precond{alg,true_A} ;
                       precond.init() ;
                       SentryType sentry(timer,"CG-Diag") ;
-                      if(asynch==0)
+                      if(pipelined)
+                        solver.solvePipelined(precond,stop_criteria,true_A,true_b,true_x) ;
+                      else if(asynch==0)
                         solver.solve(precond,stop_criteria,true_A,true_b,true_x) ;
                       else
                         solver.solve2(precond,stop_criteria,true_A,true_b,true_x) ;
@@ -550,7 +562,9 @@ int main(int argc, char** argv)
                       precond.init() ;
 
                       SentryType sentry(timer,"CG-ChebyshevPoly") ;
-                      if(asynch==0)
+                      if(pipelined)
+                        solver.solvePipelined(precond,stop_criteria,true_A,true_b,true_x) ;
+                      else if(asynch==0)
                         solver.solve(precond,stop_criteria,true_A,true_b,true_x) ;
                       else
                         solver.solve2(precond,stop_criteria,true_A,true_b,true_x) ;
@@ -567,7 +581,9 @@ int main(int argc, char** argv)
                       precond.init() ;
 
                       SentryType sentry(timer,"CG-NeumanPoly") ;
-                      if(asynch==0)
+                      if(pipelined)
+                        solver.solvePipelined(precond,stop_criteria,true_A,true_b,true_x) ;
+                      else if(asynch==0)
                         solver.solve(precond,stop_criteria,true_A,true_b,true_x) ;
                       else
                         solver.solve2(precond,stop_criteria,true_A,true_b,true_x) ;
@@ -587,7 +603,9 @@ int main(int argc, char** argv)
                       PrecondType      precond{alg,true_A} ;
                       precond.init() ;
                       SentryType sentry(timer,"BiCGS-Diag") ;
-                      if(asynch==0)
+                      if(pipelined)
+                        solver.solvePipelined(precond,stop_criteria,true_A,true_b,true_x) ;
+                      else if(asynch==0)
                         solver.solve(precond,stop_criteria,true_A,true_b,true_x) ;
                       else
                         solver.solve2(precond,stop_criteria,true_A,true_b,true_x) ;
@@ -605,7 +623,9 @@ int main(int argc, char** argv)
                       precond.init() ;
 
                       SentryType sentry(timer,"BiCGS-ChebyshevPoly") ;
-                      if(asynch==0)
+                      if(pipelined)
+                        solver.solvePipelined(precond,stop_criteria,true_A,true_b,true_x) ;
+                      else if(asynch==0)
                         solver.solve(precond,stop_criteria,true_A,true_b,true_x) ;
                       else
                         solver.solve2(precond,stop_criteria,true_A,true_b,true_x) ;
@@ -622,7 +642,9 @@ int main(int argc, char** argv)
                       precond.init() ;
 
                       SentryType sentry(timer,"BiCGS-NeumanPoly") ;
-                      if(asynch==0)
+                      if(pipelined)
+                        solver.solvePipelined(precond,stop_criteria,true_A,true_b,true_x) ;
+                      else if(asynch==0)
                         solver.solve(precond,stop_criteria,true_A,true_b,true_x) ;
                       else
                         solver.solve2(precond,stop_criteria,true_A,true_b,true_x) ;
@@ -635,7 +657,9 @@ int main(int argc, char** argv)
                       precond.init() ;
 
                       SentryType sentry(timer,"BiCGS-ILU0") ;
-                      if(asynch==0)
+                      if(pipelined)
+                        solver.solvePipelined(precond,stop_criteria,true_A,true_b,true_x) ;
+                      else if(asynch==0)
                         solver.solve(precond,stop_criteria,true_A,true_b,true_x) ;
                       else
                         solver.solve2(precond,stop_criteria,true_A,true_b,true_x) ;
@@ -651,7 +675,9 @@ int main(int argc, char** argv)
                       precond.init() ;
 
                       SentryType sentry(timer,"BiCGS-FILU0") ;
-                      if(asynch==0)
+                      if(pipelined)
+                        solver.solvePipelined(precond,stop_criteria,true_A,true_b,true_x) ;
+                      else if(asynch==0)
                         solver.solve(precond,stop_criteria,true_A,true_b,true_x) ;
                       else
                         solver.solve2(precond,stop_criteria,true_A,true_b,true_x) ;
@@ -668,6 +694,26 @@ int main(int argc, char** argv)
                 {
                   trace_mng->info()<<"Solver convergence failed";
                 }
+
+                if(pipelined)
+                {
+                  // The pipelined solvers update the residual by recurrence :
+                  // check the true residual |b-Ax|/|b| and fail the run if the
+                  // solver did not converge.
+                  typename AlgebraType::Vector r ;
+                  alg.allocate(AlgebraType::resource(true_A),r) ;
+                  alg.mult(true_A,true_x,r) ;
+                  alg.axpy(-1.,true_b,r) ;
+                  double nrm2_b = alg.norm2(true_b) ;
+                  double true_residual = alg.norm2(r) / (nrm2_b>0 ? nrm2_b : 1.) ;
+                  alg.free(r) ;
+                  trace_mng->info()<<"True residual  : "<<true_residual;
+                  if(!stop_criteria.getStatus() || true_residual > 10*tol)
+                  {
+                    trace_mng->info()<<"Pipelined solver failed : true residual "<<true_residual<<" tolerance "<<tol;
+                    exit_code = 1 ;
+                  }
+                }
               } ;
     // clang-format on
 
@@ -826,11 +872,17 @@ int main(int argc, char** argv)
       trace_mng->info() << "SYCL BackEnd not available";
 #endif
     }
+
+    if (kernel.compare("sellcs") == 0) {
+      // Same solvers and preconditioners as SYCL : ILU needs the CSR format
+      Alien::SellCSInternalLinearAlgebra alg;
+      run_sycl(alg);
+    }
   }
 
   timer.printInfo(trace_mng->info().file(), "KRYLOV-BENCH");
 
   Environment::finalize();
 
-  return 0;
+  return exit_code;
 }
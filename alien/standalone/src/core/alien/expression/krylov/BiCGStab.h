@@ -27,6 +27,8 @@
 #include <ostream>
 #include <vector>
 
+#include <alien/expression/krylov/KrylovUtils.h>
+
 namespace Alien
 {
 
@@ -93,6 +95,16 @@ class BiCGStab
       return m_status;
     }
 
+    //! Comme stop(r) mais avec \a nrm2_r le carré de la norme du résidu déjà calculé
+    bool stop(ValueType nrm2_r)
+    {
+      if (m_iter >= m_max_iteration)
+        return true;
+      m_value = nrm2_r;
+      m_status = m_value < m_criteria_value;
+      return m_status;
+    }
+
     void operator++()
     {
       if (m_trace_mng)
@@ -154,7 +166,7 @@ class BiCGStab
   {
     if (iter.nullRhs())
       return 0;
-    ValueType rho(0), rho1(0), alpha(0), beta(0), omega(0);
+    ValueType rho(0), rho1(0), alpha(0), beta(0), omega(0), nrm2_r(0), nrm2_s(0);
     VectorType p, phat, s, shat, t, v, r, r0;
 
     m_algebra.allocate(AlgebraType::resource(A), p, phat, s, shat, t, v, r, r0);
@@ -187,11 +199,11 @@ class BiCGStab
       throw typename AlgebraType::NullValueException("alpha");
     alpha = rho1 / alpha;
     m_algebra.copy(r, s);
-    m_algebra.axpy(-alpha, v, s);
+    nrm2_s = KrylovUtils::axpyDot(m_algebra, -alpha, v, s, s);
     if (m_output_level > 1)
       _print(0, "Seq 1", "alpha", alpha);
 
-    if (iter.stop(s)) {
+    if (iter.stop(nrm2_s)) {
       ++iter;
       m_algebra.axpy(alpha, phat, x);
       m_algebra.free(p, phat, s, shat, t, v, r, r0);
@@ -222,14 +234,14 @@ class BiCGStab
     m_algebra.axpy(omega, shat, x);
     m_algebra.axpy(alpha, phat, x);
     m_algebra.copy(s, r);
-    m_algebra.axpy(-omega, t, r);
+    nrm2_r = KrylovUtils::axpyDot(m_algebra, -omega, t, r, r);
 
     rho = rho1;
     ++iter;
     if (m_output_level > 1)
       _print(iter(), "Seq 3", "beta", beta, "alpha", alpha, "rho1", rho1);
 
-    while (!iter.stop(r)) {
+    while (!iter.stop(nrm2_r)) {
       //SEQ4
       rho1 = m_algebra.dot(r, r0);
       beta = (rho1 / rho) * (alpha / omega);
@@ -252,11 +264,11 @@ class BiCGStab
         alpha = rho1 / alpha;
 
       m_algebra.copy(r, s);
-      m_algebra.axpy(-alpha, v, s);
+      nrm2_s = KrylovUtils::axpyDot(m_algebra, -alpha, v, s, s);
 
       if (m_output_level > 1)
         _print(iter(), "Seq 1", "alpha", alpha);
-      if (iter.stop(s)) {
+      if (iter.stop(nrm2_s)) {
         m_algebra.axpy(alpha, phat, x);
         m_algebra.free(p, phat, s, shat, t, v, r, r0);
         return 0;
@@ -271,7 +283,7 @@ class BiCGStab
       if (m_output_level > 1)
         _print(iter(), "Seq 2", "beta", beta, "alpha", alpha, "rho1", rho1, "omega", omega);
       if (beta == 0) {
-        if (iter.stop(s)) {
+        if (iter.stop(nrm2_s)) {
           m_algebra.axpy(alpha, phat, x);
           m_algebra.free(p, phat, s, shat, t, v, r, r0);
           return 0;
@@ -285,7 +297,7 @@ class BiCGStab
       m_algebra.axpy(omega, shat, x);
       m_algebra.axpy(alpha, phat, x);
       m_algebra.copy(s, r);
-      m_algebra.axpy(-omega, t, r);
+      nrm2_r = KrylovUtils::axpyDot(m_algebra, -omega, t, r, r);
 
       rho = rho1;
 
@@ -308,6 +320,7 @@ class BiCGStab
     // clang-format off
     ValueType  rho (0),   rho1 (0),    alpha (0),     beta (0),    gamma (0),     omega (0);
     FutureType frho(rho), frho1(rho1), falpha(alpha), fbeta(beta), fgamma(gamma), fomega(omega) ;
+    ValueType  nrm2_r(0), nrm2_s(0);
     VectorType p, phat, s, shat, t, v, r, r0;
     // clang-format on
 
@@ -342,11 +355,11 @@ class BiCGStab
     alpha = frho1.get() / alpha;
 
     m_algebra.copy(r, s);
-    m_algebra.axpy(-alpha, v, s);
+    nrm2_s = KrylovUtils::axpyDot(m_algebra, -alpha, v, s, s);
     if (m_output_level > 1)
       _print(0, "Seq 1", "alpha", alpha);
 
-    if (iter.stop(s)) {
+    if (iter.stop(nrm2_s)) {
       ++iter;
       m_algebra.axpy(alpha, phat, x);
       m_algebra.free(p, phat, s, shat, t, v, r, r0);
@@ -376,14 +389,14 @@ class BiCGStab
     m_algebra.axpy(omega, shat, x);
     m_algebra.axpy(alpha, phat, x);
     m_algebra.copy(s, r);
-    m_algebra.axpy(-omega, t, r);
+    nrm2_r = KrylovUtils::axpyDot(m_algebra, -omega, t, r, r);
 
     rho = rho1;
     ++iter;
     if (m_output_level > 1)
       _print(iter(), "Seq 3", "beta", beta, "alpha", alpha, "rho1", rho1);
 
-    while (!iter.stop(r)) {
+    while (!iter.stop(nrm2_r)) {
       //SEQ4
       /*
             beta = (rho_1 / rho_2) * (alpha / omega);
@@ -410,11 +423,11 @@ class BiCGStab
         alpha = rho1 / alpha;
 
       m_algebra.copy(r, s);
-      m_algebra.axpy(-alpha, v, s);
+      nrm2_s = KrylovUtils::axpyDot(m_algebra, -alpha, v, s, s);
       if (m_output_level > 1)
         _print(iter(), "Seq 1", "alpha", alpha);
 
-      if (iter.stop(s)) {
+      if (iter.stop(nrm2_s)) {
         m_algebra.axpy(alpha, phat, x);
         m_algebra.free(p, phat, s, shat, t, v, r, r0);
         return 0;
@@ -428,7 +441,7 @@ class BiCGStab
       if (m_output_level > 1)
         _print(iter(), "Seq 2", "beta", beta, "alpha", alpha, "rho1", rho1, "omega", omega);
       if (fbeta.get() == 0) {
-        if (iter.stop(s)) {
+        if (iter.stop(nrm2_s)) {
           m_algebra.axpy(alpha, phat, x);
           m_algebra.free(p, phat, s, shat, t, v, r, r0);
           return 0;
@@ -442,7 +455,7 @@ class BiCGStab
       m_algebra.axpy(omega, shat, x);
       m_algebra.axpy(alpha, phat, x);
       m_algebra.copy(s, r);
-      m_algebra.axpy(-omega, t, r);
+      nrm2_r = KrylovUtils::axpyDot(m_algebra, -omega, t, r, r);
 
       rho = rho1;
 
@@ -456,7 +469,169 @@ class BiCGStab
     return 0;
   }
 
+  /*!
+   * \brief BiCGStab pipeliné.
+   *
+   * Variante de BiCGStab préconditionné à droite qui suit l'algorithme
+   * p-BiCGStab de Cools et Vanroose (2017). En plus des vecteurs habituels,
+   * on conserve les produits par A*M de la direction de descente et du
+   * résidu ce qui permet de les mettre à jour par récurrence. Chaque
+   * itération effectue deux réductions globales non bloquantes
+   * (AlgebraType::multiDot()) : la première calcule omega et la seconde
+   * le résidu, utilisé par le critère d'arrêt, et les valeurs nécessaires
+   * au calcul de alpha et beta de l'itération suivante. Chaque réduction
+   * est recouverte par une application du préconditionneur suivie d'un
+   * produit matrice-vecteur.
+   *
+   * Le nombre d'applications du préconditionneur, de produits
+   * matrice-vecteur et de produits scalaires par itération est le même que
+   * pour solve(). Le produit scalaire (r0,A*M*p) est calculé par récurrence.
+   *
+   * L'algèbre doit fournir le type MultiFutureType et la méthode multiDot().
+   * Le critère d'arrêt doit fournir la méthode stop(ValueType) prenant le
+   * carré de la norme du résidu.
+   */
+  template <typename PrecondT, typename iterT>
+  int solvePipelined(PrecondT& precond, iterT& iter, MatrixType const& A,
+                     VectorType const& b, VectorType& x)
+  {
+    typedef typename AlgebraType::MultiFutureType MultiFutureType;
+
+    if (iter.nullRhs())
+      return 0;
+    ValueType rho(0), rho1(0), r0s(0), alpha(0), beta(0), omega(0);
+    // Avec B = A * M et p la direction de descente, on a :
+    // w = B * r, t = B * w, s = B * p, z = B * s, v = B * z
+    // rhat = M * r, what = M * w, phat = M * p, shat = M * s, zhat = M * z
+    VectorType r, r0, w, t, s, z, v, rhat, what, phat, shat, zhat;
+
+    m_algebra.allocate(AlgebraType::resource(A), r, r0, w, t, s, z, v, rhat, what, phat, shat, zhat);
+
+    // SEQ0
+    /*
+     * r = b - A * x
+     * r0 = r
+     * rhat = solve(M,r), w = A * rhat
+     * rho = dot(r0,r), dot(r0,w), nrm2 = dot(r,r) (non bloquant)
+     * what = solve(M,w), t = A * what
+     */
+    m_algebra.copy(b, r);
+    m_algebra.mult(A, x, w);
+    m_algebra.axpy(-1., w, r);
+    m_algebra.copy(r, r0);
+    m_algebra.exec(precond, r, rhat);
+    m_algebra.mult(A, rhat, w);
+
+    MultiFutureType fomega;
+    MultiFutureType fdots;
+    m_algebra.multiDot({ { &r, &r }, { &r0, &r }, { &r0, &w } }, fdots);
+    m_algebra.exec(precond, w, what);
+    m_algebra.mult(A, what, t);
+    if (iter.stop(fdots.get(0))) {
+      m_algebra.free(r, r0, w, t, s, z, v, rhat, what, phat, shat, zhat);
+      return 0;
+    }
+    rho = fdots.get(1);
+    // Lors de la première itération p = r donc s = w.
+    r0s = fdots.get(2);
+
+    bool is_first = true;
+    for (;;) {
+      if (rho == 0)
+        throw typename AlgebraType::NullValueException("rho");
+      if (r0s == 0)
+        throw typename AlgebraType::NullValueException("alpha");
+      alpha = rho / r0s;
+
+      /*
+       * phat = rhat + beta * (phat - omega * shat)
+       * s = w + beta * (s - omega * z)
+       * shat = what + beta * (shat - omega * zhat)
+       * z = t + beta * (z - omega * v)
+       */
+      _xpbyz(rhat, beta, omega, shat, phat, is_first);
+      _xpbyz(w, beta, omega, z, s, is_first);
+      _xpbyz(what, beta, omega, zhat, shat, is_first);
+      _xpbyz(t, beta, omega, v, z, is_first);
+
+      /*
+       * x += alpha * phat
+       * q = r - alpha * s, rangé dans r
+       * qhat = rhat - alpha * shat, rangé dans rhat
+       * y = B * q = w - alpha * z, rangé dans w
+       * dot(q,y), dot(y,y) (non bloquant)
+       * zhat = solve(M,z), v = A * zhat
+       */
+      m_algebra.axpy(alpha, phat, x);
+      m_algebra.axpy(-alpha, s, r);
+      m_algebra.axpy(-alpha, shat, rhat);
+      m_algebra.axpy(-alpha, z, w);
+      m_algebra.multiDot({ { &r, &w }, { &w, &w } }, fomega);
+      m_algebra.exec(precond, z, zhat);
+      m_algebra.mult(A, zhat, v);
+
+      ValueType yy = fomega.get(1);
+      if (yy == 0)
+        throw typename AlgebraType::NullValueException("omega");
+      omega = fomega.get(0) / yy;
+      if (omega == 0)
+        throw typename AlgebraType::NullValueException("omega");
+
+      /*
+       * yhat = what - alpha * zhat, rangé dans what
+       * x += omega * qhat
+       * rhat = qhat - omega * yhat
+       * r = q - omega * y
+       * w = y - omega * (t - alpha * v)
+       * nrm2 = dot(r,r), rho1 = dot(r0,r), dot(r0,w), dot(r0,z) (non bloquant)
+       * what = solve(M,w), t = A * what
+       */
+      m_algebra.axpy(-alpha, zhat, what);
+      m_algebra.axpy(omega, rhat, x);
+      m_algebra.axpy(-omega, what, rhat);
+      m_algebra.axpy(-omega, w, r);
+      m_algebra.axpy(-omega, t, w);
+      m_algebra.axpy(omega * alpha, v, w);
+      m_algebra.multiDot({ { &r, &r }, { &r0, &r }, { &r0, &w }, { &r0, &z } }, fdots);
+      m_algebra.exec(precond, w, what);
+      m_algebra.mult(A, what, t);
+
+      ++iter;
+      if (iter.stop(fdots.get(0)))
+        break;
+
+      /*
+       * beta = (rho1 / rho) * (alpha / omega)
+       * dot(r0,s) = dot(r0,w) + beta * (dot(r0,s) - omega * dot(r0,z))
+       */
+      rho1 = fdots.get(1);
+      beta = (rho1 / rho) * (alpha / omega);
+      r0s = fdots.get(2) + beta * (r0s - omega * fdots.get(3));
+      if (m_output_level > 1)
+        _print(iter(), "Pipelined", "beta", beta, "alpha", alpha, "rho1", rho1, "omega", omega);
+      rho = rho1;
+      is_first = false;
+    }
+
+    m_algebra.free(r, r0, w, t, s, z, v, rhat, what, phat, shat, zhat);
+
+    return 0;
+  }
+
  private:
+  //! Calcule y = x + beta * (y - omega * z) (y = x lors de la première itération)
+  void _xpbyz(VectorType const& x, ValueType beta, ValueType omega,
+              VectorType const& z, VectorType& y, bool is_first)
+  {
+    if (is_first)
+      m_algebra.copy(x, y);
+    else {
+      m_algebra.axpy(-omega, z, y);
+      m_algebra.scal(beta, y);
+      m_algebra.axpy(1., x, y);
+    }
+  }
+
   void
   _print(int iter, std::string const& msg, std::string const& label0,
          ValueType value0)
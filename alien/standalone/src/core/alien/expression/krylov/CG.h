@@ -27,6 +27,8 @@
 #include <ostream>
 #include <vector>
 
+#include <alien/expression/krylov/KrylovUtils.h>
+
 namespace Alien
 {
 
@@ -64,7 +66,7 @@ class CG
   {
     if (iter.nullRhs())
       return 0;
-    ValueType rho(0), rho1(0), alpha(0);
+    ValueType rho(0), rho1(0), alpha(0), nrm2_r(0);
     VectorType p, z, q, r;
 
     m_algebra.allocate(AlgebraType::resource(A), p, z, q, r);
@@ -104,11 +106,11 @@ class CG
     }
     alpha = rho1 / alpha;
     m_algebra.axpy(alpha, p, x);
-    m_algebra.axpy(-alpha, q, r);
+    nrm2_r = KrylovUtils::axpyDot(m_algebra, -alpha, q, r, r);
     rho = rho1;
     ++iter;
 
-    while (!iter.stop(r)) {
+    while (!iter.stop(nrm2_r)) {
       // SEQ2
       /*
        * z = solve(M,r)
@@ -129,7 +131,7 @@ class CG
       m_algebra.mult(A, p, q);
       alpha = m_algebra.dot(q, p);
       if (alpha == 0) {
-        if (iter.stop(r)) {
+        if (iter.stop(nrm2_r)) {
           ++iter;
           m_algebra.free(p, z, q, r);
           return 0;
@@ -139,7 +141,7 @@ class CG
       }
       alpha = rho1 / alpha;
       m_algebra.axpy(alpha, p, x);
-      m_algebra.axpy(-alpha, q, r);
+      nrm2_r = KrylovUtils::axpyDot(m_algebra, -alpha, q, r, r);
       rho = rho1;
       ++iter;
     }
@@ -159,7 +161,7 @@ class CG
 
     if (iter.nullRhs())
       return 0;
-    ValueType rho(0), rho1(0), alpha(0);
+    ValueType rho(0), rho1(0), alpha(0), nrm2_r(0);
     FutureType frho(rho), frho1(rho1), falpha(alpha);
     VectorType p, z, q, r;
 
@@ -198,11 +200,11 @@ class CG
     }
     alpha = frho1.get() / alpha;
     m_algebra.axpy(alpha, p, x);
-    m_algebra.axpy(-alpha, q, r);
+    nrm2_r = KrylovUtils::axpyDot(m_algebra, -alpha, q, r, r);
     rho = rho1;
     ++iter;
 
-    while (!iter.stop(r)) {
+    while (!iter.stop(nrm2_r)) {
 
       /*
        * z = solve(M,r)
@@ -223,7 +225,7 @@ class CG
       m_algebra.mult(A, p, q);
       m_algebra.dot(p, q, falpha);
       if (falpha.get() == 0) {
-        if (iter.stop(r)) {
+        if (iter.stop(nrm2_r)) {
           ++iter;
           m_algebra.free(p, z, q, r);
           return 0;
@@ -233,7 +235,7 @@ class CG
       }
       alpha = rho1 / alpha;
       m_algebra.axpy(alpha, p, x);
-      m_algebra.axpy(-alpha, q, r);
+      nrm2_r = KrylovUtils::axpyDot(m_algebra, -alpha, q, r, r);
       rho = rho1;
       ++iter;
     }
@@ -243,7 +245,127 @@ class CG
     return 0;
   }
 
+  /*!
+   * \brief Gradient conjugué pipeliné (Ghysels et Vanroose, 2014).
+   *
+   * Les produits scalaires d'une itération ainsi que la norme du résidu
+   * utilisée par le critère d'arrêt sont fusionnés en une seule réduction
+   * globale non bloquante (AlgebraType::multiDot()), recouverte par
+   * l'application du préconditionneur et le produit matrice-vecteur.
+   * En contrepartie, l'algorithme utilise plus de vecteurs et une
+   * itération supplémentaire est calculée avant de détecter la convergence.
+   *
+   * L'algèbre doit fournir le type MultiFutureType et la méthode multiDot().
+   * Le critère d'arrêt doit fournir la méthode stop(ValueType) prenant le
+   * carré de la norme du résidu.
+   */
+  template <typename PrecondT, typename iterT>
+  int solvePipelined(PrecondT& precond,
+                     iterT& iter,
+                     MatrixType const& A,
+                     VectorType const& b,
+                     VectorType& x)
+  {
+    typedef typename AlgebraType::MultiFutureType MultiFutureType;
+
+    if (iter.nullRhs())
+      return 0;
+    ValueType gamma(0), gamma_old(0), delta(0), alpha(0), alpha_old(0), beta(0);
+    VectorType r, u, w, m, n, z, q, s, p;
+
+    m_algebra.allocate(AlgebraType::resource(A), r, u, w, m, n, z, q, s, p);
+
+    // SEQ0
+    /*
+     * r = b - A * x
+     * u = solve(M,r)
+     * w = A * u
+     */
+    m_algebra.copy(b, r);
+    m_algebra.mult(A, x, p);
+    m_algebra.axpy(-1., p, r);
+    m_algebra.exec(precond, r, u);
+    m_algebra.mult(A, u, w);
+
+    MultiFutureType fdots;
+    bool is_first = true;
+    for (;;) {
+      /*
+       * gamma = dot(r,u), delta = dot(w,u), nrm2 = dot(r,r) (non bloquant)
+       * m = solve(M,w)
+       * n = A * m
+       */
+      m_algebra.multiDot({ { &r, &u }, { &w, &u }, { &r, &r } }, fdots);
+      m_algebra.exec(precond, w, m);
+      m_algebra.mult(A, m, n);
+      gamma = fdots.get(0);
+      delta = fdots.get(1);
+      if (iter.stop(fdots.get(2)))
+        break;
+
+      /*
+       * beta = gamma / gamma_old
+       * alpha = gamma / (delta - beta * gamma / alpha_old)
+       */
+      if (is_first) {
+        beta = 0;
+        alpha = delta;
+      }
+      else {
+        beta = gamma / gamma_old;
+        alpha = delta - beta * gamma / alpha_old;
+      }
+      if (m_output_level > 1)
+        _print(iter(), "Pipelined", "gamma", gamma, "delta", delta, "beta", beta);
+      if (alpha == 0)
+        throw typename AlgebraType::NullValueException("alpha");
+      alpha = gamma / alpha;
+
+      /*
+       * z = n + beta * z
+       * q = m + beta * q
+       * s = w + beta * s
+       * p = u + beta * p
+       */
+      _xpby(n, beta, z, is_first);
+      _xpby(m, beta, q, is_first);
+      _xpby(w, beta, s, is_first);
+      _xpby(u, beta, p, is_first);
+
+      /*
+       * x += alpha * p
+       * r -= alpha * s
+       * u -= alpha * q
+       * w -= alpha * z
+       */
+      m_algebra.axpy(alpha, p, x);
+      m_algebra.axpy(-alpha, s, r);
+      m_algebra.axpy(-alpha, q, u);
+      m_algebra.axpy(-alpha, z, w);
+
+      gamma_old = gamma;
+      alpha_old = alpha;
+      is_first = false;
+      ++iter;
+    }
+
+    m_algebra.free(r, u, w, m, n, z, q, s, p);
+
+    return 0;
+  }
+
  private:
+  //! Calcule y = x + beta * y (y = x lors de la première itération)
+  void _xpby(VectorType const& x, ValueType beta, VectorType& y, bool is_first)
+  {
+    if (is_first)
+      m_algebra.copy(x, y);
+    else {
+      m_algebra.scal(beta, y);
+      m_algebra.axpy(1., x, y);
+    }
+  }
+
   void
   _print(int iter, std::string const& msg, std::string const& label0,
          ValueType value0)
@@ -89,6 +89,16 @@ class Iteration
     return m_status;
   }
 
+  //! Comme stop(r) mais avec \a nrm2_r le carré de la norme du résidu déjà calculé
+  bool stop(ValueType nrm2_r)
+  {
+    if (m_iter >= m_max_iteration)
+      return true;
+    m_value = nrm2_r;
+    m_status = m_value < m_criteria_value;
+    return m_status;
+  }
+
   void operator++()
   {
     if (m_trace_mng) {
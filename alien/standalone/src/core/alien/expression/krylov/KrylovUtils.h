@@ -0,0 +1,65 @@
+/*
+ * Copyright 2020 IFPEN-CEA
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace Alien::KrylovUtils
+{
+
+/*!
+ * \brief Indique si l'algèbre \a AlgebraT fournit la méthode
+ * axpyDot(alpha, x, y, z) pour des scalaires de type \a ValueT et des
+ * vecteurs de type \a VectorT.
+ */
+template <typename AlgebraT, typename ValueT, typename VectorT, typename = void>
+struct HasAxpyDot : std::false_type
+{};
+
+template <typename AlgebraT, typename ValueT, typename VectorT>
+struct HasAxpyDot<AlgebraT, ValueT, VectorT,
+                  std::void_t<decltype(std::declval<AlgebraT&>().axpyDot(
+                  std::declval<ValueT>(), std::declval<VectorT const&>(),
+                  std::declval<VectorT&>(), std::declval<VectorT const&>()))>>
+: std::true_type
+{};
+
+/*!
+ * \brief Calcule y += alpha * x et retourne dot(y, z).
+ *
+ * Si l'algèbre fournit axpyDot(), les deux opérations sont faites en un
+ * seul parcours des vecteurs. Sinon, on utilise axpy() puis dot().
+ *
+ * Le produit scalaire est bloquant : cette méthode ne doit pas être
+ * utilisée lorsque la réduction doit être recouverte par d'autres calculs
+ * (voir les versions pipelinées des solveurs qui utilisent multiDot()).
+ */
+template <typename AlgebraT, typename ValueT, typename VectorT>
+ValueT axpyDot(AlgebraT& algebra, ValueT alpha, VectorT const& x, VectorT& y, VectorT const& z)
+{
+  if constexpr (HasAxpyDot<AlgebraT, ValueT, VectorT>::value)
+    return algebra.axpyDot(alpha, x, y, z);
+  else {
+    algebra.axpy(alpha, x, y);
+    return algebra.dot(y, z);
+  }
+}
+
+} // namespace Alien::KrylovUtils
@@ -0,0 +1,71 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SellCSBackEnd.h                                             (C) 2000-2024 */
+/*                                                                           */
+/* Back-end SELL-C-sigma sur CPU.                                            */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <alien/core/backend/BackEnd.h>
+#include <alien/utils/Precomp.h>
+
+/*---------------------------------------------------------------------------*/
+
+namespace Alien
+{
+
+/*---------------------------------------------------------------------------*/
+
+template <typename T>
+class SellCSMatrix;
+template <typename T>
+class SellCSVector;
+
+template <typename T>
+struct SellCSTraits
+{
+  typedef SellCSMatrix<T> MatrixType;
+  typedef SellCSVector<T> VectorType;
+};
+
+/*---------------------------------------------------------------------------*/
+
+namespace BackEnd
+{
+  namespace tag
+  {
+    struct sellcs
+    {};
+  } // namespace tag
+} // namespace BackEnd
+
+/*!
+ * \brief Back-end SELL-C-sigma.
+ *
+ * Il n'y a pas d'algèbre générique associée à ce back-end. Les solveurs de
+ * Krylov utilisent directement SellCSInternalLinearAlgebra.
+ */
+template <>
+struct AlgebraTraits<BackEnd::tag::sellcs>
+{
+  // clang-format off
+  typedef Real                          value_type;
+  typedef SellCSTraits<Real>::MatrixType matrix_type;
+  typedef SellCSTraits<Real>::VectorType vector_type;
+  // clang-format on
+
+  static BackEndId name() { return "sellcs"; }
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace Alien
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,351 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SellCSMatrix.cc                                             (C) 2000-2024 */
+/*                                                                           */
+/* Matrice au format SELL-C-sigma.                                           */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include <alien/kernels/sell_cs/SellCSMatrix.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+
+#include <alien/kernels/simple_csr/SimpleCSRMatrix.h>
+#include <alien/kernels/simple_csr/SimpleCSRVector.h>
+#include <alien/kernels/simple_csr/algebra/KernelThreadPool.h>
+
+/*
+ * Taille des paquets par défaut : nombre de 'double' d'un registre
+ * vectoriel de la machine cible.
+ */
+#ifndef ALIEN_SELLCS_CHUNK_SIZE
+#if defined(__AVX512F__)
+#define ALIEN_SELLCS_CHUNK_SIZE 8
+#else
+#define ALIEN_SELLCS_CHUNK_SIZE 4
+#endif
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+namespace Alien
+{
+
+using namespace Arccore;
+
+/*---------------------------------------------------------------------------*/
+
+namespace
+{
+  //! Taille de la fenêtre de tri par défaut (en nombre de lignes)
+  const Integer DefaultSortWindow = 256;
+
+  Integer _readEnvValue(const char* name, Integer default_value)
+  {
+    if (const char* env_value = std::getenv(name)) {
+      try {
+        return std::stoi(env_value);
+      }
+      catch (const std::exception&) {
+        throw FatalErrorException(A_FUNCINFO, String::format("Invalid value '{0}' for {1}", env_value, name));
+      }
+    }
+    return default_value;
+  }
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+template <typename ValueT>
+SellCSMatrix<ValueT>::SellCSMatrix()
+: IMatrixImpl(nullptr, AlgebraTraits<BackEnd::tag::sellcs>::name())
+{}
+
+template <typename ValueT>
+SellCSMatrix<ValueT>::SellCSMatrix(const MultiMatrixImpl* multi_impl)
+: IMatrixImpl(multi_impl, AlgebraTraits<BackEnd::tag::sellcs>::name())
+{}
+
+template <typename ValueT>
+SellCSMatrix<ValueT>::~SellCSMatrix()
+{}
+
+/*---------------------------------------------------------------------------*/
+
+template <typename ValueT>
+Integer SellCSMatrix<ValueT>::defaultChunkSize()
+{
+  static const Integer chunk_size = _readEnvValue("ALIEN_SELLCS_CHUNK_SIZE", ALIEN_SELLCS_CHUNK_SIZE);
+  return chunk_size;
+}
+
+template <typename ValueT>
+Integer SellCSMatrix<ValueT>::defaultSortWindow()
+{
+  static const Integer sort_window = _readEnvValue("ALIEN_SELLCS_SIGMA", DefaultSortWindow);
+  return sort_window;
+}
+
+/*---------------------------------------------------------------------------*/
+
+template <typename ValueT>
+void SellCSMatrix<ValueT>::clear()
+{
+  m_chunk_offset.dispose();
+  m_chunk_width.dispose();
+  m_row_perm.dispose();
+  m_cols.dispose();
+  m_values.dispose();
+  m_diag.dispose();
+  m_ghost_row_offset.dispose();
+  m_ghost_cols.dispose();
+  m_ghost_values.dispose();
+  m_local_size = 0;
+  m_ghost_size = 0;
+  m_local_nnz = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+
+template <typename ValueT>
+void SellCSMatrix<ValueT>::initFromCSR(const SimpleCSRMatrix<ValueT>& csr)
+{
+  initFromCSR(csr, defaultChunkSize(), defaultSortWindow());
+}
+
+/*---------------------------------------------------------------------------*/
+
+template <typename ValueT>
+void SellCSMatrix<ValueT>::
+initFromCSR(const SimpleCSRMatrix<ValueT>& csr, Integer chunk_size, Integer sort_window)
+{
+  if (chunk_size != 4 && chunk_size != 8)
+    throw FatalErrorException(A_FUNCINFO, String::format("Invalid SELL-C-sigma chunk size '{0}' (valid values are 4 or 8)", chunk_size));
+  if (sort_window < 1)
+    throw FatalErrorException(A_FUNCINFO, String::format("Invalid SELL-C-sigma sort window '{0}'", sort_window));
+
+  clear();
+
+  const Integer C = chunk_size;
+  m_chunk_size = C;
+  m_sort_window = (sort_window == 1) ? 1 : ((sort_window + C - 1) / C) * C;
+  m_is_parallel = csr.isParallel();
+  m_local_size = csr.getLocalSize();
+  m_ghost_size = csr.getGhostSize();
+  m_send_policy = csr.getSendPolicy();
+  m_recv_policy = csr.getRecvPolicy();
+  m_parallel_mng = csr.getParallelMng();
+  m_dist_info = csr.getDistStructInfo();
+
+  // En parallèle, les colonnes en numérotation locale sont dans DistStructInfo
+  // et les coefficients locaux sont en tête de chaque ligne.
+  const auto& profile = csr.getCSRProfile();
+  ConstArrayView<Integer> kcol = profile.getRowOffset();
+  ConstArrayView<Integer> cols = m_is_parallel ? m_dist_info.m_cols.constView() : profile.getCols();
+  ConstArrayView<ValueT> values = csr.internal()->getValues();
+  const Integer nrow = m_local_size;
+
+  UniqueArray<Integer> row_size(nrow);
+  for (Integer irow = 0; irow < nrow; ++irow)
+    row_size[irow] = m_is_parallel ? m_dist_info.m_local_row_size[irow] : (kcol[irow + 1] - kcol[irow]);
+
+  // Tri des lignes par longueur décroissante dans chaque fenêtre de sigma lignes.
+  const Integer nb_chunk = (nrow + C - 1) / C;
+  m_row_perm.resize(nb_chunk * C);
+  m_row_perm.fill(-1);
+  std::iota(m_row_perm.begin(), m_row_perm.begin() + nrow, 0);
+  if (m_sort_window > 1) {
+    for (Integer begin = 0; begin < nrow; begin += m_sort_window) {
+      Integer end = std::min(begin + m_sort_window, nrow);
+      std::stable_sort(m_row_perm.begin() + begin, m_row_perm.begin() + end,
+                       [&](Integer a, Integer b) { return row_size[a] > row_size[b]; });
+    }
+  }
+
+  m_chunk_width.resize(nb_chunk);
+  m_chunk_offset.resize(nb_chunk + 1);
+  m_chunk_offset[0] = 0;
+  for (Integer ichunk = 0; ichunk < nb_chunk; ++ichunk) {
+    Integer width = 0;
+    for (Integer lane = 0; lane < C; ++lane) {
+      Integer irow = m_row_perm[ichunk * C + lane];
+      if (irow >= 0)
+        width = std::max(width, row_size[irow]);
+    }
+    m_chunk_width[ichunk] = width;
+    m_chunk_offset[ichunk + 1] = m_chunk_offset[ichunk] + width * C;
+  }
+
+  // Remplissage des paquets. Les coefficients de remplissage sont nuls et
+  // utilisent la dernière colonne de la ligne (ou la colonne 0 pour une
+  // ligne vide) pour rester dans les bornes du vecteur.
+  m_cols.resize(m_chunk_offset[nb_chunk]);
+  m_values.resize(m_chunk_offset[nb_chunk]);
+  m_diag.resize(nrow);
+  m_diag.fill(ValueT());
+  for (Integer ichunk = 0; ichunk < nb_chunk; ++ichunk) {
+    const Integer offset = m_chunk_offset[ichunk];
+    const Integer width = m_chunk_width[ichunk];
+    for (Integer lane = 0; lane < C; ++lane) {
+      const Integer irow = m_row_perm[ichunk * C + lane];
+      const Integer size = (irow >= 0) ? row_size[irow] : 0;
+      const Integer first = (irow >= 0) ? kcol[irow] : 0;
+      Integer pad_col = 0;
+      for (Integer k = 0; k < size; ++k) {
+        const Integer col = cols[first + k];
+        m_cols[offset + k * C + lane] = col;
+        m_values[offset + k * C + lane] = values[first + k];
+        if (col == irow)
+          m_diag[irow] = values[first + k];
+        pad_col = col;
+      }
+      for (Integer k = size; k < width; ++k) {
+        m_cols[offset + k * C + lane] = pad_col;
+        m_values[offset + k * C + lane] = ValueT();
+      }
+      m_local_nnz += size;
+    }
+  }
+
+  // Partie fantôme des lignes d'interface
+  if (m_is_parallel) {
+    const Integer interface_nrow = m_dist_info.m_interface_nrow;
+    ConstArrayView<Integer> row_ids = m_dist_info.m_interface_rows;
+    m_ghost_row_offset.resize(interface_nrow + 1);
+    m_ghost_row_offset[0] = 0;
+    for (Integer i = 0; i < interface_nrow; ++i) {
+      const Integer irow = row_ids[i];
+      m_ghost_row_offset[i + 1] = m_ghost_row_offset[i] + (kcol[irow + 1] - kcol[irow] - row_size[irow]);
+    }
+    m_ghost_cols.resize(m_ghost_row_offset[interface_nrow]);
+    m_ghost_values.resize(m_ghost_row_offset[interface_nrow]);
+    for (Integer i = 0; i < interface_nrow; ++i) {
+      const Integer irow = row_ids[i];
+      Integer index = m_ghost_row_offset[i];
+      for (Integer k = kcol[irow] + row_size[irow]; k < kcol[irow + 1]; ++k, ++index) {
+        m_ghost_cols[index] = cols[k];
+        m_ghost_values[index] = values[k];
+      }
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Produit de la partie locale.
+ *
+ * La boucle sur les \a ChunkSize lignes d'un paquet a une taille connue à la
+ * compilation et porte sur des coefficients contigus : elle est vectorisée
+ * par le compilateur (lecture indexée de \a x, multiplication et addition
+ * sur un registre complet).
+ */
+template <typename ValueT>
+template <int ChunkSize>
+void SellCSMatrix<ValueT>::_multLocal(const ValueT* x, ValueT* y) const
+{
+  const Integer* chunk_offset = m_chunk_offset.data();
+  const Integer* chunk_width = m_chunk_width.data();
+  const Integer* row_perm = m_row_perm.data();
+  const Integer* cols = m_cols.data();
+  const ValueT* values = m_values.data();
+
+  auto& pool = SimpleCSRInternal::KernelThreadPool::instance();
+  pool.forEachRowRange(m_chunk_offset, nbChunk(), [&](Integer begin, Integer end) {
+    for (Integer ichunk = begin; ichunk < end; ++ichunk) {
+      ValueT sum[ChunkSize] = {};
+      const Integer* chunk_cols = cols + chunk_offset[ichunk];
+      const ValueT* chunk_values = values + chunk_offset[ichunk];
+      const Integer width = chunk_width[ichunk];
+      for (Integer k = 0; k < width; ++k) {
+        for (int lane = 0; lane < ChunkSize; ++lane)
+          sum[lane] += chunk_values[lane] * x[chunk_cols[lane]];
+        chunk_cols += ChunkSize;
+        chunk_values += ChunkSize;
+      }
+      const Integer* rows = row_perm + ichunk * ChunkSize;
+      for (int lane = 0; lane < ChunkSize; ++lane)
+        if (rows[lane] >= 0)
+          y[rows[lane]] = sum[lane];
+    }
+  });
+}
+
+/*---------------------------------------------------------------------------*/
+
+template <typename ValueT>
+void SellCSMatrix<ValueT>::_addGhostMult(const ValueT* x, ValueT* y) const
+{
+  ConstArrayView<Integer> row_ids = m_dist_info.m_interface_rows;
+  const Integer* ghost_row_offset = m_ghost_row_offset.data();
+  const Integer* ghost_cols = m_ghost_cols.data();
+  const ValueT* ghost_values = m_ghost_values.data();
+  auto& pool = SimpleCSRInternal::KernelThreadPool::instance();
+  pool.forEachRange(m_dist_info.m_interface_nrow, [&](Integer begin, Integer end) {
+    for (Integer i = begin; i < end; ++i) {
+      ValueT tmpy = ValueT();
+      for (Integer k = ghost_row_offset[i]; k < ghost_row_offset[i + 1]; ++k)
+        tmpy += ghost_values[k] * x[ghost_cols[k]];
+      y[row_ids[i]] += tmpy;
+    }
+  });
+}
+
+/*---------------------------------------------------------------------------*/
+
+template <typename ValueT>
+void SellCSMatrix<ValueT>::
+mult(const SimpleCSRVector<ValueT>& x_impl, SimpleCSRVector<ValueT>& y_impl) const
+{
+  ValueT* y_ptr = y_impl.getDataPtr();
+  auto mult_local = [&](const ValueT* x_ptr) {
+    if (m_chunk_size == 8)
+      _multLocal<8>(x_ptr, y_ptr);
+    else
+      _multLocal<4>(x_ptr, y_ptr);
+  };
+
+  if (!m_is_parallel) {
+    mult_local(x_impl.getDataPtr());
+    return;
+  }
+
+  x_impl.resize(m_local_size + m_ghost_size);
+  ValueT* x_ptr = const_cast<ValueT*>(x_impl.getDataPtr());
+  SimpleCSRInternal::SendRecvOp<ValueT> op(x_ptr, m_dist_info.m_send_info, m_send_policy,
+                                           x_ptr, m_dist_info.m_recv_info, m_recv_policy,
+                                           m_parallel_mng, nullptr);
+  op.start();
+  // La partie locale est calculée pendant les échanges des valeurs fantômes.
+  mult_local(x_ptr);
+  op.end();
+  _addGhostMult(x_ptr, y_ptr);
+}
+
+/*---------------------------------------------------------------------------*/
+
+template <typename ValueT>
+void SellCSMatrix<ValueT>::computeInvDiag(SimpleCSRVector<ValueT>& y) const
+{
+  ValueT* y_ptr = y.getDataPtr();
+  for (Integer irow = 0; irow < m_local_size; ++irow)
+    y_ptr[irow] = 1. / m_diag[irow];
+}
+
+/*---------------------------------------------------------------------------*/
+
+template class ALIEN_EXPORT SellCSMatrix<Real>;
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace Alien
+
+/*---------------------------------------------------------------------------*/
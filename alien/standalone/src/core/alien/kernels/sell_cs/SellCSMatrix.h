@@ -0,0 +1,164 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SellCSMatrix.h                                              (C) 2000-2024 */
+/*                                                                           */
+/* Matrice au format SELL-C-sigma.                                           */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <alien/core/impl/IMatrixImpl.h>
+
+#include <alien/kernels/sell_cs/SellCSBackEnd.h>
+#include <alien/kernels/simple_csr/CSRStructInfo.h>
+#include <alien/kernels/simple_csr/DistStructInfo.h>
+#include <alien/kernels/simple_csr/SendRecvOp.h>
+
+/*---------------------------------------------------------------------------*/
+
+namespace Alien
+{
+
+template <typename T>
+class SimpleCSRMatrix;
+template <typename T>
+class SimpleCSRVector;
+
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Matrice au format SELL-C-sigma.
+ *
+ * Les lignes locales sont regroupées par paquets (chunks) de C lignes.
+ * Dans un paquet, les coefficients sont rangés par colonne : le k-ième
+ * coefficient des C lignes est contigu en mémoire, ce qui permet de traiter
+ * les C lignes simultanément avec des instructions vectorielles. Chaque
+ * paquet a la largeur de sa plus longue ligne et les lignes plus courtes sont
+ * complétées par des coefficients nuls.
+ *
+ * Pour limiter ce remplissage, les lignes sont triées par longueur
+ * décroissante dans des fenêtres de sigma lignes. La multiplication écrit
+ * donc le résultat via la permutation des lignes.
+ *
+ * C vaut par défaut le nombre de 'double' d'un registre AVX2 (4) ou AVX-512
+ * (8) suivant les options de compilation. Les valeurs par défaut de C et
+ * sigma peuvent être modifiées par les variables d'environnement
+ * ALIEN_SELLCS_CHUNK_SIZE et ALIEN_SELLCS_SIGMA.
+ *
+ * En parallèle, seule la partie locale est au format SELL-C-sigma. Les
+ * coefficients des colonnes fantômes des lignes d'interface sont conservés
+ * au format CSR et ajoutés après la réception des valeurs fantômes. Comme
+ * pour SimpleCSRMatrix, la partie locale est calculée pendant les échanges.
+ *
+ * La matrice est construite à partir d'une SimpleCSRMatrix scalaire via
+ * initFromCSR().
+ */
+template <typename ValueT>
+class ALIEN_EXPORT SellCSMatrix : public IMatrixImpl
+{
+ public:
+  // clang-format off
+  typedef BackEnd::tag::sellcs              TagType;
+  typedef ValueT                            ValueType;
+  typedef ValueT                            value_type;
+  typedef SimpleCSRInternal::DistStructInfo DistStructInfo;
+  // clang-format on
+
+ public:
+  //! Constructeur sans association à un MultiImpl
+  SellCSMatrix();
+
+  //! Constructeur avec association à un MultiImpl
+  SellCSMatrix(const MultiMatrixImpl* multi_impl);
+
+  virtual ~SellCSMatrix();
+
+ public:
+  //! Taille des paquets de lignes utilisée par défaut (C)
+  static Integer defaultChunkSize();
+
+  //! Taille de la fenêtre de tri des lignes utilisée par défaut (sigma)
+  static Integer defaultSortWindow();
+
+  //! Construit la matrice à partir de \a csr avec les tailles par défaut
+  void initFromCSR(const SimpleCSRMatrix<ValueT>& csr);
+
+  /*!
+   * \brief Construit la matrice à partir de \a csr.
+   *
+   * \a chunk_size doit valoir 4 ou 8. \a sort_window est arrondi au multiple
+   * de \a chunk_size supérieur. Une valeur de \a sort_window égale à 1
+   * désactive le tri.
+   */
+  void initFromCSR(const SimpleCSRMatrix<ValueT>& csr, Integer chunk_size, Integer sort_window);
+
+  //! Calcule y = A.x
+  void mult(const SimpleCSRVector<ValueT>& x, SimpleCSRVector<ValueT>& y) const;
+
+  //! Calcule l'inverse de la diagonale de la matrice
+  void computeInvDiag(SimpleCSRVector<ValueT>& y) const;
+
+  void clear() override;
+
+ public:
+  Integer chunkSize() const { return m_chunk_size; }
+  Integer sortWindow() const { return m_sort_window; }
+  Integer nbChunk() const { return m_chunk_width.size(); }
+  bool isParallel() const { return m_is_parallel; }
+  Integer getLocalSize() const { return m_local_size; }
+  Integer getGhostSize() const { return m_ghost_size; }
+
+  //! Nombre de coefficients non nuls de la partie locale
+  Int64 localNnz() const { return m_local_nnz; }
+
+  //! Nombre de coefficients stockés pour la partie locale (remplissage compris)
+  Int64 paddedNnz() const { return m_values.size(); }
+
+  const DistStructInfo& getDistStructInfo() const { return m_dist_info; }
+
+ private:
+  template <int ChunkSize>
+  void _multLocal(const ValueT* x, ValueT* y) const;
+  void _addGhostMult(const ValueT* x, ValueT* y) const;
+
+ private:
+  // clang-format off
+  Integer              m_chunk_size  = 0;
+  Integer              m_sort_window = 0;
+  Integer              m_local_size  = 0;
+  Integer              m_ghost_size  = 0;
+  Int64                m_local_nnz   = 0;
+  bool                 m_is_parallel = false;
+
+  //! Position du premier coefficient de chaque paquet (taille nbChunk()+1)
+  UniqueArray<Integer> m_chunk_offset;
+  //! Largeur de chaque paquet
+  UniqueArray<Integer> m_chunk_width;
+  //! Ligne d'origine de chaque ligne des paquets (-1 pour les lignes de remplissage)
+  UniqueArray<Integer> m_row_perm;
+  UniqueArray<Integer> m_cols;
+  UniqueArray<ValueT>  m_values;
+  UniqueArray<ValueT>  m_diag;
+
+  //! Partie fantôme des lignes d'interface au format CSR
+  UniqueArray<Integer> m_ghost_row_offset;
+  UniqueArray<Integer> m_ghost_cols;
+  UniqueArray<ValueT>  m_ghost_values;
+
+  DistStructInfo                               m_dist_info;
+  SimpleCSRInternal::CommProperty::ePolicyType m_send_policy = SimpleCSRInternal::CommProperty::ASynch;
+  SimpleCSRInternal::CommProperty::ePolicyType m_recv_policy = SimpleCSRInternal::CommProperty::ASynch;
+  IMessagePassingMng*                          m_parallel_mng = nullptr;
+  // clang-format on
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace Alien
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,52 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SellCSVector.h                                              (C) 2000-2024 */
+/*                                                                           */
+/* Vecteur du back-end SELL-C-sigma.                                         */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <alien/kernels/sell_cs/SellCSBackEnd.h>
+#include <alien/kernels/simple_csr/SimpleCSRVector.h>
+
+/*---------------------------------------------------------------------------*/
+
+namespace Alien
+{
+
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vecteur du back-end SELL-C-sigma.
+ *
+ * Le format SELL-C-sigma ne concerne que la matrice. Les vecteurs gardent
+ * donc le stockage de SimpleCSRVector (valeurs locales suivies des valeurs
+ * fantômes) ce qui permet de réutiliser les opérations vectorielles de
+ * SimpleCSRInternalLinearAlgebra.
+ */
+template <typename ValueT>
+class SellCSVector : public SimpleCSRVector<ValueT>
+{
+ public:
+  //! Constructeur sans association à un MultiImpl
+  SellCSVector()
+  : SimpleCSRVector<ValueT>(nullptr, AlgebraTraits<BackEnd::tag::sellcs>::name())
+  {}
+
+  //! Constructeur avec association à un MultiImpl
+  SellCSVector(const MultiVectorImpl* multi_impl)
+  : SimpleCSRVector<ValueT>(multi_impl, AlgebraTraits<BackEnd::tag::sellcs>::name())
+  {}
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace Alien
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,68 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SellCSInternalLinearAlgebra.cc                              (C) 2000-2024 */
+/*                                                                           */
+/* Algèbre pour les solveurs de Krylov avec le back-end SELL-C-sigma.        */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include <alien/kernels/sell_cs/algebra/SellCSInternalLinearAlgebra.h>
+
+/*---------------------------------------------------------------------------*/
+
+namespace Alien
+{
+
+/*---------------------------------------------------------------------------*/
+
+SellCSInternalLinearAlgebra::SellCSInternalLinearAlgebra()
+: SimpleCSRInternalLinearAlgebra()
+{}
+
+/*---------------------------------------------------------------------------*/
+
+SellCSInternalLinearAlgebra::~SellCSInternalLinearAlgebra()
+{}
+
+/*---------------------------------------------------------------------------*/
+
+SellCSInternalLinearAlgebra::ResourceType const&
+SellCSInternalLinearAlgebra::resource(Matrix const& A)
+{
+  return A.distribution().rowDistribution();
+}
+
+void SellCSInternalLinearAlgebra::allocate(ResourceType const& resource, Vector& v)
+{
+  v.init(resource, true);
+}
+
+void SellCSInternalLinearAlgebra::free(Vector& v)
+{
+  v.clear();
+}
+
+/*---------------------------------------------------------------------------*/
+
+void SellCSInternalLinearAlgebra::mult(const Matrix& A, const Vector& x, Vector& r) const
+{
+  A.mult(x, r);
+}
+
+/*---------------------------------------------------------------------------*/
+
+void SellCSInternalLinearAlgebra::computeInvDiag(const Matrix& A, Vector& inv_diag) const
+{
+  A.computeInvDiag(inv_diag);
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace Alien
+
+/*---------------------------------------------------------------------------*/
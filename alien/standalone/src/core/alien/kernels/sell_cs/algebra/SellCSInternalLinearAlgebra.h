@@ -0,0 +1,89 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SellCSInternalLinearAlgebra.h                               (C) 2000-2024 */
+/*                                                                           */
+/* Algèbre pour les solveurs de Krylov avec le back-end SELL-C-sigma.        */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <alien/kernels/sell_cs/SellCSBackEnd.h>
+#include <alien/kernels/sell_cs/SellCSMatrix.h>
+#include <alien/kernels/sell_cs/SellCSVector.h>
+
+#include <alien/kernels/simple_csr/algebra/SimpleCSRInternalLinearAlgebra.h>
+
+/*---------------------------------------------------------------------------*/
+
+namespace Alien
+{
+
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Algèbre du back-end SELL-C-sigma.
+ *
+ * Les vecteurs SellCSVector ayant le même stockage que SimpleCSRVector,
+ * les opérations vectorielles (dont multiDot()) sont celles de
+ * SimpleCSRInternalLinearAlgebra. Seules les opérations utilisant la
+ * matrice sont spécifiques.
+ *
+ * Cette algèbre peut être utilisée avec les solveurs CG et BiCGStab et les
+ * préconditionneurs diagonal, de Chebyshev et de Neumann. Les
+ * préconditionneurs ILU nécessitent le format CSR et ne sont pas disponibles.
+ */
+class ALIEN_EXPORT SellCSInternalLinearAlgebra
+: public SimpleCSRInternalLinearAlgebra
+{
+ public:
+  // clang-format off
+  typedef BackEnd::tag::sellcs                    BackEndType;
+  typedef AlgebraTraits<BackEndType>::matrix_type Matrix;
+  typedef AlgebraTraits<BackEndType>::vector_type Vector;
+  // clang-format on
+
+  SellCSInternalLinearAlgebra();
+  virtual ~SellCSInternalLinearAlgebra();
+
+ public:
+  // Les méthodes suivantes masquent celles de SimpleCSRInternalLinearAlgebra.
+  void mult(const Matrix& A, const Vector& x, Vector& r) const;
+  void computeInvDiag(const Matrix& A, Vector& inv_diag) const;
+
+  template <typename PrecondT>
+  void exec(PrecondT& precond, Vector const& x, Vector& y)
+  {
+    return precond.solve(*this, x, y);
+  }
+
+  static ResourceType const& resource(Matrix const& A);
+
+  void allocate(ResourceType const& resource, Vector& v);
+
+  template <typename T0, typename... T>
+  void allocate(ResourceType const& resource, T0& v0, T&... args)
+  {
+    allocate(resource, v0);
+    allocate(resource, args...);
+  }
+
+  void free(Vector& v);
+
+  template <typename T0, typename... T>
+  void free(T0& v0, T&... args)
+  {
+    free(v0);
+    free(args...);
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace Alien
+
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,59 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+
+#include <alien/core/backend/IMatrixConverter.h>
+#include <alien/core/backend/MatrixConverterRegisterer.h>
+
+#include <alien/kernels/dok/DoKBackEnd.h>
+#include <alien/kernels/dok/DoKMatrixT.h>
+#include <alien/kernels/dok/converters/to_simple_csr_matrix.h>
+#include <alien/kernels/sell_cs/SellCSBackEnd.h>
+#include <alien/kernels/sell_cs/SellCSMatrix.h>
+#include <alien/kernels/simple_csr/SimpleCSRMatrix.h>
+
+using namespace Alien;
+
+/*---------------------------------------------------------------------------*/
+
+/*!
+ * \brief Conversion d'une matrice DoK en SELL-C-sigma.
+ *
+ * La matrice est d'abord convertie dans une SimpleCSRMatrix temporaire
+ * qui calcule les informations de distribution (colonnes fantômes et
+ * communications) utilisées par la multiplication parallèle.
+ */
+class DoKtoSellCSMatrixConverter : public IMatrixConverter
+{
+ public:
+  DoKtoSellCSMatrixConverter() {}
+  virtual ~DoKtoSellCSMatrixConverter() {}
+
+ public:
+  BackEndId sourceBackend() const { return AlgebraTraits<BackEnd::tag::DoK>::name(); }
+  BackEndId targetBackend() const { return AlgebraTraits<BackEnd::tag::sellcs>::name(); }
+  void convert(const IMatrixImpl* sourceImpl, IMatrixImpl* targetImpl) const;
+};
+
+/*---------------------------------------------------------------------------*/
+
+void DoKtoSellCSMatrixConverter::convert(
+const IMatrixImpl* sourceImpl, IMatrixImpl* targetImpl) const
+{
+  const DoKMatrix& v = cast<DoKMatrix>(sourceImpl, sourceBackend());
+  SellCSMatrix<Real>& v2 = cast<SellCSMatrix<Real>>(targetImpl, targetBackend());
+
+  alien_debug(
+  [&] { cout() << "Converting DoKMatrix: " << &v << " to SellCSMatrix " << &v2; });
+
+  SimpleCSRMatrix<Real> csr;
+  DoKtoSimpleCSRMatrixConverter().convert(sourceImpl, &csr);
+  v2.initFromCSR(csr);
+}
+
+/*---------------------------------------------------------------------------*/
+
+REGISTER_MATRIX_CONVERTER(DoKtoSellCSMatrixConverter);
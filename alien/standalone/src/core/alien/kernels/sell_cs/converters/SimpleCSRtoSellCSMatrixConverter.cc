@@ -0,0 +1,55 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+
+#include <alien/core/backend/IMatrixConverter.h>
+#include <alien/core/backend/MatrixConverterRegisterer.h>
+
+#include <alien/kernels/sell_cs/SellCSBackEnd.h>
+#include <alien/kernels/sell_cs/SellCSMatrix.h>
+#include <alien/kernels/simple_csr/SimpleCSRBackEnd.h>
+#include <alien/kernels/simple_csr/SimpleCSRMatrix.h>
+
+using namespace Alien;
+
+/*---------------------------------------------------------------------------*/
+
+class SimpleCSRtoSellCSMatrixConverter : public IMatrixConverter
+{
+ public:
+  SimpleCSRtoSellCSMatrixConverter() {}
+  virtual ~SimpleCSRtoSellCSMatrixConverter() {}
+
+ public:
+  BackEndId sourceBackend() const
+  {
+    return AlgebraTraits<BackEnd::tag::simplecsr>::name();
+  }
+  BackEndId targetBackend() const { return AlgebraTraits<BackEnd::tag::sellcs>::name(); }
+  void convert(const IMatrixImpl* sourceImpl, IMatrixImpl* targetImpl) const;
+};
+
+/*---------------------------------------------------------------------------*/
+
+void SimpleCSRtoSellCSMatrixConverter::convert(
+const IMatrixImpl* sourceImpl, IMatrixImpl* targetImpl) const
+{
+  const SimpleCSRMatrix<Real>& v =
+  cast<SimpleCSRMatrix<Real>>(sourceImpl, sourceBackend());
+  SellCSMatrix<Real>& v2 = cast<SellCSMatrix<Real>>(targetImpl, targetBackend());
+
+  alien_debug(
+  [&] { cout() << "Converting SimpleCSRMatrix: " << &v << " to SellCSMatrix " << &v2; });
+
+  if (sourceImpl->block() || sourceImpl->vblock())
+    throw FatalErrorException(A_FUNCINFO, "Block matrices are not handled by SELL-C-sigma back-end");
+
+  v2.initFromCSR(v);
+}
+
+/*---------------------------------------------------------------------------*/
+
+REGISTER_MATRIX_CONVERTER(SimpleCSRtoSellCSMatrixConverter);
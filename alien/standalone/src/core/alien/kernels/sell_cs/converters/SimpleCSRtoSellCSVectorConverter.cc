@@ -0,0 +1,54 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+
+#include <alien/core/backend/IVectorConverter.h>
+#include <alien/core/backend/VectorConverterRegisterer.h>
+
+#include <alien/kernels/sell_cs/SellCSBackEnd.h>
+#include <alien/kernels/sell_cs/SellCSVector.h>
+#include <alien/kernels/simple_csr/SimpleCSRBackEnd.h>
+#include <alien/kernels/simple_csr/SimpleCSRVector.h>
+
+using namespace Alien;
+
+/*---------------------------------------------------------------------------*/
+
+class SimpleCSRtoSellCSVectorConverter : public IVectorConverter
+{
+ public:
+  SimpleCSRtoSellCSVectorConverter() {}
+  virtual ~SimpleCSRtoSellCSVectorConverter() {}
+
+ public:
+  Alien::BackEndId sourceBackend() const
+  {
+    return AlgebraTraits<BackEnd::tag::simplecsr>::name();
+  }
+  Alien::BackEndId targetBackend() const
+  {
+    return AlgebraTraits<BackEnd::tag::sellcs>::name();
+  }
+  void convert(const IVectorImpl* sourceImpl, IVectorImpl* targetImpl) const;
+};
+
+/*---------------------------------------------------------------------------*/
+
+void SimpleCSRtoSellCSVectorConverter::convert(
+const IVectorImpl* sourceImpl, IVectorImpl* targetImpl) const
+{
+  const SimpleCSRVector<Real>& v = cast<SimpleCSRVector<Real>>(sourceImpl, sourceBackend());
+  SellCSVector<Real>& v2 = cast<SellCSVector<Real>>(targetImpl, targetBackend());
+
+  alien_debug(
+  [&] { cout() << "Converting SimpleCSRVector: " << &v << " to SellCSVector " << &v2; });
+
+  v2.values().copy(v.values());
+}
+
+/*---------------------------------------------------------------------------*/
+
+REGISTER_VECTOR_CONVERTER(SimpleCSRtoSellCSVectorConverter);
@@ -159,6 +159,11 @@ class SimpleCSRMatrix : public IMatrixImpl
     return m_parallel_mng;
   }
 
+  IMessagePassingMng* getParallelMng() const
+  {
+    return m_parallel_mng;
+  }
+
   void sequentialStart()
   {
     m_local_offset = 0;
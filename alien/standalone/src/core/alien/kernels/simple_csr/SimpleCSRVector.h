@@ -52,6 +52,15 @@ class SimpleCSRVector : public IVectorImpl
   , m_vblock(nullptr)
   {}
 
+ protected:
+  //! Constructeur pour les back-ends utilisant le même stockage (back-end \a backend)
+  SimpleCSRVector(const MultiVectorImpl* multi_impl, BackEndId backend)
+  : IVectorImpl(multi_impl, backend)
+  , m_local_size(0)
+  , m_vblock(nullptr)
+  {}
+
+ public:
   void allocate()
   {
     m_values.resize(m_local_size);
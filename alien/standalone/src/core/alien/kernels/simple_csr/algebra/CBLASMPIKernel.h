@@ -30,6 +30,7 @@
 
 #include <alien/utils/Precomp.h>
 #include <alien/kernels/simple_csr/algebra/alien_cblas.h>
+#include <alien/kernels/simple_csr/algebra/KernelThreadPool.h>
 
 namespace Alien
 {
@@ -46,22 +47,32 @@ class CBLASMPIKernel
   Distribution const& dist ALIEN_UNUSED_PARAM, const VectorT& x, VectorT& y)
   {
     typedef typename VectorT::ValueType ValueType;
-    cblas::copy(
-    x.scalarizedLocalSize(), (ValueType*)x.getDataPtr(), 1, y.getDataPtr(), 1);
+    ValueType* x_ptr = (ValueType*)x.getDataPtr();
+    ValueType* y_ptr = y.getDataPtr();
+    _pool().forEachRange(x.scalarizedLocalSize(), [&](Integer begin, Integer end) {
+      cblas::copy(end - begin, x_ptr + begin, 1, y_ptr + begin, 1);
+    });
   }
 
   template <typename Distribution, typename VectorT>
   static void axpy(Distribution const& dist ALIEN_UNUSED_PARAM,
                    typename VectorT::ValueType alpha, const VectorT& x, VectorT& y)
   {
-    cblas::axpy(x.scalarizedLocalSize(), alpha, x.getDataPtr(), 1, y.getDataPtr(), 1);
+    auto x_ptr = x.getDataPtr();
+    auto y_ptr = y.getDataPtr();
+    _pool().forEachRange(x.scalarizedLocalSize(), [&](Integer begin, Integer end) {
+      cblas::axpy(end - begin, alpha, x_ptr + begin, 1, y_ptr + begin, 1);
+    });
   }
 
   template <typename Distribution, typename VectorT>
   static void scal(Distribution const& dist ALIEN_UNUSED_PARAM,
                    typename VectorT::ValueType alpha, VectorT& x)
   {
-    cblas::scal(x.scalarizedLocalSize(), alpha, x.getDataPtr(), 1);
+    auto x_ptr = x.getDataPtr();
+    _pool().forEachRange(x.scalarizedLocalSize(), [&](Integer begin, Integer end) {
+      cblas::scal(end - begin, alpha, x_ptr + begin, 1);
+    });
   }
 
   template <typename Distribution, typename VectorT>
@@ -74,9 +85,11 @@ class CBLASMPIKernel
     auto x_ptr = x.getDataPtr();
     auto y_ptr = y.getDataPtr();
     auto z_ptr = z.getDataPtr();
-    for (std::size_t i = 0; i < local_size; ++i) {
-      z_ptr[i] = x_ptr[i] * y_ptr[i];
-    }
+    _pool().forEachRange(local_size, [&](Integer begin, Integer end) {
+      for (Integer i = begin; i < end; ++i) {
+        z_ptr[i] = x_ptr[i] * y_ptr[i];
+      }
+    });
   }
 
   template <typename Distribution, typename VectorT>
@@ -86,9 +99,11 @@ class CBLASMPIKernel
   {
     auto local_size = y.scalarizedLocalSize();
     auto y_ptr = y.getDataPtr();
-    for (std::size_t i = 0; i < local_size; ++i) {
-      y_ptr[i] = alpha;
-    }
+    _pool().forEachRange(local_size, [&](Integer begin, Integer end) {
+      for (Integer i = begin; i < end; ++i) {
+        y_ptr[i] = alpha;
+      }
+    });
   }
 
   template <typename Distribution, typename VectorT>
@@ -96,8 +111,46 @@ class CBLASMPIKernel
   Distribution const& dist, const VectorT& x, const VectorT& y)
   {
     typedef typename VectorT::ValueType ValueType;
-    ValueType value = cblas::dot(x.scalarizedLocalSize(), (ValueType*)x.getDataPtr(), 1,
-                                 (ValueType*)y.getDataPtr(), 1);
+    ValueType value = _dot(x.scalarizedLocalSize(), (ValueType*)x.getDataPtr(),
+                           (ValueType*)y.getDataPtr());
+    if (dist.isParallel()) {
+      return Arccore::MessagePassing::mpAllReduce(
+      dist.parallelMng(), Arccore::MessagePassing::ReduceSum, value);
+    }
+    return value;
+  }
+
+  /*!
+   * \brief Produit scalaire local au sous-domaine, sans réduction globale.
+   */
+  template <typename VectorT>
+  static typename VectorT::ValueType localDot(const VectorT& x, const VectorT& y)
+  {
+    typedef typename VectorT::ValueType ValueType;
+    return _dot(x.scalarizedLocalSize(), (ValueType*)x.getDataPtr(),
+                (ValueType*)y.getDataPtr());
+  }
+
+  /*!
+   * \brief Calcule y += alpha * x et retourne dot(y,z) en un seul parcours.
+   */
+  template <typename Distribution, typename VectorT>
+  static typename VectorT::ValueType axpyDot(Distribution const& dist,
+                                             typename VectorT::ValueType alpha,
+                                             const VectorT& x, VectorT& y, const VectorT& z)
+  {
+    typedef typename VectorT::ValueType ValueType;
+    auto x_ptr = x.getDataPtr();
+    auto y_ptr = y.getDataPtr();
+    auto z_ptr = z.getDataPtr();
+    ValueType value = _pool().reduceSum<ValueType>(y.scalarizedLocalSize(), [&](Integer begin, Integer end) {
+      ValueType sum = ValueType();
+      for (Integer i = begin; i < end; ++i) {
+        y_ptr[i] += alpha * x_ptr[i];
+        sum += y_ptr[i] * z_ptr[i];
+      }
+      return sum;
+    });
     if (dist.isParallel()) {
       return Arccore::MessagePassing::mpAllReduce(
       dist.parallelMng(), Arccore::MessagePassing::ReduceSum, value);
@@ -126,8 +179,10 @@ class CBLASMPIKernel
   static typename VectorT::ValueType nrm1(Distribution const& dist, const VectorT& x)
   {
     typedef typename VectorT::ValueType ValueType;
-    typename VectorT::ValueType value = cblas::nrm1(x.scalarizedLocalSize(),
-                                                    (ValueType*)x.getDataPtr(), 1);
+    ValueType* x_ptr = (ValueType*)x.getDataPtr();
+    ValueType value = _pool().reduceSum<ValueType>(x.scalarizedLocalSize(), [&](Integer begin, Integer end) {
+      return cblas::nrm1(end - begin, x_ptr + begin, 1);
+    });
     if (dist.isParallel()) {
       value = Arccore::MessagePassing::mpAllReduce(
       dist.parallelMng(), Arccore::MessagePassing::ReduceSum, value);
@@ -139,8 +194,8 @@ class CBLASMPIKernel
   static typename VectorT::ValueType nrm2(Distribution const& dist, const VectorT& x)
   {
     typedef typename VectorT::ValueType ValueType;
-    typename VectorT::ValueType value = cblas::dot(x.scalarizedLocalSize(),
-                                                   (ValueType*)x.getDataPtr(), 1, (ValueType*)x.getDataPtr(), 1);
+    ValueType* x_ptr = (ValueType*)x.getDataPtr();
+    ValueType value = _dot(x.scalarizedLocalSize(), x_ptr, x_ptr);
     if (dist.isParallel()) {
       value = Arccore::MessagePassing::mpAllReduce(
       dist.parallelMng(), Arccore::MessagePassing::ReduceSum, value);
@@ -177,6 +232,20 @@ class CBLASMPIKernel
     }
     return std::sqrt(value);
   }
+
+ private:
+  static SimpleCSRInternal::KernelThreadPool& _pool()
+  {
+    return SimpleCSRInternal::KernelThreadPool::instance();
+  }
+
+  template <typename ValueType>
+  static ValueType _dot(Integer n, ValueType* x, ValueType* y)
+  {
+    return _pool().reduceSum<ValueType>(n, [&](Integer begin, Integer end) {
+      return cblas::dot(end - begin, x + begin, 1, y + begin, 1);
+    });
+  }
 };
 
 } // namespace Alien
@@ -0,0 +1,147 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* KernelThreadPool.cc                                         (C) 2000-2024 */
+/*                                                                           */
+/* Pool de threads pour les noyaux de calcul SimpleCSR.                      */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "KernelThreadPool.h"
+
+#include <cstdlib>
+#include <string>
+
+/*---------------------------------------------------------------------------*/
+
+namespace Alien::SimpleCSRInternal
+{
+
+/*---------------------------------------------------------------------------*/
+
+KernelThreadPool::
+KernelThreadPool()
+{
+  if (const char* env_value = std::getenv("ALIEN_SIMPLECSR_NB_THREAD")) {
+    try {
+      setNbThread(std::stoi(env_value));
+    }
+    catch (const std::exception&) {
+      throw FatalErrorException(A_FUNCINFO, String::format("Invalid value '{0}' for ALIEN_SIMPLECSR_NB_THREAD", env_value));
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+
+KernelThreadPool::
+~KernelThreadPool()
+{
+  _stopThreads();
+}
+
+/*---------------------------------------------------------------------------*/
+
+KernelThreadPool& KernelThreadPool::
+instance()
+{
+  static KernelThreadPool pool;
+  return pool;
+}
+
+/*---------------------------------------------------------------------------*/
+
+void KernelThreadPool::
+setNbThread(Integer nb_thread)
+{
+  if (nb_thread < 1)
+    nb_thread = 1;
+  if (nb_thread == m_nb_thread)
+    return;
+  _stopThreads();
+  m_nb_thread = nb_thread;
+  m_is_exit = false;
+  // Les threads partent de la génération courante pour ne pas exécuter
+  // à nouveau un travail déjà terminé.
+  const Int64 generation = m_generation;
+  for (Integer i = 1; i < nb_thread; ++i)
+    m_threads.emplace_back([this, i, generation] { _workerLoop(i, generation); });
+}
+
+/*---------------------------------------------------------------------------*/
+
+void KernelThreadPool::
+_stopThreads()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_is_exit = true;
+  }
+  m_work_condition.notify_all();
+  for (std::thread& t : m_threads)
+    t.join();
+  m_threads.clear();
+  m_nb_thread = 1;
+}
+
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Exécute \a f(i) pour i dans [0,nb_chunk[.
+ *
+ * Le morceau \a i est traité par le thread \a i, le morceau 0 par
+ * le thread appelant.
+ */
+void KernelThreadPool::
+_run(Integer nb_chunk, const std::function<void(Integer)>& f)
+{
+  std::unique_lock<std::mutex> run_lock(m_run_mutex, std::try_to_lock);
+  if (!run_lock.owns_lock()) {
+    for (Integer i = 0; i < nb_chunk; ++i)
+      f(i);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_function = &f;
+    m_nb_chunk = nb_chunk;
+    m_nb_remaining = m_nb_thread - 1;
+    ++m_generation;
+  }
+  m_work_condition.notify_all();
+  f(0);
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done_condition.wait(lock, [this] { return m_nb_remaining == 0; });
+  m_function = nullptr;
+}
+
+/*---------------------------------------------------------------------------*/
+
+void KernelThreadPool::
+_workerLoop(Integer index, Int64 generation)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (;;) {
+    m_work_condition.wait(lock, [&] { return m_is_exit || m_generation != generation; });
+    if (m_is_exit)
+      return;
+    generation = m_generation;
+    const std::function<void(Integer)>* f = m_function;
+    const bool has_work = index < m_nb_chunk;
+    lock.unlock();
+    if (has_work)
+      (*f)(index);
+    lock.lock();
+    if (--m_nb_remaining == 0)
+      m_done_condition.notify_one();
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace Alien::SimpleCSRInternal
+
+/*---------------------------------------------------------------------------*/
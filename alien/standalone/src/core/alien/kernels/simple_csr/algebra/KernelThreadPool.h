@@ -0,0 +1,178 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* KernelThreadPool.h                                          (C) 2000-2024 */
+/*                                                                           */
+/* Pool de threads pour les noyaux de calcul SimpleCSR.                      */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <alien/utils/Precomp.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+
+namespace Alien::SimpleCSRInternal
+{
+
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Pool de threads pour les noyaux de calcul SimpleCSR.
+ *
+ * Ce pool est utilisé par le produit matrice-vecteur et les opérations
+ * vectorielles du backend SimpleCSR. Par défaut il ne contient qu'un
+ * thread et les noyaux sont exécutés séquentiellement comme auparavant.
+ * Le nombre de threads est positionné par la variable d'environnement
+ * ALIEN_SIMPLECSR_NB_THREAD ou par setNbThread().
+ *
+ * Les threads sont créés une seule fois et attendent du travail entre deux
+ * appels. Le thread appelant exécute le premier morceau. Si le pool est
+ * déjà utilisé par un autre thread (par exemple plusieurs sous-domaines
+ * dans le même processus), le travail est fait séquentiellement par
+ * l'appelant.
+ *
+ * Les réductions sont faites en sommant les résultats partiels dans l'ordre
+ * des morceaux, ce qui rend le résultat reproductible pour un nombre de
+ * threads donné.
+ */
+class ALIEN_EXPORT KernelThreadPool
+{
+ public:
+
+  //! Nombre minimum d'éléments traités par un thread.
+  static constexpr Integer MinChunkSize = 4096;
+
+ public:
+
+  KernelThreadPool();
+  ~KernelThreadPool();
+  KernelThreadPool(const KernelThreadPool&) = delete;
+  KernelThreadPool& operator=(const KernelThreadPool&) = delete;
+
+ public:
+
+  //! Instance partagée par les noyaux SimpleCSR.
+  static KernelThreadPool& instance();
+
+  //! Nombre de threads (y compris le thread appelant)
+  Integer nbThread() const { return m_nb_thread; }
+
+  /*!
+   * \brief Positionne le nombre de threads.
+   *
+   * Une valeur inférieure ou égale à 1 rend l'exécution séquentielle.
+   * Cette méthode ne doit pas être appelée pendant l'exécution d'un noyau.
+   */
+  void setNbThread(Integer nb_thread);
+
+  //! Nombre de morceaux à utiliser pour traiter \a n éléments.
+  Integer nbChunk(Integer n) const
+  {
+    if (m_nb_thread <= 1)
+      return 1;
+    return std::clamp(n / MinChunkSize, 1, m_nb_thread);
+  }
+
+  //! Appelle \a f(begin,end) sur des intervalles de même taille couvrant [0,n[.
+  template <typename LambdaT>
+  void forEachRange(Integer n, const LambdaT& f)
+  {
+    const Integer nb_chunk = nbChunk(n);
+    if (nb_chunk == 1) {
+      f(0, n);
+      return;
+    }
+    _run(nb_chunk, [&](Integer ichunk) {
+      f(_rangeBegin(n, nb_chunk, ichunk), _rangeBegin(n, nb_chunk, ichunk + 1));
+    });
+  }
+
+  /*!
+   * \brief Appelle \a f(begin,end) sur des intervalles de lignes couvrant [0,nrow[.
+   *
+   * Le découpage est fait pour que chaque intervalle contienne à peu près
+   * le même nombre de coefficients non nuls d'après \a row_offset.
+   */
+  template <typename LambdaT>
+  void forEachRowRange(ConstArrayView<Integer> row_offset, Integer nrow, const LambdaT& f)
+  {
+    const Integer nb_chunk = nbChunk(nrow);
+    if (nb_chunk == 1) {
+      f(0, nrow);
+      return;
+    }
+    _run(nb_chunk, [&](Integer ichunk) {
+      f(_rowBegin(row_offset, nrow, nb_chunk, ichunk), _rowBegin(row_offset, nrow, nb_chunk, ichunk + 1));
+    });
+  }
+
+  //! Somme des valeurs retournées par \a f(begin,end) sur des intervalles couvrant [0,n[.
+  template <typename ValueT, typename LambdaT>
+  ValueT reduceSum(Integer n, const LambdaT& f)
+  {
+    const Integer nb_chunk = nbChunk(n);
+    if (nb_chunk == 1)
+      return f(0, n);
+    std::vector<ValueT> partial_sums(nb_chunk, ValueT());
+    _run(nb_chunk, [&](Integer ichunk) {
+      partial_sums[ichunk] = f(_rangeBegin(n, nb_chunk, ichunk), _rangeBegin(n, nb_chunk, ichunk + 1));
+    });
+    ValueT sum = ValueT();
+    for (const ValueT& v : partial_sums)
+      sum += v;
+    return sum;
+  }
+
+ private:
+
+  Integer m_nb_thread = 1;
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::mutex m_run_mutex;
+  std::condition_variable m_work_condition;
+  std::condition_variable m_done_condition;
+  const std::function<void(Integer)>* m_function = nullptr;
+  Integer m_nb_chunk = 0;
+  Integer m_nb_remaining = 0;
+  Int64 m_generation = 0;
+  bool m_is_exit = false;
+
+ private:
+
+  void _run(Integer nb_chunk, const std::function<void(Integer)>& f);
+  void _workerLoop(Integer index, Int64 generation);
+  void _stopThreads();
+
+  static Integer _rangeBegin(Integer n, Integer nb_chunk, Integer ichunk)
+  {
+    return static_cast<Integer>((static_cast<Int64>(n) * ichunk) / nb_chunk);
+  }
+  static Integer _rowBegin(ConstArrayView<Integer> row_offset, Integer nrow,
+                           Integer nb_chunk, Integer ichunk)
+  {
+    if (ichunk == nb_chunk)
+      return nrow;
+    const Int64 nnz = row_offset[nrow] - row_offset[0];
+    const Int64 target = row_offset[0] + (nnz * ichunk) / nb_chunk;
+    const Integer* begin = row_offset.data();
+    return static_cast<Integer>(std::lower_bound(begin, begin + nrow, target) - begin);
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+
+} // namespace Alien::SimpleCSRInternal
+
+/*---------------------------------------------------------------------------*/
@@ -237,6 +237,58 @@ void SimpleCSRInternalLinearAlgebra::dot(const CSRVector& vx,
 
 /*---------------------------------------------------------------------------*/
 
+Real SimpleCSRInternalLinearAlgebra::axpyDot(Real alpha, const CSRVector& vx, CSRVector& vy,
+                                             const CSRVector& vz) const
+{
+#ifdef ALIEN_USE_PERF_TIMER
+  SentryType s(m_timer, "CSR-AXPYDOT");
+#endif
+  return CBLASMPIKernel::axpyDot(vy.distribution(), alpha, vx, vy, vz);
+}
+
+/*---------------------------------------------------------------------------*/
+
+void SimpleCSRInternalLinearAlgebra::multiDot(std::initializer_list<DotArgs> dots,
+                                              SimpleCSRInternalLinearAlgebra::MultiFutureType& res) const
+{
+#ifdef ALIEN_USE_PERF_TIMER
+  SentryType s(m_timer, "CSR-MULTIDOT");
+#endif
+  // Les tableaux de \a res ne doivent pas être modifiés pendant une réduction.
+  res.wait();
+  const Integer nb_dot = static_cast<Integer>(dots.size());
+  res.m_local_values.resize(nb_dot);
+  res.m_values.resize(nb_dot);
+  if (nb_dot == 0)
+    return;
+  Integer index = 0;
+  for (const DotArgs& d : dots) {
+    res.m_local_values[index] = CBLASMPIKernel::localDot(*d.first, *d.second);
+    ++index;
+  }
+  const VectorDistribution& dist = dots.begin()->first->distribution();
+  if (dist.isParallel()) {
+    res.m_parallel_mng = dist.parallelMng();
+    res.m_request = Arccore::MessagePassing::mpNonBlockingAllReduce(
+    res.m_parallel_mng, Arccore::MessagePassing::ReduceSum,
+    res.m_local_values.constSpan(), res.m_values.span());
+  }
+  else
+    res.m_values.copy(res.m_local_values.constSpan());
+}
+
+/*---------------------------------------------------------------------------*/
+
+void SimpleCSRInternalLinearAlgebra::MultiFuture::wait()
+{
+  if (m_request.isValid()) {
+    Arccore::MessagePassing::mpWait(m_parallel_mng, m_request);
+    m_request.reset();
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+
 void SimpleCSRInternalLinearAlgebra::scal(Real alpha, CSRVector& vx) const
 {
 #ifdef ALIEN_USE_PERF_TIMER
@@ -28,6 +28,11 @@
 #include <alien/utils/ExceptionUtils.h>
 
 #include <alien/utils/StdTimer.h>
+
+#include <arccore/message_passing/Request.h>
+
+#include <initializer_list>
+#include <utility>
 /*---------------------------------------------------------------------------*/
 
 namespace Alien
@@ -95,6 +100,39 @@ class ALIEN_EXPORT SimpleCSRInternalLinearAlgebra
 
   typedef Future<Real> FutureType;
 
+  /*!
+   * \brief Résultat de plusieurs produits scalaires réduits globalement
+   * en une seule opération non bloquante.
+   *
+   * Les valeurs sont disponibles via get() qui attend si besoin la fin
+   * de la réduction. Une même instance peut être réutilisée pour plusieurs
+   * appels successifs à multiDot().
+   */
+  class ALIEN_EXPORT MultiFuture
+  {
+    friend class SimpleCSRInternalLinearAlgebra;
+
+   public:
+    //! Valeur du \a i-ème produit scalaire
+    Real get(Integer i)
+    {
+      wait();
+      return m_values[i];
+    }
+
+    //! Attend la fin de la réduction en cours
+    void wait();
+
+   private:
+    UniqueArray<Real> m_local_values;
+    UniqueArray<Real> m_values;
+    Arccore::MessagePassing::IMessagePassingMng* m_parallel_mng = nullptr;
+    Arccore::MessagePassing::Request m_request;
+  };
+
+  typedef MultiFuture MultiFutureType;
+  typedef std::pair<const Vector*, const Vector*> DotArgs;
+
   typedef Alien::StdTimer TimerType;
   typedef TimerType::Sentry SentryType;
 
@@ -121,6 +159,22 @@ class ALIEN_EXPORT SimpleCSRInternalLinearAlgebra
 
   Real dot(const Vector& x, const Vector& y) const;
   void dot(const Vector& x, const Vector& y, FutureType& res) const;
+  /*!
+   * \brief Calcule y += alpha * x et retourne dot(y,z) en un seul parcours des vecteurs.
+   *
+   * Utilisé par CG::solve() et BiCGStab::solve() pour la mise à jour du
+   * résidu suivie du calcul de sa norme (voir KrylovUtils::axpyDot()).
+   */
+  Real axpyDot(Real alpha, const Vector& x, Vector& y, const Vector& z) const;
+  /*!
+   * \brief Calcule les produits scalaires des couples de \a dots.
+   *
+   * Les produits scalaires locaux sont calculés immédiatement puis réduits
+   * globalement par une seule réduction non bloquante. Le résultat est
+   * disponible via \a res, ce qui permet de recouvrir la réduction par
+   * d'autres calculs.
+   */
+  void multiDot(std::initializer_list<DotArgs> dots, MultiFutureType& res) const;
 
   void scal(Real alpha, Vector& x) const;
   void diagonal(const Matrix& a, Vector& x) const;
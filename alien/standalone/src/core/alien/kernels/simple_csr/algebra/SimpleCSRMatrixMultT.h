@@ -11,6 +11,8 @@
 
 #include <alien/handlers/scalar/CSRModifierViewT.h>
 
+#include <alien/kernels/simple_csr/algebra/KernelThreadPool.h>
+
 /*---------------------------------------------------------------------------*/
 
 namespace Alien::SimpleCSRInternal
@@ -89,31 +91,37 @@ const VectorType& x_impl, VectorType& y_impl) const
                       m_matrix_impl.m_send_policy, x_ptr, m_matrix_impl.m_matrix_dist_info.m_recv_info,
                       m_matrix_impl.m_recv_policy, m_matrix_impl.m_parallel_mng, m_matrix_impl.m_trace);
   op.start();
+  // La partie locale est calculée pendant les échanges des valeurs fantômes.
+  KernelThreadPool& pool = KernelThreadPool::instance();
   ConstArrayView<Integer> local_row_size =
   m_matrix_impl.m_matrix_dist_info.m_local_row_size;
-  for (Integer irow = 0; irow < m_matrix_impl.m_local_size; ++irow) {
-    Integer off = row_offset[irow];
-    Integer off2 = off + local_row_size[irow];
-    Real tmpy = 0.;
-    for (Integer j = off; j < off2; ++j) {
-      tmpy += matrix[j] * x_ptr[cols[j]];
+  pool.forEachRowRange(row_offset, m_matrix_impl.m_local_size, [&](Integer begin, Integer end) {
+    for (Integer irow = begin; irow < end; ++irow) {
+      Integer off = row_offset[irow];
+      Integer off2 = off + local_row_size[irow];
+      Real tmpy = 0.;
+      for (Integer j = off; j < off2; ++j) {
+        tmpy += matrix[j] * x_ptr[cols[j]];
+      }
+      y_ptr[irow] = tmpy;
     }
-    y_ptr[irow] = tmpy;
-  }
+  });
   op.end();
 
   Integer interface_nrow = m_matrix_impl.m_matrix_dist_info.m_interface_nrow;
   ConstArrayView<Integer> row_ids = m_matrix_impl.m_matrix_dist_info.m_interface_rows;
-  for (Integer i = 0; i < interface_nrow; ++i) {
-    Integer irow = row_ids[i];
-    Integer off = row_offset[irow] + local_row_size[irow];
-    Integer off2 = row_offset[irow + 1];
-    Real tmpy = 0.;
-    for (Integer j = off; j < off2; ++j) {
-      tmpy += matrix[j] * x_ptr[cols[j]];
+  pool.forEachRange(interface_nrow, [&](Integer begin, Integer end) {
+    for (Integer i = begin; i < end; ++i) {
+      Integer irow = row_ids[i];
+      Integer off = row_offset[irow] + local_row_size[irow];
+      Integer off2 = row_offset[irow + 1];
+      Real tmpy = 0.;
+      for (Integer j = off; j < off2; ++j) {
+        tmpy += matrix[j] * x_ptr[cols[j]];
+      }
+      y_ptr[irow] += tmpy;
     }
-    y_ptr[irow] += tmpy;
-  }
+  });
 }
 
 template <typename ValueT>
@@ -130,31 +138,37 @@ const UniqueArray<Real>& x_impl, UniqueArray<Real>& y_impl) const
                       m_matrix_impl.m_send_policy, x_ptr, m_matrix_impl.m_matrix_dist_info.m_recv_info,
                       m_matrix_impl.m_recv_policy, m_matrix_impl.m_parallel_mng, m_matrix_impl.m_trace);
   op.start();
+  // La partie locale est calculée pendant les échanges des valeurs fantômes.
+  KernelThreadPool& pool = KernelThreadPool::instance();
   ConstArrayView<Integer> local_row_size =
   m_matrix_impl.m_matrix_dist_info.m_local_row_size;
-  for (Integer irow = 0; irow < m_matrix_impl.m_local_size; ++irow) {
-    Integer off = row_offset[irow];
-    Integer off2 = off + local_row_size[irow];
-    Real tmpy = 0.;
-    for (Integer j = off; j < off2; ++j) {
-      tmpy += matrix[j] * x_ptr[cols[j]];
+  pool.forEachRowRange(row_offset, m_matrix_impl.m_local_size, [&](Integer begin, Integer end) {
+    for (Integer irow = begin; irow < end; ++irow) {
+      Integer off = row_offset[irow];
+      Integer off2 = off + local_row_size[irow];
+      Real tmpy = 0.;
+      for (Integer j = off; j < off2; ++j) {
+        tmpy += matrix[j] * x_ptr[cols[j]];
+      }
+      y_ptr[irow] = tmpy;
     }
-    y_ptr[irow] = tmpy;
-  }
+  });
   op.end();
 
   Integer interface_nrow = m_matrix_impl.m_matrix_dist_info.m_interface_nrow;
   ConstArrayView<Integer> row_ids = m_matrix_impl.m_matrix_dist_info.m_interface_rows;
-  for (Integer i = 0; i < interface_nrow; ++i) {
-    Integer irow = row_ids[i];
-    Integer off = row_offset[irow] + local_row_size[irow];
-    Integer off2 = row_offset[irow + 1];
-    Real tmpy = 0.;
-    for (Integer j = off; j < off2; ++j) {
-      tmpy += matrix[j] * x_ptr[cols[j]];
+  pool.forEachRange(interface_nrow, [&](Integer begin, Integer end) {
+    for (Integer i = begin; i < end; ++i) {
+      Integer irow = row_ids[i];
+      Integer off = row_offset[irow] + local_row_size[irow];
+      Integer off2 = row_offset[irow + 1];
+      Real tmpy = 0.;
+      for (Integer j = off; j < off2; ++j) {
+        tmpy += matrix[j] * x_ptr[cols[j]];
+      }
+      y_ptr[irow] += tmpy;
     }
-    y_ptr[irow] += tmpy;
-  }
+  });
 }
 /*---------------------------------------------------------------------------*/
 
@@ -170,13 +184,15 @@ void SimpleCSRMatrixMultT<ValueT>::_seqMult(const VectorType& x_impl, VectorType
   ConstArrayView<Integer> cols = m_matrix_impl.m_matrix.getCSRProfile().getCols();
   ConstArrayView<Integer> row_offset =
   m_matrix_impl.m_matrix.getCSRProfile().getRowOffset();
-  for (Integer irow = 0; irow < m_matrix_impl.m_local_size; ++irow) {
-    Real tmpy = 0.;
-    for (Integer j = row_offset[irow]; j < row_offset[irow + 1]; ++j) {
-      tmpy += matrix[j] * x_ptr[cols[j]];
+  KernelThreadPool::instance().forEachRowRange(row_offset, m_matrix_impl.m_local_size, [&](Integer begin, Integer end) {
+    for (Integer irow = begin; irow < end; ++irow) {
+      Real tmpy = 0.;
+      for (Integer j = row_offset[irow]; j < row_offset[irow + 1]; ++j) {
+        tmpy += matrix[j] * x_ptr[cols[j]];
+      }
+      y_ptr[irow] = tmpy;
     }
-    y_ptr[irow] = tmpy;
-  }
+  });
 }
 
 template <typename ValueT>
@@ -231,13 +247,15 @@ const UniqueArray<Real>& x_impl, UniqueArray<Real>& y_impl) const
   ConstArrayView<Integer> cols = m_matrix_impl.m_matrix.getCSRProfile().getCols();
   ConstArrayView<Integer> row_offset =
   m_matrix_impl.m_matrix.getCSRProfile().getRowOffset();
-  for (Integer irow = 0; irow < m_matrix_impl.m_local_size; ++irow) {
-    Real tmpy = 0.;
-    for (Integer j = row_offset[irow]; j < row_offset[irow + 1]; ++j) {
-      tmpy += matrix[j] * x_ptr[cols[j]];
+  KernelThreadPool::instance().forEachRowRange(row_offset, m_matrix_impl.m_local_size, [&](Integer begin, Integer end) {
+    for (Integer irow = begin; irow < end; ++irow) {
+      Real tmpy = 0.;
+      for (Integer j = row_offset[irow]; j < row_offset[irow + 1]; ++j) {
+        tmpy += matrix[j] * x_ptr[cols[j]];
+      }
+      y_ptr[irow] = tmpy;
     }
-    y_ptr[irow] = tmpy;
-  }
+  });
 }
 
 /*---------------------------------------------------------------------------*/
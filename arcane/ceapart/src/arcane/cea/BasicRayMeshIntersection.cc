@@ -16,6 +16,7 @@
 #include "arcane/utils/StringBuilder.h"
 #include "arcane/utils/TraceAccessor.h"
 #include "arcane/utils/NotImplementedException.h"
+#include "arcane/utils/ValueConvert.h"
 
 #include "arcane/ISubDomain.h"
 #include "arcane/IMesh.h"
@@ -29,6 +30,8 @@
 #include "arcane/IRayMeshIntersection.h"
 #include "arcane/IParallelMng.h"
 #include "arcane/IParticleFamily.h"
+#include "arcane/core/BoundingVolumeHierarchy.h"
+#include "arcane/core/Concurrency.h"
 
 #include "arcane_packages.h"
 
@@ -481,6 +484,7 @@ class BasicRayMeshIntersection
   virtual void setFaceIntersector(IRayFaceIntersector* intersector)
   {
     m_face_intersector = intersector;
+    m_is_default_face_intersector = false;
   }
   virtual IRayFaceIntersector* faceIntersector()
   {
@@ -513,6 +517,29 @@ class BasicRayMeshIntersection
                       RealConstArrayView distances);
  private:
   IRayFaceIntersector* m_face_intersector;
+  //! Indique si \a m_face_intersector a été créé par cette instance
+  bool m_is_default_face_intersector = false;
+  //! Indique si on utilise une hiérarchie de boîtes englobantes en 3D
+  bool m_use_bvh = true;
+  //! Hiérarchie des boîtes englobantes des faces
+  BoundingVolumeHierarchy m_bvh;
+  //! Valeur de IMesh::timestamp() lors de la construction de \a m_bvh
+  Int64 m_bvh_mesh_timestamp = -1;
+  //! Numéros locaux des faces de \a m_bvh
+  Int32UniqueArray m_bvh_faces;
+  Real3UniqueArray m_bvh_faces_min;
+  Real3UniqueArray m_bvh_faces_max;
+
+ private:
+
+  void _updateBVH();
+  void _computeWithBVH(Real3ConstArrayView segments_position,
+                       Real3ConstArrayView segments_direction,
+                       Int32ConstArrayView segments_orig_face,
+                       Int32ArrayView user_values,
+                       Real3ArrayView segments_intersection,
+                       RealArrayView segments_distance,
+                       Int32ArrayView faces_local_id);
 };
 
 /*---------------------------------------------------------------------------*/
@@ -523,6 +550,8 @@ BasicRayMeshIntersection(const ServiceBuildInfo& sbi)
 : BasicService(sbi)
 , m_face_intersector(0)
 {
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_RAY_MESH_INTERSECTION_USE_BVH", true))
+    m_use_bvh = (v.value() != 0);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -541,6 +570,11 @@ compute(Real3ConstArrayView segments_position,
   
   bool is_3d = mesh->dimension()==3;
   info() << "COMPUTE INTERSECTION!!";
+  if (is_3d && m_use_bvh){
+    _computeWithBVH(segments_position,segments_direction,segments_orig_face,user_values,
+                    segments_intersection,segments_distance,faces_local_id);
+    return;
+  }
   FaceGroup outer_faces = mesh->outerFaces();
   Integer nb_face = outer_faces.size();
   Integer nb_segment = segments_position.size();
@@ -635,6 +669,148 @@ compute(Real3ConstArrayView segments_position,
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Met à jour la hiérarchie des boîtes englobantes des faces.
+ *
+ * Seules les faces extérieures propres sont prises en compte. La hiérarchie
+ * n'est reconstruite que si la topologie du maillage a changé. Sinon, seules
+ * les boîtes sont recalculées pour tenir compte du déplacement des noeuds.
+ *
+ * Comme pour le test dans RayTriangle3DIntersection::checkBoundingBox(), la
+ * boîte de chaque face est agrandie de la moitié de sa taille dans chaque
+ * direction pour éviter de rejeter des intersections à cause des arrondis.
+ */
+void BasicRayMeshIntersection::
+_updateBVH()
+{
+  IMesh* mesh = this->mesh();
+  const Int64 timestamp = mesh->timestamp();
+  const bool need_build = (timestamp!=m_bvh_mesh_timestamp);
+  if (need_build){
+    m_bvh_faces.clear();
+    ENUMERATE_FACE(iface,mesh->outerFaces()){
+      if (iface->isOwn())
+        m_bvh_faces.add(iface.itemLocalId());
+    }
+    m_bvh_mesh_timestamp = timestamp;
+  }
+
+  const Int32 nb_face = m_bvh_faces.size();
+  m_bvh_faces_min.resize(nb_face);
+  m_bvh_faces_max.resize(nb_face);
+  VariableNodeReal3 nodes_coordinates(mesh->nodesCoordinates());
+  FaceInfoListView faces(mesh->faceFamily());
+  arcaneParallelFor(0,nb_face,[&](Integer begin,Integer size){
+    for( Integer i=begin; i<(begin+size); ++i ){
+      Face face = faces[m_bvh_faces[i]];
+      Real3 face_min = nodes_coordinates[face.node(0)];
+      Real3 face_max = face_min;
+      for( Node node : face.nodes() ){
+        face_min = math::min(face_min,nodes_coordinates[node]);
+        face_max = math::max(face_max,nodes_coordinates[node]);
+      }
+      Real3 half_extent = (face_max - face_min) * 0.5;
+      m_bvh_faces_min[i] = face_min - half_extent;
+      m_bvh_faces_max[i] = face_max + half_extent;
+    }
+  });
+
+  if (need_build){
+    m_bvh.build(m_bvh_faces_min,m_bvh_faces_max);
+    info() << "Build BVH for ray intersection nb_face=" << nb_face
+           << " nb_node=" << m_bvh.nodes().size();
+  }
+  else
+    m_bvh.refit(m_bvh_faces_min,m_bvh_faces_max);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule les intersections en utilisant la hiérarchie de boîtes.
+ *
+ * Le résultat est le même que celui du parcours de toutes les faces: si
+ * plusieurs faces sont intersectées à la même distance, on conserve
+ * la première dans l'ordre du groupe des faces extérieures.
+ *
+ * Les segments sont traités en parallèle sauf si l'intersecteur de faces
+ * a été positionné par l'utilisateur car il n'est pas forcément
+ * utilisable par plusieurs threads.
+ */
+void BasicRayMeshIntersection::
+_computeWithBVH(Real3ConstArrayView segments_position,
+                Real3ConstArrayView segments_direction,
+                Int32ConstArrayView segments_orig_face,
+                Int32ArrayView user_values,
+                Real3ArrayView segments_intersection,
+                RealArrayView segments_distance,
+                Int32ArrayView faces_local_id)
+{
+  if (!m_face_intersector){
+    m_face_intersector = new BasicRayFaceIntersector(traceMng());
+    m_is_default_face_intersector = true;
+  }
+  _updateBVH();
+
+  IMesh* mesh = this->mesh();
+  VariableNodeReal3 nodes_coordinates(mesh->nodesCoordinates());
+  FaceInfoListView faces(mesh->faceFamily());
+  const Real max_value = 1.0e100;
+  const Integer nb_segment = segments_position.size();
+  info() << "NB OUTER FACE=" << m_bvh_faces.size() << " NB_SEGMENT=" << nb_segment;
+
+  auto compute_func = [&](Integer begin,Integer size){
+    Real3UniqueArray face_nodes;
+    for( Integer i=begin; i<(begin+size); ++i ){
+      Real3 position = segments_position[i];
+      Real3 direction = segments_direction[i];
+      Int32 orig_face_local_id = segments_orig_face[i];
+      Real3 intersection;
+      Real distance = max_value;
+      Int32 min_index = -1;
+      Int32 user_value = 0;
+      Real max_distance = max_value;
+      m_bvh.visitRay(position,direction,max_distance,[&](Int32 index,Real& current_max_distance){
+        Face face = faces[m_bvh_faces[index]];
+        Integer nb_node = face.nbNode();
+        face_nodes.resize(nb_node);
+        for( Integer z=0; z<nb_node; ++z )
+          face_nodes[z] = nodes_coordinates[face.node(z)];
+        Real d = 0.0;
+        Real3 local_intersection;
+        Int32 uv = 0;
+        bool is_found = m_face_intersector->computeIntersection(position,direction,orig_face_local_id,face.localId(),
+                                                                face_nodes,&uv,&d,&local_intersection);
+        if (is_found && (d<distance || (d==distance && index<min_index))){
+          distance = d;
+          min_index = index;
+          intersection = local_intersection;
+          user_value = uv;
+          current_max_distance = d;
+        }
+      });
+      Int32 min_face_local_id = NULL_ITEM_LOCAL_ID;
+      if (min_index<0)
+        distance = -1.0;
+      else
+        min_face_local_id = m_bvh_faces[min_index];
+      segments_distance[i] = distance;
+      segments_intersection[i] = intersection;
+      faces_local_id[i] = min_face_local_id;
+      user_values[i] = user_value;
+    }
+  };
+  if (m_is_default_face_intersector)
+    arcaneParallelFor(0,nb_segment,compute_func);
+  else
+    compute_func(0,nb_segment);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 struct FoundInfo
 {
   Int32 contrib_owner;
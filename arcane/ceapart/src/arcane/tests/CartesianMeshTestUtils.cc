@@ -14,6 +14,8 @@
 #include "arcane/tests/CartesianMeshTestUtils.h"
 
 #include "arcane/utils/CheckedConvert.h"
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/NumArray.h"
 #include "arcane/utils/PlatformUtils.h"
 #include "arcane/utils/Real2.h"
 #include "arcane/utils/ValueChecker.h"
@@ -33,6 +35,8 @@
 #include "arcane/accelerator/Runner.h"
 #include "arcane/accelerator/RunCommandEnumerate.h"
 #include "arcane/accelerator/VariableViews.h"
+#include "arcane/accelerator/NumArrayViews.h"
+#include "arcane/accelerator/RunCommandLoop.h"
 #endif
 #include "arcane/accelerator/core/IAcceleratorMng.h"
 
@@ -41,6 +45,8 @@
 #include "arcane/cartesianmesh/FaceDirectionMng.h"
 #include "arcane/cartesianmesh/NodeDirectionMng.h"
 #include "arcane/cartesianmesh/CartesianConnectivity.h"
+#include "arcane/cartesianmesh/ICartesianMeshPatch.h"
+#include "arcane/cartesianmesh/v2/CartesianItemBox.h"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -103,6 +109,8 @@ testAll(bool is_amr)
     _saveSVG();
   }
   _testConnectivityByDirection();
+  if (!m_is_amr)
+    _testCartesianItemBox();
 }
 
 /*---------------------------------------------------------------------------*/
@@ -1515,6 +1523,91 @@ _testConnectivityByDirection()
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void CartesianMeshTestUtils::
+_testCartesianItemBox()
+{
+  info() << "TEST_CARTESIAN_ITEM_BOX";
+  using namespace Arcane::CartesianMesh::V2;
+
+  CartesianItemBox box;
+  if (!box.tryInitForCells(m_cartesian_mesh->patch(0))) {
+    // Cela peut arriver si le sous-domaine n'est pas un parallélépipède
+    // (par exemple après un équilibrage de charge).
+    info() << "Cells are not a cartesian box. Skipping test";
+    return;
+  }
+
+  const CartesianStencilView view = box.view();
+  SmallSpan<const Int32> local_ids = box.localIds();
+  const Int32 nb_dir = m_mesh->dimension();
+  info() << "CartesianItemBox nb_item=" << box.nbItem()
+         << " size=" << view.nbItemDir(0) << "x" << view.nbItemDir(1) << "x" << view.nbItemDir(2)
+         << " own_size=" << view.ownNbItemDir(0) << "x" << view.ownNbItemDir(1) << "x" << view.ownNbItemDir(2);
+
+  // Vérifie que les voisins calculés à partir de la vue sont les mêmes
+  // que ceux de CellDirectionMng.
+  for (Integer idir = 0; idir < nb_dir; ++idir) {
+    CellDirectionMng cdm(m_cartesian_mesh->cellDirection(idir));
+    arcaneSequentialFor(view.allLoopRanges(), [&](MDIndex<3> iter) {
+      Int32 id = view.id(iter);
+      auto ijk = view.ijk(id);
+      DirCellLocalId dir_cell(cdm.dirCellId(CellLocalId(local_ids[id])));
+      CellLocalId expected_previous(NULL_ITEM_LOCAL_ID);
+      if (ijk[idir] > 0)
+        expected_previous = CellLocalId(local_ids[view.previousId(id, idir)]);
+      CellLocalId expected_next(NULL_ITEM_LOCAL_ID);
+      if (ijk[idir] + 1 < view.nbItemDir(idir))
+        expected_next = CellLocalId(local_ids[view.nextId(id, idir)]);
+      _checkSameId(dir_cell.previous(), expected_previous);
+      _checkSameId(dir_cell.next(), expected_next);
+    });
+  }
+
+#if defined(ARCANE_HAS_ACCELERATOR_API)
+  // Récupère sur accélérateur via le stencil les numéros locaux des voisins
+  // des mailles internes de la boîte et vérifie qu'ils sont identiques
+  // à ceux de CellDirectionMng.
+  const Int32 nb_box_item = box.nbItem();
+  NumArray<Int32, MDDim1> box_local_ids(nb_box_item);
+  for (Int32 i = 0; i < nb_box_item; ++i)
+    box_local_ids[i] = local_ids[i];
+  // Pour chaque maille et chaque direction, numéro local de la maille
+  // précédente puis de la maille suivante.
+  NumArray<Int32, MDDim2> neighbour_local_ids(nb_box_item, 6);
+  neighbour_local_ids.fill(-2);
+  {
+    auto queue = m_accelerator_mng->defaultQueue();
+    info() << "Test CartesianStencilView on accelerator policy=" << queue->executionPolicy();
+    auto command = makeCommand(*queue);
+    auto in_local_ids = viewIn(command, box_local_ids);
+    auto out_neighbour_local_ids = viewInOut(command, neighbour_local_ids);
+    command << RUNCOMMAND_LOOP(iter, view.innerLoopRanges(1))
+    {
+      CartesianStencil7 s(view.stencil7(view.id(iter)));
+      for (Int32 d = 0; d < nb_dir; ++d) {
+        out_neighbour_local_ids(s.center(), 2 * d) = in_local_ids[s.previous(d)];
+        out_neighbour_local_ids(s.center(), 2 * d + 1) = in_local_ids[s.next(d)];
+      }
+    };
+  }
+  Int32 nb_checked = 0;
+  for (Integer idir = 0; idir < nb_dir; ++idir) {
+    CellDirectionMng cdm(m_cartesian_mesh->cellDirection(idir));
+    arcaneSequentialFor(view.innerLoopRanges(1), [&](MDIndex<3> iter) {
+      Int32 id = view.id(iter);
+      DirCellLocalId dir_cell(cdm.dirCellId(CellLocalId(local_ids[id])));
+      _checkSameId(CellLocalId(neighbour_local_ids(id, 2 * idir)), dir_cell.previous());
+      _checkSameId(CellLocalId(neighbour_local_ids(id, 2 * idir + 1)), dir_cell.next());
+      ++nb_checked;
+    });
+  }
+  info() << "CartesianStencilView nb_checked_cell=" << nb_checked;
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void CartesianMeshTestUtils::
 _sample(ICartesianMesh* cartesian_mesh)
 {
@@ -102,6 +102,7 @@ class CartesianMeshTestUtils
   void _testNodeToCellConnectivity3DAccelerator();
   void _testCellToNodeConnectivity3DAccelerator();
   void _testConnectivityByDirection();
+  void _testCartesianItemBox();
   template<typename ItemType> void
   _testConnectivityByDirectionHelper(const ItemGroup& group);
 };
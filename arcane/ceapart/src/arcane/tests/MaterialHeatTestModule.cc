@@ -171,6 +171,10 @@ class MaterialHeatTestModule
   RunQueue m_queue;
   Runner m_sequential_runner;
   UniqueArray<MeshMaterialVariableRef*> m_additional_variables;
+  //! Période (en itérations) du compactage explicite des valeurs partielles
+  Int32 m_compact_period = 0;
+  //! Nombre total d'octets libérés par le compactage explicite
+  Int64 m_total_compact_reclaimed_bytes = 0;
 
  private:
 
@@ -193,6 +197,8 @@ class MaterialHeatTestModule
 
   void _compute();
   void _printCellsTemperature(Int32ConstArrayView ids);
+  void _compactPartialValues();
+  void _getConstituentValues(Array<Real>& values);
   void _changeVariableAllocator();
 };
 
@@ -210,6 +216,8 @@ MaterialHeatTestModule(const ModuleBuildInfo& mbi)
   if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_PROFILE_HEATTEST", true))
     if (v.value() != 0)
       m_profiling_service = platform::getProfilingService();
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_HEATTEST_COMPACT_PERIOD", true))
+    m_compact_period = v.value();
 }
 
 /*---------------------------------------------------------------------------*/
@@ -395,6 +403,11 @@ compute()
   for (const HeatObject& ho : m_heat_objects) {
     _computeTotalTemperature(ho, do_check);
   }
+
+  // Les suppressions de mailles matériaux laissent des valeurs partielles
+  // inutilisées: le compactage doit donc libérer de la mémoire.
+  if (is_end && m_compact_period > 0 && iteration >= m_compact_period && m_total_compact_reclaimed_bytes == 0)
+    ARCANE_FATAL("Compaction of partial values did not reclaim memory");
 }
 
 /*---------------------------------------------------------------------------*/
@@ -449,6 +462,11 @@ _compute()
     }
   }
 
+  // Compacte éventuellement les valeurs partielles. Les valeurs doivent
+  // être conservées et le résultat numérique identique.
+  if (m_compact_period > 0 && (m_global_iteration() % m_compact_period) == 0)
+    _compactPartialValues();
+
   // Affiche les valeurs pour les mailles modifiées
   if (options()->verbosityLevel() > 0) {
     for (const HeatObject& ho : m_heat_objects) {
@@ -844,6 +862,66 @@ _computeGlobalTemperature()
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void MaterialHeatTestModule::
+_compactPartialValues()
+{
+  UniqueArray<Real> values_before;
+  _getConstituentValues(values_before);
+
+  Int64 reclaimed_bytes = m_material_mng->compactPartialValues();
+  info() << "Compact partial values reclaimed_bytes=" << reclaimed_bytes;
+  if (reclaimed_bytes < 0)
+    ARCANE_FATAL("Bad number of reclaimed bytes '{0}'", reclaimed_bytes);
+  m_total_compact_reclaimed_bytes += reclaimed_bytes;
+
+  // Les valeurs des mailles constituants ne doivent pas être modifiées.
+  UniqueArray<Real> values_after;
+  _getConstituentValues(values_after);
+  if (values_after.size() != values_before.size())
+    ARCANE_FATAL("Bad number of constituent values after compaction n={0} expected={1}",
+                 values_after.size(), values_before.size());
+  Int32 nb_diff = 0;
+  for (Int32 i = 0, n = values_before.size(); i < n; ++i)
+    if (values_after[i] != values_before[i])
+      ++nb_diff;
+  if (nb_diff != 0)
+    ARCANE_FATAL("Values have changed after compaction nb_diff={0}", nb_diff);
+
+  // Les valeurs partielles sont contigües: un second compactage ne doit
+  // rien libérer.
+  Int64 reclaimed_bytes2 = m_material_mng->compactPartialValues();
+  if (reclaimed_bytes2 != 0)
+    ARCANE_FATAL("Second compaction reclaimed memory n={0}", reclaimed_bytes2);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Récupère les valeurs de la température pour chaque maille constituant.
+ *
+ * Les valeurs sont rangées dans l'ordre des mailles puis des milieux et
+ * matériaux de chaque maille, qui ne dépend pas des MatVarIndex.
+ */
+void MaterialHeatTestModule::
+_getConstituentValues(Array<Real>& values)
+{
+  m_queue.barrier();
+  values.clear();
+  CellToAllEnvCellConverter all_env_cell_converter(m_material_mng);
+  ENUMERATE_ (Cell, icell, allCells()) {
+    AllEnvCell all_env_cell = all_env_cell_converter[icell];
+    values.add(m_mat_temperature[icell]);
+    for (EnvCell ec : all_env_cell.subEnvItems()) {
+      values.add(m_mat_temperature[ec]);
+      for (MatCell mc : ec.subMatItems())
+        values.add(m_mat_temperature[mc]);
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void MaterialHeatTestModule::
 _printCellsTemperature(Int32ConstArrayView ids)
 {
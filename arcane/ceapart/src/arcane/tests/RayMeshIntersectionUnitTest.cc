@@ -55,6 +55,11 @@ class RayMeshIntersectionUnitTest
 
   void _testReferences(Integer nb_ref);
   void _testUsed();
+  void _checkWithBruteForce(IRayMeshIntersection* mi,
+                            Real3ConstArrayView segments_position,
+                            Real3ConstArrayView segments_direction,
+                            RealConstArrayView segments_distance,
+                            Int32ConstArrayView faces_lid);
 };
 
 /*---------------------------------------------------------------------------*/
@@ -113,6 +118,7 @@ executeTest()
   // Calcul avec les segments
   mi->compute(segments_position,segments_direction,segments_orig_face,segments_user_value,
               segments_intersection,segments_distance,faces_lid);
+  _checkWithBruteForce(mi.get(),segments_position,segments_direction,segments_distance,faces_lid);
 
   // Calcul avec les rayons sous forme de particule
   IItemFamily* ray_family = mesh()->findItemFamily(IK_Particle,"Rays",true);
@@ -151,9 +157,20 @@ executeTest()
               rays_intersection,rays_distance,rays_face);
   info() << "Print rays infos";
   FaceInfoListView faces_internal(mesh()->faceFamily());
+  Integer nb_error = 0;
   ENUMERATE_PARTICLE(ipart,ray_family->allItems()){
     Particle ray = *ipart;
     Int32 face_lid = rays_face[ipart];
+    // En séquentiel, le résultat doit être le même que celui des segments.
+    if (nb_rank==1){
+      Int32 index = ray.localId();
+      if (face_lid!=faces_lid[index] || !math::isNearlyEqual(rays_distance[ipart],segments_distance[index])){
+        ++nb_error;
+        info() << "Bad ray intersection uid=" << ray.uniqueId()
+               << " face=" << face_lid << " expected=" << faces_lid[index]
+               << " d=" << rays_distance[ipart] << " expected=" << segments_distance[index];
+      }
+    }
     if (face_lid!=NULL_ITEM_ID)
       info() << "Ray uid=" << ray.uniqueId()
              << " pos=" << rays_position[ipart]
@@ -163,6 +180,74 @@ executeTest()
              << " d=" << rays_distance[ipart]
              << " p=" << rays_intersection[ipart];
   }
+  if (nb_error!=0)
+    ARCANE_FATAL("Bad ray intersections nb_error={0}",nb_error);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compare les intersections calculées par \a mi avec celles obtenues
+ * en testant toutes les faces extérieures propres.
+ *
+ * Comme dans BasicRayMeshIntersection, si plusieurs faces sont intersectées
+ * à la même distance, on conserve la première dans l'ordre du groupe.
+ */
+void RayMeshIntersectionUnitTest::
+_checkWithBruteForce(IRayMeshIntersection* mi,
+                     Real3ConstArrayView segments_position,
+                     Real3ConstArrayView segments_direction,
+                     RealConstArrayView segments_distance,
+                     Int32ConstArrayView faces_lid)
+{
+  IRayFaceIntersector* intersector = mi->faceIntersector();
+  if (!intersector)
+    ARCANE_FATAL("Null face intersector");
+  VariableNodeReal3& nodes_coordinates(mesh()->nodesCoordinates());
+  Real3UniqueArray face_nodes;
+  Integer nb_segment = segments_position.size();
+  Integer nb_found = 0;
+  Integer nb_error = 0;
+  for( Integer i=0; i<nb_segment; ++i ){
+    Real distance = 1.0e100;
+    Int32 min_face_local_id = NULL_ITEM_LOCAL_ID;
+    ENUMERATE_FACE(iface,mesh()->outerFaces()){
+      Face face = *iface;
+      if (!face.isOwn())
+        continue;
+      face_nodes.resize(face.nbNode());
+      Integer z = 0;
+      for( Node node : face.nodes() )
+        face_nodes[z++] = nodes_coordinates[node];
+      Real d = 0.0;
+      Real3 local_intersection;
+      Int32 uv = 0;
+      bool is_found = intersector->computeIntersection(segments_position[i],segments_direction[i],NULL_ITEM_LOCAL_ID,
+                                                       face.localId(),face_nodes,&uv,&d,&local_intersection);
+      if (is_found && d<distance){
+        distance = d;
+        min_face_local_id = face.localId();
+      }
+    }
+    if (min_face_local_id==NULL_ITEM_LOCAL_ID)
+      distance = -1.0;
+    else
+      ++nb_found;
+    if (min_face_local_id!=faces_lid[i] || !math::isNearlyEqual(distance,segments_distance[i])){
+      ++nb_error;
+      info() << "Bad segment intersection i=" << i
+             << " face=" << faces_lid[i] << " expected=" << min_face_local_id
+             << " d=" << segments_distance[i] << " expected=" << distance;
+    }
+  }
+  info() << "Check intersections with brute force nb_segment=" << nb_segment
+         << " nb_found=" << nb_found << " nb_error=" << nb_error;
+  if (nb_error!=0)
+    ARCANE_FATAL("Bad segment intersections nb_error={0}",nb_error);
+  // S'assure que le test n'est pas trivial.
+  Integer total_found = mesh()->parallelMng()->reduce(Parallel::ReduceSum,nb_found);
+  if (total_found==0)
+    ARCANE_FATAL("No intersection found");
 }
 
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Fusionne les traces 'timeline.<rang>.json' générées par le service
+# 'TimelineProfiling' (ARCANE_MESSAGE_PASSING_PROFILING=TIMELINE) en un
+# seul fichier au format 'Chrome Trace' lisible par chrome://tracing
+# ou https://ui.perfetto.dev.
+#
+# Chaque fichier contient dans 'otherData' l'instant d'origine (en
+# nanosecondes) de ses évènements. Les évènements sont recalés par
+# rapport à la plus petite origine pour que les rangs partagent le même
+# axe des temps. Ce recalage suppose que les horloges des noeuds de
+# calcul sont synchronisées.
+
+import argparse
+import glob
+import json
+import os
+
+
+def read_trace(filename):
+    with open(filename, "r", encoding="utf-8") as f:
+        return json.load(f)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Fusionne les traces de timeline de chaque rang")
+    parser.add_argument("inputs", nargs="*", help="Fichiers à fusionner (par défaut 'timeline.*.json' du répertoire courant)")
+    parser.add_argument("-o", "--output", default="timeline.json", help="Fichier de sortie")
+    args = parser.parse_args()
+
+    inputs = args.inputs
+    if len(inputs) == 0:
+        inputs = sorted(glob.glob("timeline.*.json"))
+    inputs = [x for x in inputs if os.path.abspath(x) != os.path.abspath(args.output)]
+    if len(inputs) == 0:
+        raise RuntimeError("No input trace file")
+
+    traces = [read_trace(x) for x in inputs]
+    origins = [int(t.get("otherData", {}).get("origin_ns", 0)) for t in traces]
+    min_origin = min(origins)
+
+    all_events = []
+    for trace, origin in zip(traces, origins):
+        # Décalage en microsecondes car c'est l'unité de 'ts'.
+        shift = (origin - min_origin) / 1000.0
+        for ev in trace.get("traceEvents", []):
+            if "ts" in ev:
+                ev["ts"] = ev["ts"] + shift
+            all_events.append(ev)
+
+    result = {
+        "traceEvents": all_events,
+        "displayTimeUnit": "ms",
+        "otherData": {"origin_ns": min_origin, "nb_rank": len(traces)},
+    }
+    with open(args.output, "w", encoding="utf-8") as f:
+        json.dump(result, f)
+    print("Merged {0} trace(s) into '{1}' ({2} events)".format(len(traces), args.output, len(all_events)))
+
+
+if __name__ == "__main__":
+    main()
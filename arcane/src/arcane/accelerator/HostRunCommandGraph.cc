@@ -0,0 +1,153 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* HostRunCommandGraph.cc                                      (C) 2000-2024 */
+/*                                                                           */
+/* Enregistrement et rejeu fusionné de commandes sur l'hôte.                 */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/accelerator/HostRunCommandGraph.h"
+
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/ParallelLoopOptions.h"
+#include "arcane/utils/Profiling.h"
+#include "arcane/utils/ForLoopTraceInfo.h"
+
+#include "arcane/core/Concurrency.h"
+
+#include <algorithm>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Accelerator
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+HostRunCommandGraph::
+HostRunCommandGraph(const RunQueue& queue)
+: m_queue(queue)
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void HostRunCommandGraph::
+_addCommand(std::unique_ptr<ICommand> command, eHostCommandDependency dependency,
+            const TraceInfo& trace_info)
+{
+  CommandInfo info;
+  info.m_command = std::move(command);
+  info.m_dependency = dependency;
+  info.m_trace_info = trace_info;
+  m_commands.push_back(std::move(info));
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void HostRunCommandGraph::
+clear()
+{
+  m_commands.clear();
+  m_nb_phase = 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void HostRunCommandGraph::
+launch()
+{
+  const eExecutionPolicy exec_policy = m_queue.executionPolicy();
+  if (isAcceleratorPolicy(exec_policy))
+    ARCANE_FATAL("HostRunCommandGraph is not available for execution policy '{0}'", exec_policy);
+  const bool is_parallel = (exec_policy == eExecutionPolicy::Thread);
+
+  const Int32 nb_command = nbCommand();
+  m_nb_phase = 0;
+  Int32 phase_begin = 0;
+  Int32 phase_nb_element = 0;
+  for (Int32 i = 0; i < nb_command; ++i) {
+    const CommandInfo& info = m_commands[i];
+    Int32 nb_element = info.m_command->prepare();
+    bool is_new_phase = (i == 0 || info.m_dependency == eHostCommandDependency::All ||
+                         nb_element != phase_nb_element);
+    if (!is_new_phase)
+      continue;
+    if (i != 0)
+      _executePhase(phase_begin, i, phase_nb_element, is_parallel);
+    phase_begin = i;
+    phase_nb_element = nb_element;
+  }
+  if (nb_command != 0)
+    _executePhase(phase_begin, nb_command, phase_nb_element, is_parallel);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Exécute les commandes [first_command,last_command[.
+ *
+ * L'intervalle d'itération est découpé en autant de blocs que de threads
+ * et chaque bloc exécute toutes les commandes de la phase.
+ */
+void HostRunCommandGraph::
+_executePhase(Int32 first_command, Int32 last_command, Int32 nb_element, bool is_parallel)
+{
+  ++m_nb_phase;
+  if (nb_element <= 0)
+    return;
+  Int32 nb_block = (is_parallel) ? TaskFactory::nbAllowedThread() : 1;
+  nb_block = std::clamp(nb_block, 1, nb_element);
+
+  auto func = [&](Integer block_begin, Integer block_size) {
+    for (Integer block = block_begin; block < (block_begin + block_size); ++block) {
+      Int32 begin = static_cast<Int32>((static_cast<Int64>(nb_element) * block) / nb_block);
+      Int32 end = static_cast<Int32>((static_cast<Int64>(nb_element) * (block + 1)) / nb_block);
+      for (Int32 c = first_command; c < last_command; ++c)
+        m_commands[c].m_command->apply(begin, end);
+    }
+  };
+
+  // Les statistiques sont gérées ici pour qu'elles soient aussi
+  // disponibles lorsque la phase est exécutée séquentiellement.
+  ForLoopOneExecStat exec_stat;
+  ForLoopOneExecStat* exec_stat_ptr = (ProfilingRegistry::hasProfiling()) ? &exec_stat : nullptr;
+  {
+    Arcane::impl::ScopedStatLoop scoped_stat(exec_stat_ptr);
+    if (nb_block == 1) {
+      if (exec_stat_ptr)
+        exec_stat_ptr->incrementNbChunk();
+      func(0, 1);
+    }
+    else {
+      ParallelLoopOptions options;
+      options.setPartitioner(ParallelLoopOptions::Partitioner::Static);
+      options.setGrainSize(1);
+      ForLoopRunInfo run_info(options);
+      run_info.setExecStat(exec_stat_ptr);
+      arcaneParallelFor(0, nb_block, run_info, func);
+    }
+  }
+  if (exec_stat_ptr) {
+    ForLoopTraceInfo trace_info(m_commands[first_command].m_trace_info, "HostRunCommandGraph");
+    ProfilingRegistry::_threadLocalForLoopInstance()->merge(exec_stat, trace_info);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
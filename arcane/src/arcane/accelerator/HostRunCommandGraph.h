@@ -0,0 +1,326 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* HostRunCommandGraph.h                                       (C) 2000-2024 */
+/*                                                                           */
+/* Enregistrement et rejeu fusionné de commandes sur l'hôte.                 */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_ACCELERATOR_HOSTRUNCOMMANDGRAPH_H
+#define ARCANE_ACCELERATOR_HOSTRUNCOMMANDGRAPH_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/TraceInfo.h"
+
+#include "arcane/accelerator/AcceleratorGlobal.h"
+#include "arcane/accelerator/core/RunQueue.h"
+#include "arcane/accelerator/RunCommandLoop.h"
+#include "arcane/accelerator/RunCommandEnumerate.h"
+
+#include <memory>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Accelerator
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Dépendance d'une commande d'un HostRunCommandGraph vis à vis
+ * des commandes précédentes.
+ */
+enum class eHostCommandDependency
+{
+  /*!
+   * \brief La commande dépend de toutes les itérations des commandes
+   * précédentes.
+   *
+   * Une synchronisation de tous les threads est nécessaire avant son exécution.
+   */
+  All,
+  /*!
+   * \brief L'itération \a i de la commande ne dépend que des itérations \a i
+   * des commandes précédentes.
+   *
+   * Si le nombre d'itérations est le même que celui de la commande précédente,
+   * aucune synchronisation n'est nécessaire car chaque thread traite le même
+   * intervalle pour les deux commandes.
+   */
+  SameIndex
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Graphe de commandes exécutées sur l'hôte.
+ *
+ * Cette classe permet d'enregistrer une suite de commandes (boucles
+ * RUNCOMMAND_LOOP1 ou RUNCOMMAND_ENUMERATE sans réduction) puis de les
+ * rejouer autant de fois que nécessaire via launch().
+ *
+ * Avec la politique d'exécution eExecutionPolicy::Thread, chaque commande
+ * exécutée directement correspond à une boucle parallèle et donc à une
+ * synchronisation de tous les threads. Lors du rejeu, les commandes sont
+ * regroupées en phases. Une nouvelle phase commence lorsqu'une commande a la
+ * dépendance eHostCommandDependency::All ou un nombre d'itérations différent
+ * de la commande précédente. Chaque phase est exécutée par une seule boucle
+ * parallèle avec un partitionnement statique où chaque thread exécute
+ * successivement le même intervalle de chaque commande de la phase. Cela
+ * supprime les synchronisations inutiles et améliore la réutilisation des
+ * caches entre les commandes.
+ *
+ * Les synchronisations entre phases sont réalisées par la fin de la boucle
+ * parallèle et non par une barrière entre threads, car l'ordonnanceur de
+ * tâches ne garantit pas que tous les threads s'exécutent simultanément.
+ *
+ * Les commandes conservent une copie des lambdas. Les vues capturées doivent
+ * donc rester valides tant que le graphe est utilisé. Pour les commandes sur
+ * un groupe d'entités, la liste des entités est relue depuis le groupe à
+ * chaque rejeu et les modifications du groupe sont donc prises en compte.
+ * Pour les commandes sur une vue (ItemVectorView), la vue est celle de
+ * l'enregistrement et doit donc rester valide.
+ *
+ * Si le profilage est actif (ProfilingRegistry::hasProfiling()), les
+ * statistiques de chaque phase sont ajoutées à celles des boucles en
+ * utilisant les informations de trace de la première commande de la phase.
+ *
+ * Ce mécanisme n'est disponible que pour les politiques d'exécution sur l'hôte.
+ *
+ * \code
+ * HostRunCommandGraph graph(queue);
+ * graph.command() << RUNCOMMAND_ENUMERATE(Cell, cid, allCells()) { ... };
+ * graph.command(eHostCommandDependency::SameIndex) << RUNCOMMAND_ENUMERATE(Cell, cid, allCells()) { ... };
+ * for (int i = 0; i < nb_iteration; ++i)
+ *   graph.launch();
+ * \endcode
+ */
+class ARCANE_ACCELERATOR_EXPORT HostRunCommandGraph
+{
+ public:
+
+  //! Commande enregistrée
+  class ICommand
+  {
+   public:
+
+    virtual ~ICommand() = default;
+
+   public:
+
+    //! Prépare le rejeu et retourne le nombre d'itérations
+    virtual Int32 prepare() = 0;
+    //! Exécute les itérations [begin,end[
+    virtual void apply(Int32 begin, Int32 end) const = 0;
+  };
+
+ private:
+
+  struct CommandInfo
+  {
+    std::unique_ptr<ICommand> m_command;
+    eHostCommandDependency m_dependency = eHostCommandDependency::All;
+    TraceInfo m_trace_info;
+  };
+
+  template <typename Lambda>
+  class LoopCommand
+  : public ICommand
+  {
+   public:
+
+    LoopCommand(Int32 nb_element, const Lambda& func)
+    : m_nb_element(nb_element)
+    , m_func(func)
+    {}
+    Int32 prepare() override { return m_nb_element; }
+    void apply(Int32 begin, Int32 end) const override
+    {
+      for (Int32 i = begin; i < end; ++i)
+        m_func(MDIndex<1>(i));
+    }
+
+   private:
+
+    Int32 m_nb_element;
+    Lambda m_func;
+  };
+
+  template <typename TraitsType, typename Lambda>
+  class ItemCommand
+  : public ICommand
+  {
+    using BuilderType = typename TraitsType::BuilderType;
+    using ValueType = typename BuilderType::ValueType;
+
+   public:
+
+    ItemCommand(const typename TraitsType::ContainerType& items, const Lambda& func)
+    : m_items(items)
+    , m_func(func)
+    {}
+    Int32 prepare() override
+    {
+      m_local_ids = m_items.currentLocalIds();
+      return m_local_ids.size();
+    }
+    void apply(Int32 begin, Int32 end) const override
+    {
+      for (Int32 i = begin; i < end; ++i)
+        m_func(BuilderType::create(i, ValueType(m_local_ids[i])));
+    }
+
+   private:
+
+    typename TraitsType::ContainerType m_items;
+    SmallSpan<const Int32> m_local_ids;
+    Lambda m_func;
+  };
+
+ public:
+
+  //! Commande en cours d'enregistrement sur une boucle 1D
+  class LoopRecorder
+  {
+   public:
+
+    LoopRecorder(HostRunCommandGraph* graph, eHostCommandDependency dependency,
+                 const TraceInfo& trace_info, Int32 nb_element)
+    : m_graph(graph)
+    , m_dependency(dependency)
+    , m_trace_info(trace_info)
+    , m_nb_element(nb_element)
+    {}
+    template <typename Lambda> void operator<<(const Lambda& func)
+    {
+      auto command = std::make_unique<LoopCommand<Lambda>>(m_nb_element, func);
+      m_graph->_addCommand(std::move(command), m_dependency, m_trace_info);
+    }
+
+   private:
+
+    HostRunCommandGraph* m_graph;
+    eHostCommandDependency m_dependency;
+    TraceInfo m_trace_info;
+    Int32 m_nb_element;
+  };
+
+  //! Commande en cours d'enregistrement sur une liste d'entités
+  template <typename TraitsType>
+  class ItemRecorder
+  {
+   public:
+
+    ItemRecorder(HostRunCommandGraph* graph, eHostCommandDependency dependency,
+                 const TraceInfo& trace_info, const TraitsType& traits)
+    : m_graph(graph)
+    , m_dependency(dependency)
+    , m_trace_info(trace_info)
+    , m_traits(traits)
+    {}
+    template <typename Lambda> void operator<<(const Lambda& func)
+    {
+      auto command = std::make_unique<ItemCommand<TraitsType, Lambda>>(m_traits.m_item_container, func);
+      m_graph->_addCommand(std::move(command), m_dependency, m_trace_info);
+    }
+
+   private:
+
+    HostRunCommandGraph* m_graph;
+    eHostCommandDependency m_dependency;
+    TraceInfo m_trace_info;
+    TraitsType m_traits;
+  };
+
+  //! Commande à enregistrer
+  class Recorder
+  {
+   public:
+
+    Recorder(HostRunCommandGraph* graph, eHostCommandDependency dependency)
+    : m_graph(graph)
+    , m_dependency(dependency)
+    {}
+
+   public:
+
+    Recorder& operator<<(const TraceInfo& trace_info)
+    {
+      m_trace_info = trace_info;
+      return *this;
+    }
+    LoopRecorder operator<<(const ArrayBounds<MDDim1>& bounds)
+    {
+      return { m_graph, m_dependency, m_trace_info, static_cast<Int32>(bounds.nbElement()) };
+    }
+    LoopRecorder operator<<(const impl::ExtendedArrayBoundLoop<ArrayBounds<MDDim1>>& ex_loop)
+    {
+      return { m_graph, m_dependency, m_trace_info, static_cast<Int32>(ex_loop.m_bounds.nbElement()) };
+    }
+    template <typename TraitsType> ItemRecorder<TraitsType>
+    operator<<(const impl::ItemRunCommandArgs<TraitsType>& args)
+    {
+      return { m_graph, m_dependency, m_trace_info, args.m_traits };
+    }
+
+   private:
+
+    HostRunCommandGraph* m_graph;
+    eHostCommandDependency m_dependency;
+    TraceInfo m_trace_info;
+  };
+
+ public:
+
+  explicit HostRunCommandGraph(const RunQueue& queue);
+  HostRunCommandGraph(const HostRunCommandGraph&) = delete;
+  HostRunCommandGraph& operator=(const HostRunCommandGraph&) = delete;
+
+ public:
+
+  //! Enregistre une nouvelle commande ayant la dépendance \a dependency.
+  Recorder command(eHostCommandDependency dependency = eHostCommandDependency::All)
+  {
+    return { this, dependency };
+  }
+
+  //! Exécute les commandes enregistrées.
+  void launch();
+
+  //! Supprime les commandes enregistrées
+  void clear();
+
+  //! Nombre de commandes enregistrées
+  Int32 nbCommand() const { return static_cast<Int32>(m_commands.size()); }
+
+  //! Nombre de phases lors du dernier appel à launch()
+  Int32 nbPhase() const { return m_nb_phase; }
+
+ private:
+
+  RunQueue m_queue;
+  std::vector<CommandInfo> m_commands;
+  Int32 m_nb_phase = 0;
+
+ private:
+
+  void _addCommand(std::unique_ptr<ICommand> command, eHostCommandDependency dependency,
+                   const TraceInfo& trace_info);
+  void _executePhase(Int32 first_command, Int32 last_command, Int32 nb_element, bool is_parallel);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
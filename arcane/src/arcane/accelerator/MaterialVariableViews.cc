@@ -0,0 +1,44 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MaterialVariableViews.cc                                    (C) 2000-2024 */
+/*                                                                           */
+/* Gestion des vues sur les variables matériaux pour les accélérateurs.      */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/accelerator/MaterialVariableViews.h"
+
+#include "arcane/core/materials/internal/IMeshMaterialVariableInternal.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Accelerator
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MatVariableViewBase::
+MatVariableViewBase(RunCommand&, IMeshMaterialVariable* var, AccessMode access_mode,
+                    IMeshComponent* component)
+{
+  IMeshMaterialVariableInternal* var_api = var->_internalApi();
+  if (access_mode != AccessMode::Out)
+    var_api->notifyBeginRead(component);
+  if (access_mode != AccessMode::In)
+    var_api->notifyValuesModified(component);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Accelerator
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
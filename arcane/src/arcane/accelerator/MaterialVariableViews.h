@@ -21,6 +21,9 @@
 #include "arcane/core/materials/MeshEnvironmentVariableRef.h"
 #include "arcane/core/materials/MatItem.h"
 
+#include "arcane/accelerator/AcceleratorGlobal.h"
+#include "arcane/accelerator/ViewsCommon.h"
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -37,15 +40,33 @@ namespace Arcane::Accelerator
 /*---------------------------------------------------------------------------*/
 /*!
  * \brief Classe de base des vues sur les variables matériaux.
+ *
+ * La création d'une vue en lecture recalcule si besoin les valeurs
+ * des matériaux qui ne sont plus à jour si la variable possède une fonction
+ * de calcul (voir IMeshMaterialVariable::setComputeFunction()). La création
+ * d'une vue en écriture indique que les variables qui dépendent de celle-ci
+ * devront être recalculées.
+ *
+ * Si la vue est créée pour un constituant (matériau ou milieu), seuls les
+ * matériaux de ce constituant sont recalculés ou considérés comme modifiés.
+ * Sinon, tous les matériaux le sont.
  */
-class MatVariableViewBase
+class ARCANE_ACCELERATOR_EXPORT MatVariableViewBase
 {
  public:
-  // Pour l'instant n'utilise pas encore les paramètres
-  MatVariableViewBase(RunCommand&, IMeshMaterialVariable*)
+
+  //! Mode d'accès de la vue
+  enum class AccessMode
   {
-  }
- private:
+    In,
+    Out,
+    InOut
+  };
+
+ public:
+
+  MatVariableViewBase(RunCommand&, IMeshMaterialVariable* var, AccessMode access_mode,
+                      IMeshComponent* component);
 };
 
 /*---------------------------------------------------------------------------*/
@@ -64,8 +85,9 @@ class MatItemVariableScalarInViewT
 
  public:
 
-  MatItemVariableScalarInViewT(RunCommand& cmd, IMeshMaterialVariable* var, ArrayView<DataType>* v)
-  : MatVariableViewBase(cmd, var), m_value(v){}
+  MatItemVariableScalarInViewT(RunCommand& cmd, IMeshMaterialVariable* var, ArrayView<DataType>* v,
+                               IMeshComponent* component = nullptr)
+  : MatVariableViewBase(cmd, var, AccessMode::In, component), m_value(v){}
 
   //! Opérateur d'accès pour l'entité \a item
   ARCCORE_HOST_DEVICE const DataType& operator[](ComponentItemLocalId lid) const
@@ -134,8 +156,9 @@ class MatItemVariableScalarOutViewT
 
  public:
 
-  MatItemVariableScalarOutViewT(RunCommand& cmd,IMeshMaterialVariable* var,ArrayView<DataType>* v)
-  : MatVariableViewBase(cmd, var), m_value(v){}
+  MatItemVariableScalarOutViewT(RunCommand& cmd,IMeshMaterialVariable* var,ArrayView<DataType>* v,
+                                IMeshComponent* component = nullptr)
+  : MatVariableViewBase(cmd, var, _accessMode(), component), m_value(v){}
 
   //! Opérateur d'accès pour l'entité \a item
   ARCCORE_HOST_DEVICE Accessor operator[](ComponentItemLocalId lid) const
@@ -175,6 +198,16 @@ class MatItemVariableScalarOutViewT
  private:
 
   ArrayView<DataType>* m_value;
+
+ private:
+
+  static constexpr AccessMode _accessMode()
+  {
+    if constexpr (std::is_same_v<Accessor, DataViewGetterSetter<DataType>>)
+      return AccessMode::InOut;
+    else
+      return AccessMode::Out;
+  }
 };
 
 /*---------------------------------------------------------------------------*/
@@ -183,10 +216,10 @@ class MatItemVariableScalarOutViewT
  * \brief Vue en écriture pour les variables materiaux scalaire
  */
 template<typename DataType> auto
-viewOut(RunCommand& cmd, CellMaterialVariableScalarRef<DataType>& var)
+viewOut(RunCommand& cmd, CellMaterialVariableScalarRef<DataType>& var, IMeshComponent* component = nullptr)
 {
   using Accessor = DataViewSetter<DataType>;
-  return MatItemVariableScalarOutViewT<Cell,Accessor>(cmd, var.materialVariable(),var._internalValue());
+  return MatItemVariableScalarOutViewT<Cell,Accessor>(cmd, var.materialVariable(),var._internalValue(),component);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -195,10 +228,10 @@ viewOut(RunCommand& cmd, CellMaterialVariableScalarRef<DataType>& var)
  * \brief Vue en écriture pour les variables materiaux scalaire
  */
 template<typename DataType> auto
-viewOut(RunCommand& cmd, CellEnvironmentVariableScalarRef<DataType>& var)
+viewOut(RunCommand& cmd, CellEnvironmentVariableScalarRef<DataType>& var, IMeshComponent* component = nullptr)
 {
   using Accessor = DataViewSetter<DataType>;
-  return MatItemVariableScalarOutViewT<Cell,Accessor>(cmd, var.materialVariable(),var._internalValue());
+  return MatItemVariableScalarOutViewT<Cell,Accessor>(cmd, var.materialVariable(),var._internalValue(),component);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -207,10 +240,10 @@ viewOut(RunCommand& cmd, CellEnvironmentVariableScalarRef<DataType>& var)
  * \brief Vue en lecture/écriture pour les variables materiaux scalaire
  */
 template<typename DataType> auto
-viewInOut(RunCommand& cmd, CellMaterialVariableScalarRef<DataType>& var)
+viewInOut(RunCommand& cmd, CellMaterialVariableScalarRef<DataType>& var, IMeshComponent* component = nullptr)
 {
   using Accessor = DataViewGetterSetter<DataType>;
-  return MatItemVariableScalarOutViewT<Cell,Accessor>(cmd, var.materialVariable(),var._internalValue());
+  return MatItemVariableScalarOutViewT<Cell,Accessor>(cmd, var.materialVariable(),var._internalValue(),component);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -219,10 +252,10 @@ viewInOut(RunCommand& cmd, CellMaterialVariableScalarRef<DataType>& var)
  * \brief Vue en lecture/écriture pour les variables materiaux scalaire
  */
 template<typename DataType> auto
-viewInOut(RunCommand& cmd, CellEnvironmentVariableScalarRef<DataType>& var)
+viewInOut(RunCommand& cmd, CellEnvironmentVariableScalarRef<DataType>& var, IMeshComponent* component = nullptr)
 {
   using Accessor = DataViewGetterSetter<DataType>;
-  return MatItemVariableScalarOutViewT<Cell,Accessor>(cmd, var.materialVariable(),var._internalValue());
+  return MatItemVariableScalarOutViewT<Cell,Accessor>(cmd, var.materialVariable(),var._internalValue(),component);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -232,9 +265,9 @@ viewInOut(RunCommand& cmd, CellEnvironmentVariableScalarRef<DataType>& var)
  * \brief Vue en lecture pour les variables materiaux scalaire
  */
 template<typename DataType> auto
-viewIn(RunCommand& cmd,const CellMaterialVariableScalarRef<DataType>& var)
+viewIn(RunCommand& cmd,const CellMaterialVariableScalarRef<DataType>& var, IMeshComponent* component = nullptr)
 {
-  return MatItemVariableScalarInViewT<Cell,DataType>(cmd, var.materialVariable(),var._internalValue());
+  return MatItemVariableScalarInViewT<Cell,DataType>(cmd, var.materialVariable(),var._internalValue(),component);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -244,9 +277,9 @@ viewIn(RunCommand& cmd,const CellMaterialVariableScalarRef<DataType>& var)
  * \brief Vue en lecture pour les variables materiaux scalaire
  */
 template<typename DataType> auto
-viewIn(RunCommand& cmd,const CellEnvironmentVariableScalarRef<DataType>& var)
+viewIn(RunCommand& cmd,const CellEnvironmentVariableScalarRef<DataType>& var, IMeshComponent* component = nullptr)
 {
-  return MatItemVariableScalarInViewT<Cell,DataType>(cmd, var.materialVariable(),var._internalValue());
+  return MatItemVariableScalarInViewT<Cell,DataType>(cmd, var.materialVariable(),var._internalValue(),component);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -18,10 +18,12 @@
 #include "arcane/accelerator/RunQueueInternal.h"
 
 #include "arcane/utils/ArcaneCxx20.h"
+#include "arcane/utils/SimdOperation.h"
 
 #include "arcane/core/ItemTypes.h"
 #include "arcane/core/ItemGroup.h"
 #include "arcane/core/Concurrency.h"
+#include "arcane/core/SimdItem.h"
 
 #include <concepts>
 
@@ -183,6 +185,19 @@ class RunCommandItemContainer
 
   Int32 size() const { return m_unpadded_vector_view.size(); }
   SmallSpan<const Int32> localIds() const { return m_unpadded_vector_view.localIds(); }
+  /*!
+   * \brief Liste courante des entités.
+   *
+   * Si le conteneur a été construit à partir d'un groupe, la liste est relue
+   * depuis ce groupe et tient donc compte de ses éventuelles modifications
+   * depuis la construction du conteneur. Sinon, retourne localIds().
+   */
+  SmallSpan<const Int32> currentLocalIds() const
+  {
+    if (!m_item_group.null())
+      return m_item_group._unpaddedView().localIds();
+    return localIds();
+  }
   ItemVectorView paddedView() const
   {
     if (!m_item_group.null())
@@ -297,6 +312,92 @@ _applyItems(RunCommand& command, typename TraitsType::ContainerType items,
   launch_info.endExecute();
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Applique \a func sur les paquets SIMD [pack_begin,pack_begin+nb_pack[.
+ *
+ * Les paquets complets sont passés sous forme de SimdItemIndexT et les
+ * entités du dernier paquet incomplet sont passées une par une sous
+ * forme de numéro local. Si les numéros locaux ne sont pas alignés, toutes
+ * les entités sont passées une par une.
+ */
+template <typename TraitsType, typename Lambda>
+void _doSimdItemsLambda(ItemVectorView items, Int32 pack_begin, Int32 nb_pack, const Lambda& func)
+{
+  using ItemType = TraitsType::ItemType;
+  using LocalIdType = TraitsType::LocalIdType;
+  using SimdIndexType = SimdInfo::SimdInt32IndexType;
+  auto privatizer = privatize(func);
+  auto& body = privatizer.privateCopy();
+
+  const Int32* local_ids = items.localIds().data();
+  const Int32 nb_item = items.size();
+  const bool is_aligned = (reinterpret_cast<std::uintptr_t>(local_ids) % alignof(SimdIndexType)) == 0;
+  const Int32 nb_full_pack = (is_aligned) ? (nb_item / SimdSize) : 0;
+  for (Int32 pack = pack_begin; pack < (pack_begin + nb_pack); ++pack) {
+    const Int32 index = pack * SimdSize;
+    if (pack < nb_full_pack) {
+      body(SimdItemIndexT<ItemType>(reinterpret_cast<const SimdIndexType*>(local_ids + index)));
+      continue;
+    }
+    const Int32 end = math::min(index + SimdSize, nb_item);
+    for (Int32 i = index; i < end; ++i)
+      body(LocalIdType(local_ids[i]));
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Applique l'enumération vectorielle \a func sur la liste d'entité \a items.
+ *
+ * Sur accélérateur, cette méthode est équivalente à _applyItems(). Sur l'hôte,
+ * \a func est appelée avec des paquets de SimdSize entités (SimdItemIndexT)
+ * et les entités restantes sont traitées une par une. En multi-thread, chaque
+ * thread traite un ensemble de paquets complets.
+ */
+template <typename TraitsType, typename Lambda> void
+_applySimdItems(RunCommand& command, typename TraitsType::ContainerType items, const Lambda& func)
+{
+  using ValueType = TraitsType::ValueType;
+  using LocalIdType = TraitsType::LocalIdType;
+  static_assert(std::is_same_v<ValueType, LocalIdType>, "RUNCOMMAND_ENUMERATE_SIMD only supports local id types");
+  Integer vsize = items.size();
+  if (vsize == 0)
+    return;
+  impl::RunCommandLaunchInfo launch_info(command, vsize);
+  const eExecutionPolicy exec_policy = launch_info.executionPolicy();
+  launch_info.computeLoopRunInfo();
+  launch_info.beginExecute();
+  SmallSpan<const Int32> ids = items.localIds();
+  const Int32 nb_pack = (vsize + SimdSize - 1) / SimdSize;
+  switch (exec_policy) {
+  case eExecutionPolicy::CUDA:
+    _applyKernelCUDA(launch_info, ARCANE_KERNEL_CUDA_FUNC(doIndirectGPULambda2) < TraitsType, Lambda >, func, ids);
+    break;
+  case eExecutionPolicy::HIP:
+    _applyKernelHIP(launch_info, ARCANE_KERNEL_HIP_FUNC(doIndirectGPULambda2) < TraitsType, Lambda >, func, ids);
+    break;
+  case eExecutionPolicy::SYCL:
+    _applyKernelSYCL(launch_info, ARCANE_KERNEL_SYCL_FUNC(impl::DoIndirectSYCLLambda) < TraitsType, Lambda > {}, func, ids);
+    break;
+  case eExecutionPolicy::Sequential:
+    impl::_doSimdItemsLambda<TraitsType>(items.paddedView(), 0, nb_pack, func);
+    break;
+  case eExecutionPolicy::Thread: {
+    ItemVectorView padded_items = items.paddedView();
+    arcaneParallelFor(0, nb_pack, launch_info.loopRunInfo(),
+                      [&](Int32 begin, Int32 size) {
+                        impl::_doSimdItemsLambda<TraitsType>(padded_items, begin, size, func);
+                      });
+  } break;
+  default:
+    ARCANE_FATAL("Invalid execution policy '{0}'", exec_policy);
+  }
+  launch_info.endExecute();
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -320,6 +421,25 @@ class ItemRunCommandArgs
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+//! Arguments pour RUNCOMMAND_ENUMERATE_SIMD
+template <typename TraitsType>
+class SimdItemRunCommandArgs
+{
+ public:
+
+  explicit SimdItemRunCommandArgs(const TraitsType& traits)
+  : m_traits(traits)
+  {
+  }
+
+ public:
+
+  TraitsType m_traits;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 } // namespace Arcane::Accelerator::impl
 
 namespace Arcane::Accelerator
@@ -417,6 +537,38 @@ void operator<<(ItemRunCommand<TraitsType, ReducerArgs...>&& nr, const Lambda& f
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+template <typename TraitsType>
+class SimdItemRunCommand
+{
+ public:
+
+  SimdItemRunCommand(RunCommand& command, const TraitsType& traits)
+  : m_command(command)
+  , m_traits(traits)
+  {
+  }
+
+ public:
+
+  RunCommand& m_command;
+  TraitsType m_traits;
+};
+
+template <typename TraitsType> auto
+operator<<(RunCommand& command, const impl::SimdItemRunCommandArgs<TraitsType>& args)
+{
+  return SimdItemRunCommand<TraitsType>(command, args.m_traits);
+}
+
+template <typename TraitsType, typename Lambda>
+void operator<<(SimdItemRunCommand<TraitsType>&& nr, const Lambda& f)
+{
+  impl::_applySimdItems<TraitsType>(nr.m_command, nr.m_traits.m_item_container, f);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 } // namespace Arcane::Accelerator
 
 namespace Arcane::Accelerator::impl
@@ -433,6 +585,13 @@ makeExtendedItemEnumeratorLoop(const ItemContainerType& container_type,
   return ItemRunCommandArgs<TraitsType, ReducerArgs...>(TraitsType(container_type), reducer_args...);
 }
 
+template <typename ItemTypeName, typename ItemContainerType> auto
+makeSimdItemEnumeratorLoop(const ItemContainerType& container_type)
+{
+  using TraitsType = RunCommandItemEnumeratorTraitsT<ItemTypeName>;
+  return SimdItemRunCommandArgs<TraitsType>(TraitsType(container_type));
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -470,6 +629,31 @@ makeExtendedItemEnumeratorLoop(const ItemContainerType& container_type,
 #define RUNCOMMAND_ENUMERATE_EX(ItemTypeName, iter_name, item_group, ...) \
   RUNCOMMAND_ENUMERATE (ItemTypeName, iter_name, item_group, __VA_ARGS__)
 
+/*!
+ * \brief Macro pour itérer sur un groupe d'entités avec vectorisation sur l'hôte.
+ *
+ * Cette macro s'utilise comme RUNCOMMAND_ENUMERATE() mais le type de
+ * \a iter_name n'est pas fixé. Sur accélérateur, il s'agit du numéro
+ * local de l'entité (par exemple CellLocalId). Sur l'hôte (politiques
+ * eExecutionPolicy::Sequential et eExecutionPolicy::Thread), il s'agit d'un
+ * SimdItemIndexT contenant SimdSize entités, sauf pour les dernières entités
+ * qui sont traitées une par une. Le corps de la boucle doit donc pouvoir être
+ * instancié avec ces deux types, ce qui est le cas si on n'utilise que les
+ * vues sur les variables et les opérations arithmétiques.
+ *
+ * \code
+ * command << RUNCOMMAND_ENUMERATE_SIMD(Cell, vi, allCells())
+ * {
+ *   out_a[vi] = in_b[vi] * in_c[vi] + 2.0;
+ * };
+ * \endcode
+ *
+ * Les réductions ne sont pas supportées.
+ */
+#define RUNCOMMAND_ENUMERATE_SIMD(ItemTypeName, iter_name, item_group) \
+  A_FUNCINFO << ::Arcane::Accelerator::impl::makeSimdItemEnumeratorLoop<ItemTypeName>(item_group) \
+             << [=] ARCCORE_HOST_DEVICE(auto iter_name)
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
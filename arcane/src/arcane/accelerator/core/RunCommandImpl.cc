@@ -17,6 +17,7 @@
 #include "arcane/utils/ForLoopTraceInfo.h"
 #include "arcane/utils/ConcurrencyUtils.h"
 #include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/internal/ProfilingInternal.h"
 
 #include "arcane/accelerator/core/Runner.h"
 #include "arcane/accelerator/core/internal/IRunQueueEventImpl.h"
@@ -124,6 +125,11 @@ notifyBeginLaunchKernel()
   m_start_event->recordQueue(stream);
   m_has_been_launched = true;
   if (ProfilingRegistry::hasProfiling()) {
+    // Les compteurs matériels n'ont de sens que si le noyau s'exécute
+    // sur l'hôte. Dans ce cas l'exécution est terminée lors de l'appel
+    // à notifyEndLaunchKernel().
+    if (!m_use_accelerator && Arcane::impl::HardwareCounterStat::isEnabled())
+      m_has_hardware_counters = Arcane::impl::HardwareCounterStat::readCounters(m_begin_hardware_counters);
     m_begin_time = platform::getRealTimeNS();
     m_loop_one_exec_stat_ptr = &m_loop_one_exec_stat;
     m_loop_one_exec_stat.setBeginTime(m_begin_time);
@@ -144,6 +150,13 @@ notifyEndLaunchKernel()
   // TODO: utiliser la bonne stream en séquentiel
   m_stop_event->recordQueue(stream);
   stream->notifyEndLaunchKernel(*this);
+  if (m_has_hardware_counters && m_loop_one_exec_stat_ptr) {
+    Arcane::impl::HardwareCounterStat::CounterValues end_counters;
+    if (Arcane::impl::HardwareCounterStat::readCounters(end_counters)) {
+      Arcane::impl::HardwareCounterStat::substract(m_begin_hardware_counters, end_counters);
+      m_loop_one_exec_stat_ptr->setHardwareCounters(end_counters);
+    }
+  }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -208,6 +221,7 @@ _reset()
   m_nb_thread_per_block = 0;
   m_parallel_loop_options = TaskFactory::defaultParallelLoopOptions();
   m_begin_time = 0;
+  m_has_hardware_counters = false;
   m_loop_one_exec_stat.reset();
   m_loop_one_exec_stat_ptr = nullptr;
   m_has_been_launched = false;
@@ -107,6 +107,10 @@ class RunCommandImpl
   ForLoopOneExecStat m_loop_one_exec_stat;
   ForLoopOneExecStat* m_loop_one_exec_stat_ptr = nullptr;
 
+  //! Compteurs matériels au lancement de la commande (uniquement sur l'hôte)
+  FixedArray<Int64, ForLoopOneExecStat::NB_HARDWARE_COUNTER> m_begin_hardware_counters;
+  bool m_has_hardware_counters = false;
+
   //! Indique si la commande s'exécute sur accélérateur
   const bool m_use_accelerator = false;
 
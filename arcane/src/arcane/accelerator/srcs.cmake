@@ -8,8 +8,11 @@ set( ARCANE_SOURCES
   CommonCudaHipAtomicImpl.h
   CommonUtils.h
   CommonUtils.cc
+  HostRunCommandGraph.h
+  HostRunCommandGraph.cc
   IReduceMemoryImpl.h
   MaterialVariableViews.h
+  MaterialVariableViews.cc
   MemoryCopier.cc
   NumArray.h
   NumArrayViews.h
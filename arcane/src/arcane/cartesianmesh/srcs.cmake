@@ -37,6 +37,10 @@ set(ARCANE_SOURCES
   v2/CartesianTypes.h
   v2/CartesianMeshUniqueIdRenumberingV2.h
   v2/CartesianMeshUniqueIdRenumberingV2.cc
+  v2/CartesianStencilView.h
+  v2/CartesianTiling.h
+  v2/CartesianItemBox.h
+  v2/CartesianItemBox.cc
 
   ICartesianMeshAMRPatchMng.h
   CartesianMeshAMRPatchMng.cc
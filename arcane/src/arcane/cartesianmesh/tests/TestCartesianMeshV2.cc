@@ -10,6 +10,7 @@
 #include "arcane/cartesianmesh/v2/CartesianTypes.h"
 #include "arcane/cartesianmesh/v2/CartesianGrid.h"
 #include "arcane/cartesianmesh/v2/CartesianNumbering.h"
+#include "arcane/cartesianmesh/v2/CartesianStencilView.h"
 
 #include <iostream>
 
@@ -288,6 +289,90 @@ TEST(CartesianMeshV2, TestCartesianGrid)
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void test_CartesianStencilView(const LocalIdType (&nitem)[3], Integer dimension)
+{
+  CartesianNumbering<LocalIdType> cart_numb;
+  cart_numb.initNumbering(nitem, dimension);
+
+  // La partie propre est la boîte sans une couche d'items sur chaque bord.
+  LocalIdType own_lower[3] = { 0, 0, 0 };
+  LocalIdType own_nb[3] = { 1, 1, 1 };
+  for (Integer d = 0; d < dimension; ++d) {
+    own_lower[d] = 1;
+    own_nb[d] = cart_numb.nbItemDir(d) - 2;
+  }
+  CartesianStencilView view(cart_numb, own_lower, own_nb);
+
+  ASSERT_EQ(view.dimension(), dimension) << "Bad dimension";
+  ASSERT_EQ(view.nbItem(), cart_numb.nbItem()) << "Bad nb item";
+  for (Integer d = 0; d < 3; ++d) {
+    ASSERT_EQ(view.nbItemDir(d), cart_numb.nbItemDir(d)) << "Bad nb item for direction";
+    if (d < dimension)
+      ASSERT_EQ(view.deltaDir(d), cart_numb.deltaDir(d)) << "Bad delta for direction";
+    else
+      ASSERT_EQ(view.deltaDir(d), 0) << "Bad delta for direction";
+  }
+
+  // Vérifie que le parcours de allLoopRanges() est dans l'ordre de la numérotation
+  // et que les voisins sont corrects.
+  LocalIdType cur_id = 0;
+  arcaneSequentialFor(view.allLoopRanges(), [&](MDIndex<3> iter) {
+    LocalIdType id = view.id(iter);
+    ASSERT_EQ(id, cur_id) << "Bad loop order";
+    auto ijk = view.ijk(id);
+    ASSERT_EQ(cart_numb.id(ijk[0], ijk[1], ijk[2]), id) << "Bad ijk";
+    ++cur_id;
+  });
+  ASSERT_EQ(cur_id, cart_numb.nbItem()) << "Bad number of iterations";
+
+  Int32 nb_inner = 0;
+  arcaneSequentialFor(view.innerLoopRanges(1), [&](MDIndex<3> iter) {
+    LocalIdType id = view.id(iter);
+    auto ijk = view.ijk(id);
+    CartesianStencil7 s(view.stencil7(id));
+    ASSERT_EQ(s.center(), id);
+    for (Integer d = 0; d < dimension; ++d) {
+      IdxType prev{ ijk[0], ijk[1], ijk[2] };
+      IdxType next{ ijk[0], ijk[1], ijk[2] };
+      prev[d] -= 1;
+      next[d] += 1;
+      ASSERT_EQ(s.previous(d), cart_numb.id(prev)) << "Bad previous";
+      ASSERT_EQ(s.next(d), cart_numb.id(next)) << "Bad next";
+      ASSERT_EQ(view.previousId(id, d), s.previous(d));
+      ASSERT_EQ(view.nextId(id, d), s.next(d));
+    }
+    ASSERT_TRUE(view.isOwn(ijk[0], ijk[1], ijk[2])) << "Inner item should be own";
+    LocalIdType dk = (dimension == 3) ? 1 : 0;
+    IdxType corner{ ijk[0] + 1, ijk[1] - 1, ijk[2] + dk };
+    ASSERT_EQ(view.neighbourId(id, 1, -1, dk), cart_numb.id(corner)) << "Bad corner neighbour";
+    ++nb_inner;
+  });
+  Int32 expected_nb_own = own_nb[0] * own_nb[1] * own_nb[2];
+  ASSERT_EQ(nb_inner, expected_nb_own) << "Bad number of inner items";
+
+  Int32 nb_own = 0;
+  arcaneSequentialFor(view.ownLoopRanges(), [&](MDIndex<3>) { ++nb_own; });
+  ASSERT_EQ(nb_own, expected_nb_own) << "Bad number of own items";
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(CartesianMeshV2, TestCartesianStencilView)
+{
+  {
+    LocalIdType3 nitem = { 6, 5, 0 };
+    test_CartesianStencilView(nitem, /*dim=*/2);
+  }
+  {
+    LocalIdType3 nitem = { 6, 5, 4 };
+    test_CartesianStencilView(nitem, /*dim=*/3);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 // Effecttue des instantiations explicites pour tester la compilation.
 template class Arcane::CartesianMesh::V2::CartesianGrid<Arcane::Int32>;
 template class Arcane::CartesianMesh::V2::CartesianGrid<Arcane::Int64>;
@@ -0,0 +1,157 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/ValueConvert.h"
+#include "arcane/utils/UniqueArray.h"
+
+#include "arcane/cartesianmesh/v2/CartesianNumbering.h"
+#include "arcane/cartesianmesh/v2/CartesianStencilView.h"
+#include "arcane/cartesianmesh/v2/CartesianTiling.h"
+
+#include <iostream>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+using namespace Arcane;
+using namespace Arcane::CartesianMesh::V2;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace
+{
+CartesianStencilView
+_createView(Int32 ni, Int32 nj, Int32 nk, Int32 dimension)
+{
+  CartesianNumbering<Int32> numbering;
+  Int32 nitem[3] = { ni, nj, nk };
+  numbering.initNumbering(nitem, dimension);
+  Int32 own_lower[3] = { 0, 0, 0 };
+  Int32 own_nb[3] = { ni, nj, (dimension == 3) ? nk : 1 };
+  return CartesianStencilView(numbering, own_lower, own_nb);
+}
+
+void _checkCoverage(const CartesianStencilView& view, Int32 width, Int32 ti, Int32 tj, Int32 tk)
+{
+  CartesianTiling tiling(view.innerLoopRanges(width), ti, tj, tk);
+
+  // Nombre de fois où chaque élément est visité.
+  UniqueArray<Int32> nb_visit_ref(view.nbItem(), 0);
+  arcaneSequentialFor(view.innerLoopRanges(width), [&](MDIndex<3> iter) {
+    ++nb_visit_ref[view.id(iter)];
+  });
+
+  UniqueArray<Int32> nb_visit_tile(view.nbItem(), 0);
+  arcaneSequentialFor(tiling, [&](MDIndex<3> iter) {
+    ++nb_visit_tile[view.id(iter)];
+  });
+  ASSERT_EQ(nb_visit_ref, nb_visit_tile) << "Bad visit for tile iteration";
+
+  UniqueArray<Int32> nb_visit_item(view.nbItem(), 0);
+  Int32 nb_iteration = tiling.nbTile() * tiling.tileVolume();
+  for (Int32 i = 0; i < nb_iteration; ++i) {
+    MDIndex<3> idx;
+    if (tiling.itemIndex(i, idx))
+      ++nb_visit_item[view.id(idx)];
+  }
+  ASSERT_EQ(nb_visit_ref, nb_visit_item) << "Bad visit for item iteration";
+
+  UniqueArray<Int32> nb_visit_parallel(view.nbItem(), 0);
+  arcaneParallelFor(tiling, ParallelLoopOptions(), [&](MDIndex<3> iter) {
+    ++nb_visit_parallel[view.id(iter)];
+  });
+  ASSERT_EQ(nb_visit_ref, nb_visit_parallel) << "Bad visit for parallel iteration";
+}
+
+/*!
+ * \brief Stencil à 7 points appliqué sur les éléments de \a iterable.
+ */
+template <typename IterableType> void
+_applyStencil(const IterableType& iterable, const CartesianStencilView& view,
+              ConstArrayView<Real> in_values, ArrayView<Real> out_values)
+{
+  const Int32 dimension = view.dimension();
+  arcaneSequentialFor(iterable, [&](MDIndex<3> iter) {
+    CartesianStencil7 s(view.stencil7(view.id(iter)));
+    Real v = -2.0 * dimension * in_values[s.center()];
+    for (Int32 d = 0; d < dimension; ++d)
+      v += in_values[s.previous(d)] + in_values[s.next(d)];
+    out_values[s.center()] = v;
+  });
+}
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(CartesianMeshV2, TestCartesianTiling)
+{
+  {
+    CartesianStencilView view(_createView(17, 13, 11, 3));
+    _checkCoverage(view, 0, 4, 4, 4);
+    _checkCoverage(view, 1, 8, 3, 5);
+    _checkCoverage(view, 1, 64, 64, 64);
+    _checkCoverage(view, 2, 1, 1, 1);
+  }
+  {
+    CartesianStencilView view(_createView(23, 19, 1, 2));
+    _checkCoverage(view, 0, 8, 8, 1);
+    _checkCoverage(view, 1, 5, 7, 4);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compare le temps d'un stencil à 7 points en parcours linéaire et par tuiles.
+ *
+ * La taille du domaine peut être changée via la variable d'environnement
+ * ARCANE_TEST_TILING_SIZE.
+ */
+TEST(CartesianMeshV2, BenchCartesianTiling)
+{
+  Int32 n = 96;
+  Int32 nb_loop = 5;
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_TEST_TILING_SIZE", true))
+    n = v.value();
+
+  CartesianStencilView view(_createView(n, n, n, 3));
+  const Int32 nb_item = view.nbItem();
+  UniqueArray<Real> in_values(nb_item);
+  for (Int32 i = 0; i < nb_item; ++i)
+    in_values[i] = static_cast<Real>((i * 7) % 31);
+
+  UniqueArray<Real> ref_values(nb_item, 0.0);
+  Real ref_time = 0.0;
+  {
+    Real t0 = platform::getRealTime();
+    for (Int32 i = 0; i < nb_loop; ++i)
+      _applyStencil(view.innerLoopRanges(1), view, in_values, ref_values);
+    ref_time = platform::getRealTime() - t0;
+  }
+  std::cout << "BENCH_TILING n=" << n << " linear time=" << ref_time << "\n";
+
+  const Int32 tile_sizes[][3] = { { 32, 8, 8 }, { 64, 4, 4 }, { 1024, 16, 16 }, { 16, 16, 16 } };
+  for (const auto& ts : tile_sizes) {
+    CartesianTiling tiling(view.innerLoopRanges(1), ts[0], ts[1], ts[2]);
+    UniqueArray<Real> out_values(nb_item, 0.0);
+    Real t0 = platform::getRealTime();
+    for (Int32 i = 0; i < nb_loop; ++i)
+      _applyStencil(tiling, view, in_values, out_values);
+    Real tiled_time = platform::getRealTime() - t0;
+    std::cout << "BENCH_TILING n=" << n << " tile=" << ts[0] << "x" << ts[1] << "x" << ts[2]
+              << " time=" << tiled_time << " ratio=" << ((tiled_time > 0.0) ? (ref_time / tiled_time) : 0.0) << "\n";
+    ASSERT_EQ(ref_values, out_values) << "Bad values for tiled stencil";
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,232 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CartesianItemBox.cc                                         (C) 2000-2024 */
+/*                                                                           */
+/* Boîte cartésienne des entités (propres et fantômes) d'un patch.           */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/cartesianmesh/v2/CartesianItemBox.h"
+
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/Math.h"
+
+#include "arcane/core/IMesh.h"
+#include "arcane/core/IItemFamily.h"
+#include "arcane/core/ItemGroup.h"
+#include "arcane/core/ItemEnumerator.h"
+
+#include "arcane/cartesianmesh/ICartesianMeshPatch.h"
+#include "arcane/cartesianmesh/CellDirectionMng.h"
+#include "arcane/cartesianmesh/NodeDirectionMng.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::CartesianMesh::V2
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void CartesianItemBox::
+initForCells(ICartesianMeshPatch* patch)
+{
+  if (!tryInitForCells(patch))
+    ARCANE_FATAL("Cells of patch do not form a cartesian box");
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void CartesianItemBox::
+initForNodes(ICartesianMeshPatch* patch)
+{
+  if (!tryInitForNodes(patch))
+    ARCANE_FATAL("Nodes of patch do not form a cartesian box");
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+bool CartesianItemBox::
+tryInitForCells(ICartesianMeshPatch* patch)
+{
+  CellDirectionMng& cdm0 = patch->cellDirection(0);
+  CellGroup cells = cdm0.allCells();
+  Int32 dimension = cells.mesh()->dimension();
+  CellDirectionMng* dir_mngs[3] = { nullptr, nullptr, nullptr };
+  for (Int32 d = 0; d < dimension; ++d)
+    dir_mngs[d] = &patch->cellDirection(d);
+  return _init(cells, dimension, ConstArrayView<CellDirectionMng*>(dimension, dir_mngs));
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+bool CartesianItemBox::
+tryInitForNodes(ICartesianMeshPatch* patch)
+{
+  NodeDirectionMng& ndm0 = patch->nodeDirection(0);
+  NodeGroup nodes = ndm0.allNodes();
+  Int32 dimension = nodes.mesh()->dimension();
+  NodeDirectionMng* dir_mngs[3] = { nullptr, nullptr, nullptr };
+  for (Int32 d = 0; d < dimension; ++d)
+    dir_mngs[d] = &patch->nodeDirection(d);
+  return _init(nodes, dimension, ConstArrayView<NodeDirectionMng*>(dimension, dir_mngs));
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void CartesianItemBox::
+_clear()
+{
+  m_view = CartesianStencilView();
+  m_local_ids.clear();
+  m_cartesian_ids.clear();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void CartesianItemBox::
+fillTiledLocalIds(const CartesianTiling& tiling, Array<Int32>& local_ids) const
+{
+  local_ids.clear();
+  local_ids.reserve(tiling.nbTile() * tiling.tileVolume());
+  arcaneSequentialFor(tiling, [&](MDIndex<3> idx) {
+    local_ids.add(m_local_ids[m_view.id(idx)]);
+  });
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule la position (i,j,k) de chaque entité de \a items.
+ *
+ * Pour chaque direction, on part des entités qui n'ont pas d'entité
+ * précédente et on suit la chaîne des entités suivantes en incrémentant
+ * l'indice. Pour que le résultat soit cohérent, il faut que toutes les
+ * chaînes d'une direction commencent à la même position, ce qui est le cas
+ * si les entités forment un parallélépipède. On vérifie ensuite que
+ * chaque position de la boîte est occupée par une et une seule entité.
+ *
+ * Retourne \a false si les entités ou les entités propres ne forment pas
+ * un parallélépipède.
+ */
+template <typename ItemType, typename DirectionMngType> bool CartesianItemBox::
+_init(const ItemGroupT<ItemType>& items, Int32 dimension,
+      ConstArrayView<DirectionMngType*> dir_mngs)
+{
+  IItemFamily* family = items.itemFamily();
+  const Int32 max_local_id = family->maxLocalId();
+  const Int32 nb_item = items.size();
+
+  UniqueArray<Int32> indexes[3];
+  Int32 nb_item_dir[3] = { 1, 1, 1 };
+  for (Int32 d = 0; d < dimension; ++d) {
+    DirectionMngType& dm = *dir_mngs[d];
+    Array<Int32>& dir_indexes = indexes[d];
+    dir_indexes.resize(max_local_id);
+    dir_indexes.fill(-1);
+    Int32 max_n = 0;
+    ENUMERATE_ (ItemType, iitem, items) {
+      ItemType item = *iitem;
+      if (!dm[item].previous().null())
+        continue;
+      Int32 n = 0;
+      for (ItemType current = item; !current.null(); current = dm[current].next()) {
+        if (n >= nb_item)
+          ARCANE_FATAL("Invalid cycle in direction '{0}' for item '{1}'", d, item.uniqueId());
+        dir_indexes[current.localId()] = n;
+        ++n;
+      }
+      max_n = math::max(max_n, n);
+    }
+    nb_item_dir[d] = max_n;
+  }
+
+  Int64 box_nb_item = Int64(nb_item_dir[0]) * Int64(nb_item_dir[1]) * Int64(nb_item_dir[2]);
+  if (box_nb_item != nb_item) {
+    _clear();
+    return false;
+  }
+
+  CartesianNumbering<Int32> numbering;
+  numbering.initNumbering(nb_item_dir, dimension);
+
+  m_local_ids.resize(nb_item);
+  m_local_ids.fill(NULL_ITEM_LOCAL_ID);
+  m_cartesian_ids.resize(max_local_id);
+  m_cartesian_ids.fill(-1);
+
+  Int32 own_min[3] = { 0, 0, 0 };
+  Int32 own_max[3] = { 0, 0, 0 };
+  for (Int32 d = 0; d < dimension; ++d) {
+    own_min[d] = nb_item_dir[d];
+    own_max[d] = -1;
+  }
+  Int32 nb_own = 0;
+
+  ENUMERATE_ (ItemType, iitem, items) {
+    ItemType item = *iitem;
+    Int32 lid = item.localId();
+    Int32 ijk[3] = { 0, 0, 0 };
+    for (Int32 d = 0; d < dimension; ++d) {
+      ijk[d] = indexes[d][lid];
+      if (ijk[d] < 0)
+        ARCANE_FATAL("Item '{0}' is not connected in direction '{1}'", item.uniqueId(), d);
+    }
+    Int32 cartesian_id = numbering.id(ijk[0], ijk[1], ijk[2]);
+    // Deux entités à la même position: les chaînes ne commencent pas
+    // toutes à la même position.
+    if (m_local_ids[cartesian_id] != NULL_ITEM_LOCAL_ID) {
+      _clear();
+      return false;
+    }
+    m_local_ids[cartesian_id] = lid;
+    m_cartesian_ids[lid] = cartesian_id;
+    if (item.isOwn()) {
+      ++nb_own;
+      for (Int32 d = 0; d < dimension; ++d) {
+        own_min[d] = math::min(own_min[d], ijk[d]);
+        own_max[d] = math::max(own_max[d], ijk[d]);
+      }
+    }
+  }
+
+  Int32 own_lower[3] = { 0, 0, 0 };
+  Int32 own_nb_item_dir[3] = { 1, 1, 1 };
+  if (nb_own == 0) {
+    for (Int32 d = 0; d < dimension; ++d)
+      own_nb_item_dir[d] = 0;
+  }
+  else {
+    for (Int32 d = 0; d < dimension; ++d) {
+      own_lower[d] = own_min[d];
+      own_nb_item_dir[d] = own_max[d] - own_min[d] + 1;
+    }
+  }
+  Int64 own_box_nb_item = Int64(own_nb_item_dir[0]) * Int64(own_nb_item_dir[1]) * Int64(own_nb_item_dir[2]);
+  if (nb_own != 0 && own_box_nb_item != nb_own) {
+    _clear();
+    return false;
+  }
+
+  m_view = CartesianStencilView(numbering, own_lower, own_nb_item_dir);
+  return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::CartesianMesh::V2
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,165 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CartesianItemBox.h                                          (C) 2000-2024 */
+/*                                                                           */
+/* Boîte cartésienne des entités (propres et fantômes) d'un patch.           */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_CARTESIANMESH_CARTESIANITEMBOX_H
+#define ARCANE_CARTESIANMESH_CARTESIANITEMBOX_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/UniqueArray.h"
+
+#include "arcane/core/ItemTypes.h"
+
+#include "arcane/cartesianmesh/CartesianMeshGlobal.h"
+#include "arcane/cartesianmesh/v2/CartesianStencilView.h"
+#include "arcane/cartesianmesh/v2/CartesianTiling.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::CartesianMesh::V2
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \ingroup ArcaneCartesianMesh
+ * \brief Boîte cartésienne des entités (propres et fantômes) d'un patch.
+ *
+ * Cette classe calcule, à partir des informations de direction d'un patch,
+ * la position (i,j,k) de chaque maille (ou noeud) du patch dans la boîte
+ * englobante des entités propres et fantômes. Elle fournit une
+ * CartesianStencilView sur cette boîte ainsi que la correspondance entre
+ * l'indice cartésien et le numéro local de l'entité.
+ *
+ * Cette correspondance n'est utilisée que pour recopier les valeurs des
+ * variables vers un tableau indexé par l'indice cartésien (gather())
+ * et inversement (scatter()). Les calculs de stencils se font ensuite
+ * uniquement avec la vue, sans accès à la connectivité.
+ *
+ * Le patch doit être un parallélépipède (un rectangle en 2D) y compris
+ * les entités fantômes. Si ce n'est pas le cas, initForCells() et
+ * initForNodes() lèvent une exception alors que tryInitForCells()
+ * et tryInitForNodes() retournent \a false.
+ *
+ * L'instance doit être reconstruite si le maillage change.
+ */
+class ARCANE_CARTESIANMESH_EXPORT CartesianItemBox
+{
+ public:
+
+  CartesianItemBox() = default;
+
+ public:
+
+  //! Initialise l'instance pour les mailles du patch \a patch
+  void initForCells(ICartesianMeshPatch* patch);
+
+  //! Initialise l'instance pour les noeuds du patch \a patch
+  void initForNodes(ICartesianMeshPatch* patch);
+
+  /*!
+   * \brief Initialise l'instance pour les mailles du patch \a patch si elles
+   * forment une boîte cartésienne.
+   *
+   * Retourne \a false si ce n'est pas le cas (par exemple si le
+   * sous-domaine a été équilibré). Dans ce cas l'instance est vide.
+   * Une exception est levée si la connectivité par direction est invalide.
+   */
+  bool tryInitForCells(ICartesianMeshPatch* patch);
+
+  /*!
+   * \brief Initialise l'instance pour les noeuds du patch \a patch s'ils
+   * forment une boîte cartésienne.
+   *
+   * \sa tryInitForCells()
+   */
+  bool tryInitForNodes(ICartesianMeshPatch* patch);
+
+ public:
+
+  //! Vue avec connectivité implicite sur la boîte
+  const CartesianStencilView& view() const { return m_view; }
+
+  //! Nombre d'entités de la boîte
+  Int32 nbItem() const { return m_local_ids.size(); }
+
+  //! Numéro local de l'entité pour chaque indice cartésien de la boîte
+  SmallSpan<const Int32> localIds() const { return m_local_ids; }
+
+  /*!
+   * \brief Indice cartésien pour chaque numéro local d'entité.
+   *
+   * Vaut (-1) si l'entité n'est pas dans la boîte.
+   */
+  SmallSpan<const Int32> cartesianIds() const { return m_cartesian_ids; }
+
+  /*!
+   * \brief Remplit \a local_ids avec les numéros locaux des entités
+   * de \a tiling dans l'ordre des tuiles.
+   *
+   * \a tiling doit avoir été construit à partir d'un intervalle d'itération
+   * de view(). Le tableau retourné peut servir à créer une vue
+   * via IItemFamily::view() pour itérer avec ENUMERATE_CELL() ou
+   * RUNCOMMAND_ENUMERATE() dans l'ordre des tuiles, par exemple
+   * pour utiliser les méthodes de CellDirectionMng.
+   */
+  void fillTiledLocalIds(const CartesianTiling& tiling, Array<Int32>& local_ids) const;
+
+  /*!
+   * \brief Recopie les valeurs \a item_values indexées par numéro local
+   * dans \a box_values indexées par l'indice cartésien.
+   *
+   * \a box_values doit avoir au moins nbItem() éléments.
+   */
+  template <typename DataType> void
+  gather(SmallSpan<const DataType> item_values, SmallSpan<DataType> box_values) const
+  {
+    const Int32 n = nbItem();
+    for (Int32 i = 0; i < n; ++i)
+      box_values[i] = item_values[m_local_ids[i]];
+  }
+
+  /*!
+   * \brief Recopie les valeurs \a box_values indexées par l'indice cartésien
+   * dans \a item_values indexées par numéro local.
+   */
+  template <typename DataType> void
+  scatter(SmallSpan<const DataType> box_values, SmallSpan<DataType> item_values) const
+  {
+    const Int32 n = nbItem();
+    for (Int32 i = 0; i < n; ++i)
+      item_values[m_local_ids[i]] = box_values[i];
+  }
+
+ private:
+
+  CartesianStencilView m_view;
+  UniqueArray<Int32> m_local_ids;
+  UniqueArray<Int32> m_cartesian_ids;
+
+ private:
+
+  template <typename ItemType, typename DirectionMngType> bool
+  _init(const ItemGroupT<ItemType>& items, Int32 dimension,
+        ConstArrayView<DirectionMngType*> dir_mngs);
+  void _clear();
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::CartesianMesh::V2
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
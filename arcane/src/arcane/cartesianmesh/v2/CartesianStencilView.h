@@ -0,0 +1,264 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CartesianStencilView.h                                      (C) 2000-2024 */
+/*                                                                           */
+/* Vue sur une boîte cartésienne avec connectivité implicite.                */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_CARTESIANMESH_CARTESIANSTENCILVIEW_H
+#define ARCANE_CARTESIANMESH_CARTESIANSTENCILVIEW_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/ForLoopRanges.h"
+
+#include "arcane/cartesianmesh/CartesianMeshGlobal.h"
+#include "arcane/cartesianmesh/v2/CartesianNumbering.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::CartesianMesh::V2
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Stencil à 7 points (5 points en 2D) autour d'un item.
+ *
+ * Les indices sont des indices cartésiens dans la boîte de la
+ * CartesianStencilView qui a créé l'instance. Pour les directions
+ * au delà de la dimension, les voisins valent center().
+ */
+class CartesianStencil7
+{
+ public:
+
+  ARCCORE_HOST_DEVICE CartesianStencil7(Int32 center, Int32 dx, Int32 dy, Int32 dz)
+  : m_center(center)
+  , m_delta{ dx, dy, dz }
+  {}
+
+ public:
+
+  //! Indice de l'item central
+  ARCCORE_HOST_DEVICE Int32 center() const { return m_center; }
+  //! Indice de l'item précédent dans la direction \a dir
+  ARCCORE_HOST_DEVICE Int32 previous(Int32 dir) const { return m_center - m_delta[dir]; }
+  //! Indice de l'item suivant dans la direction \a dir
+  ARCCORE_HOST_DEVICE Int32 next(Int32 dir) const { return m_center + m_delta[dir]; }
+
+ private:
+
+  Int32 m_center;
+  Int32 m_delta[3];
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vue sur une boîte cartésienne d'items avec une connectivité implicite.
+ *
+ * Cette vue associe à chaque triplet (i,j,k) de la boîte un indice cartésien
+ * `i + j*nx + k*nx*ny` et calcule les voisins arithmétiquement à partir
+ * de cet indice. Aucun tableau de connectivité n'est nécessaire et la vue
+ * peut être copiée sur accélérateur.
+ *
+ * La boîte contient les items propres et les items fantômes. La partie
+ * propre est la sous-boîte définie par ownLowerBound() et ownNbItemDir().
+ *
+ * Les intervalles d'itération retournés par allLoopRanges(), ownLoopRanges()
+ * et innerLoopRanges() sont exprimés dans l'ordre (k,j,i) pour que la
+ * dimension la plus interne d'une boucle RUNCOMMAND_LOOP() ou arcaneParallelFor()
+ * soit la direction X et donc que les accès soient contigus. La
+ * méthode id(MDIndex<3>) fait la conversion inverse:
+ *
+ * \code
+ * CartesianStencilView v = ...;
+ * command << RUNCOMMAND_LOOP(iter, v.innerLoopRanges(1))
+ * {
+ *   CartesianStencil7 s(v.stencil7(v.id(iter)));
+ *   out[s.center()] = in[s.previous(0)] + in[s.next(0)] + in[s.previous(1)] + in[s.next(1)];
+ * };
+ * \endcode
+ *
+ * Les valeurs doivent être stockées dans des tableaux indexés par l'indice
+ * cartésien (par exemple une NumArray de taille nbItem()). La classe
+ * CartesianItemBox permet de construire une instance à partir d'un patch
+ * et de faire la correspondance avec les numéros locaux des entités.
+ */
+class CartesianStencilView
+{
+ public:
+
+  CartesianStencilView() = default;
+
+  /*!
+   * \brief Créé une vue sur la boîte \a numbering dont la partie propre
+   * commence à \a own_lower et contient \a own_nb_item_dir items par direction.
+   */
+  CartesianStencilView(const CartesianNumbering<Int32>& numbering,
+                       const Int32 (&own_lower)[3], const Int32 (&own_nb_item_dir)[3])
+  : m_dimension(numbering.dimension())
+  {
+    for (Int32 d = 0; d < 3; ++d) {
+      m_nb_item_dir[d] = numbering.nbItemDir(d);
+      m_own_lower[d] = own_lower[d];
+      m_own_nb_item_dir[d] = own_nb_item_dir[d];
+    }
+    m_delta[0] = 1;
+    m_delta[1] = m_nb_item_dir[0];
+    m_delta[2] = m_nb_item_dir[0] * m_nb_item_dir[1];
+    // Pour les directions au delà de la dimension, il n'y a pas de voisin.
+    for (Int32 d = m_dimension; d < 3; ++d)
+      m_delta[d] = 0;
+  }
+
+ public:
+
+  //! Dimension de la boîte
+  ARCCORE_HOST_DEVICE Int32 dimension() const { return m_dimension; }
+
+  //! Nombre total d'items dans la boîte (propres et fantômes)
+  ARCCORE_HOST_DEVICE Int32 nbItem() const { return m_nb_item_dir[0] * m_nb_item_dir[1] * m_nb_item_dir[2]; }
+
+  //! Nombre d'items de la boîte dans la direction \a dir
+  ARCCORE_HOST_DEVICE Int32 nbItemDir(Int32 dir) const { return m_nb_item_dir[dir]; }
+
+  //! Indice (dans la boîte) du premier item propre dans la direction \a dir
+  ARCCORE_HOST_DEVICE Int32 ownLowerBound(Int32 dir) const { return m_own_lower[dir]; }
+
+  //! Nombre d'items propres dans la direction \a dir
+  ARCCORE_HOST_DEVICE Int32 ownNbItemDir(Int32 dir) const { return m_own_nb_item_dir[dir]; }
+
+  //! Décalage de l'indice cartésien pour passer à l'item suivant dans la direction \a dir
+  ARCCORE_HOST_DEVICE Int32 deltaDir(Int32 dir) const { return m_delta[dir]; }
+
+  //! Passage (i,j,k) => indice cartésien
+  ARCCORE_HOST_DEVICE Int32 id(Int32 i, Int32 j, Int32 k) const
+  {
+    return i + j * m_delta[1] + k * m_nb_item_dir[0] * m_nb_item_dir[1];
+  }
+
+  //! Passage d'un indice de boucle (k,j,i) => indice cartésien
+  ARCCORE_HOST_DEVICE Int32 id(MDIndex<3> iter) const
+  {
+    return id(iter[2], iter[1], iter[0]);
+  }
+
+  //! Passage indice cartésien => (i,j,k)
+  ARCCORE_HOST_DEVICE std::array<Int32, 3> ijk(Int32 item_id) const
+  {
+    Int32 nxy = m_nb_item_dir[0] * m_nb_item_dir[1];
+    Int32 k = item_id / nxy;
+    Int32 r = item_id - k * nxy;
+    Int32 j = r / m_nb_item_dir[0];
+    Int32 i = r - j * m_nb_item_dir[0];
+    return { i, j, k };
+  }
+
+  //! Vrai si (i,j,k) est dans la boîte
+  ARCCORE_HOST_DEVICE bool isInside(Int32 i, Int32 j, Int32 k) const
+  {
+    return (i >= 0 && i < m_nb_item_dir[0] && j >= 0 && j < m_nb_item_dir[1] && k >= 0 && k < m_nb_item_dir[2]);
+  }
+
+  //! Vrai si (i,j,k) est dans la partie propre de la boîte
+  ARCCORE_HOST_DEVICE bool isOwn(Int32 i, Int32 j, Int32 k) const
+  {
+    return (i >= m_own_lower[0] && i < (m_own_lower[0] + m_own_nb_item_dir[0]) &&
+            j >= m_own_lower[1] && j < (m_own_lower[1] + m_own_nb_item_dir[1]) &&
+            k >= m_own_lower[2] && k < (m_own_lower[2] + m_own_nb_item_dir[2]));
+  }
+
+  /*!
+   * \brief Indice de l'item suivant \a item_id dans la direction \a dir.
+   *
+   * Il n'y a pas de vérification que le voisin est dans la boîte.
+   */
+  ARCCORE_HOST_DEVICE Int32 nextId(Int32 item_id, Int32 dir) const { return item_id + m_delta[dir]; }
+
+  /*!
+   * \brief Indice de l'item précédent \a item_id dans la direction \a dir.
+   *
+   * Il n'y a pas de vérification que le voisin est dans la boîte.
+   */
+  ARCCORE_HOST_DEVICE Int32 previousId(Int32 item_id, Int32 dir) const { return item_id - m_delta[dir]; }
+
+  /*!
+   * \brief Indice de l'item décalé de (\a di,\a dj,\a dk) par rapport à \a item_id.
+   *
+   * Permet de construire des stencils quelconques (par exemple 27 points).
+   * Il n'y a pas de vérification que le voisin est dans la boîte.
+   */
+  ARCCORE_HOST_DEVICE Int32 neighbourId(Int32 item_id, Int32 di, Int32 dj, Int32 dk) const
+  {
+    return item_id + di * m_delta[0] + dj * m_delta[1] + dk * m_delta[2];
+  }
+
+  //! Stencil à 7 points (5 en 2D) centré sur \a item_id
+  ARCCORE_HOST_DEVICE CartesianStencil7 stencil7(Int32 item_id) const
+  {
+    return CartesianStencil7(item_id, m_delta[0], m_delta[1], m_delta[2]);
+  }
+
+  //! Intervalle d'itération (k,j,i) sur tous les items de la boîte
+  ComplexForLoopRanges<3> allLoopRanges() const
+  {
+    return _loopRanges(0, 0, 0, m_nb_item_dir[0], m_nb_item_dir[1], m_nb_item_dir[2]);
+  }
+
+  //! Intervalle d'itération (k,j,i) sur les items propres
+  ComplexForLoopRanges<3> ownLoopRanges() const
+  {
+    return _loopRanges(m_own_lower[0], m_own_lower[1], m_own_lower[2],
+                       m_own_nb_item_dir[0], m_own_nb_item_dir[1], m_own_nb_item_dir[2]);
+  }
+
+  /*!
+   * \brief Intervalle d'itération (k,j,i) sur les items dont tous les voisins
+   * à une distance inférieure ou égale à \a width sont dans la boîte.
+   *
+   * Cela permet d'appliquer un stencil de demi-largeur \a width sans test.
+   */
+  ComplexForLoopRanges<3> innerLoopRanges(Int32 width) const
+  {
+    Int32 lower[3] = { 0, 0, 0 };
+    Int32 n[3] = { m_nb_item_dir[0], m_nb_item_dir[1], m_nb_item_dir[2] };
+    for (Int32 d = 0; d < m_dimension; ++d) {
+      lower[d] = width;
+      n[d] = (n[d] > 2 * width) ? (n[d] - 2 * width) : 0;
+    }
+    return _loopRanges(lower[0], lower[1], lower[2], n[0], n[1], n[2]);
+  }
+
+ private:
+
+  Int32 m_dimension = 0;
+  Int32 m_nb_item_dir[3] = { 1, 1, 1 };
+  Int32 m_delta[3] = { 0, 0, 0 };
+  Int32 m_own_lower[3] = { 0, 0, 0 };
+  Int32 m_own_nb_item_dir[3] = { 1, 1, 1 };
+
+ private:
+
+  static ComplexForLoopRanges<3>
+  _loopRanges(Int32 i0, Int32 j0, Int32 k0, Int32 ni, Int32 nj, Int32 nk)
+  {
+    return makeLoopRanges(ForLoopRange(k0, nk), ForLoopRange(j0, nj), ForLoopRange(i0, ni));
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::CartesianMesh::V2
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -0,0 +1,223 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CartesianTiling.h                                           (C) 2000-2024 */
+/*                                                                           */
+/* Découpage en tuiles d'un intervalle d'itération cartésien.                */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_CARTESIANMESH_CARTESIANTILING_H
+#define ARCANE_CARTESIANMESH_CARTESIANTILING_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/ForLoopRanges.h"
+#include "arcane/utils/ConcurrencyUtils.h"
+
+#include "arcane/cartesianmesh/CartesianMeshGlobal.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::CartesianMesh::V2
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Découpage en tuiles d'un intervalle d'itération cartésien 3D.
+ *
+ * L'intervalle est exprimé dans l'ordre (k,j,i) comme ceux retournés
+ * par CartesianStencilView. Il est découpé en tuiles de taille
+ * (tile_i,tile_j,tile_k). Les tuiles sur les bords peuvent être plus petites.
+ *
+ * Parcourir un domaine tuile par tuile permet de garder dans le cache les
+ * voisins dans les directions Y et Z qui sont éloignés en mémoire
+ * lors d'un parcours linéaire.
+ *
+ * Il y a deux manières d'itérer:
+ * - sur l'hôte, en itérant sur les tuiles via tileLoopRanges() et en
+ *   appelant applyInTile() pour chaque tuile. La boucle interne est
+ *   séquentielle dans la direction X. La fonction arcaneParallelFor()
+ *   associée à cette classe permet de le faire en multi-thread.
+ * - sur accélérateur, en itérant via itemLoopRanges() et en utilisant
+ *   itemIndex() pour convertir l'indice linéaire en indice (k,j,i). Les
+ *   indices consécutifs sont dans la même tuile. Comme les tuiles du bord
+ *   peuvent être incomplètes, itemIndex() retourne \a false si l'indice
+ *   n'est pas valide.
+ *
+ * \code
+ * CartesianStencilView v = ...;
+ * CartesianTiling tiling(v.innerLoopRanges(1), 64, 8, 8);
+ * // Sur accélérateur
+ * command << RUNCOMMAND_LOOP(iter, tiling.itemLoopRanges())
+ * {
+ *   MDIndex<3> idx;
+ *   if (!tiling.itemIndex(iter[0], idx))
+ *     return;
+ *   Int32 id = v.id(idx);
+ *   ...
+ * };
+ * // Sur l'hôte en multi-thread
+ * arcaneParallelFor(tiling, ParallelLoopOptions(), [&](MDIndex<3> idx) {
+ *   Int32 id = v.id(idx);
+ *   ...
+ * });
+ * \endcode
+ */
+class CartesianTiling
+{
+ public:
+
+  CartesianTiling() = default;
+
+  //! Découpe \a loop_ranges (dans l'ordre (k,j,i)) en tuiles de taille (tile_i,tile_j,tile_k).
+  CartesianTiling(const ComplexForLoopRanges<3>& loop_ranges, Int32 tile_i, Int32 tile_j, Int32 tile_k)
+  {
+    m_lower[0] = loop_ranges.lowerBound<2>();
+    m_lower[1] = loop_ranges.lowerBound<1>();
+    m_lower[2] = loop_ranges.lowerBound<0>();
+    m_upper[0] = loop_ranges.upperBound<2>();
+    m_upper[1] = loop_ranges.upperBound<1>();
+    m_upper[2] = loop_ranges.upperBound<0>();
+    const Int32 tile_size[3] = { tile_i, tile_j, tile_k };
+    for (Int32 d = 0; d < 3; ++d) {
+      Int32 n = m_upper[d] - m_lower[d];
+      if (n < 0)
+        n = 0;
+      // Une tuile ne peut pas être plus grande que l'intervalle.
+      Int32 ts = (tile_size[d] <= 0) ? n : tile_size[d];
+      if (ts > n)
+        ts = n;
+      if (ts == 0)
+        ts = 1;
+      m_tile_size[d] = ts;
+      m_nb_tile_dir[d] = (n + ts - 1) / ts;
+    }
+  }
+
+ public:
+
+  //! Nombre de tuiles
+  ARCCORE_HOST_DEVICE Int32 nbTile() const { return m_nb_tile_dir[0] * m_nb_tile_dir[1] * m_nb_tile_dir[2]; }
+
+  //! Nombre de tuiles dans la direction \a dir
+  ARCCORE_HOST_DEVICE Int32 nbTileDir(Int32 dir) const { return m_nb_tile_dir[dir]; }
+
+  //! Taille d'une tuile dans la direction \a dir
+  ARCCORE_HOST_DEVICE Int32 tileSize(Int32 dir) const { return m_tile_size[dir]; }
+
+  //! Nombre maximum d'éléments dans une tuile
+  ARCCORE_HOST_DEVICE Int32 tileVolume() const { return m_tile_size[0] * m_tile_size[1] * m_tile_size[2]; }
+
+  //! Intervalle d'itération sur les tuiles
+  SimpleForLoopRanges<1> tileLoopRanges() const { return makeLoopRanges(nbTile()); }
+
+  /*!
+   * \brief Intervalle d'itération sur les éléments pour les accélérateurs.
+   *
+   * Le nombre d'itérations est nbTile() * tileVolume() et peut donc être
+   * supérieur au nombre d'éléments si les tuiles du bord sont incomplètes.
+   */
+  SimpleForLoopRanges<1> itemLoopRanges() const { return makeLoopRanges(nbTile() * tileVolume()); }
+
+  //! Bornes [lower,upper[ dans l'ordre (i,j,k) de la tuile \a tile_index
+  ARCCORE_HOST_DEVICE void tileBounds(Int32 tile_index, Int32 (&lower)[3], Int32 (&upper)[3]) const
+  {
+    Int32 tile_ijk[3];
+    tile_ijk[0] = tile_index % m_nb_tile_dir[0];
+    Int32 r = tile_index / m_nb_tile_dir[0];
+    tile_ijk[1] = r % m_nb_tile_dir[1];
+    tile_ijk[2] = r / m_nb_tile_dir[1];
+    for (Int32 d = 0; d < 3; ++d) {
+      lower[d] = m_lower[d] + tile_ijk[d] * m_tile_size[d];
+      Int32 u = lower[d] + m_tile_size[d];
+      upper[d] = (u > m_upper[d]) ? m_upper[d] : u;
+    }
+  }
+
+  /*!
+   * \brief Indice (k,j,i) de l'élément d'indice linéaire \a item_index.
+   *
+   * Retourne \a false si l'élément est en dehors de l'intervalle (ce qui
+   * est possible pour les tuiles incomplètes).
+   */
+  ARCCORE_HOST_DEVICE bool itemIndex(Int32 item_index, MDIndex<3>& idx) const
+  {
+    const Int32 volume = tileVolume();
+    Int32 tile_index = item_index / volume;
+    Int32 r = item_index - tile_index * volume;
+    Int32 lower[3];
+    Int32 upper[3];
+    tileBounds(tile_index, lower, upper);
+    Int32 i = lower[0] + (r % m_tile_size[0]);
+    r /= m_tile_size[0];
+    Int32 j = lower[1] + (r % m_tile_size[1]);
+    Int32 k = lower[2] + (r / m_tile_size[1]);
+    idx = MDIndex<3>(k, j, i);
+    return (i < upper[0] && j < upper[1] && k < upper[2]);
+  }
+
+  //! Applique \a func sur les éléments (k,j,i) de la tuile \a tile_index
+  template <typename Lambda> ARCCORE_HOST_DEVICE void
+  applyInTile(Int32 tile_index, const Lambda& func) const
+  {
+    Int32 lower[3];
+    Int32 upper[3];
+    tileBounds(tile_index, lower, upper);
+    for (Int32 k = lower[2]; k < upper[2]; ++k)
+      for (Int32 j = lower[1]; j < upper[1]; ++j)
+        for (Int32 i = lower[0]; i < upper[0]; ++i)
+          func(MDIndex<3>(k, j, i));
+  }
+
+ private:
+
+  Int32 m_lower[3] = { 0, 0, 0 };
+  Int32 m_upper[3] = { 0, 0, 0 };
+  Int32 m_tile_size[3] = { 1, 1, 1 };
+  Int32 m_nb_tile_dir[3] = { 0, 0, 0 };
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Applique séquentiellement \a func sur les éléments de \a tiling
+ * tuile par tuile.
+ */
+template <typename Lambda> inline void
+arcaneSequentialFor(const CartesianTiling& tiling, const Lambda& func)
+{
+  for (Int32 t = 0, n = tiling.nbTile(); t < n; ++t)
+    tiling.applyInTile(t, func);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Applique en concurrence \a func sur les éléments de \a tiling.
+ *
+ * Les tuiles sont réparties entre les threads et chaque tuile est
+ * parcourue séquentiellement par un seul thread.
+ */
+template <typename Lambda> inline void
+arcaneParallelFor(const CartesianTiling& tiling, const ParallelLoopOptions& options, const Lambda& func)
+{
+  auto tile_func = [&](MDIndex<1> tile_index) {
+    tiling.applyInTile(tile_index[0], func);
+  };
+  ::Arcane::arcaneParallelFor(tiling.tileLoopRanges(), options, tile_func);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::CartesianMesh::V2
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
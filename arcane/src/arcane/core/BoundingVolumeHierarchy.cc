@@ -0,0 +1,347 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* BoundingVolumeHierarchy.cc                                  (C) 2000-2024 */
+/*                                                                           */
+/* Hiérarchie de boîtes englobantes.                                         */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/core/BoundingVolumeHierarchy.h"
+
+#include "arcane/utils/FatalErrorException.h"
+
+#include "arcane/core/Concurrency.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Construction de l'arbre par découpage récursif.
+ */
+class BoundingVolumeHierarchy::Builder
+{
+ public:
+
+  //! Nombre d'intervalles pour l'évaluation de la SAH
+  static constexpr Int32 NbBin = 16;
+  //! Nombre d'objets au delà duquel on découpe même si la SAH ne le justifie pas
+  static constexpr Int32 MaxSAHLeafSize = 16;
+
+  //! Sous-arbre à construire en parallèle
+  struct Job
+  {
+    Int32 node_index;
+    Int32 begin;
+    Int32 end;
+    Int32 depth;
+  };
+
+ public:
+
+  Builder(ConstArrayView<Real3> items_min, ConstArrayView<Real3> items_max,
+          ArrayView<Int32> item_indexes, Int32 max_leaf_size)
+  : m_items_min(items_min)
+  , m_items_max(items_max)
+  , m_item_indexes(item_indexes)
+  , m_max_leaf_size(max_leaf_size)
+  , m_centroids(items_min.size())
+  {
+    arcaneParallelFor(0, items_min.size(), [&](Integer begin, Integer size) {
+      for (Integer i = begin; i < (begin + size); ++i)
+        m_centroids[i] = (m_items_min[i] + m_items_max[i]) * 0.5;
+    });
+  }
+
+ public:
+
+  /*!
+   * \brief Construit le noeud \a node_index de \a nodes pour les objets [begin,end).
+   *
+   * Si \a jobs n'est pas nul, les sous-arbres ayant au plus \a job_size
+   * objets ne sont pas construits mais ajoutés à \a jobs.
+   */
+  void buildNode(Array<Node>& nodes, Int32 node_index, Int32 begin, Int32 end,
+                 Int32 depth, Array<Job>* jobs, Int32 job_size)
+  {
+    Node node;
+    Real3 c_min;
+    Real3 c_max;
+    _computeBounds(begin, end, node.m_min, node.m_max, c_min, c_max);
+    const Int32 n = end - begin;
+    if (jobs && n <= job_size && n > m_max_leaf_size) {
+      nodes[node_index] = node;
+      jobs->add(Job{ node_index, begin, end, depth });
+      return;
+    }
+    Int32 split = -1;
+    if (n > m_max_leaf_size && depth < MaxDepth)
+      split = _split(begin, end, node, c_min, c_max);
+    if (split < 0) {
+      node.m_first = begin;
+      node.m_nb_item = n;
+      nodes[node_index] = node;
+      return;
+    }
+    Int32 left = nodes.size();
+    nodes.add(Node());
+    nodes.add(Node());
+    node.m_first = left;
+    node.m_nb_item = 0;
+    nodes[node_index] = node;
+    buildNode(nodes, left, begin, split, depth + 1, jobs, job_size);
+    buildNode(nodes, left + 1, split, end, depth + 1, jobs, job_size);
+  }
+
+ private:
+
+  ConstArrayView<Real3> m_items_min;
+  ConstArrayView<Real3> m_items_max;
+  ArrayView<Int32> m_item_indexes;
+  Int32 m_max_leaf_size;
+  UniqueArray<Real3> m_centroids;
+
+ private:
+
+  static Real _area(Real3 b_min, Real3 b_max)
+  {
+    Real3 d = b_max - b_min;
+    return 2.0 * (d.x * d.y + d.y * d.z + d.z * d.x);
+  }
+
+  static void _addToBox(Real3 v_min, Real3 v_max, Real3& b_min, Real3& b_max)
+  {
+    b_min = math::min(b_min, v_min);
+    b_max = math::max(b_max, v_max);
+  }
+
+  void _computeBounds(Int32 begin, Int32 end, Real3& b_min, Real3& b_max,
+                      Real3& c_min, Real3& c_max) const
+  {
+    const Real max_value = std::numeric_limits<Real>::max();
+    b_min = c_min = Real3(max_value, max_value, max_value);
+    b_max = c_max = Real3(-max_value, -max_value, -max_value);
+    for (Int32 i = begin; i < end; ++i) {
+      Int32 index = m_item_indexes[i];
+      _addToBox(m_items_min[index], m_items_max[index], b_min, b_max);
+      _addToBox(m_centroids[index], m_centroids[index], c_min, c_max);
+    }
+  }
+
+  Int32 _bin(Int32 item_index, Integer axis, Real c_min, Real scale) const
+  {
+    Int32 b = static_cast<Int32>((m_centroids[item_index][axis] - c_min) * scale);
+    return std::clamp(b, 0, NbBin - 1);
+  }
+
+  /*!
+   * \brief Partitionne les objets [begin,end) en deux.
+   *
+   * Retourne la position de la séparation ou (-1) s'il est préférable
+   * de faire une feuille.
+   */
+  Int32 _split(Int32 begin, Int32 end, const Node& node, Real3 c_min, Real3 c_max)
+  {
+    const Int32 n = end - begin;
+    const Real max_value = std::numeric_limits<Real>::max();
+    const Real3 extent = c_max - c_min;
+    Real best_cost = max_value;
+    Integer best_axis = -1;
+    Int32 best_bin = -1;
+    for (Integer axis = 0; axis < 3; ++axis) {
+      if (!(extent[axis] > 0.0))
+        continue;
+      const Real scale = NbBin / extent[axis];
+      Int32 counts[NbBin] = {};
+      Real3 bins_min[NbBin];
+      Real3 bins_max[NbBin];
+      for (Int32 b = 0; b < NbBin; ++b) {
+        bins_min[b] = Real3(max_value, max_value, max_value);
+        bins_max[b] = Real3(-max_value, -max_value, -max_value);
+      }
+      for (Int32 i = begin; i < end; ++i) {
+        Int32 index = m_item_indexes[i];
+        Int32 b = _bin(index, axis, c_min[axis], scale);
+        ++counts[b];
+        _addToBox(m_items_min[index], m_items_max[index], bins_min[b], bins_max[b]);
+      }
+      // Coût à gauche de chaque plan de séparation.
+      Real left_costs[NbBin - 1];
+      Real3 acc_min(max_value, max_value, max_value);
+      Real3 acc_max(-max_value, -max_value, -max_value);
+      Int32 acc_count = 0;
+      for (Int32 b = 0; b < (NbBin - 1); ++b) {
+        acc_count += counts[b];
+        if (counts[b] > 0)
+          _addToBox(bins_min[b], bins_max[b], acc_min, acc_max);
+        left_costs[b] = (acc_count > 0) ? (acc_count * _area(acc_min, acc_max)) : 0.0;
+      }
+      acc_min = Real3(max_value, max_value, max_value);
+      acc_max = Real3(-max_value, -max_value, -max_value);
+      acc_count = 0;
+      for (Int32 b = NbBin - 1; b > 0; --b) {
+        acc_count += counts[b];
+        if (counts[b] > 0)
+          _addToBox(bins_min[b], bins_max[b], acc_min, acc_max);
+        Real right_cost = (acc_count > 0) ? (acc_count * _area(acc_min, acc_max)) : 0.0;
+        Real cost = left_costs[b - 1] + right_cost;
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_axis = axis;
+          best_bin = b - 1;
+        }
+      }
+    }
+
+    Int32* indexes = m_item_indexes.data();
+    if (best_axis >= 0) {
+      if (n <= MaxSAHLeafSize && best_cost >= n * _area(node.m_min, node.m_max))
+        return (-1);
+      const Real scale = NbBin / extent[best_axis];
+      const Real axis_min = c_min[best_axis];
+      Int32* mid = std::partition(indexes + begin, indexes + end, [&](Int32 index) {
+        return _bin(index, best_axis, axis_min, scale) <= best_bin;
+      });
+      Int32 split = static_cast<Int32>(mid - indexes);
+      if (split != begin && split != end)
+        return split;
+    }
+    // Tous les centres sont confondus ou la partition est vide:
+    // découpe au milieu selon l'axe le plus grand.
+    Integer axis = 0;
+    if (extent.y > extent[axis])
+      axis = 1;
+    if (extent.z > extent[axis])
+      axis = 2;
+    Int32 split = begin + n / 2;
+    std::nth_element(indexes + begin, indexes + split, indexes + end, [&](Int32 a, Int32 b) {
+      return m_centroids[a][axis] < m_centroids[b][axis];
+    });
+    return split;
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void BoundingVolumeHierarchy::
+build(ConstArrayView<Real3> items_min, ConstArrayView<Real3> items_max)
+{
+  const Int32 n = items_min.size();
+  if (items_max.size() != n)
+    ARCANE_FATAL("Bad size for items_max n={0} expected={1}", items_max.size(), n);
+  m_nodes.clear();
+  m_item_indexes.resize(n);
+  std::iota(m_item_indexes.begin(), m_item_indexes.end(), 0);
+  if (n == 0)
+    return;
+
+  Builder builder(items_min, items_max, m_item_indexes, m_max_leaf_size);
+  m_nodes.add(Node());
+
+  const Int32 min_parallel_size = m_min_parallel_build_size;
+  if (n < (2 * min_parallel_size)) {
+    builder.buildNode(m_nodes, 0, 0, n, 0, nullptr, 0);
+    return;
+  }
+
+  // Construit séquentiellement le haut de l'arbre jusqu'à avoir des
+  // sous-arbres de taille suffisamment petite pour équilibrer la charge,
+  // puis construit ces sous-arbres en parallèle.
+  const Int32 nb_thread = std::max(TaskFactory::nbAllowedThread(), 1);
+  const Int32 job_size = std::max(min_parallel_size, n / (4 * nb_thread));
+  UniqueArray<Builder::Job> jobs;
+  builder.buildNode(m_nodes, 0, 0, n, 0, &jobs, job_size);
+
+  const Int32 nb_job = jobs.size();
+  std::vector<UniqueArray<Node>> jobs_nodes(nb_job);
+  ParallelLoopOptions loop_options;
+  loop_options.setGrainSize(1);
+  arcaneParallelFor(0, nb_job, loop_options, [&](Integer begin, Integer size) {
+    for (Integer j = begin; j < (begin + size); ++j) {
+      const Builder::Job& job = jobs[j];
+      UniqueArray<Node>& local_nodes = jobs_nodes[j];
+      local_nodes.add(Node());
+      builder.buildNode(local_nodes, 0, job.begin, job.end, job.depth, nullptr, 0);
+    }
+  });
+
+  // Ajoute les noeuds des sous-arbres. La racine de chaque sous-arbre
+  // remplace le noeud en attente et les autres noeuds sont ajoutés à la fin.
+  for (Int32 j = 0; j < nb_job; ++j) {
+    ConstArrayView<Node> local_nodes = jobs_nodes[j];
+    const Int32 base = m_nodes.size() - 1;
+    auto remap = [base](Node node) {
+      if (!node.isLeaf())
+        node.m_first += base;
+      return node;
+    };
+    m_nodes[jobs[j].node_index] = remap(local_nodes[0]);
+    for (Int32 k = 1, nk = local_nodes.size(); k < nk; ++k)
+      m_nodes.add(remap(local_nodes[k]));
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void BoundingVolumeHierarchy::
+refit(ConstArrayView<Real3> items_min, ConstArrayView<Real3> items_max)
+{
+  const Int32 n = m_item_indexes.size();
+  if (items_min.size() != n || items_max.size() != n)
+    ARCANE_FATAL("Bad number of items n={0} expected={1}", items_min.size(), n);
+  const Int32 nb_node = m_nodes.size();
+
+  // Met à jour les feuilles en parallèle puis les noeuds internes en
+  // remontant. Comme les fils ont un indice supérieur à leur père, il
+  // suffit de parcourir les noeuds en ordre inverse.
+  arcaneParallelFor(0, nb_node, [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); ++i) {
+      Node& node = m_nodes[i];
+      if (!node.isLeaf())
+        continue;
+      Int32 first_index = m_item_indexes[node.m_first];
+      Real3 b_min = items_min[first_index];
+      Real3 b_max = items_max[first_index];
+      for (Int32 k = node.m_first + 1, nk = node.m_first + node.m_nb_item; k < nk; ++k) {
+        Int32 index = m_item_indexes[k];
+        b_min = math::min(b_min, items_min[index]);
+        b_max = math::max(b_max, items_max[index]);
+      }
+      node.m_min = b_min;
+      node.m_max = b_max;
+    }
+  });
+  for (Int32 i = nb_node - 1; i >= 0; --i) {
+    Node& node = m_nodes[i];
+    if (node.isLeaf())
+      continue;
+    const Node& left = m_nodes[node.m_first];
+    const Node& right = m_nodes[node.m_first + 1];
+    node.m_min = math::min(left.m_min, right.m_min);
+    node.m_max = math::max(left.m_max, right.m_max);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
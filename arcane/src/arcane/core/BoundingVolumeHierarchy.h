@@ -0,0 +1,258 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* BoundingVolumeHierarchy.h                                   (C) 2000-2024 */
+/*                                                                           */
+/* Hiérarchie de boîtes englobantes.                                         */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_CORE_BOUNDINGVOLUMEHIERARCHY_H
+#define ARCANE_CORE_BOUNDINGVOLUMEHIERARCHY_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/Array.h"
+#include "arcane/utils/Real3.h"
+
+#include "arcane/core/ArcaneTypes.h"
+
+#include <utility>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Hiérarchie de boîtes englobantes (BVH).
+ *
+ * Cette classe permet d'accélérer les requêtes géométriques (intersection
+ * avec un rayon, recherche des objets contenant un point) sur un ensemble
+ * d'objets définis par leur boîte englobante alignée sur les axes. Les
+ * objets sont repérés par leur indice dans les tableaux passés à build().
+ *
+ * La construction utilise l'heuristique de surface (SAH) calculée par
+ * intervalles (binned SAH). Les sous-arbres sont construits en parallèle
+ * via TaskFactory si le multi-threading est actif.
+ *
+ * Si les objets se déplacent sans changer de nombre, refit() recalcule
+ * les boîtes des noeuds sans modifier la structure de l'arbre. Cette
+ * opération est beaucoup moins coûteuse que build() mais la qualité de
+ * l'arbre diminue si les déplacements sont importants.
+ *
+ * Les méthodes visitRay() et visitPoint() sont constantes et peuvent être
+ * appelées simultanément par plusieurs threads.
+ */
+class ARCANE_CORE_EXPORT BoundingVolumeHierarchy
+{
+ public:
+
+  //! Profondeur maximale de l'arbre
+  static constexpr Int32 MaxDepth = 60;
+
+  /*!
+   * \brief Noeud de l'arbre.
+   *
+   * Si nbItem() est nul, il s'agit d'un noeud interne dont les fils ont
+   * pour indices first() et first()+1. Sinon, il s'agit d'une feuille
+   * contenant les objets itemIndexes()[first()] à itemIndexes()[first()+nbItem()-1].
+   * Les fils d'un noeud ont toujours un indice supérieur à celui de leur père.
+   */
+  struct Node
+  {
+    Real3 m_min;
+    Real3 m_max;
+    Int32 m_first = 0;
+    Int32 m_nb_item = 0;
+
+    bool isLeaf() const { return m_nb_item > 0; }
+  };
+
+ public:
+
+  /*!
+   * \brief Construit l'arbre.
+   *
+   * \a items_min et \a items_max contiennent les coins des boîtes
+   * englobantes des objets.
+   */
+  void build(ConstArrayView<Real3> items_min, ConstArrayView<Real3> items_max);
+
+  /*!
+   * \brief Met à jour les boîtes des noeuds sans changer la structure.
+   *
+   * Le nombre d'objets doit être le même que lors du dernier appel à build().
+   */
+  void refit(ConstArrayView<Real3> items_min, ConstArrayView<Real3> items_max);
+
+  //! Nombre d'objets
+  Int32 nbItem() const { return m_item_indexes.size(); }
+
+  //! Liste des noeuds. Le premier est la racine.
+  ConstArrayView<Node> nodes() const { return m_nodes; }
+
+  //! Indices des objets rangés par feuille
+  ConstArrayView<Int32> itemIndexes() const { return m_item_indexes; }
+
+  //! Nombre maximum d'objets par feuille
+  void setMaxLeafSize(Int32 v) { m_max_leaf_size = (v > 0) ? v : 1; }
+
+  /*!
+   * \brief Taille minimale d'un sous-arbre construit par une tâche.
+   *
+   * Si le nombre d'objets est inférieur au double de cette valeur, l'arbre
+   * est construit en une seule fois. Sinon, le haut de l'arbre est construit
+   * séquentiellement puis les sous-arbres sont construits indépendamment
+   * (en parallèle si le multi-threading est actif) et fusionnés. La
+   * structure obtenue ne dépend pas du nombre de threads.
+   */
+  void setMinParallelBuildSize(Int32 v) { m_min_parallel_build_size = (v > 0) ? v : 1; }
+
+  /*!
+   * \brief Parcours les objets dont la boîte intersecte le rayon.
+   *
+   * Le rayon est la demi-droite d'origine \a origin et de direction
+   * \a direction (non forcément normalisée). Seule la partie du rayon
+   * dont le paramètre est compris entre 0 et \a max_distance est
+   * considérée. \a func(item_index,max_distance) est appelée pour chaque
+   * objet candidat et peut diminuer \a max_distance (par exemple si elle
+   * trouve une intersection) pour élaguer la suite du parcours. Les noeuds
+   * les plus proches sont parcourus en premier.
+   */
+  template <typename Func> void
+  visitRay(Real3 origin, Real3 direction, Real& max_distance, const Func& func) const
+  {
+    if (m_nodes.empty())
+      return;
+    Int32 stack[MaxDepth + 2];
+    Int32 stack_size = 0;
+    Real t_enter = 0.0;
+    if (!_intersectRay(m_nodes[0], origin, direction, max_distance, t_enter))
+      return;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+      const Node& node = m_nodes[stack[--stack_size]];
+      if (node.isLeaf()) {
+        for (Int32 i = node.m_first, n = node.m_first + node.m_nb_item; i < n; ++i)
+          func(m_item_indexes[i], max_distance);
+        continue;
+      }
+      Int32 left = node.m_first;
+      Int32 right = left + 1;
+      Real t_left = 0.0;
+      Real t_right = 0.0;
+      bool has_left = _intersectRay(m_nodes[left], origin, direction, max_distance, t_left);
+      bool has_right = _intersectRay(m_nodes[right], origin, direction, max_distance, t_right);
+      // Empile le fils le plus lointain en premier pour traiter le plus proche d'abord.
+      if (has_left && has_right) {
+        if (t_left < t_right) {
+          stack[stack_size++] = right;
+          stack[stack_size++] = left;
+        }
+        else {
+          stack[stack_size++] = left;
+          stack[stack_size++] = right;
+        }
+      }
+      else if (has_left)
+        stack[stack_size++] = left;
+      else if (has_right)
+        stack[stack_size++] = right;
+    }
+  }
+
+  /*!
+   * \brief Parcours les objets dont la boîte contient le point \a point.
+   *
+   * \a func(item_index) est appelée pour chaque objet candidat. Si elle
+   * retourne \a true, le parcours est arrêté.
+   */
+  template <typename Func> void
+  visitPoint(Real3 point, const Func& func) const
+  {
+    if (m_nodes.empty())
+      return;
+    Int32 stack[MaxDepth + 2];
+    Int32 stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+      const Node& node = m_nodes[stack[--stack_size]];
+      if (!_isInside(node, point))
+        continue;
+      if (node.isLeaf()) {
+        for (Int32 i = node.m_first, n = node.m_first + node.m_nb_item; i < n; ++i)
+          if (func(m_item_indexes[i]))
+            return;
+        continue;
+      }
+      stack[stack_size++] = node.m_first + 1;
+      stack[stack_size++] = node.m_first;
+    }
+  }
+
+ private:
+
+  class Builder;
+
+  UniqueArray<Node> m_nodes;
+  UniqueArray<Int32> m_item_indexes;
+  Int32 m_max_leaf_size = 4;
+  Int32 m_min_parallel_build_size = 4096;
+
+ private:
+
+  static bool _isInside(const Node& node, Real3 p)
+  {
+    return (p.x >= node.m_min.x && p.x <= node.m_max.x &&
+            p.y >= node.m_min.y && p.y <= node.m_max.y &&
+            p.z >= node.m_min.z && p.z <= node.m_max.z);
+  }
+
+  //! Intersection par la méthode des plans (slabs) entre un rayon et une boîte
+  static bool _intersectRay(const Node& node, Real3 origin, Real3 direction,
+                            Real max_distance, Real& t_enter)
+  {
+    Real t_min = 0.0;
+    Real t_max = max_distance;
+    for (Integer axis = 0; axis < 3; ++axis) {
+      Real o = origin[axis];
+      Real d = direction[axis];
+      Real b_min = node.m_min[axis];
+      Real b_max = node.m_max[axis];
+      if (d == 0.0) {
+        if (o < b_min || o > b_max)
+          return false;
+        continue;
+      }
+      Real inv_d = 1.0 / d;
+      Real t0 = (b_min - o) * inv_d;
+      Real t1 = (b_max - o) * inv_d;
+      if (t0 > t1)
+        std::swap(t0, t1);
+      if (t0 > t_min)
+        t_min = t0;
+      if (t1 < t_max)
+        t_max = t1;
+      if (t_min > t_max)
+        return false;
+    }
+    t_enter = t_min;
+    return true;
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -14,6 +14,7 @@
 #include "arcane/utils/ValueConvert.h"
 #include "arcane/utils/ITraceMng.h"
 #include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/MemoryUtils.h"
 
 #include "arcane/CaseTable.h"
 #include "arcane/CaseTableParams.h"
@@ -47,6 +48,8 @@ CaseTable(const CaseFunctionBuildInfo& info, eCurveType curve_type)
 : CaseFunction(info)
 , m_param_list(nullptr)
 , m_curve_type(curve_type)
+, m_real_params(MemoryUtils::getAllocatorForMostlyReadOnlyData())
+, m_real_values(MemoryUtils::getAllocatorForMostlyReadOnlyData())
 {
   m_param_list = new CaseTableParams(info.m_param_type);
   if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_USE_LINEAR_SEARCH_IN_CASE_TABLE", true))
@@ -146,6 +149,7 @@ value(Integer param,Real3& v) const
 CaseTable::eError CaseTable::
 setParam(Integer id,const String& str)
 {
+  _invalidateRealView();
   return m_param_list->setValue(id,str);
 }
 
@@ -155,6 +159,7 @@ setParam(Integer id,const String& str)
 CaseTable::eError CaseTable::
 setValue(Integer id,const String& str)
 {
+  _invalidateRealView();
   if (_isValidIndex(id))
     return _setValue(id,str);
   return ErrNo;
@@ -206,6 +211,7 @@ void CaseTable::
 setParamType(eParamType new_type)
 {
   bool type_changed = (new_type!=paramType());
+  _invalidateRealView();
   CaseFunction::setParamType(new_type);
   if (type_changed)
     m_param_list->setType(new_type);
@@ -219,6 +225,7 @@ setParamType(eParamType new_type)
 CaseTable::eError CaseTable::
 appendElement(const String& param,const String& value)
 {
+  _invalidateRealView();
   eError err = m_param_list->appendValue(param);
   if (err!=ErrNo)
     return err;
@@ -232,6 +239,7 @@ appendElement(const String& param,const String& value)
 void CaseTable::
 insertElement(Integer id)
 {
+  _invalidateRealView();
   // Ajoute un élément à la fin.
   Integer n = nbElement();
   if (n==0)
@@ -262,6 +270,7 @@ removeElement(Integer id)
 {
   if (!_isValidIndex(id))
     return;
+  _invalidateRealView();
   
   m_value_list.remove(id);
   m_param_list->removeValue(id);
@@ -397,6 +406,97 @@ _findValue(ParamType param,ValueType& avalue) const
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Convertit les paramètres et valeurs de la table en réels.
+ *
+ * Les coefficients de transformation ne sont pas appliqués ici car ils
+ * peuvent changer sans que la table soit modifiée.
+ *
+ * Cette méthode peut être appelée simultanément par plusieurs threads.
+ * Seul le premier construit les tableaux, les autres attendent la fin
+ * de la construction.
+ */
+void CaseTable::
+_buildRealView() const
+{
+  std::lock_guard<std::mutex> lock(m_real_view_mutex);
+  if (m_is_real_view_valid.load(std::memory_order_acquire))
+    return;
+  eValueType value_type = valueType();
+  if (value_type!=ValueReal && value_type!=ValueUnknown)
+    ARCANE_FATAL("Table '{0}' : real view is only available for tables with real values",name());
+  Integer nb_elem = nbElement();
+  m_real_params.resize(nb_elem);
+  m_real_values.resize(nb_elem);
+  for( Integer i=0; i<nb_elem; ++i ){
+    m_param_list->value(i,m_real_params[i]);
+    _verboseBuiltInGetValue(this,i,m_real_values[i],m_value_list[i].asString());
+  }
+  m_is_real_view_valid.store(true,std::memory_order_release);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+CaseTableView CaseTable::
+realView() const
+{
+  if (!m_is_real_view_valid.load(std::memory_order_acquire))
+    _buildRealView();
+
+  Real param_comul = 1.0;
+  String param_func = transformParamFunction();
+  if (!param_func.null()){
+    if (builtInGetValue(param_comul,param_func))
+      ARCANE_FATAL("Can not convert 'comul-x' value '{0}'",param_func);
+    if (math::isZero(param_comul))
+      ARCANE_FATAL("The parameter 'comul-x' can not be zero");
+  }
+  // La transformation des valeurs est un coefficient multiplicateur.
+  Real value_comul = 1.0;
+  _applyValueTransform(value_comul);
+
+  return CaseTableView(m_real_params,m_real_values,m_curve_type==CurveLinear,
+                       param_comul,value_comul);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void CaseTable::
+values(SmallSpan<const Real> params,SmallSpan<Real> out) const
+{
+  const Int32 n = params.size();
+  if (out.size()<n)
+    ARCANE_FATAL("Table '{0}' : output size '{1}' is smaller than the number of parameters '{2}'",
+                 name(),out.size(),n);
+  CaseTableView view = realView();
+  const Int32 nb_elem = view.nbElement();
+  if (nb_elem==0){
+    out.fill(0.0);
+    return;
+  }
+  SmallSpan<const Real> table_params = m_real_params;
+  const Real param_comul = view.paramComul();
+  // Indice retourné par lowerBound() pour le paramètre précédent. Si le
+  // paramètre courant est dans le même intervalle ou dans le suivant, on
+  // évite la recherche dichotomique.
+  Int32 k = 0;
+  for( Int32 i=0; i<n; ++i ){
+    Real p = params[i] / param_comul;
+    bool is_in_range = (k==0 || table_params[k-1]<p) && (k==nb_elem || p<=table_params[k]);
+    if (!is_in_range){
+      if (k<nb_elem && table_params[k]<p && (k+1==nb_elem || p<=table_params[k+1]))
+        ++k;
+      else
+        k = view.lowerBound(p);
+    }
+    out[i] = view._value(p,k);
+  }
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -17,6 +17,10 @@
 #include "arcane/datatype/SmallVariant.h"
 
 #include "arcane/CaseFunction.h"
+#include "arcane/core/CaseTableView.h"
+
+#include <atomic>
+#include <mutex>
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -157,6 +161,31 @@ class ARCANE_CORE_EXPORT CaseTable
   virtual void value(Integer param,String& v) const;
   virtual void value(Integer param,Real3& v) const;
 
+  /*!
+   * \brief Calcule les valeurs pour une liste de paramètres.
+   *
+   * Pour chaque indice \a i, \a out[i] contient la même valeur que celle
+   * retournée par value(params[i],out[i]). Le calcul utilise realView() et
+   * est donc beaucoup plus rapide que des appels successifs à value().
+   * Si les paramètres sont croissants, la recherche de l'intervalle
+   * réutilise celui du paramètre précédent.
+   */
+  void values(SmallSpan<const Real> params,SmallSpan<Real> out) const;
+
+  /*!
+   * \brief Vue constante sur la table pour des valeurs réelles.
+   *
+   * Les paramètres et valeurs convertis en réels sont conservés
+   * et ne sont recalculés que si la table est modifiée. Ils sont alloués
+   * pour être accessibles sur accélérateur. La vue retournée n'est plus
+   * valide après une modification de la table.
+   *
+   * Cette méthode et values() peuvent être appelées simultanément par
+   * plusieurs threads tant que la table n'est pas modifiée. Elles ne sont
+   * valides que si le type des valeurs est ValueReal ou ValueUnknown.
+   */
+  CaseTableView realView() const;
+
  public:
 
  private:
@@ -165,6 +194,14 @@ class ARCANE_CORE_EXPORT CaseTable
   UniqueArray<SmallVariant> m_value_list; //!< Liste des valeurs.
   eCurveType m_curve_type; //!< Type de la courbe
   bool m_use_fast_search = true;
+  //! Paramètres convertis en réels pour realView()
+  mutable UniqueArray<Real> m_real_params;
+  //! Valeurs converties en réels pour realView()
+  mutable UniqueArray<Real> m_real_values;
+  //! Indique si m_real_params et m_real_values sont à jour
+  mutable std::atomic<bool> m_is_real_view_valid = false;
+  //! Protège la construction de m_real_params et m_real_values
+  mutable std::mutex m_real_view_mutex;
 
  private:
 
@@ -173,6 +210,8 @@ class ARCANE_CORE_EXPORT CaseTable
 
   bool _isValidIndex(Integer index) const;
   eError _setValue(Integer index,const String& value_str);
+  void _invalidateRealView() { m_is_real_view_valid = false; }
+  void _buildRealView() const;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,143 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CaseTableView.h                                             (C) 2000-2024 */
+/*                                                                           */
+/* Vue constante sur une table de marche à valeurs réelles.                  */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_CORE_CASETABLEVIEW_H
+#define ARCANE_CORE_CASETABLEVIEW_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arccore/base/Span.h"
+
+#include "arcane/core/ArcaneTypes.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vue constante sur une table de marche à valeurs réelles.
+ *
+ * Cette vue est obtenue via CaseTable::realView(). Elle contient les
+ * paramètres et les valeurs de la table déjà convertis en réels ainsi que
+ * les coefficients de transformation. Elle peut être copiée par valeur dans
+ * une commande (RUNCOMMAND_LOOP, RUNCOMMAND_ENUMERATE, ...) et value() est
+ * appelable sur accélérateur.
+ *
+ * La recherche de l'intervalle contenant le paramètre est dichotomique.
+ * Le résultat est identique à celui de CaseTable::value(Real,Real&).
+ *
+ * La vue n'est plus valide si la table est modifiée ou détruite.
+ */
+class CaseTableView
+{
+ public:
+
+  CaseTableView() = default;
+  CaseTableView(SmallSpan<const Real> params, SmallSpan<const Real> values,
+                bool is_linear, Real param_comul, Real value_comul)
+  : m_params(params)
+  , m_values(values)
+  , m_is_linear(is_linear)
+  , m_param_comul(param_comul)
+  , m_value_comul(value_comul)
+  {}
+
+ public:
+
+  //! Nombre d'éléments de la table
+  constexpr ARCCORE_HOST_DEVICE Int32 nbElement() const { return m_params.size(); }
+
+  //! Valeur de la table pour le paramètre \a param
+  ARCCORE_HOST_DEVICE Real value(Real param) const
+  {
+    const Int32 n = m_params.size();
+    if (n == 0)
+      return 0.0;
+    param = param / m_param_comul;
+    Int32 k = lowerBound(param);
+    return _value(param, k);
+  }
+
+  /*!
+   * \brief Indice du premier paramètre supérieur ou égal à \a param.
+   *
+   * Retourne nbElement() si tous les paramètres sont inférieurs à \a param.
+   * \a param est le paramètre après transformation.
+   */
+  ARCCORE_HOST_DEVICE Int32 lowerBound(Real param) const
+  {
+    Int32 first = 0;
+    Int32 count = m_params.size();
+    while (count > 0) {
+      Int32 step = count / 2;
+      Int32 mid = first + step;
+      if (m_params[mid] < param) {
+        first = mid + 1;
+        count -= step + 1;
+      }
+      else
+        count = step;
+    }
+    return first;
+  }
+
+  //! Coefficient multiplicateur du paramètre
+  constexpr ARCCORE_HOST_DEVICE Real paramComul() const { return m_param_comul; }
+
+ public:
+
+  /*!
+   * \internal
+   * \brief Valeur pour le paramètre transformé \a param et l'indice \a k
+   * retourné par lowerBound(param).
+   */
+  ARCCORE_HOST_DEVICE Real _value(Real param, Int32 k) const
+  {
+    const Int32 n = m_params.size();
+    Real v = 0.0;
+    if (k == n)
+      v = m_values[n - 1];
+    else if (k == 0 || m_params[k] == param)
+      v = m_values[k];
+    else if (!m_is_linear)
+      // Courbe constante par morceau: valeur du début de l'intervalle.
+      v = m_values[k - 1];
+    else {
+      Real x0 = m_params[k - 1];
+      Real y0 = m_values[k - 1];
+      Real t = (param - x0) / (m_params[k] - x0);
+      v = y0 + (m_values[k] - y0) * t;
+    }
+    return v * m_value_comul;
+  }
+
+ private:
+
+  SmallSpan<const Real> m_params;
+  SmallSpan<const Real> m_values;
+  bool m_is_linear = false;
+  Real m_param_comul = 1.0;
+  Real m_value_comul = 1.0;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -0,0 +1,172 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CellParticleIndexView.h                                     (C) 2000-2024 */
+/*                                                                           */
+/* Vue sur l'index des particules de chaque maille.                          */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_CORE_CELLPARTICLEINDEXVIEW_H
+#define ARCANE_CORE_CELLPARTICLEINDEXVIEW_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arccore/base/Span.h"
+
+#include "arcane/core/ItemLocalId.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Liste des particules d'une maille.
+ *
+ * Cette classe s'utilise dans une boucle 'for-range':
+ * \code
+ * for (ParticleLocalId p : index_view.particles(cell_id))
+ *   ...
+ * \endcode
+ */
+class CellParticleRange
+{
+ public:
+
+  class Iterator
+  {
+   public:
+
+    constexpr ARCCORE_HOST_DEVICE explicit Iterator(const Int32* ptr)
+    : m_ptr(ptr)
+    {}
+    constexpr ARCCORE_HOST_DEVICE ParticleLocalId operator*() const { return ParticleLocalId(*m_ptr); }
+    constexpr ARCCORE_HOST_DEVICE Iterator& operator++()
+    {
+      ++m_ptr;
+      return *this;
+    }
+    friend constexpr ARCCORE_HOST_DEVICE bool operator!=(const Iterator& a, const Iterator& b)
+    {
+      return a.m_ptr != b.m_ptr;
+    }
+
+   private:
+
+    const Int32* m_ptr;
+  };
+
+ public:
+
+  constexpr ARCCORE_HOST_DEVICE explicit CellParticleRange(SmallSpan<const Int32> local_ids)
+  : m_local_ids(local_ids)
+  {}
+
+ public:
+
+  constexpr ARCCORE_HOST_DEVICE Iterator begin() const { return Iterator(m_local_ids.data()); }
+  constexpr ARCCORE_HOST_DEVICE Iterator end() const { return Iterator(m_local_ids.data() + m_local_ids.size()); }
+  constexpr ARCCORE_HOST_DEVICE Int32 size() const { return m_local_ids.size(); }
+  //! Numéros locaux des particules
+  constexpr ARCCORE_HOST_DEVICE SmallSpan<const Int32> localIds() const { return m_local_ids; }
+
+ private:
+
+  SmallSpan<const Int32> m_local_ids;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vue sur l'index des particules de chaque maille.
+ *
+ * Cette vue est obtenue via IParticleFamily::cellParticleIndexView().
+ * L'index est au format CSR: les particules de la maille \a c sont
+ * rangées entre les positions offsets[c] et offsets[c+1] (exclue) du
+ * tableau des numéros locaux des particules. Dans une maille, les
+ * particules sont rangées par numéro local croissant.
+ *
+ * Si la famille a été triée par maille (IParticleFamily::sortParticlesByCell()),
+ * les numéros locaux des particules d'une maille sont consécutifs et
+ * l'accès aux variables des particules d'une maille est contigu en mémoire.
+ *
+ * La vue peut être copiée par valeur dans une commande (RUNCOMMAND_LOOP,
+ * RUNCOMMAND_ENUMERATE, ...):
+ * \code
+ * CellParticleIndexView index_view = particle_family->cellParticleIndexView();
+ * command << RUNCOMMAND_ENUMERATE(Cell, cid, allCells())
+ * {
+ *   Real sum = 0.0;
+ *   for (ParticleLocalId p : index_view.particles(cid))
+ *     sum += in_particle_weight[p];
+ *   out_cell_weight[cid] = sum;
+ * };
+ * \endcode
+ *
+ * La vue est invalidée par toute modification de la famille de particules
+ * ou du maillage.
+ */
+class CellParticleIndexView
+{
+ public:
+
+  CellParticleIndexView() = default;
+  CellParticleIndexView(SmallSpan<const Int32> offsets, SmallSpan<const Int32> particle_local_ids)
+  : m_offsets(offsets)
+  , m_particle_local_ids(particle_local_ids)
+  {}
+
+ public:
+
+  //! Nombre de mailles de l'index
+  constexpr ARCCORE_HOST_DEVICE Int32 nbCell() const
+  {
+    return (m_offsets.size() > 0) ? (m_offsets.size() - 1) : 0;
+  }
+
+  //! Nombre de particules de la maille \a cell_id
+  constexpr ARCCORE_HOST_DEVICE Int32 nbParticle(CellLocalId cell_id) const
+  {
+    return m_offsets[cell_id + 1] - m_offsets[cell_id];
+  }
+
+  //! Liste des particules de la maille \a cell_id
+  constexpr ARCCORE_HOST_DEVICE CellParticleRange particles(CellLocalId cell_id) const
+  {
+    Int32 begin = m_offsets[cell_id];
+    return CellParticleRange(m_particle_local_ids.subSpan(begin, m_offsets[cell_id + 1] - begin));
+  }
+
+  //! \a index-ème particule de la maille \a cell_id
+  constexpr ARCCORE_HOST_DEVICE ParticleLocalId particle(CellLocalId cell_id, Int32 index) const
+  {
+    return ParticleLocalId(m_particle_local_ids[m_offsets[cell_id] + index]);
+  }
+
+  //! Tableau des positions (de taille nbCell()+1)
+  constexpr ARCCORE_HOST_DEVICE SmallSpan<const Int32> offsets() const { return m_offsets; }
+
+  //! Numéros locaux des particules rangées par maille
+  constexpr ARCCORE_HOST_DEVICE SmallSpan<const Int32> particleLocalIds() const { return m_particle_local_ids; }
+
+ private:
+
+  SmallSpan<const Int32> m_offsets;
+  SmallSpan<const Int32> m_particle_local_ids;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
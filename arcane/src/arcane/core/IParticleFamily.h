@@ -16,6 +16,7 @@
 
 #include "arcane/ArcaneTypes.h"
 #include "arcane/ItemTypes.h"
+#include "arcane/core/CellParticleIndexView.h"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -130,6 +131,45 @@ class ARCANE_CORE_EXPORT IParticleFamily
    */
   virtual void exchangeParticles() = 0;
 
+ public:
+
+  /*!
+   * \brief Active ou désactive le tri des particules par maille.
+   *
+   * Si ce mode est actif, le compactage de la famille range les particules
+   * par maille: les particules d'une même maille ont des numéros locaux
+   * consécutifs et les mailles sont rangées par numéro local croissant.
+   * Cela s'applique au compactage du maillage et à sortParticlesByCell().
+   * Les particules sans maille sont rangées après les autres.
+   */
+  virtual void setCellSortedMode(bool v) = 0;
+
+  //! Indique si le tri des particules par maille est actif
+  virtual bool isCellSortedMode() const = 0;
+
+  /*!
+   * \brief Trie les particules par maille.
+   *
+   * Compacte la famille en rangeant les particules par maille.
+   * Le mode trié doit être actif (voir setCellSortedMode()).
+   *
+   * Cette opération modifie les numéros locaux des particules. Elle est
+   * locale au sous-domaine et peut être appelée périodiquement, par exemple
+   * après chaque échange de particules, pour conserver la localité des accès
+   * aux variables lors des boucles sur les particules d'une maille.
+   */
+  virtual void sortParticlesByCell() = 0;
+
+  /*!
+   * \brief Vue sur l'index des particules de chaque maille.
+   *
+   * L'index est recalculé si la famille ou le maillage ont été modifiés
+   * depuis le dernier appel. Il n'est pas nécessaire que le mode trié
+   * soit actif mais dans ce cas les accès aux variables des particules
+   * d'une maille ne sont pas contigus.
+   */
+  virtual CellParticleIndexView cellParticleIndexView() = 0;
+
  public:
 
   //! Interface sur la famille
@@ -0,0 +1,109 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* IPointLocator.h                                             (C) 2000-2024 */
+/*                                                                           */
+/* Interface de la localisation de points dans les mailles d'un maillage.    */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_CORE_IPOINTLOCATOR_H
+#define ARCANE_CORE_IPOINTLOCATOR_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/core/ItemTypes.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Interface de la localisation de points dans les mailles d'un maillage.
+ *
+ * Ce service permet de déterminer, pour une position donnée, la maille
+ * qui la contient et le sous-domaine propriétaire de cette maille.
+ *
+ * L'instance doit être associée à un maillage via setMesh() puis
+ * construite par build(). Après un déplacement des noeuds ou une
+ * modification du maillage (par exemple après un équilibrage de charge),
+ * il faut appeler update() avant d'effectuer de nouvelles recherches.
+ *
+ * Les mailles sont supposées convexes. Si un point est sur la frontière
+ * de plusieurs mailles, la maille retenue est celle de plus petit
+ * uniqueId(), ce qui rend le résultat indépendant du découpage.
+ */
+class ARCANE_CORE_EXPORT IPointLocator
+{
+ public:
+
+  virtual ~IPointLocator() = default;
+
+ public:
+
+  //! Positionne le maillage associé. Doit être appelé avant build().
+  virtual void setMesh(IMesh* mesh) = 0;
+
+  //! Maillage associé
+  virtual IMesh* mesh() const = 0;
+
+  /*!
+   * \brief Construit les structures de recherche.
+   *
+   * Cette méthode est collective.
+   */
+  virtual void build() = 0;
+
+  /*!
+   * \brief Met à jour les structures de recherche.
+   *
+   * Si la topologie du maillage n'a pas changé depuis le dernier appel à
+   * build(), seules les boîtes englobantes sont recalculées. Sinon, les
+   * structures sont reconstruites. Cette méthode est collective.
+   */
+  virtual void update() = 0;
+
+  /*!
+   * \brief Cherche parmi les mailles propres du sous-domaine celle
+   * contenant \a point.
+   *
+   * Cette méthode n'est pas collective et peut être appelée
+   * simultanément par plusieurs threads.
+   *
+   * \return le numéro local de la maille ou une valeur nulle
+   * si aucune maille propre ne contient \a point.
+   */
+  virtual CellLocalId findLocalCell(Real3 point) const = 0;
+
+  /*!
+   * \brief Localise un ensemble de points sur l'ensemble des sous-domaines.
+   *
+   * Pour chaque point de \a points, \a owner_ranks contient en retour
+   * le rang du sous-domaine propriétaire de la maille contenant le
+   * point et \a cells_unique_id l'uniqueId() de cette maille. Si le point
+   * n'est dans aucune maille, le rang vaut A_NULL_RANK et l'uniqueId()
+   * NULL_ITEM_UNIQUE_ID.
+   *
+   * Chaque sous-domaine peut localiser un nombre différent de points.
+   * Les points ne sont envoyés qu'aux sous-domaines dont la boîte
+   * englobante les contient. Cette méthode est collective.
+   */
+  virtual void locate(ConstArrayView<Real3> points, ArrayView<Int32> owner_ranks,
+                      ArrayView<Int64> cells_unique_id) = 0;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
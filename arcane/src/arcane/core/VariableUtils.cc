@@ -102,6 +102,22 @@ markVariableAsMostlyReadOnly(::Arcane::Materials::MeshMaterialVariableRef& var)
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+Int64 VariableUtils::
+computeNumaPagePlacement(IVariable* var, Array<Int64>& nb_page_per_node)
+{
+  ARCANE_CHECK_POINTER(var);
+  ConstMemoryView mem_view;
+  if (var->isUsed()) {
+    INumericDataInternal* nd = var->data()->_commonInternal()->numericData();
+    if (nd)
+      mem_view = nd->memoryView();
+  }
+  return MemoryUtils::computeNumaPagePlacement(mem_view, nb_page_per_node);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void VariableUtils::
 experimentalChangeAllocator(::Arcane::Materials::IMeshMaterialVariable* var,
                             eMemoryRessource mem)
@@ -68,6 +68,19 @@ void markVariableAsMostlyReadOnly(VariableRef& var);
 extern "C++" ARCANE_CORE_EXPORT
 void markVariableAsMostlyReadOnly(::Arcane::Materials::MeshMaterialVariableRef& var);
 
+/*!
+ * \brief Calcule le placement sur les noeuds NUMA de la mémoire de \a var.
+ *
+ * \a var doit être une variable d'un type numérique. En retour,
+ * \a nb_page_per_node contient pour chaque noeud NUMA le nombre de pages
+ * de la variable qui s'y trouvent.
+ *
+ * \return le nombre de pages dont le placement n'est pas connu.
+ * \sa MemoryUtils::computeNumaPagePlacement().
+ */
+extern "C++" ARCANE_CORE_EXPORT
+Int64 computeNumaPagePlacement(IVariable* var, Array<Int64>& nb_page_per_node);
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
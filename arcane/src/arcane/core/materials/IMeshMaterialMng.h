@@ -441,6 +441,39 @@ class ARCANE_CORE_EXPORT IMeshMaterialMng
   virtual void setUseMaterialValueWhenRemovingPartialValue(bool v) =0;
   virtual bool isUseMaterialValueWhenRemovingPartialValue() const =0;
 
+  /*!
+   * \brief Compacte les valeurs partielles des variables matériaux.
+   *
+   * Lors des suppressions de mailles matériaux ou milieux, les valeurs
+   * partielles ne sont pas réutilisées et les tableaux associés conservent
+   * leur taille maximale. Cette méthode renumérote les valeurs partielles
+   * de chaque milieu et matériau de manière contigüe, déplace les valeurs
+   * de toutes les variables en conséquence et libère la mémoire inutilisée.
+   *
+   * Les valeurs des variables sont conservées mais les MatVarIndex changent.
+   * Comme après une modification des matériaux, les vues et les
+   * ComponentItemVector créés avant cet appel ne sont plus valides.
+   *
+   * Retourne le nombre d'octets libérés.
+   */
+  virtual Int64 compactPartialValues() =0;
+
+  /*!
+   * \brief Positionne le seuil de compactage automatique des valeurs partielles.
+   *
+   * Si \a v est strictement positif, les valeurs partielles d'un milieu ou
+   * d'un matériau sont compactées à la fin d'une modification des matériaux
+   * lorsque la proportion de valeurs partielles inutilisées dépasse \a v.
+   * Par exemple, avec \a v valant 0.5, le compactage a lieu lorsque plus
+   * de la moitié des valeurs partielles ne sont plus utilisées.
+   * Si \a v vaut 0 (le défaut), il n'y a pas de compactage automatique.
+   *
+   * On peut aussi positionner cette valeur via la variable d'environnement
+   * ARCANE_MATERIALMNG_COMPACTION_RATIO.
+   */
+  virtual void setPartialValuesCompactionRatio(Real v) =0;
+  virtual Real partialValuesCompactionRatio() const =0;
+
  public:
 
   //!\internal
@@ -157,6 +157,44 @@ class ARCANE_CORE_EXPORT IMeshMaterialVariableInternal
 
   //! Redimensionne la valeur partielle associée à l'indexer \a index
   virtual void resizeForIndexer(Int32 index, RunQueue& queue) = 0;
+
+  /*!
+   * \brief Compacte la valeur partielle associée à l'indexer \a index.
+   *
+   * La valeur d'indice \a old_indexes[i] est déplacée à l'indice
+   * \a new_indexes[i]. Les valeurs de \a new_indexes doivent être
+   * comprises entre 0 et \a old_indexes.size(). Le tableau des valeurs
+   * partielles est ensuite redimensionné sans capacité additionnelle.
+   * \a buffer est utilisé comme tableau de travail et doit être accessible
+   * depuis \a queue.
+   *
+   * Retourne le nombre d'octets libérés.
+   */
+  virtual Int64 compactForIndexer(Int32 index, SmallSpan<const Int32> old_indexes,
+                                  SmallSpan<const Int32> new_indexes,
+                                  Array<std::byte>& buffer, RunQueue& queue) = 0;
+
+  /*!
+   * \brief Indique qu'on va lire les valeurs de la variable pour le
+   * constituant \a component.
+   *
+   * Si la variable possède une fonction de calcul, les valeurs de
+   * \a component qui ne sont plus à jour par rapport à leurs dépendances
+   * ou à la liste de leurs mailles sont recalculées. Si \a component est un
+   * milieu, ce sont ses matériaux qui sont mis à jour. Si \a component
+   * est nul, tous les matériaux sont concernés.
+   */
+  virtual void notifyBeginRead(IMeshComponent* component) = 0;
+
+  /*!
+   * \brief Indique que les valeurs de la variable pour le constituant
+   * \a component ont été modifiées.
+   *
+   * Les variables qui dépendent de celle-ci seront recalculées lors de
+   * leur prochaine lecture, uniquement pour les matériaux de \a component.
+   * Si \a component est nul, tous les matériaux sont concernés.
+   */
+  virtual void notifyValuesModified(IMeshComponent* component) = 0;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,157 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SampleSort.h                                                (C) 2000-2024 */
+/*                                                                           */
+/* Algorithme de tri parallèle par échantillonnage.                          */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_CORE_PARALLEL_SAMPLESORT_H
+#define ARCANE_CORE_PARALLEL_SAMPLESORT_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/TraceAccessor.h"
+#include "arcane/utils/UniqueArray.h"
+
+#include "arcane/core/IParallelSort.h"
+#include "arcane/core/parallel/BitonicSort.h"
+
+#include <limits>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Parallel
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Algorithme de tri parallèle par échantillonnage (sample sort).
+ *
+ * Cette classe fournit les mêmes fonctionnalités que BitonicSort et utilise
+ * les mêmes classes de caractéristiques (KeyTypeTraits) pour comparer
+ * les clés. Seule la méthode KeyTypeTraits::compareLess() est utilisée.
+ * Le type de la clé doit pouvoir être copié octet par octet.
+ *
+ * L'algorithme est le suivant:
+ * - chaque rang trie localement ses clés;
+ * - chaque rang choisit à intervalle régulier un échantillon de
+ *   nbSamplePerRank() clés. Les échantillons de tous les rangs sont
+ *   récupérés par tous les rangs et permettent de calculer les
+ *   clés séparatrices entre les rangs. Chaque échantillon est pondéré
+ *   par le nombre de clés du rang dont il est issu;
+ * - les clés sont envoyées aux rangs destinataires via une opération
+ *   de type 'allToAllVariable'. Cette opération est découpée en plusieurs
+ *   étapes si le nombre d'octets à échanger dépasse maxMessageSize();
+ * - chaque rang fusionne les listes triées reçues.
+ *
+ * Contrairement à BitonicSort, le nombre de messages ne dépend pas
+ * du logarithme du nombre de rangs et chaque clé n'est envoyée qu'une
+ * seule fois.
+ *
+ * Après le tri, les clés sont dans l'ordre croissant en commençant par
+ * le rang 0. Le nombre de clés par rang est à peu près équilibré. Si
+ * certains rangs n'ont pas de clés, il s'agit toujours des rangs
+ * de plus grand numéro. A clés égales, l'ordre est celui du rang puis
+ * de l'indice d'origine.
+ */
+template <typename KeyType, typename KeyTypeTraits = BitonicSortDefaultTraits<KeyType>>
+class SampleSort
+: public TraceAccessor
+, public IParallelSort<KeyType>
+{
+ public:
+
+  explicit SampleSort(IParallelMng* parallel_mng);
+
+ public:
+
+  /*!
+   * \brief Trie en parallèle les éléments de \a keys sur tous les rangs.
+   *
+   * Cette opération est collective.
+   */
+  void sort(ConstArrayView<KeyType> keys) override;
+
+  //! Après un tri, retourne la liste des éléments de ce rang.
+  ConstArrayView<KeyType> keys() const override { return m_keys; }
+
+  //! Après un tri, retourne le tableau des rangs d'origine des éléments de keys().
+  Int32ConstArrayView keyRanks() const override { return m_key_ranks; }
+
+  //! Après un tri, retourne le tableau des indices dans la liste d'origine des éléments de keys().
+  Int32ConstArrayView keyIndexes() const override { return m_key_indexes; }
+
+ public:
+
+  //! Indique si on souhaite récupérer les rangs et indices d'origine des clés.
+  void setNeedIndexAndRank(bool want_index_and_rank)
+  {
+    m_want_index_and_rank = want_index_and_rank;
+  }
+
+  /*!
+   * \brief Positionne le nombre d'échantillons par rang.
+   *
+   * Augmenter ce nombre améliore l'équilibrage du nombre de clés
+   * par rang après le tri mais augmente la taille des échantillons
+   * échangés.
+   */
+  void setNbSamplePerRank(Int32 v) { m_nb_sample_per_rank = math::max(v, 1); }
+  Int32 nbSamplePerRank() const { return m_nb_sample_per_rank; }
+
+  /*!
+   * \brief Positionne le nombre maximum d'octets envoyés ou reçus par
+   * un rang lors d'une étape de l'échange des clés.
+   *
+   * La valeur par défaut est la plus grande taille possible pour un message
+   * de 'allToAllVariable'. Cette valeur doit être la même sur tous les rangs.
+   */
+  void setMaxMessageSize(Int64 v)
+  {
+    m_max_message_size = math::min(math::max(v, static_cast<Int64>(1)), static_cast<Int64>(std::numeric_limits<Int32>::max()));
+  }
+  Int64 maxMessageSize() const { return m_max_message_size; }
+
+ private:
+
+  //! Clés triées de ce rang
+  UniqueArray<KeyType> m_keys;
+  //! Tableau contenant le rang du processeur d'origine de la clé
+  UniqueArray<Int32> m_key_ranks;
+  //! Tableau contenant l'indice de la clé dans le processeur d'origine
+  UniqueArray<Int32> m_key_indexes;
+  //! Gestionnaire du parallèlisme
+  IParallelMng* m_parallel_mng = nullptr;
+  //! Indique si on souhaite les infos sur les rangs et index
+  bool m_want_index_and_rank = true;
+  //! Nombre d'échantillons par rang
+  Int32 m_nb_sample_per_rank = 32;
+  //! Nombre maximum d'octets échangés par un rang lors d'une étape
+  Int64 m_max_message_size = std::numeric_limits<Int32>::max();
+
+ private:
+
+  void _exchangeKeys(ConstArrayView<KeyType> sorted_keys,
+                     Int32ConstArrayView send_counts, Int32ConstArrayView send_indexes,
+                     Int32ConstArrayView recv_counts, Int32ConstArrayView recv_indexes,
+                     ArrayView<KeyType> recv_keys);
+  void _computeSplitters(ConstArrayView<KeyType> sorted_keys, Array<KeyType>& splitters);
+  void _merge(ConstArrayView<KeyType> recv_keys, ConstArrayView<Int32> recv_key_indexes,
+              Int32ConstArrayView recv_counts, Int32ConstArrayView recv_indexes);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::Parallel
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -19,6 +19,8 @@
 #include "arcane/utils/Convert.h"
 #include "arcane/utils/Array.h"
 #include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/internal/TimelineRecorder.h"
 
 #include "arcane/core/IParallelMng.h"
 #include "arcane/core/Properties.h"
@@ -148,6 +150,14 @@ void Stat::
 add(const String& name, double elapsed_time, Int64 msg_size)
 {
   Arccore::MessagePassing::Stat::add(name, elapsed_time, msg_size);
+  // Cette méthode est appelée à la fin de l'opération. On en déduit le
+  // temps de début à partir du temps écoulé.
+  if (impl::TimelineRecorder::isEnabled()) {
+    Int64 end_time = platform::getRealTimeNS();
+    Int64 begin_time = end_time - static_cast<Int64>(elapsed_time * 1.0e9);
+    impl::TimelineRecorder::addEvent(impl::TimelineRecorder::eCategory::MessagePassing,
+                                     name, begin_time, end_time);
+  }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -235,6 +235,7 @@ set(ARCANE_ORIGINAL_SOURCES
   IPhysicalUnitConverter.h
   IPhysicalUnitSystem.h
   IPhysicalUnitSystemService.h
+  IPointLocator.h
   IProperty.h
   IPropertyMng.h
   IRandomNumberGenerator.h
@@ -399,6 +400,8 @@ set(ARCANE_ORIGINAL_SOURCES
   BasicUnitTest.h
   BlockIndexList.h
   BlockIndexList.cc
+  BoundingVolumeHierarchy.h
+  BoundingVolumeHierarchy.cc
   CartesianGridDimension.h
   CartesianGridDimension.cc
   CartesianMeshAllocateBuildInfo.h
@@ -440,6 +443,8 @@ set(ARCANE_ORIGINAL_SOURCES
   CaseTable.h
   CaseTableParams.cc
   CaseTableParams.h
+  CaseTableView.h
+  CellParticleIndexView.h
   CheckpointInfo.cc
   CheckpointInfo.h
   CheckpointService.cc
@@ -746,6 +751,8 @@ set(ARCANE_ORIGINAL_SOURCES
   parallel/IRequestList.h
   parallel/IStat.h
   parallel/MultiReduce.cc
+  parallel/SampleSort.h
+  parallel/SampleSortT.H
   parallel/Stat.cc
   parallel/VariableParallelOperationBase.cc
   parallel/VariableParallelOperationBase.h
@@ -0,0 +1,308 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "arcane/utils/Real3.h"
+#include "arcane/utils/UniqueArray.h"
+
+#include "arcane/core/BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+using namespace Arcane;
+
+namespace
+{
+using Node = BoundingVolumeHierarchy::Node;
+
+// Génère \a n petites boîtes aléatoires dans le cube unité.
+void _generateBoxes(Int32 n, UniqueArray<Real3>& items_min, UniqueArray<Real3>& items_max)
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<Real> pos_dist(0.0, 1.0);
+  std::uniform_real_distribution<Real> size_dist(0.001, 0.02);
+  items_min.resize(n);
+  items_max.resize(n);
+  for (Int32 i = 0; i < n; ++i) {
+    Real3 p(pos_dist(gen), pos_dist(gen), pos_dist(gen));
+    Real3 s(size_dist(gen), size_dist(gen), size_dist(gen));
+    items_min[i] = p - s;
+    items_max[i] = p + s;
+  }
+}
+
+bool _contains(const Node& node, Real3 b_min, Real3 b_max)
+{
+  return (b_min.x >= node.m_min.x && b_min.y >= node.m_min.y && b_min.z >= node.m_min.z &&
+          b_max.x <= node.m_max.x && b_max.y <= node.m_max.y && b_max.z <= node.m_max.z);
+}
+
+// Vérifie la cohérence de l'arbre.
+void _checkTree(const BoundingVolumeHierarchy& bvh, ConstArrayView<Real3> items_min,
+                ConstArrayView<Real3> items_max)
+{
+  const Int32 n = items_min.size();
+  ConstArrayView<Node> nodes = bvh.nodes();
+  ConstArrayView<Int32> indexes = bvh.itemIndexes();
+  ASSERT_EQ(bvh.nbItem(), n);
+  ASSERT_FALSE(nodes.empty());
+
+  // Chaque objet apparait dans exactement une feuille.
+  std::vector<Int32> nb_ref(n, 0);
+  std::vector<bool> is_referenced(nodes.size(), false);
+  is_referenced[0] = true;
+  for (Int32 i = 0, nb_node = nodes.size(); i < nb_node; ++i) {
+    const Node& node = nodes[i];
+    ASSERT_TRUE(is_referenced[i]) << "Node " << i << " is not referenced";
+    if (node.isLeaf()) {
+      ASSERT_LE(node.m_first + node.m_nb_item, n);
+      for (Int32 k = node.m_first; k < node.m_first + node.m_nb_item; ++k) {
+        Int32 index = indexes[k];
+        ++nb_ref[index];
+        ASSERT_TRUE(_contains(node, items_min[index], items_max[index])) << "node=" << i << " item=" << index;
+      }
+      continue;
+    }
+    // Les fils ont un indice supérieur à celui du père et sont contenus dedans.
+    ASSERT_GT(node.m_first, i);
+    ASSERT_LT(node.m_first + 1, nb_node);
+    for (Int32 c = node.m_first; c <= node.m_first + 1; ++c) {
+      ASSERT_FALSE(is_referenced[c]) << "Node " << c << " has several parents";
+      is_referenced[c] = true;
+      ASSERT_TRUE(_contains(node, nodes[c].m_min, nodes[c].m_max)) << "node=" << i << " child=" << c;
+    }
+  }
+  for (Int32 i = 0; i < n; ++i)
+    ASSERT_EQ(nb_ref[i], 1) << "item=" << i;
+}
+
+// Retourne pour chaque feuille la liste triée de ses objets.
+std::set<std::vector<Int32>> _leaves(const BoundingVolumeHierarchy& bvh)
+{
+  std::set<std::vector<Int32>> leaves;
+  ConstArrayView<Int32> indexes = bvh.itemIndexes();
+  for (const Node& node : bvh.nodes()) {
+    if (!node.isLeaf())
+      continue;
+    std::vector<Int32> v(indexes.begin() + node.m_first, indexes.begin() + node.m_first + node.m_nb_item);
+    std::sort(v.begin(), v.end());
+    leaves.insert(v);
+  }
+  return leaves;
+}
+
+bool _isInside(Real3 b_min, Real3 b_max, Real3 p)
+{
+  return (p.x >= b_min.x && p.x <= b_max.x && p.y >= b_min.y && p.y <= b_max.y &&
+          p.z >= b_min.z && p.z <= b_max.z);
+}
+
+// Distance d'entrée du rayon dans la boîte ou (-1) s'il n'y a pas d'intersection.
+Real _rayBoxDistance(Real3 b_min, Real3 b_max, Real3 origin, Real3 direction)
+{
+  Real t_min = 0.0;
+  Real t_max = std::numeric_limits<Real>::max();
+  for (Integer axis = 0; axis < 3; ++axis) {
+    Real o = origin[axis];
+    Real d = direction[axis];
+    if (d == 0.0) {
+      if (o < b_min[axis] || o > b_max[axis])
+        return -1.0;
+      continue;
+    }
+    Real t0 = (b_min[axis] - o) / d;
+    Real t1 = (b_max[axis] - o) / d;
+    if (t0 > t1)
+      std::swap(t0, t1);
+    t_min = std::max(t_min, t0);
+    t_max = std::min(t_max, t1);
+    if (t_min > t_max)
+      return -1.0;
+  }
+  return t_min;
+}
+
+// Compare les requêtes avec un parcours de tous les objets.
+void _checkQueries(const BoundingVolumeHierarchy& bvh, ConstArrayView<Real3> items_min,
+                   ConstArrayView<Real3> items_max)
+{
+  const Int32 n = items_min.size();
+  std::mt19937 gen(17);
+  std::uniform_real_distribution<Real> dist(-0.1, 1.1);
+  std::uniform_real_distribution<Real> dir_dist(-1.0, 1.0);
+  const Int32 nb_query = 200;
+
+  // Recherche des objets contenant un point.
+  for (Int32 q = 0; q < nb_query; ++q) {
+    Real3 p(dist(gen), dist(gen), dist(gen));
+    std::set<Int32> expected;
+    for (Int32 i = 0; i < n; ++i)
+      if (_isInside(items_min[i], items_max[i], p))
+        expected.insert(i);
+    std::set<Int32> found;
+    bvh.visitPoint(p, [&](Int32 index) {
+      if (_isInside(items_min[index], items_max[index], p))
+        found.insert(index);
+      return false;
+    });
+    ASSERT_EQ(found, expected) << "point=" << p;
+  }
+
+  // Recherche de la boîte la plus proche le long d'un rayon.
+  Int32 nb_hit = 0;
+  for (Int32 q = 0; q < nb_query; ++q) {
+    Real3 origin(dist(gen), dist(gen), dist(gen));
+    Real3 direction(dir_dist(gen), dir_dist(gen), dir_dist(gen));
+    // Un rayon sur quatre est parallèle à un axe.
+    if ((q % 4) == 0)
+      direction = Real3(0.0, (q % 8) == 0 ? 1.0 : -1.0, 0.0);
+    Real expected_distance = -1.0;
+    for (Int32 i = 0; i < n; ++i) {
+      Real d = _rayBoxDistance(items_min[i], items_max[i], origin, direction);
+      if (d >= 0.0 && (expected_distance < 0.0 || d < expected_distance))
+        expected_distance = d;
+    }
+    Real found_distance = -1.0;
+    Real max_distance = std::numeric_limits<Real>::max();
+    bvh.visitRay(origin, direction, max_distance, [&](Int32 index, Real& current_max_distance) {
+      Real d = _rayBoxDistance(items_min[index], items_max[index], origin, direction);
+      if (d >= 0.0 && (found_distance < 0.0 || d < found_distance)) {
+        found_distance = d;
+        current_max_distance = d;
+      }
+    });
+    ASSERT_EQ(found_distance < 0.0, expected_distance < 0.0) << "origin=" << origin << " direction=" << direction;
+    ASSERT_NEAR(found_distance, expected_distance, 1.0e-12) << "origin=" << origin << " direction=" << direction;
+    if (expected_distance >= 0.0)
+      ++nb_hit;
+  }
+  // S'assure que le test n'est pas trivial.
+  ASSERT_GT(nb_hit, 0);
+}
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(TestBoundingVolumeHierarchy, Empty)
+{
+  BoundingVolumeHierarchy bvh;
+  UniqueArray<Real3> items_min;
+  UniqueArray<Real3> items_max;
+  bvh.build(items_min, items_max);
+  ASSERT_EQ(bvh.nbItem(), 0);
+  ASSERT_TRUE(bvh.nodes().empty());
+  Real max_distance = 1.0;
+  Int32 nb_visited = 0;
+  bvh.visitRay(Real3(), Real3(1.0, 0.0, 0.0), max_distance, [&](Int32, Real&) { ++nb_visited; });
+  bvh.visitPoint(Real3(), [&](Int32) { ++nb_visited; return false; });
+  ASSERT_EQ(nb_visited, 0);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(TestBoundingVolumeHierarchy, BuildAndQuery)
+{
+  UniqueArray<Real3> items_min;
+  UniqueArray<Real3> items_max;
+  _generateBoxes(2000, items_min, items_max);
+  BoundingVolumeHierarchy bvh;
+  bvh.build(items_min, items_max);
+  _checkTree(bvh, items_min, items_max);
+  ASSERT_GT(bvh.nodes().size(), 1);
+  _checkQueries(bvh, items_min, items_max);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(TestBoundingVolumeHierarchy, SameCentroid)
+{
+  // Toutes les boîtes ont le même centre: la découpe se fait au milieu.
+  const Int32 n = 100;
+  UniqueArray<Real3> items_min(n);
+  UniqueArray<Real3> items_max(n);
+  for (Int32 i = 0; i < n; ++i) {
+    Real s = 0.01 * (i + 1);
+    items_min[i] = Real3(-s, -s, -s);
+    items_max[i] = Real3(s, s, s);
+  }
+  BoundingVolumeHierarchy bvh;
+  bvh.build(items_min, items_max);
+  _checkTree(bvh, items_min, items_max);
+  _checkQueries(bvh, items_min, items_max);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(TestBoundingVolumeHierarchy, ParallelBuild)
+{
+  // Force la construction par sous-arbres et vérifie que la fusion donne
+  // les mêmes feuilles que la construction en une seule fois.
+  UniqueArray<Real3> items_min;
+  UniqueArray<Real3> items_max;
+  _generateBoxes(5000, items_min, items_max);
+
+  BoundingVolumeHierarchy bvh_ref;
+  bvh_ref.setMinParallelBuildSize(std::numeric_limits<Int32>::max() / 2);
+  bvh_ref.build(items_min, items_max);
+  _checkTree(bvh_ref, items_min, items_max);
+
+  for (Int32 min_size : { 16, 100, 1000 }) {
+    BoundingVolumeHierarchy bvh;
+    bvh.setMinParallelBuildSize(min_size);
+    bvh.build(items_min, items_max);
+    _checkTree(bvh, items_min, items_max);
+    ASSERT_EQ(bvh.nodes().size(), bvh_ref.nodes().size()) << "min_size=" << min_size;
+    ASSERT_EQ(_leaves(bvh), _leaves(bvh_ref)) << "min_size=" << min_size;
+    _checkQueries(bvh, items_min, items_max);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(TestBoundingVolumeHierarchy, Refit)
+{
+  UniqueArray<Real3> items_min;
+  UniqueArray<Real3> items_max;
+  _generateBoxes(3000, items_min, items_max);
+  BoundingVolumeHierarchy bvh;
+  bvh.setMinParallelBuildSize(500);
+  bvh.build(items_min, items_max);
+  auto leaves = _leaves(bvh);
+
+  // Déplace et déforme les boîtes puis met à jour l'arbre.
+  for (Int32 i = 0, n = items_min.size(); i < n; ++i) {
+    Real3 shift(0.3 * items_min[i].y, -0.2, 0.1 * items_min[i].x);
+    items_min[i] = items_min[i] * 1.5 + shift;
+    items_max[i] = items_max[i] * 1.5 + shift;
+  }
+  bvh.refit(items_min, items_max);
+  _checkTree(bvh, items_min, items_max);
+  // La structure n'est pas modifiée.
+  ASSERT_EQ(_leaves(bvh), leaves);
+  _checkQueries(bvh, items_min, items_max);
+
+  // Le nombre d'objets doit être le même.
+  items_min.resize(10);
+  items_max.resize(10);
+  ASSERT_ANY_THROW(bvh.refit(items_min, items_max));
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
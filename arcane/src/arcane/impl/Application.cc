@@ -34,6 +34,10 @@
 #include "arcane/utils/ITraceMngPolicy.h"
 #include "arcane/utils/JSONReader.h"
 #include "arcane/utils/Profiling.h"
+#include "arcane/utils/ParallelLoopTuner.h"
+#include "arcane/utils/MemoryUtils.h"
+#include "arcane/utils/internal/NumaMemoryAllocator.h"
+#include "arcane/utils/internal/ProfilingInternal.h"
 
 #include "arcane/core/ArcaneVersion.h"
 #include "arcane/core/ISubDomain.h"
@@ -415,9 +419,30 @@ build()
         TaskFactory::setVerboseLevel(v.value());
     }
 
+    // Positionne si demandé l'allocateur hôte tenant compte des noeuds NUMA.
+    // Cela doit être fait après l'initialisation des tâches car cet
+    // allocateur les utilise pour initialiser les pages.
+    if (NumaMemoryAllocator::installFromEnvironment())
+      m_trace->info() << "Using NUMA aware host memory allocator policy="
+                      << platform::getEnvironmentVariable("ARCANE_NUMA_POLICY")
+                      << " nb_numa_node=" << MemoryUtils::getNbNumaNode();
+
     if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_LOOP_PROFILING_LEVEL",true))
       ProfilingRegistry::setProfilingLevel(v.value());
 
+    // Ajustement automatique des boucles parallèles.
+    {
+      if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_LOOP_AUTOTUNE_NB_TRIAL",true))
+        ParallelLoopTuner::setNbTrial(v.value());
+      if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_LOOP_AUTOTUNE",true))
+        ParallelLoopTuner::setEnabled(v.value()>0);
+      String tuning_file = platform::getEnvironmentVariable("ARCANE_LOOP_TUNING_FILE");
+      if (!tuning_file.null()){
+        m_trace->info() << "Reading parallel loop tuning from file '" << tuning_file << "'";
+        ParallelLoopTuner::importTuning(tuning_file);
+      }
+    }
+
     // Recherche le service utilisé pour le profiling
     {
       String profile_str = platform::getEnvironmentVariable("ARCANE_PROFILING");
@@ -743,6 +768,34 @@ initialize()
     }
   }
 
+  // Active si demandé la lecture des compteurs matériels autour des points
+  // d'entrée et des boucles profilées. L'activation ne dépend que de la
+  // variable d'environnement pour que tous les rangs aient le même comportement
+  // lors de l'affichage des statistiques.
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_HARDWARE_COUNTERS",true)){
+    if (v.value()!=0){
+      impl::HardwareCounterStat::setEnabled(true);
+      auto p = m_performance_counter_service;
+      if (p.get()){
+        // Les compteurs peuvent ne pas être accessibles (par exemple à cause
+        // des droits du processus). Dans ce cas on continue sans eux.
+        try{
+          if (!p->isStarted()){
+            p->initialize();
+            p->start();
+          }
+          platform::setPerformanceCounterService(p.get());
+          m_trace->info() << "Hardware counters are enabled for entry points and loops";
+        }
+        catch(const Exception& ex){
+          m_trace->info() << "WARNING: hardware counters are not available: " << ex.message();
+        }
+      }
+      else
+        m_trace->info() << "WARNING: hardware counters are not available because no performance counter service is available.";
+    }
+  }
+
   m_trace->info() << "sizeof(ItemInternal)=" << sizeof(ItemInternal)
                   << " sizeof(ItemInternalConnectivityList)=" << sizeof(ItemInternalConnectivityList)
                   << " sizeof(ItemSharedInfo)=" << sizeof(ItemSharedInfo);
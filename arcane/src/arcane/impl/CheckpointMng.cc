@@ -20,6 +20,7 @@
 #include "arcane/utils/Array.h"
 #include "arcane/utils/NotImplementedException.h"
 #include "arcane/utils/ITraceMng.h"
+#include "arcane/utils/internal/TimelineRecorder.h"
 
 #include "arcane/Directory.h"
 #include "arcane/ICheckpointMng.h"
@@ -173,6 +174,7 @@ readCheckpoint()
 void CheckpointMng::
 readCheckpoint(ICheckpointReader* reader)
 {
+  impl::TimelineRecorder::ScopedEvent timeline_event(impl::TimelineRecorder::eCategory::Checkpoint, "ReadCheckpoint");
   m_sub_domain->variableMng()->readCheckpoint(reader);
   m_read_observable->notifyAllObservers();
 }
@@ -183,6 +185,7 @@ readCheckpoint(ICheckpointReader* reader)
 void CheckpointMng::
 _readCheckpoint(const CheckpointReadInfo& infos)
 {
+  impl::TimelineRecorder::ScopedEvent timeline_event(impl::TimelineRecorder::eCategory::Checkpoint, "ReadCheckpoint");
   m_sub_domain->variableMng()->readCheckpoint(infos);
   m_read_observable->notifyAllObservers();
 }
@@ -414,6 +417,7 @@ writeDefaultCheckpoint(ICheckpointWriter* writer)
 void CheckpointMng::
 writeCheckpoint(ICheckpointWriter* writer,ByteArray& infos)
 {
+  impl::TimelineRecorder::ScopedEvent timeline_event(impl::TimelineRecorder::eCategory::Checkpoint, "WriteCheckpoint");
   m_write_observable->notifyAllObservers();
   m_sub_domain->variableMng()->writeCheckpoint(writer);
   _writeCheckpointInfoFile(writer,infos);
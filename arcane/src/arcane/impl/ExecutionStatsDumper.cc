@@ -17,6 +17,7 @@
 #include "arcane/utils/OStringStream.h"
 #include "arcane/utils/IMemoryInfo.h"
 #include "arcane/utils/Profiling.h"
+#include "arcane/utils/ParallelLoopTuner.h"
 #include "arcane/utils/ITraceMng.h"
 #include "arcane/utils/JSONWriter.h"
 #include "arcane/utils/FloatingPointExceptionSentry.h"
@@ -63,6 +64,15 @@ _dumpProfilingJSON(JSONWriter& json_writer)
       json_writer.write("TotalTime", s.execTime());
       json_writer.write("NbLoop", s.nbCall());
       json_writer.write("NbChunk", s.nbChunk());
+      const impl::HardwareCounterStat& hw = s.hardwareCounterStat();
+      if (hw.nbSample() > 0) {
+        JSONWriter::Object jo3(json_writer, "HardwareCounters");
+        json_writer.write("NbCycle", hw.nbCycle());
+        json_writer.write("NbInstruction", hw.nbInstruction());
+        json_writer.write("NbCacheMiss", hw.nbCacheMiss());
+        json_writer.write("IPC", hw.instructionPerCycle());
+        json_writer.write("BytePerCycle", hw.bytePerCycle());
+      }
     }
     json_writer.endArray();
   };
@@ -171,10 +181,15 @@ _dumpOneLoopListStat(std::ostream& o, const impl::ForLoopStatInfoList& stat_list
     cumulative_total += s.execTime();
   }
 
+  // Affiche les compteurs matériels s'ils sont disponibles.
+  const bool has_hw_counters = impl::HardwareCounterStat::isEnabled();
+
   o << "ProfilingStat\n";
   o << std::setw(10) << "Ncall" << std::setw(10) << "Nchunk"
-    << std::setw(11) << " T (ms)" << std::setw(10) << "Tck (ns)"
-    << "     %  name\n";
+    << std::setw(11) << " T (ms)" << std::setw(10) << "Tck (ns)";
+  if (has_hw_counters)
+    o << std::setw(7) << "IPC" << std::setw(7) << "B/C";
+  o << "     %  name\n";
 
   char old_filler = o.fill();
   for (const auto& x : sorted_set) {
@@ -193,8 +208,16 @@ _dumpOneLoopListStat(std::ostream& o, const impl::ForLoopStatInfoList& stat_list
     o << std::setw(10) << nb_loop << std::setw(10) << nb_chunk
       << std::setw(7) << total_time_ms << ".";
     o << std::setfill('0') << std::setw(3) << total_time_remaining_us << std::setfill(old_filler);
-    o << std::setw(10) << time_per_chunk
-      << std::setw(4) << percent << "." << percent_digit << "  " << x.m_name << "\n";
+    o << std::setw(10) << time_per_chunk;
+    if (has_hw_counters) {
+      const impl::HardwareCounterStat& hw = s.hardwareCounterStat();
+      std::ios_base::fmtflags old_flags = o.flags();
+      std::streamsize old_precision = o.precision(2);
+      o << std::fixed << std::setw(7) << hw.instructionPerCycle() << std::setw(7) << hw.bytePerCycle();
+      o.flags(old_flags);
+      o.precision(old_precision);
+    }
+    o << std::setw(4) << percent << "." << percent_digit << "  " << x.m_name << "\n";
   }
   o << "TOTAL=" << cumulative_total / 1000000 << "\n";
 }
@@ -301,6 +324,18 @@ dumpStats(ISubDomain* sd, ITimeStats* time_stat)
         _dumpProfilingJSON("loop_profiling.json");
     }
   }
+  // Sauvegarde les options retenues pour les boucles parallèles.
+  // Le fichier peut être relu via la variable d'environnement 'ARCANE_LOOP_TUNING_FILE'.
+  if (ParallelLoopTuner::isEnabled() && ParallelLoopTuner::nbTunedSite() > 0) {
+    String filename = "loop_tuning.json";
+    if (sd) {
+      Directory dir = sd->listingDirectory();
+      filename = dir.file(String::format("loop_tuning.{0}.json", sd->parallelMng()->commRank()));
+    }
+    info() << "Saving parallel loop tuning (nb_site=" << ParallelLoopTuner::nbTunedSite()
+           << ") in file '" << filename << "'";
+    ParallelLoopTuner::exportTuning(filename);
+  }
   {
     bool use_elapsed_time = true;
     if (!platform::getEnvironmentVariable("ARCANE_USE_REAL_TIMER").null())
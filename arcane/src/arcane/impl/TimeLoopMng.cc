@@ -26,6 +26,7 @@
 #include "arcane/utils/OStringStream.h"
 #include "arcane/utils/FloatingPointExceptionSentry.h"
 #include "arcane/utils/JSONWriter.h"
+#include "arcane/utils/internal/ProfilingInternal.h"
 
 #include "arcane/core/IApplication.h"
 #include "arcane/core/IServiceLoader.h"
@@ -78,9 +79,11 @@
 #include "arcane/accelerator/core/Runner.h"
 
 #include "arcane/impl/DefaultBackwardMng.h"
+#include "arcane/impl/internal/LoadImbalanceReport.h"
 
 #include <algorithm>
 #include <map>
+#include <iomanip>
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -304,10 +307,17 @@ class TimeLoopMng
   //! Pour test, point d'entrée spécifique à appeler
   String m_specific_entry_point_name;
 
+  //! Compteurs matériels cumulés pour chaque point d'entrée
+  std::map<IEntryPoint*, impl::HardwareCounterStat> m_entry_point_hardware_counters;
+
+  //! Rapport périodique sur le déséquilibre de charge (nul si non actif)
+  std::unique_ptr<LoadImbalanceReport> m_load_imbalance_report;
+
  private:
 
   void _execOneEntryPoint(IEntryPoint* ic, Integer index_value = 0, bool do_verif = false);
   void _dumpTimeInfos(JSONWriter& json_writer);
+  void _dumpHardwareCounters(JSONWriter& json_writer, EntryPointCollection entry_points, Integer nb_cell);
   void _resetTimer() const;
   void _checkVerif(const String& entry_point_name,Integer index,bool do_verif);
   void _checkVerifSameOnAllReplica(const String& entry_point_name);
@@ -475,11 +485,25 @@ build()
         service_name = "JsonMessagePassingProfiling";
       } else if (msg_pass_prof_str == "OTF2") {
 		    service_name = "Otf2MessagePassingProfiling";
+      } else if (msg_pass_prof_str == "TIMELINE") {
+        service_name = "TimelineProfiling";
       }
       ServiceBuilder<IMessagePassingProfilingService> srv(this->subDomain());
       m_msg_pass_prof_srv = srv.createReference(service_name ,SB_AllowNull);
     }
   }
+
+  // Création du rapport périodique sur le déséquilibre de charge le cas échéant
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_LOAD_IMBALANCE_REPORT_PERIOD",true)){
+    if (v.value()>0){
+      m_load_imbalance_report = std::make_unique<LoadImbalanceReport>(subDomain());
+      m_load_imbalance_report->setPeriod(v.value());
+      if (auto v2 = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_LOAD_IMBALANCE_CELL_COST",true))
+        m_load_imbalance_report->setExportCellCost(v2.value()!=0);
+      m_load_imbalance_report->initialize();
+      info() << "Load imbalance report every " << v.value() << " iterations";
+    }
+  }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -625,6 +649,15 @@ execExitEntryPoints()
     std::ofstream file(fullname.localstr());
     m_msg_pass_prof_srv->printInfos(file);
   }
+
+  // Affiche la trace temporelle au format 'Trace Event' de Chrome
+  if (m_msg_pass_prof_srv.get() && m_msg_pass_prof_srv->implName() == "TimelineProfiling") {
+    String fullname(subDomain()->listingDirectory().file("timeline.")
+                    + String(std::to_string(subDomain()->subDomainId()))
+                    + String(".json"));
+    std::ofstream file(fullname.localstr());
+    m_msg_pass_prof_srv->printInfos(file);
+  }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -635,7 +668,17 @@ _execOneEntryPoint(IEntryPoint * ic, Integer index, bool do_verif)
 {
   m_current_entry_point_ptr = ic;
   m_observables[eTimeLoopEventType::BeginEntryPoint]->notifyAllObservers();
-  ic->executeEntryPoint();
+  if (impl::HardwareCounterStat::isEnabled()) {
+    impl::HardwareCounterStat::CounterValues begin_values;
+    impl::HardwareCounterStat::CounterValues end_values;
+    impl::HardwareCounterStat::readCounters(begin_values);
+    ic->executeEntryPoint();
+    impl::HardwareCounterStat::readCounters(end_values);
+    impl::HardwareCounterStat::substract(begin_values, end_values);
+    m_entry_point_hardware_counters[ic].add(end_values);
+  }
+  else
+    ic->executeEntryPoint();
   m_observables[eTimeLoopEventType::EndEntryPoint]->notifyAllObservers();
   m_current_entry_point_ptr = nullptr;
   if (m_verification_at_entry_point && !m_verification_only_at_exit)
@@ -946,6 +989,9 @@ doOneIteration()
   }
   m_observables[eTimeLoopEventType::EndIteration]->notifyAllObservers();
 
+  if (m_load_imbalance_report)
+    m_load_imbalance_report->notifyEndIteration(current_iteration, m_loop_entry_points);
+
   {
     bool force_prepare_dump = false;
     if (m_verification_active && m_verif_type==VerifWrite){
@@ -1621,6 +1667,9 @@ _dumpTimeInfos(JSONWriter& json_writer)
 
   info() << o.str();
 
+  if (impl::HardwareCounterStat::isEnabled())
+    _dumpHardwareCounters(json_writer, entry_points, nb_cell);
+
   {
     IParallelMng* pm = m_sub_domain->parallelMng();
     if (pm->isParallel()){
@@ -1651,6 +1700,100 @@ _dumpTimeInfos(JSONWriter& json_writer)
   Item::dumpStats(traceMng());
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Affiche les statistiques des compteurs matériels des points d'entrée.
+ *
+ * Pour chaque point d'entrée, on calcule le nombre d'instructions par cycle,
+ * une estimation du nombre d'octets lus en mémoire par cycle et le nombre
+ * de défauts de cache par appel et par maille. Ces valeurs sont agrégées
+ * (minimum, moyenne, maximum) sur l'ensemble des sous-domaines.
+ *
+ * Cette méthode est collective.
+ */
+void TimeLoopMng::
+_dumpHardwareCounters(JSONWriter& json_writer, EntryPointCollection entry_points, Integer nb_cell)
+{
+  IParallelMng* pm = m_sub_domain->parallelMng();
+  const Int32 nb_rank = pm->commSize();
+  const Integer nb_value = 3;
+
+  UniqueArray<IEntryPoint*> ep_list;
+  for (EntryPointCollection::Enumerator i(entry_points); ++i;)
+    ep_list.add(*i);
+  const Integer nb_ep = ep_list.size();
+
+  UniqueArray<Real> values(nb_ep * nb_value);
+  for (Integer i = 0; i < nb_ep; ++i) {
+    IEntryPoint* ep = ep_list[i];
+    const impl::HardwareCounterStat& s = m_entry_point_hardware_counters[ep];
+    // Un point d'entrée peut ne jamais avoir été appelé et le maillage être vide.
+    const Int64 nb_call_cell = static_cast<Int64>(ep->nbCall()) * nb_cell;
+    values[i * nb_value + 0] = s.instructionPerCycle();
+    values[i * nb_value + 1] = s.bytePerCycle();
+    values[i * nb_value + 2] = (nb_call_cell > 0) ? static_cast<Real>(s.nbCacheMiss()) / static_cast<Real>(nb_call_cell) : 0.0;
+  }
+  UniqueArray<Real> min_values(values.size());
+  UniqueArray<Real> max_values(values.size());
+  UniqueArray<Real> sum_values(values.size());
+  UniqueArray<Int32> min_ranks(values.size());
+  UniqueArray<Int32> max_ranks(values.size());
+  pm->computeMinMaxSum(values, min_values, max_values, sum_values, min_ranks, max_ranks);
+
+  json_writer.writeKey("EntryPointHardwareCounters");
+  json_writer.beginArray();
+  for (Integer i = 0; i < nb_ep; ++i) {
+    IEntryPoint* ep = ep_list[i];
+    const impl::HardwareCounterStat& s = m_entry_point_hardware_counters[ep];
+    JSONWriter::Object jo(json_writer);
+    json_writer.write("Name", ep->name());
+    json_writer.write("NbCycle", s.nbCycle());
+    json_writer.write("NbInstruction", s.nbInstruction());
+    json_writer.write("NbCacheMiss", s.nbCacheMiss());
+    const char* names[3] = { "IPC", "BytePerCycle", "CacheMissPerCell" };
+    for (Integer k = 0; k < nb_value; ++k) {
+      Integer idx = i * nb_value + k;
+      JSONWriter::Object jo2(json_writer, names[k]);
+      json_writer.write("Local", values[idx]);
+      json_writer.write("Min", min_values[idx]);
+      json_writer.write("Max", max_values[idx]);
+      json_writer.write("Avg", sum_values[idx] / nb_rank);
+    }
+  }
+  json_writer.endArray();
+
+  info() << "Hardware counters for entry points (min/avg/max over sub-domains)";
+  info() << " IPC  = Number of instructions per cycle";
+  info() << " B/C  = Estimated number of bytes read from memory per cycle";
+  info() << " M/C  = Number of cache misses per call and per cell";
+  std::ostringstream o;
+  o << std::fixed << std::setprecision(2);
+  o << "\n              Name                    IPC (min/avg/max)      B/C (min/avg/max)      M/C (min/avg/max)\n";
+  for (Integer i = 0; i < nb_ep; ++i) {
+    IEntryPoint* ep = ep_list[i];
+    if (ep->nbCall() == 0)
+      continue;
+    const String& ep_name = ep->name();
+    if (ep_name.length() > 30) {
+      o.write(ep_name.localstr(), 28);
+      o << "..";
+    }
+    else {
+      o.width(30);
+      o << ep_name;
+    }
+    for (Integer k = 0; k < nb_value; ++k) {
+      Integer idx = i * nb_value + k;
+      o << "  " << std::setw(6) << min_values[idx]
+        << "/" << std::setw(6) << (sum_values[idx] / nb_rank)
+        << "/" << std::setw(6) << max_values[idx];
+    }
+    o << '\n';
+  }
+  info() << o.str();
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -1787,6 +1930,10 @@ doComputeLoop(Integer max_loop)
   if (!m_backward_mng)
     _createOwnDefaultBackwardMng();
 
+  // Le critère d'équilibrage doit exister avant le premier équilibrage
+  if (m_load_imbalance_report)
+    m_load_imbalance_report->initializeCellCost();
+
   IProfilingService* ps = platform::getProfilingService();
   bool want_specific_profiling = false;
   // Regarde si on demande un profiling spécifique. Dans ce cas,
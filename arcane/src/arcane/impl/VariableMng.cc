@@ -19,6 +19,7 @@
 #include "arcane/utils/PlatformUtils.h"
 #include "arcane/utils/JSONWriter.h"
 #include "arcane/utils/OStringStream.h"
+#include "arcane/utils/MemoryUtils.h"
 
 #include "arcane/core/ArcaneException.h"
 #include "arcane/core/VarRefEnumerator.h"
@@ -37,6 +38,7 @@
 #include "arcane/core/IEntryPoint.h"
 #include "arcane/core/Properties.h"
 #include "arcane/core/VariableStatusChangedEventArgs.h"
+#include "arcane/core/VariableUtils.h"
 
 #include "arcane/impl/VariableUtilities.h"
 #include "arcane/impl/internal/VariableSynchronizerMng.h"
@@ -951,6 +953,30 @@ dumpStats(std::ostream& ostr,bool is_verbose)
          << Trace::Width(12) << properties.toString()
          << '\n';
   }
+
+  // Placement des pages sur les noeuds NUMA pour les mêmes variables.
+  const Int32 nb_numa_node = MemoryUtils::getNbNumaNode();
+  if (nb_numa_node > 1) {
+    ostr << "\nNUMA page placement (% of pages per node, ?=unknown):\n";
+    ostr << Trace::Width(45) << "Variable";
+    for (Int32 k = 0; k < nb_numa_node; ++k)
+      ostr << Trace::Width(8) << String::format("N{0}", k);
+    ostr << Trace::Width(8) << "?" << "\n\n";
+    UniqueArray<Int64> nb_page_per_node;
+    for (Integer i = 0; i < nb_var_to_display; ++i) {
+      IVariable* var = memory_sorted_variables[i];
+      Int64 nb_unknown = VariableUtils::computeNumaPagePlacement(var, nb_page_per_node);
+      Int64 nb_page = nb_unknown;
+      for (Int64 n : nb_page_per_node)
+        nb_page += n;
+      if (nb_page == 0)
+        continue;
+      ostr << Trace::Width(45) << var->name();
+      for (Int64 n : nb_page_per_node)
+        ostr << Trace::Width(8) << String::fromNumber(100.0 * (Real)n / (Real)nb_page, 1);
+      ostr << Trace::Width(8) << String::fromNumber(100.0 * (Real)nb_unknown / (Real)nb_page, 1) << '\n';
+    }
+  }
 }
 
 /*---------------------------------------------------------------------------*/
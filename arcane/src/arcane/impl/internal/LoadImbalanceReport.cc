@@ -0,0 +1,274 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* LoadImbalanceReport.cc                                      (C) 2000-2024 */
+/*                                                                           */
+/* Rapport périodique sur le déséquilibre de charge entre les sous-domaines. */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/impl/internal/LoadImbalanceReport.h"
+
+#include "arcane/utils/List.h"
+
+#include "arcane/core/ISubDomain.h"
+#include "arcane/core/IEntryPoint.h"
+#include "arcane/core/IParallelMng.h"
+#include "arcane/core/IVariableMng.h"
+#include "arcane/core/IVariableSynchronizerMng.h"
+#include "arcane/core/IVariableSynchronizer.h"
+#include "arcane/core/VariableSynchronizerEventArgs.h"
+#include "arcane/core/ILoadBalanceMng.h"
+#include "arcane/core/IMesh.h"
+#include "arcane/core/ItemGroup.h"
+#include "arcane/core/VariableBuildInfo.h"
+#include "arcane/core/Item.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+LoadImbalanceReport::
+LoadImbalanceReport(ISubDomain* sd)
+: TraceAccessor(sd->traceMng())
+, m_sub_domain(sd)
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+LoadImbalanceReport::
+~LoadImbalanceReport()
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void LoadImbalanceReport::
+initialize()
+{
+  auto handler = [this](const VariableSynchronizerEventArgs& args) {
+    _onSynchronize(args);
+  };
+  m_sub_domain->variableMng()->synchronizerMng()->onSynchronized().attach(m_event_observer_pool, handler);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void LoadImbalanceReport::
+initializeCellCost()
+{
+  if (!m_is_export_cell_cost || m_cell_cost)
+    return;
+  IMesh* mesh = m_sub_domain->defaultMesh();
+  if (!mesh)
+    return;
+  m_cell_cost = std::make_unique<VariableCellReal>(VariableBuildInfo(mesh, "ArcaneMeasuredCellCost", IVariable::PNoDump));
+  // Tant qu'aucune mesure n'a été faite, toutes les mailles ont le même coût.
+  m_cell_cost->fill(1.0);
+  m_sub_domain->loadBalanceMng()->addCriterion(*m_cell_cost);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void LoadImbalanceReport::
+_onSynchronize(const VariableSynchronizerEventArgs& args)
+{
+  if (args.state() != VariableSynchronizerEventArgs::State::EndSynchronize)
+    return;
+  Real elapsed_time = args.elapsedTime();
+  m_synchronize_time += elapsed_time;
+  IVariableSynchronizer* vs = args.synchronizer();
+  if (vs)
+    m_synchronizer_times[vs->itemGroup().fullName()] += elapsed_time;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void LoadImbalanceReport::
+notifyEndIteration(Int32 iteration, EntryPointCollection entry_points)
+{
+  if (m_period <= 0 || (iteration % m_period) != 0)
+    return;
+  UniqueArray<IEntryPoint*> ep_list;
+  for (EntryPointCollection::Enumerator i(entry_points); ++i;)
+    ep_list.add(*i);
+  _computeReport(ep_list);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule et affiche le rapport.
+ *
+ * Les valeurs de chaque sous-domaine sont rangées dans un tableau dont
+ * les premiers éléments sont les temps des points d'entrée, puis les temps
+ * des synchronisations de chaque synchronizer, le temps total des
+ * synchronisations et enfin le temps total. Une seule réduction suffit
+ * donc pour calculer le minimum, le maximum et la somme.
+ *
+ * Comme les synchronisations sont collectives, tous les sous-domaines ont
+ * normalement les mêmes synchronizers. On le vérifie car sinon les tableaux
+ * de la réduction n'auraient pas la même taille. Si ce n'est pas le cas,
+ * seul le temps total des synchronisations est affiché.
+ */
+void LoadImbalanceReport::
+_computeReport(ConstArrayView<IEntryPoint*> entry_points)
+{
+  IParallelMng* pm = m_sub_domain->parallelMng();
+  const Int32 nb_rank = pm->commSize();
+  const Int32 nb_ep = entry_points.size();
+
+  Int32 nb_synchronizer = static_cast<Int32>(m_synchronizer_times.size());
+  {
+    Int32 min_nb = 0;
+    Int32 max_nb = 0;
+    Int32 sum_nb = 0;
+    Int32 min_rank = 0;
+    Int32 max_rank = 0;
+    pm->computeMinMaxSum(nb_synchronizer, min_nb, max_nb, sum_nb, min_rank, max_rank);
+    if (min_nb != max_nb) {
+      warning() << "Synchronizers differ between sub-domains (min=" << min_nb << " max=" << max_nb
+                << "). Only the total synchronize time is reported";
+      nb_synchronizer = 0;
+    }
+  }
+  const Int32 sync_index = nb_ep + nb_synchronizer;
+  const Int32 total_index = sync_index + 1;
+
+  ReportValues& report = m_last_report;
+  const Int32 n = total_index + 1;
+  report.m_names.resize(n);
+  report.m_local_values.resize(n);
+  ArrayView<Real> values = report.m_local_values;
+  values.fill(0.0);
+  Real total_time = 0.0;
+  for (Int32 i = 0; i < nb_ep; ++i) {
+    IEntryPoint* ep = entry_points[i];
+    Real ep_time = ep->totalElapsedTime();
+    Real& last_time = m_last_entry_point_times[ep];
+    values[i] = ep_time - last_time;
+    last_time = ep_time;
+    total_time += values[i];
+    report.m_names[i] = ep->name();
+  }
+  if (nb_synchronizer > 0) {
+    Int32 index = nb_ep;
+    for (const auto& [name, sync_time] : m_synchronizer_times) {
+      report.m_names[index] = String("(Synchronize ") + name + ")";
+      values[index] = sync_time;
+      ++index;
+    }
+  }
+  // On conserve les synchronizers pour que tous les sous-domaines
+  // aient toujours la même liste.
+  for (auto& x : m_synchronizer_times)
+    x.second = 0.0;
+  report.m_names[sync_index] = "(Synchronize)";
+  values[sync_index] = m_synchronize_time;
+  report.m_names[total_index] = "(Total)";
+  values[total_index] = total_time;
+  m_synchronize_time = 0.0;
+
+  UniqueArray<Real> sum_values(n);
+  UniqueArray<Int32> min_ranks(n);
+  UniqueArray<Int32> max_ranks(n);
+  report.m_min_values.resize(n);
+  report.m_max_values.resize(n);
+  report.m_mean_values.resize(n);
+  pm->computeMinMaxSum(values, report.m_min_values, report.m_max_values, sum_values, min_ranks, max_ranks);
+  for (Int32 i = 0; i < n; ++i)
+    report.m_mean_values[i] = sum_values[i] / nb_rank;
+
+  // Récupère le temps total de chaque sous-domaine pour trouver les plus lents.
+  UniqueArray<Real> all_total_times(nb_rank);
+  pm->allGather(ConstArrayView<Real>(1, &total_time), all_total_times);
+
+  // Coût mesuré hors synchronisations car celles-ci contiennent le temps
+  // d'attente des autres sous-domaines.
+  if (m_is_export_cell_cost)
+    _exportCellCost(std::max(total_time - values[sync_index], 0.0));
+
+  std::ostringstream o;
+  o << std::fixed << std::setprecision(3);
+  o << "\n              Name                      Min (s)    Mean (s)     Max (s)  Imbalance  MaxRank\n";
+  auto print_line = [&](Int32 index) {
+    const String& name = report.m_names[index];
+    Real mean = report.m_mean_values[index];
+    Real imbalance = (mean > 0.0) ? (report.m_max_values[index] / mean) : 1.0;
+    if (name.length() > 36) {
+      o.write(name.localstr(), 34);
+      o << "..";
+    }
+    else {
+      o.width(36);
+      o << name;
+    }
+    o << std::setw(12) << report.m_min_values[index] << std::setw(12) << mean
+      << std::setw(12) << report.m_max_values[index] << std::setw(11) << imbalance
+      << std::setw(9) << max_ranks[index] << '\n';
+  };
+  for (Int32 i = 0; i < sync_index; ++i)
+    if (report.m_max_values[i] > 0.0)
+      print_line(i);
+  print_line(sync_index);
+  print_line(total_index);
+
+  // Affiche les sous-domaines les plus lents.
+  UniqueArray<Int32> ranks(nb_rank);
+  for (Int32 i = 0; i < nb_rank; ++i)
+    ranks[i] = i;
+  const Int32 nb_slowest = std::min(m_nb_slowest_rank, nb_rank);
+  std::partial_sort(ranks.begin(), ranks.begin() + nb_slowest, ranks.end(),
+                    [&](Int32 a, Int32 b) { return all_total_times[a] > all_total_times[b]; });
+  o << "Slowest ranks:";
+  for (Int32 i = 0; i < nb_slowest; ++i)
+    o << " " << ranks[i] << " (" << all_total_times[ranks[i]] << "s)";
+
+  info() << "Load imbalance report for the last " << m_period << " iterations" << o.str();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Répartit le coût \a local_cost sur les mailles propres.
+ *
+ * La variable est créée si besoin par initializeCellCost().
+ */
+void LoadImbalanceReport::
+_exportCellCost(Real local_cost)
+{
+  initializeCellCost();
+  if (!m_cell_cost)
+    return;
+  CellGroup own_cells = m_sub_domain->defaultMesh()->ownCells();
+  Integer nb_own_cell = own_cells.size();
+  Real cell_cost = (nb_own_cell > 0) ? (local_cost / nb_own_cell) : 0.0;
+  m_cell_cost->fill(cell_cost);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
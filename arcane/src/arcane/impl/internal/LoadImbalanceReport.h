@@ -0,0 +1,157 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* LoadImbalanceReport.h                                       (C) 2000-2024 */
+/*                                                                           */
+/* Rapport périodique sur le déséquilibre de charge entre les sous-domaines. */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_IMPL_INTERNAL_LOADIMBALANCEREPORT_H
+#define ARCANE_IMPL_INTERNAL_LOADIMBALANCEREPORT_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/TraceAccessor.h"
+#include "arcane/utils/Event.h"
+#include "arcane/utils/Array.h"
+#include "arcane/utils/String.h"
+
+#include "arcane/core/VariableTypes.h"
+#include "arcane/core/ArcaneTypes.h"
+
+#include <map>
+#include <memory>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+class VariableSynchronizerEventArgs;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Rapport périodique sur le déséquilibre de charge.
+ *
+ * Toutes les period() itérations, cette classe calcule pour chaque point
+ * d'entrée de la boucle de calcul, pour le temps passé dans les
+ * synchronisations de chaque synchronizer (identifié par le nom complet
+ * de son groupe) et pour le temps total des synchronisations le minimum,
+ * le maximum et la moyenne sur l'ensemble des sous-domaines du temps
+ * passé depuis le dernier rapport.
+ * Le facteur de déséquilibre est le rapport entre le maximum et la moyenne.
+ * Les sous-domaines les plus lents sont aussi affichés.
+ *
+ * Si setExportCellCost() est appelé, le coût mesuré (temps de calcul hors
+ * synchronisations) de chaque sous-domaine est réparti uniformément sur ses
+ * mailles propres dans la variable 'ArcaneMeasuredCellCost'. Cette variable
+ * est créée et ajoutée comme critère de ILoadBalanceMng par
+ * initializeCellCost() avec un coût de 1 par maille jusqu'au premier rapport.
+ * Elle tient ensuite compte du coût mesuré et pas uniquement du nombre
+ * de mailles.
+ *
+ * La méthode notifyEndIteration() est collective.
+ */
+class ARCANE_IMPL_EXPORT LoadImbalanceReport
+: public TraceAccessor
+{
+ public:
+
+  explicit LoadImbalanceReport(ISubDomain* sd);
+  ~LoadImbalanceReport();
+
+ public:
+
+  //! Nombre d'itérations entre deux rapports
+  Int32 period() const { return m_period; }
+  void setPeriod(Int32 v) { m_period = v; }
+
+  //! Nombre de sous-domaines les plus lents à afficher
+  void setNbSlowestRank(Int32 v) { m_nb_slowest_rank = v; }
+
+  //! Indique si on exporte le coût mesuré pour l'équilibrage de charge
+  void setExportCellCost(bool v) { m_is_export_cell_cost = v; }
+
+  /*!
+   * \brief Valeurs d'un rapport.
+   *
+   * Pour chaque ligne du rapport, contient son nom et les valeurs sur
+   * l'ensemble des sous-domaines.
+   */
+  class ReportValues
+  {
+   public:
+
+    UniqueArray<String> m_names;
+    UniqueArray<Real> m_min_values;
+    UniqueArray<Real> m_mean_values;
+    UniqueArray<Real> m_max_values;
+    //! Valeurs de ce sous-domaine
+    UniqueArray<Real> m_local_values;
+  };
+
+ public:
+
+  //! S'abonne aux évènements de synchronisation
+  void initialize();
+
+  /*!
+   * \brief Créé la variable contenant le coût des mailles et l'ajoute
+   * comme critère d'équilibrage.
+   *
+   * Ne fait rien si setExportCellCost() n'a pas été appelé. Cette méthode
+   * doit être appelée une fois le maillage créé et avant le premier
+   * équilibrage de charge.
+   */
+  void initializeCellCost();
+
+  //! Valeurs du dernier rapport calculé
+  const ReportValues& lastReport() const { return m_last_report; }
+
+  //! Variable contenant le coût des mailles (nul si non créée)
+  VariableCellReal* cellCost() const { return m_cell_cost.get(); }
+
+  /*!
+   * \brief Notifie la fin de l'itération \a iteration.
+   *
+   * \a entry_points contient les points d'entrée de la boucle de calcul.
+   * Le rapport est calculé si \a iteration est un multiple de period().
+   */
+  void notifyEndIteration(Int32 iteration, EntryPointCollection entry_points);
+
+ private:
+
+  ISubDomain* m_sub_domain = nullptr;
+  Int32 m_period = 0;
+  Int32 m_nb_slowest_rank = 3;
+  bool m_is_export_cell_cost = false;
+  EventObserverPool m_event_observer_pool;
+  //! Temps cumulé des synchronisations depuis le dernier rapport
+  Real m_synchronize_time = 0.0;
+  //! Temps cumulé des synchronisations de chaque synchronizer depuis le dernier rapport
+  std::map<String, Real> m_synchronizer_times;
+  ReportValues m_last_report;
+  //! Temps total des points d'entrée lors du dernier rapport
+  std::map<IEntryPoint*, Real> m_last_entry_point_times;
+  std::unique_ptr<VariableCellReal> m_cell_cost;
+
+ private:
+
+  void _onSynchronize(const VariableSynchronizerEventArgs& args);
+  void _computeReport(ConstArrayView<IEntryPoint*> entry_points);
+  void _exportCellCost(Real local_cost);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
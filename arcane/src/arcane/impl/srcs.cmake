@@ -147,6 +147,8 @@ set( ARCANE_SOURCES
   internal/MeshMng.cc
   internal/ThreadBindingMng.h
   internal/ThreadBindingMng.cc
+  internal/LoadImbalanceReport.h
+  internal/LoadImbalanceReport.cc
   internal/VariableMng.h
   internal/VariableSynchronizer.h
   internal/VariableSynchronizerMng.h
@@ -0,0 +1,301 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CellCentricMaterialLayout.cc                                (C) 2000-2024 */
+/*                                                                           */
+/* Rangement des valeurs matériaux contigu par maille (format CSR).          */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/materials/CellCentricMaterialLayout.h"
+
+#include "arcane/utils/MemoryUtils.h"
+
+#include "arcane/core/IMesh.h"
+#include "arcane/core/IItemFamily.h"
+#include "arcane/core/ItemGroup.h"
+#include "arcane/core/ItemEnumerator.h"
+#include "arcane/core/materials/IMeshMaterialMng.h"
+#include "arcane/core/materials/IMeshEnvironment.h"
+#include "arcane/core/materials/IMeshMaterial.h"
+#include "arcane/core/materials/internal/IMeshComponentInternal.h"
+#include "arcane/core/materials/internal/IMeshMaterialMngInternal.h"
+
+#include "arcane/materials/internal/MeshMaterialVariableIndexer.h"
+
+#include "arcane/accelerator/core/RunQueue.h"
+#include "arcane/accelerator/RunCommandLoop.h"
+#include "arcane/accelerator/RunCommandEnumerate.h"
+#include "arcane/accelerator/Scan.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Materials
+{
+
+namespace
+{
+  MemoryAllocationOptions _allocInfo(const String& name)
+  {
+    MemoryAllocationOptions opts(MemoryUtils::getDefaultDataAllocator());
+    opts.setArrayName(name);
+    return opts;
+  }
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+CellCentricMaterialLayout::
+CellCentricMaterialLayout(IMeshMaterialMng* mm)
+: m_material_mng(mm)
+, m_cell_offsets(_allocInfo("CellCentricCellOffsets"))
+, m_matvar_indexes(_allocInfo("CellCentricMatVarIndexes"))
+, m_value_infos(_allocInfo("CellCentricValueInfos"))
+, m_array_offsets(_allocInfo("CellCentricArrayOffsets"))
+, m_positions(_allocInfo("CellCentricPositions"))
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+bool CellCentricMaterialLayout::
+isUpToDate() const
+{
+  if (m_timestamp != m_material_mng->timestamp())
+    return false;
+  return m_max_local_id == m_material_mng->mesh()->cellFamily()->maxLocalId();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void CellCentricMaterialLayout::
+update()
+{
+  if (isUpToDate())
+    return;
+  _build();
+  m_timestamp = m_material_mng->timestamp();
+  m_max_local_id = m_material_mng->mesh()->cellFamily()->maxLocalId();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+CellCentricMaterialLayoutView CellCentricMaterialLayout::
+view() const
+{
+  CellCentricMaterialLayoutView v;
+  v.m_cell_offsets = m_cell_offsets.constSmallSpan();
+  v.m_matvar_indexes = m_matvar_indexes.constSmallSpan();
+  v.m_value_infos = m_value_infos.constSmallSpan();
+  v.m_array_offsets = m_array_offsets.constSmallSpan();
+  v.m_positions = m_positions.constSmallSpan();
+  return v;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule le rangement.
+ *
+ * Le calcul utilise directement les MatVarIndex des MeshMaterialVariableIndexer
+ * des milieux et des matériaux. Chaque boucle porte sur un seul indexer et
+ * une maille n'y apparaît qu'une fois: les boucles peuvent donc être
+ * exécutées en parallèle sur la file des matériaux.
+ *
+ * Une première série de boucles calcule le nombre de valeurs distinctes
+ * de chaque maille. Les valeurs qui partagent le MatVarIndex de la valeur
+ * globale (mailles pures) ne sont pas comptées. Les valeurs d'un milieu qui
+ * n'a qu'un seul matériau sont partagées avec ce matériau car ils utilisent
+ * le même indexer. Après un scan pour calculer les positions de chaque
+ * maille, une seconde série de boucles range les valeurs. Les milieux étant
+ * traités les uns après les autres, les valeurs d'un milieu sont bien suivies
+ * de celles de ses matériaux.
+ */
+void CellCentricMaterialLayout::
+_build()
+{
+  IMesh* mesh = m_material_mng->mesh();
+  CellGroup all_cells = mesh->allCells();
+  const Int32 nb_cell_lid = mesh->cellFamily()->maxLocalId();
+  RunQueue queue(m_material_mng->_internalApi()->runQueue());
+
+  // Indexer de chaque milieu et de chacun de ses matériaux. Si un matériau
+  // utilise l'indexer de son milieu, il n'est pas ajouté.
+  struct ComponentIndexer
+  {
+    MeshMaterialVariableIndexer* indexer = nullptr;
+    Int16 flags = 0;
+    Int16 environment_id = -1;
+    Int16 material_id = -1;
+  };
+  UniqueArray<ComponentIndexer> component_indexers;
+  for (IMeshEnvironment* env : m_material_mng->environments()) {
+    MeshMaterialVariableIndexer* env_indexer = env->_internalApi()->variableIndexer();
+    ComponentIndexer env_ci;
+    env_ci.indexer = env_indexer;
+    env_ci.flags = CellCentricValueInfo::FlagEnvironment;
+    env_ci.environment_id = static_cast<Int16>(env->id());
+    Int32 env_ci_index = component_indexers.size();
+    component_indexers.add(env_ci);
+    for (IMeshMaterial* mat : env->materials()) {
+      MeshMaterialVariableIndexer* mat_indexer = mat->_internalApi()->variableIndexer();
+      if (mat_indexer == env_indexer) {
+        ComponentIndexer& ci = component_indexers[env_ci_index];
+        ci.flags = static_cast<Int16>(ci.flags | CellCentricValueInfo::FlagMaterial);
+        ci.material_id = static_cast<Int16>(mat->id());
+        continue;
+      }
+      ComponentIndexer mat_ci;
+      mat_ci.indexer = mat_indexer;
+      mat_ci.flags = CellCentricValueInfo::FlagMaterial;
+      mat_ci.environment_id = static_cast<Int16>(env->id());
+      mat_ci.material_id = static_cast<Int16>(mat->id());
+      component_indexers.add(mat_ci);
+    }
+  }
+
+  // Nombre de valeurs de chaque maille. Les mailles qui ne sont pas dans
+  // allCells() n'ont pas de valeurs.
+  UniqueArray<Int32> nb_cell_values(_allocInfo("CellCentricNbCellValues"));
+  nb_cell_values.resize(nb_cell_lid + 1);
+  nb_cell_values.fill(0);
+  {
+    SmallSpan<Int32> nb_cell_values_view(nb_cell_values);
+    auto command = makeCommand(queue);
+    command << RUNCOMMAND_ENUMERATE (CellLocalId, cid, all_cells)
+    {
+      nb_cell_values_view[cid.localId()] = 1;
+    };
+  }
+  for (const ComponentIndexer& ci : component_indexers) {
+    SmallSpan<Int32> nb_cell_values_view(nb_cell_values);
+    SmallSpan<const MatVarIndex> matvar_indexes(ci.indexer->matvarIndexes());
+    SmallSpan<const Int32> local_ids(ci.indexer->localIds());
+    auto command = makeCommand(queue);
+    command << RUNCOMMAND_LOOP1(iter, matvar_indexes.size())
+    {
+      auto [z] = iter();
+      if (matvar_indexes[z].arrayIndex() != 0)
+        ++nb_cell_values_view[local_ids[z]];
+    };
+  }
+
+  // Position de la première valeur de chaque maille.
+  m_cell_offsets.resize(nb_cell_lid + 1);
+  {
+    Accelerator::GenericScanner scanner(queue);
+    Accelerator::ScannerSumOperator<Int32> op;
+    scanner.applyExclusive(0, nb_cell_values.constSmallSpan(), m_cell_offsets.smallSpan(), op, A_FUNCINFO);
+  }
+  queue.barrier();
+  const Int32 nb_value = m_cell_offsets[nb_cell_lid];
+
+  // Range la valeur globale de chaque maille puis les valeurs des
+  // constituants. On réutilise \a nb_cell_values pour conserver la position
+  // de la prochaine valeur de chaque maille.
+  m_matvar_indexes.resize(nb_value);
+  m_value_infos.resize(nb_value);
+  {
+    SmallSpan<const Int32> cell_offsets(m_cell_offsets);
+    SmallSpan<Int32> next_positions(nb_cell_values);
+    SmallSpan<MatVarIndex> out_matvar_indexes(m_matvar_indexes);
+    SmallSpan<CellCentricValueInfo> out_value_infos(m_value_infos);
+    auto command = makeCommand(queue);
+    command << RUNCOMMAND_ENUMERATE (CellLocalId, cid, all_cells)
+    {
+      const Int32 pos = cell_offsets[cid.localId()];
+      CellCentricValueInfo vi;
+      vi.m_flags = CellCentricValueInfo::FlagGlobal;
+      out_matvar_indexes[pos] = MatVarIndex(0, cid.localId());
+      out_value_infos[pos] = vi;
+      next_positions[cid.localId()] = pos + 1;
+    };
+  }
+  for (const ComponentIndexer& ci : component_indexers) {
+    SmallSpan<const Int32> cell_offsets(m_cell_offsets);
+    SmallSpan<Int32> next_positions(nb_cell_values);
+    SmallSpan<MatVarIndex> out_matvar_indexes(m_matvar_indexes);
+    SmallSpan<CellCentricValueInfo> out_value_infos(m_value_infos);
+    SmallSpan<const MatVarIndex> matvar_indexes(ci.indexer->matvarIndexes());
+    SmallSpan<const Int32> local_ids(ci.indexer->localIds());
+    const Int16 flags = ci.flags;
+    const Int16 environment_id = ci.environment_id;
+    const Int16 material_id = ci.material_id;
+    auto command = makeCommand(queue);
+    command << RUNCOMMAND_LOOP1(iter, matvar_indexes.size())
+    {
+      auto [z] = iter();
+      const MatVarIndex mvi = matvar_indexes[z];
+      const Int32 lid = local_ids[z];
+      // Une valeur pure est partagée avec la valeur globale de la maille.
+      Int32 pos = cell_offsets[lid];
+      if (mvi.arrayIndex() != 0) {
+        pos = next_positions[lid];
+        ++next_positions[lid];
+        out_matvar_indexes[pos] = mvi;
+      }
+      CellCentricValueInfo& vi = out_value_infos[pos];
+      vi.m_flags = static_cast<Int16>(vi.m_flags | flags);
+      vi.m_environment_id = environment_id;
+      if (material_id >= 0)
+        vi.m_material_id = material_id;
+    };
+  }
+
+  // Calcule la table de conversion MatVarIndex => position. Le tableau
+  // d'indice 0 contient les valeurs globales et le tableau d'indice \a i+1
+  // les valeurs partielles de l'indexer d'indice \a i.
+  ConstArrayView<MeshMaterialVariableIndexer*> indexers = m_material_mng->_internalApi()->variablesIndexer();
+  const Int32 nb_array = indexers.size() + 1;
+  m_array_offsets.resize(nb_array + 1);
+  {
+    Int32 array_offset = 0;
+    m_array_offsets[0] = 0;
+    array_offset += nb_cell_lid;
+    for (MeshMaterialVariableIndexer* indexer : indexers) {
+      m_array_offsets[indexer->index() + 1] = array_offset;
+      array_offset += indexer->maxIndexInMultipleArray();
+    }
+    m_array_offsets[nb_array] = array_offset;
+  }
+  m_positions.resize(m_array_offsets[nb_array]);
+  {
+    SmallSpan<Int32> positions(m_positions);
+    auto command = makeCommand(queue);
+    command << RUNCOMMAND_LOOP1(iter, positions.size())
+    {
+      auto [i] = iter();
+      positions[i] = -1;
+    };
+  }
+  {
+    SmallSpan<Int32> positions(m_positions);
+    SmallSpan<const Int32> array_offsets(m_array_offsets);
+    SmallSpan<const MatVarIndex> in_matvar_indexes(m_matvar_indexes);
+    auto command = makeCommand(queue);
+    command << RUNCOMMAND_LOOP1(iter, nb_value)
+    {
+      auto [pos] = iter();
+      MatVarIndex mvi = in_matvar_indexes[pos];
+      positions[array_offsets[mvi.arrayIndex()] + mvi.valueIndex()] = pos;
+    };
+  }
+  queue.barrier();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane::Materials
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
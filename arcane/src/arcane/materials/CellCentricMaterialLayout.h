@@ -0,0 +1,213 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CellCentricMaterialLayout.h                                 (C) 2000-2024 */
+/*                                                                           */
+/* Rangement des valeurs matériaux contigu par maille (format CSR).          */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_MATERIALS_CELLCENTRICMATERIALLAYOUT_H
+#define ARCANE_MATERIALS_CELLCENTRICMATERIALLAYOUT_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/UniqueArray.h"
+
+#include "arcane/core/ItemLocalId.h"
+#include "arcane/core/materials/MatVarIndex.h"
+
+#include "arcane/materials/MaterialsGlobal.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Materials
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \ingroup ArcaneMaterials
+ * \brief Informations sur une valeur d'un CellCentricMaterialLayout.
+ *
+ * Comme une valeur peut être partagée entre plusieurs niveaux, elle peut
+ * être à la fois globale, milieu et matériau. C'est le cas par exemple
+ * des valeurs des mailles pures.
+ */
+class CellCentricValueInfo
+{
+  friend class CellCentricMaterialLayout;
+
+ public:
+
+  //! Indique si la valeur est la valeur globale de la maille
+  ARCCORE_HOST_DEVICE bool isGlobal() const { return m_flags & FlagGlobal; }
+  //! Indique si la valeur est une valeur milieu
+  ARCCORE_HOST_DEVICE bool isEnvironment() const { return m_flags & FlagEnvironment; }
+  //! Indique si la valeur est une valeur matériau
+  ARCCORE_HOST_DEVICE bool isMaterial() const { return m_flags & FlagMaterial; }
+  //! Identifiant du milieu (ou (-1) si la valeur n'est que globale)
+  ARCCORE_HOST_DEVICE Int32 environmentId() const { return m_environment_id; }
+  //! Identifiant du matériau (ou (-1) si la valeur n'est pas une valeur matériau)
+  ARCCORE_HOST_DEVICE Int32 materialId() const { return m_material_id; }
+
+ private:
+
+  static constexpr Int16 FlagGlobal = 1;
+  static constexpr Int16 FlagEnvironment = 2;
+  static constexpr Int16 FlagMaterial = 4;
+
+  Int16 m_flags = 0;
+  Int16 m_environment_id = -1;
+  Int16 m_material_id = -1;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \ingroup ArcaneMaterials
+ * \brief Vue sur un CellCentricMaterialLayout.
+ *
+ * Cette vue peut être copiée sur accélérateur. Elle n'est valide que tant
+ * que le CellCentricMaterialLayout associé n'est pas mis à jour.
+ */
+class CellCentricMaterialLayoutView
+{
+  friend class CellCentricMaterialLayout;
+
+ public:
+
+  CellCentricMaterialLayoutView() = default;
+
+ public:
+
+  //! Nombre de valeurs
+  ARCCORE_HOST_DEVICE Int32 nbValue() const { return m_matvar_indexes.size(); }
+
+  //! Position de la première valeur de la maille \a c (qui est la valeur globale)
+  ARCCORE_HOST_DEVICE Int32 cellBegin(CellLocalId c) const { return m_cell_offsets[c.localId()]; }
+
+  //! Position suivant la dernière valeur de la maille \a c
+  ARCCORE_HOST_DEVICE Int32 cellEnd(CellLocalId c) const { return m_cell_offsets[c.localId() + 1]; }
+
+  //! Nombre de valeurs (globale, milieux et matériaux) de la maille \a c
+  ARCCORE_HOST_DEVICE Int32 nbCellValue(CellLocalId c) const { return cellEnd(c) - cellBegin(c); }
+
+  //! MatVarIndex de la valeur à la position \a pos
+  ARCCORE_HOST_DEVICE MatVarIndex matVarIndex(Int32 pos) const { return m_matvar_indexes[pos]; }
+
+  //! Informations sur la valeur à la position \a pos
+  ARCCORE_HOST_DEVICE CellCentricValueInfo valueInfo(Int32 pos) const { return m_value_infos[pos]; }
+
+  //! Position de la valeur d'indice \a mvi
+  ARCCORE_HOST_DEVICE Int32 position(MatVarIndex mvi) const
+  {
+    return m_positions[m_array_offsets[mvi.arrayIndex()] + mvi.valueIndex()];
+  }
+
+  //! Position de la valeur de la maille constituant \a lid
+  ARCCORE_HOST_DEVICE Int32 position(ComponentItemLocalId lid) const { return position(lid.localId()); }
+
+  //! Position de la valeur pure d'indice \a pmvi
+  ARCCORE_HOST_DEVICE Int32 position(PureMatVarIndex pmvi) const { return cellBegin(CellLocalId(pmvi.valueIndex())); }
+
+  //! Position de la valeur globale de la maille \a c
+  ARCCORE_HOST_DEVICE Int32 position(CellLocalId c) const { return cellBegin(c); }
+
+ private:
+
+  SmallSpan<const Int32> m_cell_offsets;
+  SmallSpan<const MatVarIndex> m_matvar_indexes;
+  SmallSpan<const CellCentricValueInfo> m_value_infos;
+  SmallSpan<const Int32> m_array_offsets;
+  SmallSpan<const Int32> m_positions;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \ingroup ArcaneMaterials
+ * \brief Rangement contigu par maille des valeurs des variables matériaux.
+ *
+ * Dans les variables matériaux, les valeurs sont rangées dans un tableau
+ * global et un tableau partiel par milieu et par matériau. Une boucle
+ * sur les constituants d'une maille mixte (via ENUMERATE_CELL_ENVCELL()
+ * et ENUMERATE_CELL_MATCELL()) accède donc à autant de tableaux différents
+ * qu'il y a de constituants dans la maille.
+ *
+ * Cette classe calcule un rangement alternatif de type CSR où toutes les
+ * valeurs d'une maille sont contigües: la valeur globale en premier, puis pour
+ * chaque milieu la valeur milieu suivie de celles de ses matériaux. Une
+ * valeur partagée entre plusieurs niveaux (par exemple celle d'une
+ * maille pure, ou d'un milieu avec un seul matériau) n'est présente qu'une seule
+ * fois. CellCentricValueInfo permet de connaître le niveau et le constituant
+ * de chaque valeur sans passer par AllEnvCell.
+ *
+ * L'instance est commune à toutes les variables et c'est la classe
+ * CellCentricMaterialVariableScalar qui permet d'utiliser ce rangement
+ * pour une variable donnée.
+ *
+ * Il faut appeler update() après chaque modification des matériaux. La
+ * méthode ne fait rien si les matériaux n'ont pas changé depuis le
+ * dernier appel.
+ */
+class ARCANE_MATERIALS_EXPORT CellCentricMaterialLayout
+{
+ public:
+
+  explicit CellCentricMaterialLayout(IMeshMaterialMng* mm);
+
+ public:
+
+  //! Met à jour le rangement si les matériaux ont changé.
+  void update();
+
+  //! Indique si le rangement est à jour par rapport aux matériaux
+  bool isUpToDate() const;
+
+  //! Gestionnaire des matériaux associé
+  IMeshMaterialMng* materialMng() const { return m_material_mng; }
+
+  //! Nombre de valeurs
+  Int32 nbValue() const { return m_matvar_indexes.size(); }
+
+  //! Position de la première valeur de chaque maille (de taille maxLocalId()+1)
+  SmallSpan<const Int32> cellOffsets() const { return m_cell_offsets; }
+
+  //! MatVarIndex de chaque valeur
+  SmallSpan<const MatVarIndex> matVarIndexes() const { return m_matvar_indexes; }
+
+  //! Informations sur chaque valeur
+  SmallSpan<const CellCentricValueInfo> valueInfos() const { return m_value_infos; }
+
+  //! Vue sur le rangement
+  CellCentricMaterialLayoutView view() const;
+
+ private:
+
+  IMeshMaterialMng* m_material_mng = nullptr;
+  Int64 m_timestamp = -1;
+  Int32 m_max_local_id = -1;
+  UniqueArray<Int32> m_cell_offsets;
+  UniqueArray<MatVarIndex> m_matvar_indexes;
+  UniqueArray<CellCentricValueInfo> m_value_infos;
+  UniqueArray<Int32> m_array_offsets;
+  UniqueArray<Int32> m_positions;
+
+ private:
+
+  void _build();
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane::Materials
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -0,0 +1,230 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CellCentricMaterialVariableScalar.h                         (C) 2000-2024 */
+/*                                                                           */
+/* Valeurs d'une variable matériau rangées de manière contigüe par maille.   */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_MATERIALS_CELLCENTRICMATERIALVARIABLESCALAR_H
+#define ARCANE_MATERIALS_CELLCENTRICMATERIALVARIABLESCALAR_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/MemoryUtils.h"
+#include "arcane/utils/FatalErrorException.h"
+
+#include "arcane/core/materials/MeshMaterialVariableRef.h"
+
+#include "arcane/materials/CellCentricMaterialLayout.h"
+
+#include "arcane/accelerator/core/RunQueue.h"
+#include "arcane/accelerator/RunCommandLoop.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::Materials
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \ingroup ArcaneMaterials
+ * \brief Vue sur les valeurs d'une CellCentricMaterialVariableScalar.
+ *
+ * Cette vue peut être copiée sur accélérateur. Les opérateurs d'accès
+ * acceptent les mêmes indices que CellMaterialVariableScalarRef.
+ */
+template <typename DataType>
+class CellCentricMaterialVariableScalarView
+{
+ public:
+
+  CellCentricMaterialVariableScalarView(const CellCentricMaterialLayoutView& layout, SmallSpan<DataType> values)
+  : m_layout(layout)
+  , m_values(values)
+  {}
+
+ public:
+
+  //! Valeur de la maille constituant \a lid
+  ARCCORE_HOST_DEVICE DataType& operator[](ComponentItemLocalId lid) const { return m_values[m_layout.position(lid)]; }
+
+  //! Valeur d'indice \a mvi
+  ARCCORE_HOST_DEVICE DataType& operator[](MatVarIndex mvi) const { return m_values[m_layout.position(mvi)]; }
+
+  //! Valeur globale de la maille \a c
+  ARCCORE_HOST_DEVICE DataType& operator[](CellLocalId c) const { return m_values[m_layout.position(c)]; }
+
+  //! Valeur pure d'indice \a pmvi
+  ARCCORE_HOST_DEVICE DataType& operator[](PureMatVarIndex pmvi) const { return m_values[m_layout.position(pmvi)]; }
+
+  //! Valeur à la position \a pos du rangement
+  ARCCORE_HOST_DEVICE DataType& value(Int32 pos) const { return m_values[pos]; }
+
+  /*!
+   * \brief Valeurs contigües de la maille \a c.
+   *
+   * La première valeur est la valeur globale. Les suivantes sont celles
+   * des milieux et des matériaux dans l'ordre de CellCentricMaterialLayout.
+   */
+  ARCCORE_HOST_DEVICE SmallSpan<DataType> cellValues(CellLocalId c) const
+  {
+    Int32 begin = m_layout.cellBegin(c);
+    return m_values.subSpan(begin, m_layout.cellEnd(c) - begin);
+  }
+
+  //! Vue sur le rangement
+  ARCCORE_HOST_DEVICE const CellCentricMaterialLayoutView& layout() const { return m_layout; }
+
+ private:
+
+  CellCentricMaterialLayoutView m_layout;
+  SmallSpan<DataType> m_values;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \ingroup ArcaneMaterials
+ * \brief Valeurs d'une variable matériau rangées de manière contigüe par maille.
+ *
+ * Cette classe permet d'utiliser pour une variable donnée le rangement
+ * CellCentricMaterialLayout. Les valeurs sont recopiées depuis la variable
+ * via gather() et recopiées vers la variable via scatter(). Entre ces deux
+ * appels, il faut utiliser les valeurs de l'instance (via view() ou les
+ * opérateurs d'accès) et pas celles de la variable.
+ *
+ * Les valeurs sont une copie de celles de la variable et seules les
+ * variables scalaires sont supportées. Le coût de gather() et scatter()
+ * correspond à environ deux parcours de toutes les valeurs de la variable.
+ * Ce rangement n'est donc intéressant que si les conditions suivantes sont
+ * réunies:
+ * - les noyaux parcourent tous les constituants de chaque maille (par
+ *   exemple les lois de fermeture des mailles mixtes). Les valeurs d'une
+ *   maille sont alors contigües au lieu d'être réparties dans autant de
+ *   tableaux que de constituants. Pour un noyau qui parcourt les mailles
+ *   d'un seul constituant, le rangement classique est déjà contigu et
+ *   il faut l'utiliser directement.
+ * - il y a beaucoup de mailles mixtes avec plusieurs constituants. Pour
+ *   les mailles pures, les deux rangements sont équivalents.
+ * - le gain sur les noyaux exécutés entre gather() et scatter() est
+ *   supérieur au coût des recopies. Pour un seul noyau exécuté une seule
+ *   fois, ce n'est en général pas le cas.
+ *
+ * Le test MeshMaterialCellCentricUnitTest affiche le temps d'un noyau avec
+ * chaque rangement ainsi que le coût des recopies, et le nombre d'exécutions
+ * du noyau à partir duquel le rangement par maille devient intéressant.
+ *
+ * \code
+ * CellCentricMaterialLayout layout(material_mng);
+ * layout.update();
+ * CellCentricMaterialVariableScalar<Real> cc_pressure(&layout, m_pressure);
+ * cc_pressure.gather(queue);
+ * auto command = makeCommand(queue);
+ * auto out_p = cc_pressure.view();
+ * command << RUNCOMMAND_ENUMERATE (CellLocalId, cid, allCells())
+ * {
+ *   SmallSpan<Real> p = out_p.cellValues(cid);
+ *   ...
+ * };
+ * cc_pressure.scatter(queue);
+ * \endcode
+ */
+template <typename DataType>
+class CellCentricMaterialVariableScalar
+{
+ public:
+
+  CellCentricMaterialVariableScalar(CellCentricMaterialLayout* layout, CellMaterialVariableScalarRef<DataType>& var)
+  : m_layout(layout)
+  , m_variable(&var)
+  , m_values(MemoryUtils::getDefaultDataAllocator())
+  {}
+
+ public:
+
+  //! Recopie les valeurs de la variable dans l'instance
+  void gather(const RunQueue& queue)
+  {
+    _checkLayout();
+    const Int32 n = m_layout->nbValue();
+    m_values.resize(n);
+    ArrayView<DataType>* var_values = m_variable->_internalValue();
+    SmallSpan<const MatVarIndex> indexes = m_layout->matVarIndexes();
+    SmallSpan<DataType> values = m_values.smallSpan();
+    auto command = makeCommand(queue);
+    command << RUNCOMMAND_LOOP1(iter, n)
+    {
+      auto [i] = iter();
+      MatVarIndex mvi = indexes[i];
+      values[i] = var_values[mvi.arrayIndex()][mvi.valueIndex()];
+    };
+  }
+
+  //! Recopie les valeurs de l'instance dans la variable
+  void scatter(const RunQueue& queue)
+  {
+    _checkLayout();
+    const Int32 n = m_values.size();
+    if (n != m_layout->nbValue())
+      ARCANE_FATAL("Bad number of values for variable '{0}' (current={1} expected={2}). You need to call gather()",
+                   m_variable->name(), n, m_layout->nbValue());
+    ArrayView<DataType>* var_values = m_variable->_internalValue();
+    SmallSpan<const MatVarIndex> indexes = m_layout->matVarIndexes();
+    SmallSpan<const DataType> values = m_values.constSmallSpan();
+    auto command = makeCommand(queue);
+    command << RUNCOMMAND_LOOP1(iter, n)
+    {
+      auto [i] = iter();
+      MatVarIndex mvi = indexes[i];
+      var_values[mvi.arrayIndex()][mvi.valueIndex()] = values[i];
+    };
+  }
+
+  //! Vue sur les valeurs (utilisable sur accélérateur)
+  CellCentricMaterialVariableScalarView<DataType> view()
+  {
+    return CellCentricMaterialVariableScalarView<DataType>(m_layout->view(), m_values.smallSpan());
+  }
+
+  //! Vue constante sur les valeurs (utilisable sur accélérateur)
+  CellCentricMaterialVariableScalarView<const DataType> constView() const
+  {
+    return CellCentricMaterialVariableScalarView<const DataType>(m_layout->view(), m_values.constSmallSpan());
+  }
+
+  //! Valeurs dans l'ordre de CellCentricMaterialLayout
+  SmallSpan<DataType> values() { return m_values.smallSpan(); }
+
+  //! Variable associée
+  CellMaterialVariableScalarRef<DataType>& variable() const { return *m_variable; }
+
+ private:
+
+  CellCentricMaterialLayout* m_layout = nullptr;
+  CellMaterialVariableScalarRef<DataType>* m_variable = nullptr;
+  UniqueArray<DataType> m_values;
+
+ private:
+
+  void _checkLayout() const
+  {
+    if (!m_layout->isUpToDate())
+      ARCANE_FATAL("CellCentricMaterialLayout is not up to date. You need to call update()");
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane::Materials
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
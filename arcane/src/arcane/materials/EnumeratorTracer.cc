@@ -17,6 +17,7 @@
 #include "arcane/utils/Profiling.h"
 #include "arcane/utils/PlatformUtils.h"
 #include "arcane/utils/ForLoopTraceInfo.h"
+#include "arcane/utils/internal/ProfilingInternal.h"
 
 #include "arcane/materials/MatItemEnumerator.h"
 
@@ -66,7 +67,7 @@ _beginLoop(EnumeratorTraceInfo& eti)
 void EnumeratorTracer::
 _endLoop(EnumeratorTraceInfo& eti)
 {
-  m_perf_counter->getCounters(eti.counters(), true);
+  Int32 nb_counter = m_perf_counter->getCounters(eti.counters(), true);
   const TraceInfo* ti = eti.traceInfo();
   ForLoopTraceInfo loop_trace_info;
   if (ti)
@@ -74,6 +75,13 @@ _endLoop(EnumeratorTraceInfo& eti)
   ForLoopOneExecStat exec_stat;
   exec_stat.setBeginTime(eti.beginTime());
   exec_stat.setEndTime(platform::getRealTimeNS());
+  // Ne conserve les compteurs que s'ils ont tous été lus.
+  if (impl::HardwareCounterStat::isEnabled() && nb_counter >= ForLoopOneExecStat::NB_HARDWARE_COUNTER) {
+    FixedArray<Int64, ForLoopOneExecStat::NB_HARDWARE_COUNTER> hw_counters;
+    for (Int32 i = 0; i < ForLoopOneExecStat::NB_HARDWARE_COUNTER; ++i)
+      hw_counters[i] = eti.counters()[i];
+    exec_stat.setHardwareCounters(hw_counters);
+  }
   ProfilingRegistry::_threadLocalForLoopInstance()->merge(exec_stat, loop_trace_info);
 }
 
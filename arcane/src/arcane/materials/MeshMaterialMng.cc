@@ -48,6 +48,7 @@
 #include "arcane/materials/internal/MeshMaterialSynchronizer.h"
 #include "arcane/materials/internal/MeshMaterialVariableSynchronizer.h"
 #include "arcane/materials/internal/ConstituentConnectivityList.h"
+#include "arcane/materials/internal/MeshMaterialVariableIndexer.h"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -182,6 +183,12 @@ MeshMaterialMng::
     m_modifier.reset();
   }
 
+  if (m_nb_compaction>0){
+    info() << "MeshMaterialMng compaction statistics:";
+    info() << " Nb compaction : " << m_nb_compaction;
+    info() << " Reclaimed memory (bytes) : " << m_total_compaction_reclaimed_bytes;
+  }
+
   m_internal_api.reset();
 
   if (m_allcell_2_allenvcell)
@@ -299,13 +306,23 @@ build()
   // Choix du ratio de capacité additionelle
   {
     if (auto v = Convert::Type<Real>::tryParseFromEnvironment("ARCANE_MATERIALMNG_ADDITIONAL_CAPACITY_RATIO", true)){
-      if (v>=0.0){
+      if (v && v.value()>=0.0){
         m_additional_capacity_ratio = v.value();
         info() << "Set additional capacity ratio to " << m_additional_capacity_ratio;
       }
     }
   }
 
+  // Choix du seuil de compactage des valeurs partielles
+  {
+    if (auto v = Convert::Type<Real>::tryParseFromEnvironment("ARCANE_MATERIALMNG_COMPACTION_RATIO", true)){
+      if (v && v.value()>=0.0){
+        m_partial_values_compaction_ratio = v.value();
+        info() << "Set partial values compaction ratio to " << m_partial_values_compaction_ratio;
+      }
+    }
+  }
+
   m_exchange_mng->build();
   // Si les traces des énumérateurs sur les entités sont actives, active celles
   // sur les matériaux.
@@ -663,6 +680,8 @@ void MeshMaterialMng::
 _endUpdate()
 {
   m_all_env_data->forceRecompute(true);
+  for (MeshMaterialVariableIndexer* indexer : m_variables_indexer)
+    indexer->notifyTopologyModified();
 }
 
 /*---------------------------------------------------------------------------*/
@@ -687,6 +706,87 @@ syncVariablesReferences(bool check_resize)
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+Int64 MeshMaterialMng::
+compactPartialValues()
+{
+  if (!m_is_end_create)
+    ARCANE_FATAL("Can not compact partial values before call to endCreate()");
+  return _compactPartialValues(m_variables_indexer);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compacte les valeurs partielles si nécessaire.
+ *
+ * Cette méthode est appelée à la fin d'une modification des matériaux. Elle
+ * compacte les valeurs partielles des indexeurs pour lesquels la proportion
+ * de valeurs inutilisées dépasse partialValuesCompactionRatio().
+ */
+void MeshMaterialMng::
+checkCompactPartialValues()
+{
+  const Real ratio = m_partial_values_compaction_ratio;
+  if (ratio<=0.0)
+    return;
+  RunQueue& queue = runQueue();
+  UniqueArray<MeshMaterialVariableIndexer*> indexers_to_compact;
+  for( MeshMaterialVariableIndexer* indexer : m_variables_indexer ){
+    const Int32 max_size = indexer->maxIndexInMultipleArray();
+    if (max_size==0)
+      continue;
+    const Int32 nb_unused = max_size - indexer->nbPartialValue(queue);
+    if (static_cast<Real>(nb_unused) > ratio * static_cast<Real>(max_size))
+      indexers_to_compact.add(indexer);
+  }
+  if (!indexers_to_compact.empty())
+    _compactPartialValues(indexers_to_compact);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compacte les valeurs partielles des indexeurs \a indexers.
+ *
+ * Pour chaque indexeur, on renumérote les valeurs partielles puis on
+ * déplace les valeurs de toutes les variables. Il faut ensuite recalculer
+ * les informations des constituants car elles contiennent les MatVarIndex.
+ */
+Int64 MeshMaterialMng::
+_compactPartialValues(ConstArrayView<MeshMaterialVariableIndexer*> indexers)
+{
+  RunQueue& queue = runQueue();
+  UniqueArray<Int32> old_indexes(queue.allocationOptions());
+  UniqueArray<Int32> new_indexes(queue.allocationOptions());
+  UniqueArray<std::byte> buffer(queue.allocationOptions());
+  Int64 reclaimed_bytes = 0;
+
+  for( MeshMaterialVariableIndexer* indexer : indexers ){
+    const Int32 old_size = indexer->maxIndexInMultipleArray();
+    const Int32 nb_partial = indexer->compactMultipleArray(old_indexes,new_indexes,queue);
+    info(4) << "CompactPartialValues indexer=" << indexer->name()
+            << " old_size=" << old_size << " new_size=" << nb_partial;
+    for( const auto& i : m_full_name_variable_map ){
+      IMeshMaterialVariable* mv = i.second;
+      reclaimed_bytes += mv->_internalApi()->compactForIndexer(indexer->index(),old_indexes.constSmallSpan(),
+                                                               new_indexes.constSmallSpan(),buffer,queue);
+    }
+  }
+
+  // Les MatVarIndex des constituants ont changé.
+  m_all_env_data->forceRecompute(false);
+
+  ++m_nb_compaction;
+  m_total_compaction_reclaimed_bytes += reclaimed_bytes;
+  info() << "Compact material partial values nb_indexer=" << indexers.size()
+         << " reclaimed_bytes=" << reclaimed_bytes
+         << " total_reclaimed_bytes=" << m_total_compaction_reclaimed_bytes;
+  return reclaimed_bytes;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void MeshMaterialMng::
 visitVariables(IFunctorWithArgumentT<IMeshMaterialVariable*>* functor)
 {
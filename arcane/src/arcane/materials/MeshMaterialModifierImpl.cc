@@ -21,12 +21,14 @@
 #include "arcane/core/materials/internal/IMeshComponentInternal.h"
 
 #include "arcane/materials/IMeshMaterial.h"
+#include "arcane/materials/IMeshEnvironment.h"
 #include "arcane/materials/IMeshMaterialVariable.h"
 #include "arcane/materials/MeshMaterialBackup.h"
 #include "arcane/materials/internal/MeshMaterialMng.h"
 #include "arcane/materials/internal/AllEnvData.h"
 #include "arcane/materials/internal/MeshMaterialModifierImpl.h"
 #include "arcane/materials/internal/MaterialModifierOperation.h"
+#include "arcane/materials/internal/MeshMaterialVariableIndexer.h"
 #include "arcane/materials/internal/IncrementalComponentModifier.h"
 #include "arcane/materials/internal/ConstituentListPrinter.h"
 
@@ -312,6 +314,16 @@ _endUpdate()
     all_env_data->recomputeIncremental();
   }
 
+  // Indique aux variables calculées que les constituants modifiés ne sont
+  // plus à jour.
+  for (const Operation* op : m_operations.values()) {
+    IMeshMaterial* mat = op->material();
+    mat->_internalApi()->variableIndexer()->notifyTopologyModified();
+    mat->environment()->_internalApi()->variableIndexer()->notifyTopologyModified();
+  }
+
+  m_material_mng->checkCompactPartialValues();
+
   if (!m_is_keep_work_buffer)
     m_incremental_modifier = nullptr;
 
@@ -25,6 +25,8 @@
 #include "arcane/utils/PlatformUtils.h"
 
 #include "arcane/core/materials/IMeshMaterial.h"
+#include "arcane/core/materials/IMeshEnvironment.h"
+#include "arcane/core/materials/IMeshMaterialMng.h"
 #include "arcane/core/materials/ComponentItemVectorView.h"
 #include "arcane/core/Variable.h"
 #include "arcane/core/VariableDependInfo.h"
@@ -176,6 +178,73 @@ resizeForIndexer(Int32 index, RunQueue& queue)
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+Int64 MeshMaterialVariablePrivate::
+compactForIndexer(Int32 index, SmallSpan<const Int32> old_indexes,
+                  SmallSpan<const Int32> new_indexes,
+                  Array<std::byte>& buffer, RunQueue& queue)
+{
+  return m_variable->_compactForIndexer(index, old_indexes, new_indexes, buffer, queue);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace
+{
+  /*!
+   * \brief Applique \a func aux matériaux du constituant \a component.
+   *
+   * Si \a component est un milieu, \a func est appliquée à ses matériaux.
+   * S'il est nul, elle est appliquée à tous les matériaux.
+   */
+  template <typename Lambda> void
+  _applyToMaterials(IMeshMaterialMng* mm, IMeshComponent* component, const Lambda& func)
+  {
+    if (!component) {
+      for (IMeshMaterial* mat : mm->materials())
+        func(mat);
+    }
+    else if (component->isMaterial())
+      func(component->asMaterial());
+    else
+      for (IMeshMaterial* mat : component->asEnvironment()->materials())
+        func(mat);
+  }
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialVariablePrivate::
+notifyBeginRead(IMeshComponent* component)
+{
+  // Les lectures faites par la fonction de calcul elle-même ne doivent
+  // pas déclencher de nouveau calcul.
+  if (!m_compute_function.get() || m_is_in_compute)
+    return;
+  _applyToMaterials(m_material_mng, component, [&](IMeshMaterial* mat) {
+    m_variable->update(mat);
+  });
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialVariablePrivate::
+notifyValuesModified(IMeshComponent* component)
+{
+  // Lors de l'exécution de la fonction de calcul, c'est setUpToDate() qui
+  // met à jour le tag de modification.
+  if (m_is_in_compute)
+    return;
+  _applyToMaterials(m_material_mng, component, [&](IMeshMaterial* mat) {
+    m_modified_times[mat->id()] = IVariable::incrementModifiedTime();
+  });
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -337,10 +406,21 @@ update(IMeshMaterial* mat)
     }
   }
   Int32 mat_id = mat->id();
+  IMeshMaterialVariableComputeFunction* cf = m_p->m_compute_function.get();
 
   bool need_update = false;
   Int64 modified_time = m_p->m_modified_times[mat_id];
+  // Si les mailles du matériau ou de son milieu ont changé depuis le
+  // dernier calcul, il faut recalculer les valeurs.
+  if (cf){
+    Int64 mat_topology_time = mat->_internalApi()->variableIndexer()->topologyModifiedTime();
+    Int64 env_topology_time = mat->environment()->_internalApi()->variableIndexer()->topologyModifiedTime();
+    if (mat_topology_time>modified_time || env_topology_time>modified_time)
+      need_update = true;
+  }
   for( VariableDependInfo& vdi : m_p->m_depends ){
+    if (need_update)
+      break;
     Int64 mt = vdi.variable()->modifiedTime();
     if (mt>modified_time){
       need_update = true;
@@ -358,9 +438,20 @@ update(IMeshMaterial* mat)
   }
 
   if (need_update){
-    IMeshMaterialVariableComputeFunction* cf = m_p->m_compute_function.get();
     if (cf){
-      cf->execute(mat);
+      m_p->m_is_in_compute = true;
+      try{
+        cf->execute(mat);
+      }
+      catch(...){
+        m_p->m_is_in_compute = false;
+        throw;
+      }
+      m_p->m_is_in_compute = false;
+      // Si la fonction de calcul n'a pas appelé setUpToDate(), le fait
+      // pour ne pas recalculer le matériau lors de la prochaine lecture.
+      if (m_p->m_modified_times[mat_id]==modified_time)
+        setUpToDate(mat);
     }
     else{
       ARCANE_FATAL("no compute function for variable '{0}'",name());
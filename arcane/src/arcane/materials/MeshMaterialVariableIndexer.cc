@@ -20,6 +20,8 @@
 #include "arcane/utils/ValueConvert.h"
 #include "arcane/utils/MemoryUtils.h"
 
+#include "arcane/core/IVariable.h"
+
 #include "arcane/materials/internal/MeshMaterialVariableIndexer.h"
 #include "arcane/materials/internal/ComponentItemListBuilder.h"
 #include "arcane/materials/internal/ConstituentModifierWorkInfo.h"
@@ -237,8 +239,86 @@ endUpdateRemoveV2(ConstituentModifierWorkInfo& work_info, Integer nb_remove, Run
                  nb_remove, nb_remove_computed, name());
   info(4) << "END_UPDATE_REMOVE nb_removed=" << nb_remove;
 
-  // TODO: il faut recalculer m_max_index_in_multiple_array
-  // et compacter éventuellement les variables. (pas indispensable)
+  // NOTE: m_max_index_in_multiple_array n'est pas recalculé et les valeurs
+  // partielles ne sont pas compactées. Cela est fait si nécessaire par
+  // compactMultipleArray().
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Nombre de valeurs partielles utilisées par l'indexeur.
+ *
+ * Ce nombre peut être inférieur à maxIndexInMultipleArray() s'il y a eu
+ * des suppressions depuis le dernier compactage.
+ */
+Int32 MeshMaterialVariableIndexer::
+nbPartialValue(RunQueue& queue) const
+{
+  const Int32 nb_item = nbItem();
+  if (nb_item == 0)
+    return 0;
+  SmallSpan<const MatVarIndex> matvar_indexes = m_matvar_indexes.view();
+  auto command = makeCommand(queue);
+  Arcane::Accelerator::ReducerSum2<Int32> nb_partial_reducer(command);
+  command << RUNCOMMAND_LOOP1(iter, nb_item, nb_partial_reducer)
+  {
+    auto [i] = iter();
+    if (matvar_indexes[i].arrayIndex() != 0)
+      nb_partial_reducer.combine(1);
+  };
+  return nb_partial_reducer.reducedValue();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Renumérote de manière contigüe les indices des valeurs partielles.
+ *
+ * Les valeurs partielles sont renumérotées de 0 à \a n-1 (avec \a n le
+ * nombre de valeurs partielles) en conservant leur ordre dans la liste
+ * des MatVarIndex. Pour chaque valeur partielle, son ancien indice est
+ * ajouté à \a old_indexes et son nouvel indice à \a new_indexes, ce qui
+ * permet ensuite de déplacer les valeurs des variables.
+ *
+ * Les tableaux de l'indexeur sont aussi réduits à leur taille utile.
+ *
+ * Retourne le nombre de valeurs partielles.
+ */
+Int32 MeshMaterialVariableIndexer::
+compactMultipleArray(Array<Int32>& old_indexes, Array<Int32>& new_indexes, RunQueue& queue)
+{
+  const Int32 nb_item = nbItem();
+  Int32 nb_partial = 0;
+  old_indexes.resize(nb_item);
+  new_indexes.resize(nb_item);
+  if (nb_item != 0) {
+    SmallSpan<MatVarIndex> matvar_indexes = m_matvar_indexes.view();
+    SmallSpan<Int32> old_indexes_view = old_indexes.view();
+    SmallSpan<Int32> new_indexes_view = new_indexes.view();
+    Accelerator::GenericFilterer filterer(&queue);
+    auto select_lambda = [=] ARCCORE_HOST_DEVICE(Int32 index) -> bool {
+      return matvar_indexes[index].arrayIndex() != 0;
+    };
+    auto setter_lambda = [=] ARCCORE_HOST_DEVICE(Int32 input_index, Int32 output_index) {
+      MatVarIndex mvi = matvar_indexes[input_index];
+      old_indexes_view[output_index] = mvi.valueIndex();
+      new_indexes_view[output_index] = output_index;
+      matvar_indexes[input_index] = MatVarIndex(mvi.arrayIndex(), output_index);
+    };
+    filterer.applyWithIndex(nb_item, select_lambda, setter_lambda, A_FUNCINFO);
+    nb_partial = filterer.nbOutputElement();
+  }
+  old_indexes.resize(nb_partial);
+  new_indexes.resize(nb_partial);
+
+  info(4) << "COMPACT_MULTIPLE_ARRAY name=" << name() << " nb_partial=" << nb_partial
+          << " old_size=" << maxIndexInMultipleArray();
+
+  m_max_index_in_multiple_array = nb_partial - 1;
+  m_matvar_indexes.shrink();
+  m_local_ids.shrink();
+  return nb_partial;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -398,6 +478,15 @@ _switchBetweenPureAndPartial(ConstituentModifierWorkInfo& work_info,
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void MeshMaterialVariableIndexer::
+notifyTopologyModified()
+{
+  m_topology_modified_time = IVariable::incrementModifiedTime();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void MeshMaterialVariableIndexer::
 checkValid()
 {
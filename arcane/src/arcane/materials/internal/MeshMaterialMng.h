@@ -277,6 +277,16 @@ class MeshMaterialMng
     return m_is_use_material_value_when_removing_partial_value;
   }
 
+  Int64 compactPartialValues() override;
+  void setPartialValuesCompactionRatio(Real v) override
+  {
+    m_partial_values_compaction_ratio = v;
+  }
+  Real partialValuesCompactionRatio() const override
+  {
+    return m_partial_values_compaction_ratio;
+  }
+
  public:
 
   AllEnvData* allEnvData() { return m_all_env_data.get(); }
@@ -284,6 +294,7 @@ class MeshMaterialMng
   void syncVariablesReferences(bool check_resize);
 
   void incrementTimestamp() { ++m_timestamp; }
+  void checkCompactPartialValues();
   void dumpInfos2(std::ostream& o);
 
   const MeshHandle& meshHandle() const { return m_mesh_handle; }
@@ -341,6 +352,11 @@ class MeshMaterialMng
   bool m_is_use_material_value_when_removing_partial_value = false;
   int m_modification_flags = 0;
   Real m_additional_capacity_ratio = 0.05;
+  Real m_partial_values_compaction_ratio = 0.0;
+  //! Nombre de compactages des valeurs partielles effectués
+  Int32 m_nb_compaction = 0;
+  //! Nombre total d'octets libérés par les compactages
+  Int64 m_total_compaction_reclaimed_bytes = 0;
 
   Mutex m_variable_lock;
 
@@ -386,6 +402,7 @@ class MeshMaterialMng
   MeshBlock* _findBlock(const String& name);
   MeshMaterial* _createMaterial(MeshEnvironment* env,MeshMaterialInfo* infos,const String& name);
   void _addVariableIndexer(MeshMaterialVariableIndexer* var_idx);
+  Int64 _compactPartialValues(ConstArrayView<MeshMaterialVariableIndexer*> indexers);
   void _checkEndCreate();
   void _addVariableUnlocked(IMeshMaterialVariable* var);
   void _saveInfosInProperties();
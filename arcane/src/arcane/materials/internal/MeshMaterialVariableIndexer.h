@@ -51,6 +51,7 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialVariableIndexer
 : public TraceAccessor
 {
   friend class AllEnvData;
+  friend class CellCentricMaterialLayout;
   friend class MaterialModifierOperation;
   friend class MeshEnvironment;
   friend class MeshMaterial;
@@ -82,11 +83,24 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialVariableIndexer
   //! Vrai si cet indexeur est celui d'un milieu.
   bool isEnvironment() const { return m_is_environment; }
 
+  /*!
+   * \brief Tag de la dernière modification de la liste des mailles.
+   *
+   * Ce tag est comparable à IVariable::modifiedTime() et permet de savoir
+   * si les variables calculées doivent être remises à jour pour ce constituant.
+   */
+  Int64 topologyModifiedTime() const { return m_topology_modified_time; }
+
+  //! Indique que la liste des mailles a été modifiée
+  void notifyTopologyModified();
+
  public:
 
   // Méthodes publiques car utilisées sur accélérateurs
   void endUpdateAdd(const ComponentItemListBuilder& builder, RunQueue& queue);
   void endUpdateRemoveV2(ConstituentModifierWorkInfo& work_info, Integer nb_remove, RunQueue& queue);
+  Int32 nbPartialValue(RunQueue& queue) const;
+  Int32 compactMultipleArray(Array<Int32>& old_indexes, Array<Int32>& new_indexes, RunQueue& queue);
 
  private:
 
@@ -138,6 +152,9 @@ class ARCANE_MATERIALS_EXPORT MeshMaterialVariableIndexer
   //! Vrai si l'indexeur est associé à un milieu.
   bool m_is_environment = false;
 
+  //! Tag de la dernière modification de la liste des mailles
+  Int64 m_topology_modified_time = 0;
+
  private:
 
   static void _changeLocalIdsV2(MeshMaterialVariableIndexer* var_indexer,
@@ -82,6 +82,11 @@ class MeshMaterialVariablePrivate
   }
   void syncReferences(bool check_resize) override;
   void resizeForIndexer(Int32 index, RunQueue& queue) override;
+  Int64 compactForIndexer(Int32 index, SmallSpan<const Int32> old_indexes,
+                          SmallSpan<const Int32> new_indexes,
+                          Array<std::byte>& buffer, RunQueue& queue) override;
+  void notifyBeginRead(IMeshComponent* component) override;
+  void notifyValuesModified(IMeshComponent* component) override;
 
  public:
 
@@ -118,6 +123,9 @@ class MeshMaterialVariablePrivate
   //! Fonction de calcul
   ScopedPtrT<IMeshMaterialVariableComputeFunction> m_compute_function;
 
+  //! Vrai si on est en cours d'exécution de la fonction de calcul
+  bool m_is_in_compute = false;
+
  private:
 
   bool m_has_recursive_depend = true;
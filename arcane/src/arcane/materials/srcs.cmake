@@ -2,6 +2,9 @@ set(ARCANE_SOURCES
   AllCellToAllEnvCellConverter.cc
   AllCellToAllEnvCellConverter.h
   AllEnvData.cc
+  CellCentricMaterialLayout.cc
+  CellCentricMaterialLayout.h
+  CellCentricMaterialVariableScalar.h
   ComponentItemInternal.h
   ComponentItem.h
   ComponentItemListBuilder.cc
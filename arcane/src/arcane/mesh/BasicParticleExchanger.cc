@@ -13,6 +13,14 @@
 
 #include "arcane/mesh/BasicParticleExchanger.h"
 
+#include "arcane/utils/MemoryView.h"
+
+#include "arcane/core/Concurrency.h"
+#include "arcane/core/IData.h"
+#include "arcane/core/internal/IDataInternal.h"
+
+#include <cstring>
+
 /*
  * NOTE:
  * Dans exchangeItems(), le tableau new_particle_local_ids
@@ -96,6 +104,7 @@ beginNewExchange(Integer i_nb_particle)
   if (options()){
     m_debug_exchange_items_level = options()->debugExchangeItemsLevel();
     m_max_nb_message_without_reduce = options()->maxNbMessageWithoutReduce();
+    m_use_packed_buffer = options()->usePackedBuffer();
   }
 
   m_nb_loop = 0;
@@ -130,6 +139,117 @@ beginNewExchange(Integer i_nb_particle)
   m_variables_to_exchange.clear();
   m_item_family->usedVariables(m_variables_to_exchange);
   m_variables_to_exchange.sortByName(true);
+  _computePackedLayout();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule la disposition des variables pour le format compact.
+ *
+ * Le format compact n'est utilisable que si toutes les variables à échanger
+ * sont des variables scalaires non partielles dont la donnée est numérique.
+ * Dans ce cas, les valeurs d'une particule sont rangées de manière contigüe
+ * dans un enregistrement de taille fixe, dans l'ordre de
+ * m_variables_to_exchange. Si ce n'est pas le cas, m_packed_record_size
+ * vaut 0 et on utilise IVariable::serialize().
+ */
+void BasicParticleExchanger::
+_computePackedLayout()
+{
+  m_packed_record_size = 0;
+  m_packed_variables.clear();
+  m_packed_offsets.clear();
+  if (!m_use_packed_buffer)
+    return;
+
+  Int32 record_size = 0;
+  for( VariableList::Enumerator i_var(m_variables_to_exchange); ++i_var; ){
+    IVariable* var = *i_var;
+    INumericDataInternal* num_data = var->data()->_commonInternal()->numericData();
+    if (!num_data || var->dimension()!=1 || var->isPartial()){
+      if (m_verbose_level>=1)
+        info() << "BasicParticleExchanger: packed buffer disabled because of variable '"
+               << var->name() << "'";
+      m_packed_variables.clear();
+      m_packed_offsets.clear();
+      return;
+    }
+    m_packed_variables.add(var);
+    m_packed_offsets.add(record_size);
+    record_size += num_data->memoryView().datatypeSize();
+  }
+  m_packed_record_size = record_size;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Recopie les valeurs des particules \a local_ids dans \a buffer.
+ *
+ * L'enregistrement de la i-ème particule commence à l'octet
+ * i * m_packed_record_size de \a buffer.
+ */
+void BasicParticleExchanger::
+_packVariables(Int32ConstArrayView local_ids,Span<Byte> buffer)
+{
+  const Int32 nb_var = m_packed_variables.size();
+  const Int64 record_size = m_packed_record_size;
+  UniqueArray<const std::byte*> var_data(nb_var);
+  UniqueArray<Int32> var_sizes(nb_var);
+  for( Int32 v=0; v<nb_var; ++v ){
+    MutableMemoryView mem_view = m_packed_variables[v]->data()->_commonInternal()->numericData()->memoryView();
+    var_data[v] = mem_view.data();
+    var_sizes[v] = mem_view.datatypeSize();
+  }
+  Byte* buf = buffer.data();
+  ParallelLoopOptions loop_options;
+  loop_options.setGrainSize(1024);
+  arcaneParallelFor(0,local_ids.size(),loop_options,[&](Integer begin,Integer size){
+    for( Integer z=begin, zend=begin+size; z<zend; ++z ){
+      Byte* record = buf + z * record_size;
+      const Int64 lid = local_ids[z];
+      for( Int32 v=0; v<nb_var; ++v ){
+        const Int32 s = var_sizes[v];
+        std::memcpy(record + m_packed_offsets[v],var_data[v] + lid * s,s);
+      }
+    }
+  });
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Recopie les valeurs de \a buffer dans les particules \a local_ids.
+ *
+ * Il s'agit de l'opération inverse de _packVariables(). Les variables
+ * doivent déjà avoir été redimensionnées pour contenir les nouvelles particules.
+ */
+void BasicParticleExchanger::
+_unpackVariables(Int32ConstArrayView local_ids,Span<const Byte> buffer)
+{
+  const Int32 nb_var = m_packed_variables.size();
+  const Int64 record_size = m_packed_record_size;
+  UniqueArray<std::byte*> var_data(nb_var);
+  UniqueArray<Int32> var_sizes(nb_var);
+  for( Int32 v=0; v<nb_var; ++v ){
+    MutableMemoryView mem_view = m_packed_variables[v]->data()->_commonInternal()->numericData()->memoryView();
+    var_data[v] = mem_view.data();
+    var_sizes[v] = mem_view.datatypeSize();
+  }
+  const Byte* buf = buffer.data();
+  ParallelLoopOptions loop_options;
+  loop_options.setGrainSize(1024);
+  arcaneParallelFor(0,local_ids.size(),loop_options,[&](Integer begin,Integer size){
+    for( Integer z=begin, zend=begin+size; z<zend; ++z ){
+      const Byte* record = buf + z * record_size;
+      const Int64 lid = local_ids[z];
+      for( Int32 v=0; v<nb_var; ++v ){
+        const Int32 s = var_sizes[v];
+        std::memcpy(var_data[v] + lid * s,record + m_packed_offsets[v],s);
+      }
+    }
+  });
 }
 
 /*---------------------------------------------------------------------------*/
@@ -467,14 +587,22 @@ _serializeMessage(ISerializeMessage* sm,
   sbuf->reserve(DT_Int64,1);
   // Réserve pour le nombre de uniqueId()
   sbuf->reserve(DT_Int64,1);
+  // Réserve pour la taille d'un enregistrement (0 si pas de format compact)
+  sbuf->reserve(DT_Int64,1);
   sbuf->reserveSpan(DT_Int64,nb_item);
   // Réserve pour les uniqueId() des mailles dans lesquelles se trouvent les particules
   //sbuf->reserve(DT_Size,1);
   sbuf->reserveSpan(DT_Int64,nb_item);
 
-  for( VariableList::Enumerator i_var(m_variables_to_exchange); ++i_var; ){
-    IVariable* var = *i_var;
-    var->serialize(sbuf,acc_ids);
+  const Int64 record_size = m_packed_record_size;
+  if (record_size!=0){
+    sbuf->reserveSpan(DT_Byte,nb_item*record_size);
+  }
+  else{
+    for( VariableList::Enumerator i_var(m_variables_to_exchange); ++i_var; ){
+      IVariable* var = *i_var;
+      var->serialize(sbuf,acc_ids);
+    }
   }
 
   // Sérialise les données en écriture
@@ -491,6 +619,7 @@ _serializeMessage(ISerializeMessage* sm,
   ++m_serialize_id;
 
   sbuf->putInt64(nb_item);
+  sbuf->putInt64(record_size);
   items_to_send_uid.resize(nb_item);
   items_to_send_cells_uid.resize(nb_item);
   for( Integer z=0; z<nb_item; ++z ){
@@ -509,11 +638,17 @@ _serializeMessage(ISerializeMessage* sm,
   sbuf->putSpan(items_to_send_uid);
   sbuf->putSpan(items_to_send_cells_uid);
 
-  for( VariableList::Enumerator i_var(m_variables_to_exchange); ++i_var; ){
-    IVariable* var = *i_var;
-    var->serialize(sbuf,acc_ids);
+  if (record_size!=0){
+    m_packed_buffer.resize(nb_item*record_size);
+    _packVariables(acc_ids,m_packed_buffer);
+    sbuf->putSpan(Span<const Byte>(m_packed_buffer));
+  }
+  else{
+    for( VariableList::Enumerator i_var(m_variables_to_exchange); ++i_var; ){
+      IVariable* var = *i_var;
+      var->serialize(sbuf,acc_ids);
+    }
   }
-
 }
 
 /*---------------------------------------------------------------------------*/
@@ -540,9 +675,15 @@ _deserializeMessage(ISerializeMessage* message,
   {
     Int64 serialize_id = sbuf->getInt64();
     Int64 nb_item = sbuf->getInt64();
+    Int64 record_size = sbuf->getInt64();
     if (m_debug_exchange_items_level>=1)
       info() << "BSE_DeserializeMessage id=" << serialize_id << " nb=" << nb_item
-             << " orig=" << message->destination();
+             << " record_size=" << record_size << " orig=" << message->destination();
+    // Tous les sous-domaines doivent avoir les mêmes variables et les mêmes options.
+    if (record_size!=m_packed_record_size)
+      ARCANE_FATAL("Bad packed record size received={0} expected={1} (orig={2})."
+                   " All sub-domains should have the same variables and the same value for option 'use-packed-buffer'",
+                   record_size,m_packed_record_size,message->destination());
 
     items_to_create_local_id.resize(nb_item);
     items_to_create_unique_id.resize(nb_item);
@@ -583,9 +724,16 @@ _deserializeMessage(ISerializeMessage* message,
       item_group.addItems(items_to_create_local_id,false);
     if (new_particle_local_ids)
       new_particle_local_ids->addRange(items_to_create_local_id);
-    for( VariableCollection::Enumerator i_var(m_variables_to_exchange); ++i_var; ){
-      IVariable* var = *i_var;
-      var->serialize(sbuf,items_to_create_local_id);
+    if (record_size!=0){
+      m_packed_buffer.resize(nb_item*record_size);
+      sbuf->getSpan(Span<Byte>(m_packed_buffer));
+      _unpackVariables(items_to_create_local_id,m_packed_buffer);
+    }
+    else{
+      for( VariableCollection::Enumerator i_var(m_variables_to_exchange); ++i_var; ){
+        IVariable* var = *i_var;
+        var->serialize(sbuf,items_to_create_local_id);
+      }
     }
   }
 }
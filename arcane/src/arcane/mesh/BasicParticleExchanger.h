@@ -153,6 +153,21 @@ class BasicParticleExchanger
    */
   Int32 m_max_nb_message_without_reduce = 15;
 
+  //! Indique si on utilise le format compact lorsque c'est possible
+  bool m_use_packed_buffer = true;
+  /*!
+   * \brief Taille en octet de l'enregistrement d'une particule pour le format compact.
+   *
+   * Si nul, les variables sont sérialisées une par une via IVariable::serialize().
+   */
+  Int32 m_packed_record_size = 0;
+  //! Variables échangées avec le format compact
+  UniqueArray<IVariable*> m_packed_variables;
+  //! Position de chaque variable dans l'enregistrement
+  UniqueArray<Int32> m_packed_offsets;
+  //! Tampon pour le format compact (conservé pour éviter les réallocations)
+  UniqueArray<Byte> m_packed_buffer;
+
  private:
 
   void _clearMessages();
@@ -172,6 +187,9 @@ class BasicParticleExchanger
                        Int32ConstArrayView communicating_sub_domains,
                        UniqueArray< SharedArray<Int32> >& ids_to_send);
   void _sendPendingMessages();
+  void _computePackedLayout();
+  void _packVariables(Int32ConstArrayView local_ids,Span<Byte> buffer);
+  void _unpackVariables(Int32ConstArrayView local_ids,Span<const Byte> buffer);
 
   void _generateSendItems(Int32ConstArrayView local_ids,Int32ConstArrayView sub_domains_to_send);
   void _checkInitialized();
@@ -21,7 +21,7 @@
 #include "arcane/core/IParallelMng.h"
 #include "arcane/core/Timer.h"
 
-#include "arcane/parallel/BitonicSortT.H"
+#include "arcane/core/parallel/SampleSortT.H"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -653,7 +653,7 @@ _computeParallel()
   }
 
   info() << "ALL_FACE_LIST memorysize=" << sizeof(AnyFaceInfo)*all_face_list.size();
-  Parallel::BitonicSort<AnyFaceInfo,AnyFaceBitonicSortTraits> all_face_sorter(pm);
+  Parallel::SampleSort<AnyFaceInfo,AnyFaceBitonicSortTraits> all_face_sorter(pm);
   all_face_sorter.setNeedIndexAndRank(false);
   Real sort_begin_time = platform::getRealTime();
   all_face_sorter.sort(all_face_list);
@@ -677,7 +677,7 @@ _computeAndSortBoundaryFaces(Array<BoundaryFaceInfo>& boundary_faces_info)
   bool is_verbose = m_is_verbose;
   ItemInternalMap& faces_map = m_mesh->facesMap();
 
-  Parallel::BitonicSort<BoundaryFaceInfo,BoundaryFaceBitonicSortTraits> boundary_face_sorter(pm);
+  Parallel::SampleSort<BoundaryFaceInfo,BoundaryFaceBitonicSortTraits> boundary_face_sorter(pm);
   boundary_face_sorter.setNeedIndexAndRank(false);
 
   //UniqueArray<BoundaryFaceInfo> boundary_face_list;
@@ -18,7 +18,7 @@
 #include "arcane/utils/CheckedConvert.h"
 #include "arcane/utils/ValueConvert.h"
 
-#include "arcane/core/parallel/BitonicSortT.H"
+#include "arcane/core/parallel/SampleSortT.H"
 
 #include "arcane/core/IParallelExchanger.h"
 #include "arcane/core/ISerializeMessage.h"
@@ -828,7 +828,7 @@ _sortBoundaryNodeList(Array<BoundaryNodeInfo>& boundary_node_list)
   Int32 nb_rank = pm->commSize();
   bool is_verbose = m_is_verbose;
 
-  Parallel::BitonicSort<BoundaryNodeInfo,BoundaryNodeBitonicSortTraits> boundary_node_sorter(pm);
+  Parallel::SampleSort<BoundaryNodeInfo,BoundaryNodeBitonicSortTraits> boundary_node_sorter(pm);
   boundary_node_sorter.setNeedIndexAndRank(false);
 
   {
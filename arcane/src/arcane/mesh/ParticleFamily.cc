@@ -15,6 +15,7 @@
 
 #include "arcane/utils/FatalErrorException.h"
 #include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/MemoryUtils.h"
 
 #include "arcane/mesh/ItemsExchangeInfo2.h"
 #include "arcane/mesh/DynamicMesh.h"
@@ -28,6 +29,11 @@
 #include "arcane/IVariableMng.h"
 #include "arcane/Properties.h"
 #include "arcane/ItemPrinter.h"
+#include "arcane/IItemInternalSortFunction.h"
+
+#include "arcane/core/Concurrency.h"
+
+#include <algorithm>
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -35,6 +41,126 @@
 namespace Arcane::mesh
 {
 
+namespace
+{
+  /*!
+   * \brief Tri par comptage stable et parallèle.
+   *
+   * \a keys contient pour chaque indice \a i une clé comprise entre 0 et
+   * \a nb_bucket (exclu). En retour, \a sorted_indexes contient les indices
+   * rangés par clé croissante et, pour une même clé, par indice croissant.
+   * Les indices de clé \a k sont entre les positions offsets[k] et
+   * offsets[k+1] (exclue) de \a sorted_indexes.
+   *
+   * Les indices sont découpés en blocs traités en parallèle. Chaque bloc
+   * calcule son propre histogramme, puis après un préfixe sur les
+   * histogrammes chaque bloc range ses indices sans conflit avec les autres.
+   */
+  void _parallelCountingSort(ConstArrayView<Int32> keys, Int32 nb_bucket,
+                             Array<Int32>& offsets, Array<Int32>& sorted_indexes)
+  {
+    const Int32 n = keys.size();
+    // La taille des histogrammes est nb_block*nb_bucket. On limite le nombre
+    // de blocs pour que cette taille reste de l'ordre de grandeur de \a n.
+    const Int32 min_block_size = 4096;
+    Int32 nb_block = TaskFactory::nbAllowedThread();
+    nb_block = std::min(nb_block, 1 + n / min_block_size);
+    nb_block = std::min(nb_block, 1 + static_cast<Int32>((4 * static_cast<Int64>(n)) / (nb_bucket + 1)));
+    nb_block = std::max(nb_block, 1);
+    const Int32 block_size = (n + nb_block - 1) / nb_block;
+
+    UniqueArray<Int32> counts(static_cast<Int64>(nb_block) * nb_bucket);
+    counts.fill(0);
+    ParallelLoopOptions loop_options;
+    loop_options.setGrainSize(1);
+    arcaneParallelFor(0, nb_block, loop_options, [&](Integer begin, Integer size) {
+      for (Integer b = begin; b < (begin + size); ++b) {
+        Int32* block_counts = counts.data() + static_cast<Int64>(b) * nb_bucket;
+        for (Int32 i = b * block_size, iend = std::min(n, (b + 1) * block_size); i < iend; ++i)
+          ++block_counts[keys[i]];
+      }
+    });
+
+    // Transforme les histogrammes en positions de début pour chaque bloc.
+    offsets.resize(nb_bucket + 1);
+    Int32 position = 0;
+    for (Int32 k = 0; k < nb_bucket; ++k) {
+      offsets[k] = position;
+      for (Int32 b = 0; b < nb_block; ++b) {
+        Int32& v = counts[static_cast<Int64>(b) * nb_bucket + k];
+        Int32 nb = v;
+        v = position;
+        position += nb;
+      }
+    }
+    offsets[nb_bucket] = position;
+
+    sorted_indexes.resize(n);
+    arcaneParallelFor(0, nb_block, loop_options, [&](Integer begin, Integer size) {
+      for (Integer b = begin; b < (begin + size); ++b) {
+        Int32* block_positions = counts.data() + static_cast<Int64>(b) * nb_bucket;
+        for (Int32 i = b * block_size, iend = std::min(n, (b + 1) * block_size); i < iend; ++i)
+          sorted_indexes[block_positions[keys[i]]++] = i;
+      }
+    });
+  }
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Fonction de tri des particules par maille.
+ *
+ * Les particules sont rangées par numéro local de maille croissant. Les
+ * particules sans maille sont ensuite rangées, puis les particules détruites.
+ * Le tri est stable: dans une même maille, l'ordre des particules est conservé.
+ */
+class ParticleCellSortFunction
+: public IItemInternalSortFunction
+{
+ public:
+
+  explicit ParticleCellSortFunction(IItemFamily* cell_family)
+  : m_name("ArcaneParticleCell")
+  , m_cell_family(cell_family)
+  {}
+
+ public:
+
+  const String& name() const override { return m_name; }
+
+  void sortItems(ItemInternalMutableArrayView items) override
+  {
+    const Int32 nb_cell = m_cell_family->maxLocalId();
+    const Int32 no_cell_key = nb_cell;
+    const Int32 suppressed_key = nb_cell + 1;
+    const Int32 n = items.size();
+    UniqueArray<Int32> keys(n);
+    arcaneParallelFor(0, n, [&](Integer begin, Integer size) {
+      for (Integer i = begin; i < (begin + size); ++i) {
+        ItemInternal* ii = items[i];
+        if (ii->isSuppressed())
+          keys[i] = suppressed_key;
+        else {
+          Particle p(ii);
+          keys[i] = (p.hasCell()) ? p.cellId().localId() : no_cell_key;
+        }
+      }
+    });
+    UniqueArray<Int32> offsets;
+    UniqueArray<Int32> sorted_indexes;
+    _parallelCountingSort(keys, nb_cell + 2, offsets, sorted_indexes);
+    UniqueArray<ItemInternal*> old_items(items);
+    for (Int32 i = 0; i < n; ++i)
+      items[i] = old_items[sorted_indexes[i]];
+  }
+
+ private:
+
+  String m_name;
+  IItemFamily* m_cell_family;
+};
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -46,6 +172,8 @@ ParticleFamily(IMesh* mesh, const String& name)
 , m_sub_domain_id(NULL_SUB_DOMAIN_ID)
 , m_enable_ghost_items(false)
 , m_cell_connectivity(nullptr)
+, m_cell_particle_offsets(MemoryUtils::getAllocatorForMostlyReadOnlyData())
+, m_cell_particle_local_ids(MemoryUtils::getAllocatorForMostlyReadOnlyData())
 {
 }
 
@@ -167,6 +295,7 @@ void ParticleFamily::
 _setCell(ItemLocalId particle, ItemLocalId cell)
 {
   m_cell_connectivity->replaceItem(particle, 0, cell);
+  m_is_cell_particle_index_valid = false;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -228,6 +357,7 @@ _addItems(Int64ConstArrayView unique_ids, Int32ArrayView items)
   }
 
   m_need_prepare_dump = true;
+  m_is_cell_particle_index_valid = false;
   _printInfos(nb_item);
 }
 
@@ -256,6 +386,7 @@ addItems(Int64ConstArrayView unique_ids, Int32ConstArrayView owners, Int32ArrayV
   }
 
   m_need_prepare_dump = true;
+  m_is_cell_particle_index_valid = false;
   _printInfos(nb_item);
 }
 
@@ -339,6 +470,7 @@ internalRemoveItems(Int32ConstArrayView local_ids, bool keep_ghost)
   _removeMany(local_ids);
 
   m_need_prepare_dump = true;
+  m_is_cell_particle_index_valid = false;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -371,6 +503,80 @@ readFromDump()
   ItemFamily::readFromDump();
   // Actualise le shared_info car il peut changer suite à une relecture
   _setSharedInfo();
+  m_is_cell_particle_index_valid = false;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ParticleFamily::
+setCellSortedMode(bool v)
+{
+  if (v == m_is_cell_sorted_mode)
+    return;
+  m_is_cell_sorted_mode = v;
+  // Si nul, setItemSortFunction() remet la fonction de tri par défaut.
+  setItemSortFunction((v) ? new ParticleCellSortFunction(mesh()->cellFamily()) : nullptr);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ParticleFamily::
+sortParticlesByCell()
+{
+  if (!m_is_cell_sorted_mode)
+    ARCANE_FATAL("Family '{0}': cell sorted mode is not active. Call setCellSortedMode(true) before", name());
+  compactItems(true);
+  _computeCellParticleIndex();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+CellParticleIndexView ParticleFamily::
+cellParticleIndexView()
+{
+  if (!m_is_cell_particle_index_valid || m_cell_particle_index_timestamp != mesh()->timestamp())
+    _computeCellParticleIndex();
+  return CellParticleIndexView(m_cell_particle_offsets, m_cell_particle_local_ids);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule l'index maille->particules.
+ *
+ * Les particules sont parcourues par numéro local croissant donc dans une
+ * maille elles sont rangées par numéro local croissant. Les particules
+ * sans maille ne sont pas dans l'index.
+ */
+void ParticleFamily::
+_computeCellParticleIndex()
+{
+  const Int32 nb_cell = mesh()->cellFamily()->maxLocalId();
+  const Int32 no_cell_key = nb_cell;
+  const Int32 max_local_id = maxLocalId();
+  ItemInternalList internals = itemsInternal();
+  UniqueArray<Int32> keys(max_local_id);
+  arcaneParallelFor(0, max_local_id, [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); ++i) {
+      ItemInternal* ii = internals[i];
+      if (ii->isSuppressed())
+        keys[i] = no_cell_key;
+      else {
+        Particle p(ii);
+        keys[i] = (p.hasCell()) ? p.cellId().localId() : no_cell_key;
+      }
+    }
+  });
+  _parallelCountingSort(keys, nb_cell + 1, m_cell_particle_offsets, m_cell_particle_local_ids);
+  // Supprime le dernier intervalle qui contient les particules sans maille.
+  m_cell_particle_offsets.resize(nb_cell + 1);
+  m_cell_particle_local_ids.resize(m_cell_particle_offsets[nb_cell]);
+
+  m_is_cell_particle_index_valid = true;
+  m_cell_particle_index_timestamp = mesh()->timestamp();
 }
 
 /*---------------------------------------------------------------------------*/
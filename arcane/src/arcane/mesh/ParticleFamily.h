@@ -30,6 +30,7 @@ namespace Arcane::mesh
 class IncrementalItemConnectivity;
 class OneItemIncrementalItemConnectivity;
 class ItemSharedInfoWithType;
+class ParticleFamilyCompactPolicy;
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -40,6 +41,8 @@ class ARCANE_MESH_EXPORT ParticleFamily
 : public ItemFamily
 , public IParticleFamily
 {
+  friend ParticleFamilyCompactPolicy;
+
  private:
 
   typedef ItemConnectivitySelectorT<CellInternalConnectivityIndex,OneItemIncrementalItemConnectivity> CellConnectivity;
@@ -90,7 +93,16 @@ class ARCANE_MESH_EXPORT ParticleFamily
   void setParticleCell(Particle particle,Cell new_cell) override;
   void setParticlesCell(ParticleVectorView particles,CellVectorView new_cells) override;
 
-  void endUpdate() override { ItemFamily::endUpdate(); }
+  void endUpdate() override
+  {
+    ItemFamily::endUpdate();
+    m_is_cell_particle_index_valid = false;
+  }
+
+  void setCellSortedMode(bool v) override;
+  bool isCellSortedMode() const override { return m_is_cell_sorted_mode; }
+  void sortParticlesByCell() override;
+  CellParticleIndexView cellParticleIndexView() override;
 
  public:
   
@@ -126,6 +138,14 @@ class ARCANE_MESH_EXPORT ParticleFamily
   Int32 m_sub_domain_id;
   bool m_enable_ghost_items;
   CellConnectivity* m_cell_connectivity;
+  bool m_is_cell_sorted_mode = false;
+  //! Indique si l'index maille->particules est à jour
+  bool m_is_cell_particle_index_valid = false;
+  //! Valeur de IMesh::timestamp() lors du calcul de l'index
+  Int64 m_cell_particle_index_timestamp = -1;
+  //! Index maille->particules au format CSR
+  UniqueArray<Int32> m_cell_particle_offsets;
+  UniqueArray<Int32> m_cell_particle_local_ids;
 
   inline ItemInternal* _allocParticle(Int64 uid,bool& need_alloc);
   inline ItemInternal* _findOrAllocParticle(Int64 uid,bool& is_alloc);
@@ -135,6 +155,8 @@ class ARCANE_MESH_EXPORT ParticleFamily
   inline void _setCell(ItemLocalId particle,ItemLocalId cell);
   inline void _initializeNewlyAllocatedParticle(ItemInternal* particle,Int64 uid);
   void _addItems(Int64ConstArrayView unique_ids,Int32ArrayView items);
+  void _computeCellParticleIndex();
+  void _invalidateCellParticleIndex() { m_is_cell_particle_index_valid = false; }
 };
 
 /*---------------------------------------------------------------------------*/
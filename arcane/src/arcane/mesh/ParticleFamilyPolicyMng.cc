@@ -65,8 +65,10 @@ class ParticleFamilyCompactPolicy
   }
   void endCompact(ItemFamilyCompactInfos& compact_infos) override
   {
-    if (_checkWantCompact(compact_infos))
+    if (_checkWantCompact(compact_infos)){
       m_family->finishCompactItems(compact_infos);
+      m_family->_invalidateCellParticleIndex();
+    }
   }
   void finalizeCompact(IMeshCompacter* compacter) override
   {
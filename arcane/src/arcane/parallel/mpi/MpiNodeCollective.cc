@@ -0,0 +1,264 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MpiNodeCollective.cc                                        (C) 2000-2024 */
+/*                                                                           */
+/* Opérations collectives MPI en deux niveaux (noeud puis inter-noeuds).     */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/parallel/mpi/MpiNodeCollective.h"
+
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/ITraceMng.h"
+#include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/ValueConvert.h"
+
+#include "arcane/core/parallel/IStat.h"
+
+#include "arcane/parallel/mpi/MpiLock.h"
+
+#include <cstring>
+#include <limits>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MpiNodeCollective::
+MpiNodeCollective(MPI_Comm comm, MpiLock* mpi_lock, Parallel::IStat* stat)
+: m_mpi_lock(mpi_lock)
+, m_stat(stat)
+{
+  MpiLock::Section mls(m_mpi_lock);
+
+  int comm_rank = 0;
+  int comm_size = 0;
+  MPI_Comm_rank(comm, &comm_rank);
+  MPI_Comm_size(comm, &comm_size);
+
+  int r = MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, comm_rank, MPI_INFO_NULL, &m_node_communicator);
+  if (r != MPI_SUCCESS)
+    ARCANE_FATAL("Error '{0}' in MPI_Comm_split_type", r);
+  int node_rank = 0;
+  int node_size = 0;
+  MPI_Comm_rank(m_node_communicator, &node_rank);
+  MPI_Comm_size(m_node_communicator, &node_size);
+  m_comm_size = comm_size;
+  m_node_rank = node_rank;
+  m_node_size = node_size;
+
+  int color = (node_rank == 0) ? 0 : MPI_UNDEFINED;
+  r = MPI_Comm_split(comm, color, comm_rank, &m_leader_communicator);
+  if (r != MPI_SUCCESS)
+    ARCANE_FATAL("Error '{0}' in MPI_Comm_split", r);
+
+  // Le leader diffuse son rang parmi les leaders à tout son noeud.
+  int node_index = 0;
+  if (m_leader_communicator != MPI_COMM_NULL)
+    MPI_Comm_rank(m_leader_communicator, &node_index);
+  MPI_Bcast(&node_index, 1, MPI_INT, 0, m_node_communicator);
+  m_node_index = node_index;
+
+  // Chaque rang doit connaître le noeud et le rang dans le noeud
+  // de tous les autres pour pouvoir faire une diffusion depuis n'importe
+  // quel rang.
+  int my_info[3] = { node_index, node_rank, node_size };
+  UniqueArray<int> all_infos(3 * comm_size);
+  MPI_Allgather(my_info, 3, MPI_INT, all_infos.data(), 3, MPI_INT, comm);
+  m_rank_node_index.resize(comm_size);
+  m_rank_node_rank.resize(comm_size);
+  for (Int32 i = 0; i < comm_size; ++i) {
+    m_rank_node_index[i] = all_infos[3 * i];
+    m_rank_node_rank[i] = all_infos[3 * i + 1];
+    m_nb_node = math::max(m_nb_node, all_infos[3 * i] + 1);
+    m_max_nb_rank_per_node = math::max(m_max_nb_rank_per_node, all_infos[3 * i + 2]);
+  }
+  m_node_nb_rank.resize(m_nb_node);
+  for (Int32 i = 0; i < comm_size; ++i)
+    m_node_nb_rank[m_rank_node_index[i]] = all_infos[3 * i + 2];
+  m_node_first_index.resize(m_nb_node);
+  Int32 first_index = 0;
+  for (Int32 i = 0; i < m_nb_node; ++i) {
+    m_node_first_index[i] = first_index;
+    first_index += m_node_nb_rank[i];
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MpiNodeCollective::
+~MpiNodeCollective()
+{
+  MpiLock::Section mls(m_mpi_lock);
+  if (m_leader_communicator != MPI_COMM_NULL)
+    MPI_Comm_free(&m_leader_communicator);
+  if (m_node_communicator != MPI_COMM_NULL)
+    MPI_Comm_free(&m_node_communicator);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MpiNodeCollective* MpiNodeCollective::
+createIfEnabled(ITraceMng* tm, MPI_Comm comm, MpiLock* mpi_lock, Parallel::IStat* stat)
+{
+  auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_MPI_NODE_AWARE_COLLECTIVE", true);
+  if (!v || v.value() == 0)
+    return nullptr;
+  // Le changement d'ordre des opérations n'est pas compatible
+  // avec les réductions ordonnées.
+  if (platform::getEnvironmentVariable("ARCANE_ORDERED_REDUCE") == "TRUE")
+    return nullptr;
+  int comm_size = 0;
+  {
+    MpiLock::Section mls(mpi_lock);
+    MPI_Comm_size(comm, &comm_size);
+  }
+  if (comm_size < 2)
+    return nullptr;
+  auto* nc = new MpiNodeCollective(comm, mpi_lock, stat);
+  if (!nc->isUseful()) {
+    delete nc;
+    return nullptr;
+  }
+  tm->info() << "Using node aware MPI collectives nb_node=" << nc->nbNode()
+             << " max_nb_rank_per_node=" << nc->maxNbRankPerNode();
+  return nc;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiNodeCollective::
+allReduce(void* buf, Int64 count, MPI_Datatype datatype, MPI_Op op)
+{
+  int n = _checkSize(count);
+  double begin_time = MPI_Wtime();
+  {
+    MpiLock::Section mls(m_mpi_lock);
+    if (m_node_rank == 0)
+      MPI_Reduce(MPI_IN_PLACE, buf, n, datatype, op, 0, m_node_communicator);
+    else
+      MPI_Reduce(buf, nullptr, n, datatype, op, 0, m_node_communicator);
+    if (m_leader_communicator != MPI_COMM_NULL)
+      MPI_Allreduce(MPI_IN_PLACE, buf, n, datatype, op, m_leader_communicator);
+    MPI_Bcast(buf, n, datatype, 0, m_node_communicator);
+  }
+  double end_time = MPI_Wtime();
+  if (m_stat)
+    m_stat->add("NodeAllReduce", end_time - begin_time, count);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Diffusion en place depuis le rang \a root.
+ *
+ * Si \a root n'est pas le leader de son noeud, les valeurs sont d'abord
+ * diffusées dans le noeud de \a root. Le leader de ce noeud les diffuse
+ * ensuite aux autres leaders qui les diffusent dans leur noeud.
+ */
+void MpiNodeCollective::
+broadcast(void* buf, Int64 count, MPI_Datatype datatype, Int32 root)
+{
+  int n = _checkSize(count);
+  const Int32 root_node_index = m_rank_node_index[root];
+  const Int32 root_node_rank = m_rank_node_rank[root];
+  double begin_time = MPI_Wtime();
+  {
+    MpiLock::Section mls(m_mpi_lock);
+    const bool is_root_node = (m_node_index == root_node_index);
+    if (is_root_node)
+      MPI_Bcast(buf, n, datatype, root_node_rank, m_node_communicator);
+    if (m_leader_communicator != MPI_COMM_NULL)
+      MPI_Bcast(buf, n, datatype, root_node_index, m_leader_communicator);
+    if (!is_root_node)
+      MPI_Bcast(buf, n, datatype, 0, m_node_communicator);
+  }
+  double end_time = MPI_Wtime();
+  if (m_stat)
+    m_stat->add("NodeBroadcast", end_time - begin_time, count);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Rassemblement sur tous les rangs.
+ *
+ * Les rangs d'un noeud ne sont pas forcément consécutifs dans le
+ * communicateur d'origine. Les leaders remettent donc les valeurs reçues
+ * dans l'ordre des rangs avant de les diffuser dans leur noeud.
+ */
+void MpiNodeCollective::
+allGather(const void* send_buf, Int64 send_count, void* recv_buf, Int64 recv_count,
+          MPI_Datatype datatype)
+{
+  if (recv_count != send_count * m_comm_size)
+    ARCANE_FATAL("Bad size for receive buffer n={0} expected={1}", recv_count, send_count * m_comm_size);
+  int n = _checkSize(send_count);
+  int total_n = _checkSize(recv_count);
+  double begin_time = MPI_Wtime();
+  {
+    MpiLock::Section mls(m_mpi_lock);
+    MPI_Aint lower_bound = 0;
+    MPI_Aint extent = 0;
+    MPI_Type_get_extent(datatype, &lower_bound, &extent);
+    const Int64 block_size = static_cast<Int64>(n) * extent;
+    void* mutable_send_buf = const_cast<void*>(send_buf);
+    if (m_leader_communicator != MPI_COMM_NULL) {
+      UniqueArray<std::byte> node_values(block_size * m_node_size);
+      MPI_Gather(mutable_send_buf, n, datatype, node_values.data(), n, datatype, 0, m_node_communicator);
+      UniqueArray<std::byte> all_values(block_size * m_comm_size);
+      UniqueArray<int> counts(m_nb_node);
+      UniqueArray<int> displacements(m_nb_node);
+      for (Int32 i = 0; i < m_nb_node; ++i) {
+        counts[i] = m_node_nb_rank[i] * n;
+        displacements[i] = m_node_first_index[i] * n;
+      }
+      MPI_Allgatherv(node_values.data(), m_node_size * n, datatype, all_values.data(),
+                     counts.data(), displacements.data(), datatype, m_leader_communicator);
+      auto* out_values = static_cast<std::byte*>(recv_buf);
+      for (Int32 i = 0; i < m_comm_size; ++i) {
+        Int64 index = m_node_first_index[m_rank_node_index[i]] + m_rank_node_rank[i];
+        std::memcpy(out_values + block_size * i, all_values.data() + block_size * index, block_size);
+      }
+    }
+    else
+      MPI_Gather(mutable_send_buf, n, datatype, nullptr, 0, datatype, 0, m_node_communicator);
+    MPI_Bcast(recv_buf, total_n, datatype, 0, m_node_communicator);
+  }
+  double end_time = MPI_Wtime();
+  if (m_stat)
+    m_stat->add("NodeAllGather", end_time - begin_time, recv_count);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+int MpiNodeCollective::
+_checkSize(Int64 count)
+{
+  if (count > std::numeric_limits<int>::max())
+    ARCANE_FATAL("Too many values for node collective (n={0} max={1})",
+                 count, std::numeric_limits<int>::max());
+  return static_cast<int>(count);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
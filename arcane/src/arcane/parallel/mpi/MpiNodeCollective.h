@@ -0,0 +1,138 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MpiNodeCollective.h                                         (C) 2000-2024 */
+/*                                                                           */
+/* Opérations collectives MPI en deux niveaux (noeud puis inter-noeuds).     */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_PARALLEL_MPI_MPINODECOLLECTIVE_H
+#define ARCANE_PARALLEL_MPI_MPINODECOLLECTIVE_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/Array.h"
+
+#include "arcane/core/Parallel.h"
+
+#include "arcane/parallel/mpi/ArcaneMpi.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Opérations collectives MPI tenant compte des noeuds de calcul.
+ *
+ * Les rangs du communicateur sont regroupés par noeud via
+ * MPI_Comm_split_type(MPI_COMM_TYPE_SHARED). Le rang 0 de chaque noeud
+ * (le leader) appartient en plus à un communicateur contenant tous
+ * les leaders.
+ *
+ * Une réduction se fait alors en trois étapes: réduction sur le leader
+ * de chaque noeud, réduction entre leaders puis diffusion dans chaque noeud.
+ * Seuls les leaders communiquent entre les noeuds ce qui diminue la latence
+ * lorsqu'il y a beaucoup de rangs par noeud. Le principe est le même
+ * pour la diffusion.
+ *
+ * Pour allGather(), les valeurs de chaque noeud sont d'abord rassemblées
+ * sur son leader, échangées entre leaders puis diffusées dans chaque noeud.
+ *
+ * Les opérations de cette classe sont collectives sur le communicateur
+ * d'origine.
+ */
+class ARCANE_MPI_EXPORT MpiNodeCollective
+{
+ public:
+
+  MpiNodeCollective(MPI_Comm comm, MpiLock* mpi_lock, Parallel::IStat* stat);
+  MpiNodeCollective(const MpiNodeCollective&) = delete;
+  MpiNodeCollective& operator=(const MpiNodeCollective&) = delete;
+  ~MpiNodeCollective();
+
+ public:
+
+  /*!
+   * \brief Créé une instance si la variable d'environnement
+   * ARCANE_MPI_NODE_AWARE_COLLECTIVE est positionnée.
+   *
+   * Cette méthode est collective sur \a comm. Elle retourne \a nullptr
+   * si les opérations en deux niveaux ne sont pas demandées ou pas utiles.
+   */
+  static MpiNodeCollective* createIfEnabled(ITraceMng* tm, MPI_Comm comm, MpiLock* mpi_lock,
+                                            Parallel::IStat* stat);
+
+ public:
+
+  //! Nombre de noeuds
+  Int32 nbNode() const { return m_nb_node; }
+
+  //! Nombre maximum de rangs sur un noeud
+  Int32 maxNbRankPerNode() const { return m_max_nb_rank_per_node; }
+
+  /*!
+   * \brief Indique si les opérations en deux niveaux sont intéressantes.
+   *
+   * C'est le cas s'il y a au moins un noeud avec plusieurs rangs.
+   */
+  bool isUseful() const { return m_max_nb_rank_per_node > 1; }
+
+  //! Réduction en place de \a count valeurs de \a buf
+  void allReduce(void* buf, Int64 count, MPI_Datatype datatype, MPI_Op op);
+
+  //! Diffusion en place de \a count valeurs de \a buf depuis le rang \a root
+  void broadcast(void* buf, Int64 count, MPI_Datatype datatype, Int32 root);
+
+  /*!
+   * \brief Rassemble sur tous les rangs les \a send_count valeurs de chaque rang.
+   *
+   * \a recv_buf doit pouvoir contenir \a recv_count valeurs avec
+   * \a recv_count égal à \a send_count multiplié par le nombre de rangs.
+   * Les valeurs sont rangées par ordre croissant de rang dans le
+   * communicateur d'origine.
+   */
+  void allGather(const void* send_buf, Int64 send_count, void* recv_buf, Int64 recv_count,
+                 MPI_Datatype datatype);
+
+ private:
+
+  MPI_Comm m_node_communicator = MPI_COMM_NULL;
+  MPI_Comm m_leader_communicator = MPI_COMM_NULL;
+  MpiLock* m_mpi_lock = nullptr;
+  Parallel::IStat* m_stat = nullptr;
+  Int32 m_comm_size = 0;
+  Int32 m_node_rank = 0;
+  Int32 m_node_size = 0;
+  Int32 m_node_index = 0;
+  Int32 m_nb_node = 0;
+  Int32 m_max_nb_rank_per_node = 0;
+  //! Pour chaque rang, indice de son noeud dans le communicateur des leaders
+  UniqueArray<Int32> m_rank_node_index;
+  //! Pour chaque rang, rang dans son noeud
+  UniqueArray<Int32> m_rank_node_rank;
+  //! Pour chaque noeud, indice de son premier rang dans l'ordre des leaders
+  UniqueArray<Int32> m_node_first_index;
+  //! Pour chaque noeud, nombre de rangs
+  UniqueArray<Int32> m_node_nb_rank;
+
+ private:
+
+  static int _checkSize(Int64 count);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
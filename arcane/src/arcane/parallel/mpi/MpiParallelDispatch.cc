@@ -30,6 +30,7 @@
 #include "arcane/parallel/mpi/MpiAdapter.h"
 #include "arcane/parallel/mpi/MpiParallelDispatch.h"
 #include "arcane/parallel/mpi/MpiLock.h"
+#include "arcane/parallel/mpi/MpiNodeCollective.h"
 
 #include "arccore/message_passing/Messages.h"
 
@@ -217,6 +218,58 @@ computeMinMaxSum(ConstArrayView<Type> values,
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+template<class Type> void MpiParallelDispatchT<Type>::
+broadcast(ArrayView<Type> send_buf,Int32 rank)
+{
+  if (m_node_collective){
+    m_node_collective->broadcast(send_buf.data(),send_buf.size(),_mpiDatatype(),rank);
+    return;
+  }
+  m_mp_dispatcher->broadcast(send_buf,rank);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+template<class Type> void MpiParallelDispatchT<Type>::
+allGather(ConstArrayView<Type> send_buf,ArrayView<Type> recv_buf)
+{
+  if (m_node_collective){
+    m_node_collective->allGather(send_buf.data(),send_buf.size(),recv_buf.data(),recv_buf.size(),_mpiDatatype());
+    return;
+  }
+  m_mp_dispatcher->allGather(send_buf,recv_buf);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+template<class Type> Type MpiParallelDispatchT<Type>::
+allReduce(eReduceType op,Type send_buf)
+{
+  if (m_node_collective){
+    m_node_collective->allReduce(&send_buf,1,_mpiDatatype(),_mpiReduceOperator(op));
+    return send_buf;
+  }
+  return m_mp_dispatcher->allReduce(op,send_buf);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+template<class Type> void MpiParallelDispatchT<Type>::
+allReduce(eReduceType op,ArrayView<Type> send_buf)
+{
+  if (m_node_collective){
+    m_node_collective->allReduce(send_buf.data(),send_buf.size(),_mpiDatatype(),_mpiReduceOperator(op));
+    return;
+  }
+  m_mp_dispatcher->allReduce(op,send_buf);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 template<class Type> void MpiParallelDispatchT<Type>::
 sendRecv(ConstArrayView<Type> send_buffer,ArrayView<Type> recv_buffer,Int32 rank)
 {
@@ -35,6 +35,7 @@ namespace Arcane
 /*---------------------------------------------------------------------------*/
 
 class MpiParallelMng;
+class MpiNodeCollective;
 namespace MP = ::Arccore::MessagePassing;
 
 /*---------------------------------------------------------------------------*/
@@ -70,10 +71,6 @@ class MpiParallelDispatchT
   ARCANE_MPI_EXPORT ~MpiParallelDispatchT() override;
   ARCANE_MPI_EXPORT void finalize() override;
  public:
-  void broadcast(ArrayView<Type> send_buf,Int32 rank) override
-  { m_mp_dispatcher->broadcast(send_buf,rank); }
-  void allGather(ConstArrayView<Type> send_buf, ArrayView<Type> recv_buf) override
-  { m_mp_dispatcher->allGather(send_buf,recv_buf); }
   void allGatherVariable(ConstArrayView<Type> send_buf, Array<Type>& recv_buf) override
   { m_mp_dispatcher->allGatherVariable(send_buf,recv_buf); }
   void gather(ConstArrayView<Type> send_buf, ArrayView<Type> recv_buf, Int32 rank) override
@@ -100,12 +97,12 @@ class MpiParallelDispatchT
   { m_mp_dispatcher->send(send_buffer,rank,true); }
   void recv(ArrayView<Type> recv_buffer, Int32 rank) override
   { m_mp_dispatcher->receive(recv_buffer,rank,true); }
-  Type allReduce(eReduceType op, Type send_buf) override
-  { return  m_mp_dispatcher->allReduce(op,send_buf); }
-  void allReduce(eReduceType op, ArrayView<Type> send_buf) override
-  { m_mp_dispatcher->allReduce(op,send_buf); }
 
  public:
+  ARCANE_MPI_EXPORT void broadcast(ArrayView<Type> send_buf,Int32 rank) override;
+  ARCANE_MPI_EXPORT void allGather(ConstArrayView<Type> send_buf, ArrayView<Type> recv_buf) override;
+  ARCANE_MPI_EXPORT Type allReduce(eReduceType op, Type send_buf) override;
+  ARCANE_MPI_EXPORT void allReduce(eReduceType op, ArrayView<Type> send_buf) override;
   ARCANE_MPI_EXPORT void sendRecv(ConstArrayView<Type> send_buffer, ArrayView<Type> recv_buffer, Int32 rank) override;
   ARCANE_MPI_EXPORT Type scan(eReduceType op, Type send_buf) override;
   ARCANE_MPI_EXPORT void scan(eReduceType op, ArrayView<Type> send_buf) override;
@@ -124,12 +121,20 @@ class MpiParallelDispatchT
   ITypeDispatcher<Type>* toArccoreDispatcher() override;
   MpiDatatype* datatype() const;
 
+  /*!
+   * \brief Positionne les opérations collectives en deux niveaux.
+   *
+   * Si \a v n'est pas nul, allReduce(), broadcast() et allGather() l'utilisent.
+   */
+  void setNodeCollective(MpiNodeCollective* v) { m_node_collective = v; }
+
   public:
 
   virtual ARCANE_MPI_EXPORT void computeMinMaxSumNoInit(Type& min_val, Type& max_val, Type& sum_val,
                                                         Int32& min_rank,Int32& max_rank);
  private:
   MP::Mpi::MpiTypeDispatcher<Type>* m_mp_dispatcher;
+  MpiNodeCollective* m_node_collective = nullptr;
 
  private:
   MPI_Datatype m_min_max_sum_datatype;
@@ -38,6 +38,8 @@
 #include "arcane/parallel/mpi/MpiSerializeMessage.h"
 #include "arcane/parallel/mpi/MpiParallelNonBlockingCollective.h"
 #include "arcane/parallel/mpi/MpiDatatype.h"
+#include "arcane/parallel/mpi/MpiNodeCollective.h"
+#include "arcane/parallel/mpi/MpiSharedMemoryWindowMng.h"
 #include "arcane/parallel/mpi/IVariableSynchronizerMpiCommunicator.h"
 
 #include "arcane/impl/ParallelReplication.h"
@@ -78,6 +80,8 @@ arcaneCreateMpiBlockVariableSynchronizerFactory(MpiParallelMng* mpi_pm, Int32 bl
 extern "C++" Ref<IDataSynchronizeImplementationFactory>
 arcaneCreateMpiVariableSynchronizerFactory(MpiParallelMng* mpi_pm);
 extern "C++" Ref<IDataSynchronizeImplementationFactory>
+arcaneCreateMpiSharedMemoryVariableSynchronizerFactory(MpiParallelMng* mpi_pm);
+extern "C++" Ref<IDataSynchronizeImplementationFactory>
 arcaneCreateMpiDirectSendrecvVariableSynchronizerFactory(MpiParallelMng* mpi_pm);
 extern "C++" Ref<IDataSynchronizeImplementationFactory>
 arcaneCreateMpiLegacyVariableSynchronizerFactory(MpiParallelMng* mpi_pm);
@@ -265,6 +269,8 @@ class MpiParallelMngUtilsFactory
     }
     if (platform::getEnvironmentVariable("ARCANE_SYNCHRONIZE_VERSION")=="5")
       m_synchronizer_version = 5;
+    if (platform::getEnvironmentVariable("ARCANE_SYNCHRONIZE_VERSION")=="6")
+      m_synchronizer_version = 6;
   }
  public:
 
@@ -315,6 +321,11 @@ class MpiParallelMngUtilsFactory
       throw NotSupportedException(A_FUNCINFO,"Synchronize implementation V5 is not supported with this version of MPI");
 #endif
     }
+    else if (m_synchronizer_version == 6){
+      if (do_print)
+        tm->info() << "Using MpiSynchronizer V6 (shared memory)";
+      generic_factory = arcaneCreateMpiSharedMemoryVariableSynchronizerFactory(mpi_pm);
+    }
     else{
       if (do_print)
         tm->info() << "Using MpiSynchronizer V1";
@@ -354,6 +365,8 @@ MpiParallelMng(const MpiParallelMngBuildInfo& bi)
 , m_is_communicator_owned(bi.is_mpi_comm_owned)
 , m_mpi_lock(bi.mpi_lock)
 , m_non_blocking_collective(nullptr)
+, m_node_collective(bi.node_collective)
+, m_can_create_node_collective(bi.can_create_node_collective)
 , m_utils_factory(createRef<MpiParallelMngUtilsFactory>())
 {
   if (!m_world_parallel_mng){
@@ -369,6 +382,12 @@ MpiParallelMng::
 ~MpiParallelMng()
 {
   delete m_non_blocking_collective;
+  // La libération des fenêtres en mémoire partagée est collective et
+  // doit être faite avant celle du communicateur.
+  if (m_shared_memory_window_mng.get())
+    m_shared_memory_window_mng->finalize();
+  if (m_is_node_collective_owned)
+    delete m_node_collective;
   m_sequential_parallel_mng.reset();
   if (m_is_communicator_owned){
     MpiLock::Section ls(m_mpi_lock);
@@ -394,20 +413,24 @@ namespace
 class DispatchCreator
 {
  public:
-  DispatchCreator(ITraceMng* tm,IMessagePassingMng* mpm,MpiAdapter* adapter,MpiDatatypeList* datatype_list)
-  : m_tm(tm), m_mpm(mpm), m_adapter(adapter), m_datatype_list(datatype_list){}
+  DispatchCreator(ITraceMng* tm,IMessagePassingMng* mpm,MpiAdapter* adapter,MpiDatatypeList* datatype_list,
+                  MpiNodeCollective* node_collective)
+  : m_tm(tm), m_mpm(mpm), m_adapter(adapter), m_datatype_list(datatype_list), m_node_collective(node_collective){}
  public:
   template<typename DataType> MpiParallelDispatchT<DataType>*
   create()
   {
     MpiDatatype* dt = m_datatype_list->datatype(DataType());
-    return new MpiParallelDispatchT<DataType>(m_tm,m_mpm,m_adapter,dt);
+    auto* d = new MpiParallelDispatchT<DataType>(m_tm,m_mpm,m_adapter,dt);
+    d->setNodeCollective(m_node_collective);
+    return d;
   }
 
   ITraceMng* m_tm;
   IMessagePassingMng* m_mpm;
   MpiAdapter* m_adapter;
   MpiDatatypeList* m_datatype_list;
+  MpiNodeCollective* m_node_collective;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -476,7 +499,14 @@ build()
   m_mpi_serialize_dispatcher = serialize_dispatcher;
   _setSerializeDispatcher(serialize_dispatcher);
 
-  DispatchCreator creator(m_trace,mpm,m_adapter,m_datatype_list);
+  // Utilise si demandé des opérations collectives en deux niveaux (dans le
+  // noeud puis entre les noeuds) pour allReduce() et broadcast().
+  if (!m_node_collective && m_can_create_node_collective) {
+    m_node_collective = MpiNodeCollective::createIfEnabled(m_trace, m_communicator, m_mpi_lock, m_stat);
+    m_is_node_collective_owned = true;
+  }
+
+  DispatchCreator creator(m_trace,mpm,m_adapter,m_datatype_list,m_node_collective);
   this->createDispatchers(creator);
 
   m_io_mng = arcaneCreateIOMng(this);
@@ -888,6 +918,17 @@ _internalUtilsFactory() const
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+Ref<MpiSharedMemoryWindowMng> MpiParallelMng::
+sharedMemoryWindowMng()
+{
+  if (!m_shared_memory_window_mng.get())
+    m_shared_memory_window_mng = createRef<MpiSharedMemoryWindowMng>(m_communicator, m_mpi_lock);
+  return m_shared_memory_window_mng;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 bool MpiParallelMng::
 _isAcceleratorAware() const
 {
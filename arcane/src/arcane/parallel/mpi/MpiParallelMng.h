@@ -32,6 +32,8 @@ using Communicator = MP::Communicator;
 /*---------------------------------------------------------------------------*/
 
 class MpiDatatypeList;
+class MpiNodeCollective;
+class MpiSharedMemoryWindowMng;
 class SerializeBuffer;
 class ArcaneMpiSerializeMessageList;
 
@@ -66,6 +68,10 @@ struct ARCANE_MPI_EXPORT MpiParallelMngBuildInfo
  public:
   bool is_mpi_comm_owned;
   MpiLock* mpi_lock = nullptr;
+  //! Opérations collectives en deux niveaux partagées (non détruites par le MpiParallelMng)
+  MpiNodeCollective* node_collective = nullptr;
+  //! Indique si le MpiParallelMng peut créer ses propres opérations collectives en deux niveaux
+  bool can_create_node_collective = true;
  private:
   Ref<MP::Dispatchers> m_dispatchers_ref;
   Ref<MP::MessagePassingMng> m_message_passing_mng_ref;
@@ -150,6 +156,14 @@ class ARCANE_MPI_EXPORT MpiParallelMng
 
   MpiSerializeDispatcher* serializeDispatcher() const { return m_mpi_serialize_dispatcher; }
 
+  /*!
+   * \brief Gestionnaire des fenêtres MPI en mémoire partagée.
+   *
+   * Les ressources MPI de ce gestionnaire sont libérées de manière
+   * collective lors de la destruction de cette instance.
+   */
+  Ref<MpiSharedMemoryWindowMng> sharedMemoryWindowMng();
+
  protected:
 
   ISerializeMessageList* _createSerializeMessageList() override;
@@ -181,6 +195,9 @@ class ARCANE_MPI_EXPORT MpiParallelMng
   IParallelReplication* m_replication = nullptr;
   bool m_is_timer_owned = false;
   MpiDatatypeList* m_datatype_list = nullptr;
+  MpiNodeCollective* m_node_collective = nullptr;
+  bool m_is_node_collective_owned = false;
+  bool m_can_create_node_collective = true;
   MpiAdapter* m_adapter = nullptr;
   bool m_is_parallel = false;
   Int32 m_comm_rank = A_NULL_RANK; //!< Numéro du processeur actuel
@@ -193,6 +210,7 @@ class ARCANE_MPI_EXPORT MpiParallelMng
   IParallelNonBlockingCollective* m_non_blocking_collective = nullptr;
   MpiSerializeDispatcher* m_mpi_serialize_dispatcher = nullptr;
   Ref<IParallelMngUtilsFactory> m_utils_factory;
+  Ref<MpiSharedMemoryWindowMng> m_shared_memory_window_mng;
   bool m_use_serialize_list_v2 = true;
 
  private:
@@ -0,0 +1,550 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MpiSharedMemoryVariableSynchronizeDispatcher.cc             (C) 2000-2024 */
+/*                                                                           */
+/* Synchronisation des variables via une fenêtre MPI en mémoire partagée.    */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/MemoryView.h"
+#include "arcane/utils/MemoryUtils.h"
+
+#include "arcane/parallel/mpi/MpiParallelMng.h"
+#include "arcane/parallel/mpi/MpiSharedMemoryWindowMng.h"
+#include "arcane/parallel/mpi/MpiAdapter.h"
+#include "arcane/parallel/mpi/MpiTimeInterval.h"
+#include "arcane/parallel/IStat.h"
+
+#include "arcane/impl/IDataSynchronizeBuffer.h"
+#include "arcane/impl/IDataSynchronizeImplementation.h"
+#include "arcane/impl/DataSynchronizeInfo.h"
+
+#include "arccore/message_passing/IRequestList.h"
+
+#include <atomic>
+#include <new>
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*
+ * Cette implémentation utilise une fenêtre MPI allouée via
+ * MPI_Win_allocate_shared() sur le communicateur des rangs d'un même noeud.
+ * Chaque rang possède un segment de cette fenêtre qui contient un entête
+ * puis les valeurs à envoyer aux rangs du même noeud.
+ *
+ * L'entête contient:
+ * - le numéro de la dernière synchronisation dont les valeurs ont été
+ *   écrites dans le segment,
+ * - le numéro de la dernière synchronisation dont le rang a fini de lire
+ *   les valeurs dans les segments de ses voisins,
+ * - pour chaque rang du noeud, la position dans le segment des valeurs qui
+ *   lui sont destinées (ou -1 si ces valeurs sont envoyées par message).
+ *
+ * La synchronisation entre deux rangs d'un même noeud se fait uniquement
+ * via ces numéros et ne nécessite donc pas d'opération collective.
+ * L'algorithme est le suivant:
+ *
+ * 1. Poste les messages de réception pour les rangs d'autres noeuds.
+ * 2. Recopie dans les buffers d'envoi les valeurs à envoyer.
+ * 3. Attend que les voisins du noeud aient fini de lire notre segment lors
+ *    de la synchronisation précédente puis recopie dans le segment les valeurs
+ *    qui leur sont destinées et publie le numéro de synchronisation.
+ * 4. Poste les messages d'envoi pour les autres noeuds.
+ * 5. Pour chaque voisin du noeud, attend que son numéro de synchronisation
+ *    soit à jour puis recopie depuis son segment les valeurs dans le buffer
+ *    de réception et indique qu'on a fini de lire.
+ * 6. Attend les messages de réception et d'envoi comme dans la version 2.
+ *
+ * Cela suppose que les rangs qui communiquent sont les mêmes en envoi et
+ * en réception, ce qui est le cas pour les synchronisations.
+ *
+ * La taille du segment d'un rang est le nombre d'entités à envoyer aux
+ * rangs du noeud multiplié par une taille par entité commune à tous les
+ * rangs. La taille par entité d'une synchronisation (taille du type de
+ * donnée multipliée par le nombre de valeurs par entité) est la même sur
+ * tous les rangs. Lorsqu'elle dépasse la taille courante, tous les rangs
+ * du noeud agrandissent donc leur segment au même moment, ce qui permet de
+ * réallouer la fenêtre de manière collective.
+ *
+ * Les fenêtres et le communicateur du noeud sont gérés par le
+ * MpiSharedMemoryWindowMng du MpiParallelMng qui les libère de manière
+ * collective lors de sa destruction.
+ */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Implémentation de la synchronisation utilisant la mémoire partagée
+ * pour les rangs d'un même noeud.
+ *
+ * Les échanges avec les rangs des autres noeuds utilisent des messages
+ * MPI non bloquants.
+ */
+class MpiSharedMemoryVariableSynchronizeDispatcher
+: public AbstractDataSynchronizeImplementation
+{
+ public:
+
+  class Factory;
+  explicit MpiSharedMemoryVariableSynchronizeDispatcher(Factory* f);
+  ~MpiSharedMemoryVariableSynchronizeDispatcher() override;
+
+ protected:
+
+  void compute() override;
+  void beginSynchronize(IDataSynchronizeBuffer* ds_buf) override;
+  void endSynchronize(IDataSynchronizeBuffer* ds_buf) override;
+
+ private:
+
+  //! Position du numéro de la synchronisation écrite
+  static constexpr Int64 WriteEpochOffset = 0;
+  //! Position du numéro de la synchronisation lue
+  static constexpr Int64 ReadEpochOffset = 64;
+  //! Position de la table des positions des valeurs
+  static constexpr Int64 OffsetTableOffset = 128;
+  //! Taille initiale par entité (en octet) des segments
+  static constexpr Int64 DefaultBytesPerItem = 8;
+
+ private:
+
+  MpiParallelMng* m_mpi_parallel_mng = nullptr;
+  Ref<MpiSharedMemoryWindowMng> m_window_mng;
+  //! Indice de la fenêtre dans m_window_mng (-1 si aucune)
+  Int32 m_window_index = -1;
+  Int32 m_node_rank = 0;
+  Int32 m_node_size = 0;
+  //! Numéro de la synchronisation courante
+  Int64 m_epoch = 0;
+  //! Taille de l'entête d'un segment
+  Int64 m_header_size = 0;
+  //! Taille par entité (en octet) disponible dans les segments
+  Int64 m_bytes_per_item = DefaultBytesPerItem;
+  //! Nombre d'entités à envoyer aux rangs du noeud
+  Int64 m_nb_node_send_item = 0;
+  //! Taille disponible pour les valeurs dans notre segment
+  Int64 m_data_capacity = 0;
+  //! Indique si les valeurs de la synchronisation courante sont dans le segment
+  bool m_is_send_in_window = false;
+  //! Nombre d'octets de la synchronisation courante écrits dans le segment
+  Int64 m_shared_send_size = 0;
+  //! Adresse du segment de chaque rang du noeud
+  UniqueArray<std::byte*> m_node_segments;
+  //! Pour chaque rang de m_mpi_parallel_mng, rang dans le noeud ou -1
+  UniqueArray<Int32> m_node_ranks;
+  UniqueArray<Parallel::Request> m_original_recv_requests;
+  UniqueArray<bool> m_original_recv_requests_done;
+  Ref<Parallel::IRequestList> m_receive_request_list;
+  Ref<Parallel::IRequestList> m_send_request_list;
+
+ private:
+
+  void _allocateWindow();
+  void _freeWindow();
+  void _checkWindow();
+  std::atomic<Int64>* _writeEpoch(Int32 node_rank) const
+  {
+    return std::launder(reinterpret_cast<std::atomic<Int64>*>(m_node_segments[node_rank] + WriteEpochOffset));
+  }
+  std::atomic<Int64>* _readEpoch(Int32 node_rank) const
+  {
+    return std::launder(reinterpret_cast<std::atomic<Int64>*>(m_node_segments[node_rank] + ReadEpochOffset));
+  }
+  Int64* _offsets(Int32 node_rank) const
+  {
+    return reinterpret_cast<Int64*>(m_node_segments[node_rank] + OffsetTableOffset);
+  }
+  std::byte* _data(Int32 node_rank) const
+  {
+    return m_node_segments[node_rank] + m_header_size;
+  }
+  Int32 _nodeRank(Int32 rank) const { return m_node_ranks[rank]; }
+  static void _waitEpoch(const std::atomic<Int64>* v, Int64 epoch);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+class MpiSharedMemoryVariableSynchronizeDispatcher::Factory
+: public IDataSynchronizeImplementationFactory
+{
+ public:
+
+  explicit Factory(MpiParallelMng* mpi_pm)
+  : m_mpi_parallel_mng(mpi_pm)
+  {}
+
+  Ref<IDataSynchronizeImplementation> createInstance() override
+  {
+    auto* x = new MpiSharedMemoryVariableSynchronizeDispatcher(this);
+    return makeRef<IDataSynchronizeImplementation>(x);
+  }
+
+ public:
+
+  MpiParallelMng* m_mpi_parallel_mng = nullptr;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+extern "C++" Ref<IDataSynchronizeImplementationFactory>
+arcaneCreateMpiSharedMemoryVariableSynchronizerFactory(MpiParallelMng* mpi_pm)
+{
+  auto* x = new MpiSharedMemoryVariableSynchronizeDispatcher::Factory(mpi_pm);
+  return makeRef<IDataSynchronizeImplementationFactory>(x);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MpiSharedMemoryVariableSynchronizeDispatcher::
+MpiSharedMemoryVariableSynchronizeDispatcher(Factory* f)
+: m_mpi_parallel_mng(f->m_mpi_parallel_mng)
+, m_window_mng(m_mpi_parallel_mng->sharedMemoryWindowMng())
+, m_receive_request_list(m_mpi_parallel_mng->createRequestListRef())
+, m_send_request_list(m_mpi_parallel_mng->createRequestListRef())
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MpiSharedMemoryVariableSynchronizeDispatcher::
+~MpiSharedMemoryVariableSynchronizeDispatcher()
+{
+  // L'ordre de destruction n'est pas le même sur tous les rangs. Il ne faut
+  // donc pas faire d'appel collectif ici: la fenêtre sera détruite par
+  // MpiSharedMemoryWindowMng::finalize().
+  if (m_window_index >= 0)
+    m_window_mng->releaseWindow(m_window_index);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief (Ré)alloue la fenêtre en fonction des informations de synchronisation.
+ *
+ * Cette méthode est collective.
+ */
+void MpiSharedMemoryVariableSynchronizeDispatcher::
+compute()
+{
+  m_window_mng->initialize();
+  m_node_rank = m_window_mng->nodeRank();
+  m_node_size = m_window_mng->nodeSize();
+  m_node_ranks = m_window_mng->nodeRanks();
+  // L'entête est aligné sur une ligne de cache.
+  m_header_size = OffsetTableOffset + ((m_node_size * static_cast<Int64>(sizeof(Int64)) + 63) / 64) * 64;
+
+  // Nombre d'entités à envoyer aux rangs du noeud.
+  const DataSynchronizeInfo* sync_info = _syncInfo();
+  const DataSynchronizeBufferInfoList& send_info = sync_info->sendInfo();
+  m_nb_node_send_item = 0;
+  for (Int32 i = 0, n = sync_info->size(); i < n; ++i)
+    if (_nodeRank(sync_info->targetRank(i)) >= 0)
+      m_nb_node_send_item += send_info.nbItem(i);
+
+  _freeWindow();
+  _allocateWindow();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Alloue la fenêtre pour m_bytes_per_item octets par entité.
+ *
+ * Cette méthode est collective sur le noeud.
+ */
+void MpiSharedMemoryVariableSynchronizeDispatcher::
+_allocateWindow()
+{
+  m_data_capacity = ((m_nb_node_send_item * m_bytes_per_item + 63) / 64) * 64;
+  const Int64 segment_size = m_header_size + m_data_capacity;
+  m_window_index = m_window_mng->allocateWindow(segment_size, m_node_segments);
+  // Les numéros de synchronisation repartent de zéro avec la nouvelle fenêtre.
+  m_epoch = 0;
+  new (m_node_segments[m_node_rank] + WriteEpochOffset) std::atomic<Int64>(0);
+  new (m_node_segments[m_node_rank] + ReadEpochOffset) std::atomic<Int64>(0);
+  // Il faut que tous les entêtes soient initialisés avant de les lire.
+  m_window_mng->syncWindow(m_window_index);
+  m_window_mng->nodeBarrier();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Libère la fenêtre.
+ *
+ * Cette méthode est collective sur le noeud.
+ */
+void MpiSharedMemoryVariableSynchronizeDispatcher::
+_freeWindow()
+{
+  if (m_window_index < 0)
+    return;
+  m_window_mng->freeWindow(m_window_index);
+  m_window_index = -1;
+  m_data_capacity = 0;
+  m_node_segments.clear();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiSharedMemoryVariableSynchronizeDispatcher::
+_checkWindow()
+{
+  if (m_window_index < 0)
+    ARCANE_FATAL("Shared memory window is not allocated. You need to call compute()");
+  if (m_window_mng->isFinalized())
+    ARCANE_FATAL("Shared memory windows have already been released");
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiSharedMemoryVariableSynchronizeDispatcher::
+_waitEpoch(const std::atomic<Int64>* v, Int64 epoch)
+{
+  Int32 nb_spin = 0;
+  while (v->load(std::memory_order_acquire) < epoch) {
+    if (nb_spin < 2000)
+      ++nb_spin;
+    else
+      std::this_thread::yield();
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiSharedMemoryVariableSynchronizeDispatcher::
+beginSynchronize(IDataSynchronizeBuffer* ds_buf)
+{
+  _checkWindow();
+
+  // Agrandit si besoin les segments. La taille par entité est la même sur
+  // tous les rangs donc tous les rangs du noeud font cette réallocation
+  // collective lors de la même synchronisation.
+  if (ds_buf->hasGlobalBuffer()) {
+    Int64 bytes_per_item = ds_buf->globalSendBuffer().datatypeSize();
+    if (bytes_per_item > m_bytes_per_item) {
+      m_bytes_per_item = bytes_per_item;
+      _freeWindow();
+      _allocateWindow();
+    }
+  }
+
+  const Int32 nb_message = ds_buf->nbRank();
+
+  m_send_request_list->clear();
+
+  MpiParallelMng* pm = m_mpi_parallel_mng;
+
+  MP::Mpi::MpiAdapter* mpi_adapter = pm->adapter();
+  const MPI_Datatype mpi_dt = MP::Mpi::MpiBuiltIn::datatype(Byte());
+
+  double prepare_time = 0.0;
+  double shared_time = 0.0;
+
+  ++m_epoch;
+
+  {
+    MpiTimeInterval tit(&prepare_time);
+    constexpr int serialize_tag = 523;
+
+    m_original_recv_requests_done.resize(nb_message);
+    m_original_recv_requests.resize(nb_message);
+
+    // Poste les messages de réception pour les rangs des autres noeuds.
+    for (Integer i = 0; i < nb_message; ++i) {
+      Int32 target_rank = ds_buf->targetRank(i);
+      auto buf = ds_buf->receiveBuffer(i).bytes();
+      m_original_recv_requests[i] = Parallel::Request{};
+      m_original_recv_requests_done[i] = true;
+      if (!buf.empty() && _nodeRank(target_rank) < 0) {
+        auto req = mpi_adapter->receiveNonBlockingNoStat(buf.data(), buf.size(),
+                                                         target_rank, mpi_dt, serialize_tag);
+        m_original_recv_requests[i] = req;
+        m_original_recv_requests_done[i] = false;
+      }
+    }
+
+    // Recopie les valeurs des variables dans les buffers d'envoi.
+    ds_buf->copyAllSend();
+
+    {
+      MpiTimeInterval tit2(&shared_time);
+      Int64 shared_size = 0;
+      for (Integer i = 0; i < nb_message; ++i) {
+        Int32 node_rank = _nodeRank(ds_buf->targetRank(i));
+        if (node_rank < 0)
+          continue;
+        shared_size += ds_buf->sendBuffer(i).bytes().size();
+        // Attend que ce voisin ait fini de lire notre segment.
+        _waitEpoch(_readEpoch(node_rank), m_epoch - 1);
+      }
+      // Les valeurs ne peuvent pas être dans le segment si la taille par
+      // entité n'est pas connue (pas de buffer global).
+      m_is_send_in_window = (shared_size <= m_data_capacity);
+      if (m_is_send_in_window)
+        m_shared_send_size = shared_size;
+      else
+        m_shared_send_size = 0;
+
+      Int64* offsets = _offsets(m_node_rank);
+      for (Int32 i = 0; i < m_node_size; ++i)
+        offsets[i] = -1;
+      if (m_is_send_in_window) {
+        std::byte* data = _data(m_node_rank);
+        Int64 offset = 0;
+        for (Integer i = 0; i < nb_message; ++i) {
+          Int32 node_rank = _nodeRank(ds_buf->targetRank(i));
+          if (node_rank < 0)
+            continue;
+          auto buf = ds_buf->sendBuffer(i).bytes();
+          offsets[node_rank] = offset;
+          MemoryUtils::copy(makeMutableMemoryView(data + offset, 1, buf.size()), ConstMemoryView(buf));
+          offset += buf.size();
+        }
+      }
+      m_window_mng->syncWindow(m_window_index);
+      _writeEpoch(m_node_rank)->store(m_epoch, std::memory_order_release);
+    }
+
+    // Poste les messages d'envoi pour les rangs des autres noeuds et
+    // ceux du noeud si les valeurs ne sont pas dans le segment.
+    for (Integer i = 0; i < nb_message; ++i) {
+      auto buf = ds_buf->sendBuffer(i).bytes();
+      Int32 target_rank = ds_buf->targetRank(i);
+      bool is_shared = m_is_send_in_window && _nodeRank(target_rank) >= 0;
+      if (!buf.empty() && !is_shared) {
+        auto request = mpi_adapter->sendNonBlockingNoStat(buf.data(), buf.size(),
+                                                          target_rank, mpi_dt, serialize_tag);
+        m_send_request_list->add(request);
+      }
+    }
+  }
+  pm->stat()->add("SyncPrepare", prepare_time, ds_buf->totalSendSize());
+  // Seules les valeurs passant par la fenêtre sont comptabilisées dans
+  // 'SyncSharedSend'. Les autres sont comptabilisées dans 'SyncSharedFallback'.
+  pm->stat()->add("SyncSharedSend", shared_time, m_shared_send_size);
+  if (!m_is_send_in_window)
+    pm->stat()->add("SyncSharedFallback", 0.0, ds_buf->totalSendSize());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiSharedMemoryVariableSynchronizeDispatcher::
+endSynchronize(IDataSynchronizeBuffer* ds_buf)
+{
+  MpiParallelMng* pm = m_mpi_parallel_mng;
+  const Int32 nb_message = ds_buf->nbRank();
+
+  MP::Mpi::MpiAdapter* mpi_adapter = pm->adapter();
+  const MPI_Datatype mpi_dt = MP::Mpi::MpiBuiltIn::datatype(Byte());
+  constexpr int serialize_tag = 523;
+
+  double copy_time = 0.0;
+  double wait_time = 0.0;
+  double shared_wait_time = 0.0;
+
+  // Recopie directement les valeurs depuis les segments des voisins du noeud.
+  for (Integer i = 0; i < nb_message; ++i) {
+    Int32 target_rank = ds_buf->targetRank(i);
+    Int32 node_rank = _nodeRank(target_rank);
+    if (node_rank < 0)
+      continue;
+    {
+      MpiTimeInterval tit(&shared_wait_time);
+      _waitEpoch(_writeEpoch(node_rank), m_epoch);
+      m_window_mng->syncWindow(m_window_index);
+    }
+    auto buf = ds_buf->receiveBuffer(i).bytes();
+    if (buf.empty())
+      continue;
+    Int64 offset = _offsets(node_rank)[m_node_rank];
+    if (offset < 0) {
+      // Le voisin n'avait pas assez de place dans son segment et
+      // envoie les valeurs par message.
+      m_original_recv_requests[i] = mpi_adapter->receiveNonBlockingNoStat(buf.data(), buf.size(),
+                                                                          target_rank, mpi_dt, serialize_tag);
+      m_original_recv_requests_done[i] = false;
+      continue;
+    }
+    MpiTimeInterval tit(&copy_time);
+    const std::byte* src = _data(node_rank) + offset;
+    MemoryUtils::copy(MutableMemoryView(buf), makeConstMemoryView(src, 1, buf.size()));
+    ds_buf->copyReceiveAsync(i);
+  }
+  // Indique aux voisins du noeud qu'on a fini de lire leur segment.
+  _readEpoch(m_node_rank)->store(m_epoch, std::memory_order_release);
+
+  // Traite les messages comme dans la version 2.
+  UniqueArray<Integer> remaining_original_indexes;
+  while (1) {
+    m_receive_request_list->clear();
+    remaining_original_indexes.clear();
+    for (Integer i = 0, n = m_original_recv_requests_done.size(); i < n; ++i) {
+      if (!m_original_recv_requests_done[i]) {
+        m_receive_request_list->add(m_original_recv_requests[i]);
+        remaining_original_indexes.add(i);
+      }
+    }
+    Integer nb_remaining_request = m_receive_request_list->size();
+    if (nb_remaining_request == 0)
+      break;
+
+    {
+      MpiTimeInterval tit(&wait_time);
+      m_receive_request_list->wait(Parallel::WaitSome);
+    }
+
+    ConstArrayView<Int32> done_requests = m_receive_request_list->doneRequestIndexes();
+    for (Int32 request_index : done_requests) {
+      Int32 orig_index = remaining_original_indexes[request_index];
+      m_original_recv_requests_done[orig_index] = true;
+      {
+        MpiTimeInterval tit(&copy_time);
+        ds_buf->copyReceiveAsync(orig_index);
+      }
+    }
+  }
+
+  {
+    MpiTimeInterval tit(&wait_time);
+    m_send_request_list->wait(Parallel::WaitAll);
+  }
+
+  // S'assure que les copies des buffers sont bien terminées
+  ds_buf->barrier();
+
+  Int64 total_ghost_size = ds_buf->totalReceiveSize();
+  Int64 total_share_size = ds_buf->totalSendSize();
+  Int64 total_size = total_ghost_size + total_share_size;
+  pm->stat()->add("SyncCopy", copy_time, total_ghost_size);
+  pm->stat()->add("SyncWait", wait_time, total_size);
+  pm->stat()->add("SyncSharedWait", shared_wait_time, total_ghost_size);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,211 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MpiSharedMemoryWindowMng.cc                                 (C) 2000-2024 */
+/*                                                                           */
+/* Gestion des fenêtres MPI en mémoire partagée d'un MpiParallelMng.         */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/parallel/mpi/MpiSharedMemoryWindowMng.h"
+
+#include "arcane/utils/FatalErrorException.h"
+
+#include "arcane/parallel/mpi/MpiLock.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MpiSharedMemoryWindowMng::
+MpiSharedMemoryWindowMng(MPI_Comm comm, MpiLock* mpi_lock)
+: m_communicator(comm)
+, m_mpi_lock(mpi_lock)
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MpiSharedMemoryWindowMng::
+~MpiSharedMemoryWindowMng()
+{
+  // Les ressources MPI doivent avoir été libérées par finalize() car
+  // leur destruction est collective.
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiSharedMemoryWindowMng::
+initialize()
+{
+  if (m_is_finalized)
+    ARCANE_FATAL("Can not initialize after finalize()");
+  if (m_node_communicator != MPI_COMM_NULL)
+    return;
+
+  MpiLock::Section mls(m_mpi_lock);
+
+  int comm_rank = 0;
+  int comm_size = 0;
+  MPI_Comm_rank(m_communicator, &comm_rank);
+  MPI_Comm_size(m_communicator, &comm_size);
+
+  int r = MPI_Comm_split_type(m_communicator, MPI_COMM_TYPE_SHARED, comm_rank, MPI_INFO_NULL, &m_node_communicator);
+  if (r != MPI_SUCCESS)
+    ARCANE_FATAL("Error '{0}' in MPI_Comm_split_type", r);
+  int node_rank = 0;
+  int node_size = 0;
+  MPI_Comm_rank(m_node_communicator, &node_rank);
+  MPI_Comm_size(m_node_communicator, &node_size);
+  m_node_rank = node_rank;
+  m_node_size = node_size;
+
+  // Calcule pour chaque rang son rang dans le noeud.
+  MPI_Group comm_group = MPI_GROUP_NULL;
+  MPI_Group node_group = MPI_GROUP_NULL;
+  MPI_Comm_group(m_communicator, &comm_group);
+  MPI_Comm_group(m_node_communicator, &node_group);
+  UniqueArray<int> ranks(comm_size);
+  UniqueArray<int> node_ranks(comm_size);
+  for (Int32 i = 0; i < comm_size; ++i)
+    ranks[i] = i;
+  MPI_Group_translate_ranks(comm_group, comm_size, ranks.data(), node_group, node_ranks.data());
+  MPI_Group_free(&comm_group);
+  MPI_Group_free(&node_group);
+  m_node_ranks.resize(comm_size);
+  for (Int32 i = 0; i < comm_size; ++i)
+    m_node_ranks[i] = (node_ranks[i] == MPI_UNDEFINED) ? -1 : node_ranks[i];
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Int32 MpiSharedMemoryWindowMng::
+allocateWindow(Int64 segment_size, Array<std::byte*>& segments)
+{
+  if (m_node_communicator == MPI_COMM_NULL)
+    ARCANE_FATAL("Node communicator is not created. You need to call initialize()");
+
+  MpiLock::Section mls(m_mpi_lock);
+
+  void* base_ptr = nullptr;
+  MPI_Win window = MPI_WIN_NULL;
+  int r = MPI_Win_allocate_shared(segment_size, 1, MPI_INFO_NULL, m_node_communicator, &base_ptr, &window);
+  if (r != MPI_SUCCESS)
+    ARCANE_FATAL("Error '{0}' in MPI_Win_allocate_shared size={1}", r, segment_size);
+  segments.resize(m_node_size);
+  for (Int32 i = 0; i < m_node_size; ++i) {
+    MPI_Aint size = 0;
+    int disp_unit = 0;
+    void* ptr = nullptr;
+    MPI_Win_shared_query(window, i, &size, &disp_unit, &ptr);
+    segments[i] = static_cast<std::byte*>(ptr);
+  }
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, window);
+  Int32 index = m_windows.size();
+  m_windows.add(window);
+  return index;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiSharedMemoryWindowMng::
+syncWindow(Int32 index)
+{
+  MPI_Win window = m_windows[index];
+  if (window != MPI_WIN_NULL)
+    MPI_Win_sync(window);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiSharedMemoryWindowMng::
+nodeBarrier()
+{
+  MpiLock::Section mls(m_mpi_lock);
+  MPI_Barrier(m_node_communicator);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiSharedMemoryWindowMng::
+freeWindow(Int32 index)
+{
+  MpiLock::Section mls(m_mpi_lock);
+  // S'assure que plus aucun rang du noeud n'accède à la fenêtre.
+  MPI_Barrier(m_node_communicator);
+  _freeWindow(index);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiSharedMemoryWindowMng::
+releaseWindow([[maybe_unused]] Int32 index)
+{
+  // Rien à faire: la fenêtre sera détruite lors de l'appel à finalize()
+  // car sa destruction est collective.
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiSharedMemoryWindowMng::
+_freeWindow(Int32 index)
+{
+  MPI_Win& window = m_windows[index];
+  if (window == MPI_WIN_NULL)
+    return;
+  MPI_Win_unlock_all(window);
+  MPI_Win_free(&window);
+  window = MPI_WIN_NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MpiSharedMemoryWindowMng::
+finalize()
+{
+  if (m_is_finalized)
+    return;
+  m_is_finalized = true;
+  if (m_node_communicator == MPI_COMM_NULL)
+    return;
+
+  // Si MPI est déjà terminé, il n'est plus possible de libérer les ressources.
+  int is_finalized = 0;
+  MPI_Finalized(&is_finalized);
+  if (is_finalized)
+    return;
+
+  MpiLock::Section mls(m_mpi_lock);
+  MPI_Barrier(m_node_communicator);
+  for (Int32 i = 0, n = m_windows.size(); i < n; ++i)
+    _freeWindow(i);
+  m_windows.clear();
+  MPI_Comm_free(&m_node_communicator);
+  m_node_communicator = MPI_COMM_NULL;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,138 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MpiSharedMemoryWindowMng.h                                  (C) 2000-2024 */
+/*                                                                           */
+/* Gestion des fenêtres MPI en mémoire partagée d'un MpiParallelMng.         */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_PARALLEL_MPI_MPISHAREDMEMORYWINDOWMNG_H
+#define ARCANE_PARALLEL_MPI_MPISHAREDMEMORYWINDOWMNG_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/Array.h"
+
+#include "arcane/parallel/mpi/ArcaneMpi.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Gestion du communicateur des rangs d'un même noeud et des
+ * fenêtres MPI en mémoire partagée associées.
+ *
+ * Une instance est associée à un MpiParallelMng. Les fenêtres sont
+ * identifiées par leur indice de création.
+ *
+ * La création d'une fenêtre et sa libération via freeWindow() sont
+ * collectives sur le communicateur du noeud. Comme l'ordre de destruction
+ * des objets qui utilisent les fenêtres n'est pas le même sur tous les rangs,
+ * ces objets doivent appeler releaseWindow() qui n'est pas collective.
+ * Les fenêtres ainsi libérées, ainsi que le communicateur du noeud, sont
+ * détruites par finalize() qui est appelée de manière collective par le
+ * MpiParallelMng lors de sa destruction. Le destructeur de cette classe
+ * ne fait aucun appel MPI.
+ */
+class ARCANE_MPI_EXPORT MpiSharedMemoryWindowMng
+{
+ public:
+
+  MpiSharedMemoryWindowMng(MPI_Comm comm, MpiLock* mpi_lock);
+  MpiSharedMemoryWindowMng(const MpiSharedMemoryWindowMng&) = delete;
+  MpiSharedMemoryWindowMng& operator=(const MpiSharedMemoryWindowMng&) = delete;
+  ~MpiSharedMemoryWindowMng();
+
+ public:
+
+  /*!
+   * \brief Créé si besoin le communicateur du noeud.
+   *
+   * Cette méthode est collective sur le communicateur d'origine.
+   */
+  void initialize();
+
+  //! Rang dans le noeud
+  Int32 nodeRank() const { return m_node_rank; }
+
+  //! Nombre de rangs du noeud
+  Int32 nodeSize() const { return m_node_size; }
+
+  //! Pour chaque rang du communicateur d'origine, rang dans le noeud ou -1
+  ConstArrayView<Int32> nodeRanks() const { return m_node_ranks; }
+
+  /*!
+   * \brief Alloue une fenêtre dont le segment du rang courant contient
+   * \a segment_size octets.
+   *
+   * Cette méthode est collective sur le communicateur du noeud.
+   * \a segments contient en retour l'adresse du segment de chaque rang du noeud.
+   * Retourne l'indice de la fenêtre.
+   */
+  Int32 allocateWindow(Int64 segment_size, Array<std::byte*>& segments);
+
+  //! Synchronise la vue mémoire de la fenêtre \a index (MPI_Win_sync)
+  void syncWindow(Int32 index);
+
+  //! Barrière sur le communicateur du noeud
+  void nodeBarrier();
+
+  /*!
+   * \brief Libère la fenêtre \a index.
+   *
+   * Cette méthode est collective sur le communicateur du noeud.
+   */
+  void freeWindow(Int32 index);
+
+  /*!
+   * \brief Indique que la fenêtre \a index n'est plus utilisée.
+   *
+   * Cette méthode n'est pas collective. La fenêtre sera détruite par finalize().
+   */
+  void releaseWindow(Int32 index);
+
+  /*!
+   * \brief Détruit les fenêtres et le communicateur du noeud.
+   *
+   * Cette méthode est collective sur le communicateur d'origine.
+   * Les fenêtres sont détruites dans l'ordre de leur création qui est le même
+   * sur tous les rangs.
+   */
+  void finalize();
+
+  //! Indique si finalize() a été appelée
+  bool isFinalized() const { return m_is_finalized; }
+
+ private:
+
+  MPI_Comm m_communicator = MPI_COMM_NULL;
+  MPI_Comm m_node_communicator = MPI_COMM_NULL;
+  MpiLock* m_mpi_lock = nullptr;
+  Int32 m_node_rank = 0;
+  Int32 m_node_size = 0;
+  UniqueArray<Int32> m_node_ranks;
+  UniqueArray<MPI_Win> m_windows;
+  bool m_is_finalized = false;
+
+ private:
+
+  void _freeWindow(Int32 index);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
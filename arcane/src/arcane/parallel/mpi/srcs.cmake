@@ -11,6 +11,8 @@ set( ARCANE_SOURCES
   MpiParallelMng.h
   MpiParallelDispatch.cc
   MpiParallelDispatch.h
+  MpiNodeCollective.cc
+  MpiNodeCollective.h
   MpiParallelNonBlockingCollective.cc
   MpiParallelNonBlockingCollective.h
   MpiParallelNonBlockingCollectiveDispatch.cc
@@ -19,6 +21,9 @@ set( ARCANE_SOURCES
   MpiBlockVariableSynchronizeDispatcher.cc
   MpiDirectSendrecvVariableSynchronizeDispatcher.cc
   MpiLegacyVariableSynchronizeDispatcher.cc
+  MpiSharedMemoryVariableSynchronizeDispatcher.cc
+  MpiSharedMemoryWindowMng.cc
+  MpiSharedMemoryWindowMng.h
   MpiSerializeMessage.h
   MpiSerializeMessageList.h
   MpiTimerMng.cc
@@ -38,6 +38,8 @@
 #include "arcane/parallel/mpi/MpiParallelMng.h"
 #include "arcane/parallel/mpi/MpiParallelDispatch.h"
 
+#include "arccore/concurrency/ThreadCombiningTree.h"
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -66,6 +68,7 @@ HybridParallelDispatch(ITraceMng* tm,HybridParallelMng* pm,HybridMessageQueue* m
 , m_all_dispatchs(all_dispatchs)
 , m_message_queue(message_queue)
 , m_mpi_dispatcher(0)
+, m_combining_tree(pm->getCombiningTree())
 {
   m_reduce_infos.m_index = 0;
 
@@ -287,31 +290,19 @@ template<class Type> void HybridParallelDispatch<Type>::
 broadcast(Span<Type> send_buf,Int32 rank)
 {
   m_broadcast_view = send_buf;
-  _collectiveBarrier();
   FullRankInfo fri = FullRankInfo::compute(MP::MessageRank(rank),m_local_nb_rank);
   int mpi_rank = fri.mpiRankValue();
-  if (m_mpi_rank==mpi_rank){
-    // J'ai le meme rang MPI que celui qui fait le broadcast
-    if (m_global_rank==rank){
-      //TODO: passage 64bit.
-      m_parallel_mng->mpiParallelMng()->broadcast(send_buf.smallView(),mpi_rank);
-    }
-    else{
-      m_all_dispatchs[m_local_rank]->m_broadcast_view.copy(m_all_dispatchs[fri.localRankValue()]->m_broadcast_view);
-    }
-  }
-  else{
-    if (m_local_rank==0){
-      //TODO: passage 64bit.
-      m_parallel_mng->mpiParallelMng()->broadcast(send_buf.smallView(),mpi_rank);
-    }
-  }
-  _collectiveBarrier();
-  if (m_mpi_rank!=mpi_rank){
-    if (m_local_rank!=0)
-      m_all_dispatchs[m_local_rank]->m_broadcast_view.copy(m_all_dispatchs[0]->m_broadcast_view);
+  // Le rang local qui participe au broadcast MPI est celui qui fait le
+  // broadcast si j'ai le même rang MPI que lui et le rang local 0 sinon.
+  // Il diffuse ensuite les valeurs aux autres rangs locaux.
+  Int32 local_root = (m_mpi_rank==mpi_rank) ? fri.localRankValue() : 0;
+  if (m_local_rank==local_root){
+    //TODO: passage 64bit.
+    m_parallel_mng->mpiParallelMng()->broadcast(send_buf.smallView(),mpi_rank);
   }
-  _collectiveBarrier();
+  m_combining_tree->broadcast(m_local_rank, local_root, [&](Int32 parent) {
+    m_broadcast_view.copy(m_all_dispatchs[parent]->m_broadcast_view);
+  });
 }
 
 /*---------------------------------------------------------------------------*/
@@ -778,36 +769,8 @@ sendRecv(ConstArrayView<Type> send_buffer,ArrayView<Type> recv_buffer,Integer pr
 template<class Type> Type HybridParallelDispatch<Type>::
 allReduce(eReduceType op,Type send_buf)
 {
-  m_reduce_infos.reduce_value = send_buf;
-  //pinfo() << "ALL REDUCE BEGIN RANK=" << m_global_rank << " TYPE=" << (int)op << " MY=" << send_buf;
-  cout.flush();
-  _collectiveBarrier();
-  if (m_local_rank==0){
-    Type ret = m_all_dispatchs[0]->m_reduce_infos.reduce_value;
-    switch(op){
-    case Parallel::ReduceMin:
-      for( Integer i=1; i<m_local_nb_rank; ++i )
-        ret = math::min(ret,m_all_dispatchs[i]->m_reduce_infos.reduce_value);
-      break;
-    case Parallel::ReduceMax:
-      for( Integer i=1; i<m_local_nb_rank; ++i )
-        ret = math::max(ret,m_all_dispatchs[i]->m_reduce_infos.reduce_value);
-      break;
-    case Parallel::ReduceSum:
-      for( Integer i=1; i<m_local_nb_rank; ++i )
-        ret = (Type)(ret + m_all_dispatchs[i]->m_reduce_infos.reduce_value);
-      break;
-    default:
-      ARCANE_FATAL("Bad reduce type");
-    }
-    ret = m_parallel_mng->mpiParallelMng()->reduce(op,ret);
-    m_all_dispatchs[0]->m_reduce_infos.reduce_value = ret;
-    //pinfo() << "ALL REDUCE RANK=" << m_local_rank << " TYPE=" << (int)op << " MY=" << send_buf << " GLOBAL=" << ret << '\n';
-  }
-  _collectiveBarrier();
-  Type ret = m_all_dispatchs[0]->m_reduce_infos.reduce_value;
-  _collectiveBarrier();
-  return ret;
+  _treeAllReduce(op, Span<Type>(&send_buf, 1));
+  return send_buf;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -929,13 +892,44 @@ _allReduceOrScan(eReduceType op, Span<Type> send_buf, bool is_scan)
   _collectiveBarrier();
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Réduction via l'arbre de combinaison.
+ *
+ * Les valeurs des rangs locaux sont combinées via l'arbre. Le rang local 0
+ * effectue ensuite la réduction MPI avant que le résultat soit recopié
+ * de père en fils vers les autres rangs locaux.
+ */
+template <class Type> void HybridParallelDispatch<Type>::
+_treeAllReduce(eReduceType op, Span<Type> send_buf)
+{
+  m_reduce_infos.reduce_buf_span = send_buf;
+  const Int32 my_index = ++m_reduce_infos.m_index;
+  auto combine_func = [&](Int32 child) {
+    Int32 child_index = m_all_dispatchs[child]->m_reduce_infos.m_index;
+    if (child_index != my_index)
+      ARCANE_FATAL("INTERNAL: incoherent all reduce i0={0} in={1} n={2}",
+                   my_index, child_index, child);
+    _applyReduceOperator(op, send_buf, m_all_dispatchs, child, child);
+  };
+  auto root_func = [&]() {
+    //TODO: passage 64bit.
+    m_parallel_mng->mpiParallelMng()->reduce(op, send_buf.smallView());
+  };
+  auto copy_func = [&](Int32 parent) {
+    send_buf.copy(m_all_dispatchs[parent]->m_reduce_infos.reduce_buf_span);
+  };
+  m_combining_tree->allReduce(m_local_rank, combine_func, root_func, copy_func);
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
 template <class Type> void HybridParallelDispatch<Type>::
 allReduce(eReduceType op, Span<Type> send_buf)
 {
-  _allReduceOrScan(op, send_buf, false);
+  _treeAllReduce(op, send_buf);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -1047,7 +1041,7 @@ gather(Arccore::MessagePassing::GatherMessageInfo<Type>&)
 template<class Type> void HybridParallelDispatch<Type>::
 _collectiveBarrier()
 {
-  m_parallel_mng->getThreadBarrier()->wait();
+  m_combining_tree->barrier(m_local_rank);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -251,11 +251,13 @@ class HybridParallelDispatch
 
   HybridMessageQueue* m_message_queue = nullptr;
   MpiParallelDispatchT<Type>* m_mpi_dispatcher = nullptr;
+  ThreadCombiningTree* m_combining_tree = nullptr;
 
  private:
 
   void _collectiveBarrier();
   void _allReduceOrScan(eReduceType op, Span<Type> send_buf, bool is_scan);
+  void _treeAllReduce(eReduceType op, Span<Type> send_buf);
   void _applyReduceOperator(eReduceType op, Span<Type> result, AllDispatchView dispatch_view,
                             Int32 first_rank, Int32 last_rank);
 };
@@ -171,6 +171,7 @@ HybridParallelMng(const HybridParallelMngBuildInfo& bi)
 , m_is_initialized(false)
 , m_stat(Parallel::createDefaultStat())
 , m_thread_barrier(bi.thread_barrier)
+, m_combining_tree(bi.combining_tree)
 , m_mpi_parallel_mng(bi.mpi_parallel_mng)
 , m_all_dispatchers(bi.all_dispatchers)
 , m_sub_builder_factory(bi.sub_builder_factory)
@@ -53,6 +53,7 @@ struct HybridParallelMngBuildInfo
   IParallelMng* world_parallel_mng = nullptr;
   ISharedMemoryMessageQueue* message_queue = nullptr;
   IThreadBarrier* thread_barrier = nullptr;
+  ThreadCombiningTree* combining_tree = nullptr;
   Array<HybridParallelMng*>* parallel_mng_list = nullptr;
   MpiThreadAllDispatcher* all_dispatchers = nullptr;
   IParallelMngContainerFactory* sub_builder_factory = nullptr;
@@ -152,6 +153,12 @@ class HybridParallelMng
     return m_thread_barrier;
   }
 
+  //! Arbre de combinaison pour les opérations collectives entre rangs locaux
+  ThreadCombiningTree* getCombiningTree()
+  {
+    return m_combining_tree;
+  }
+
  private:
   
   ITraceMng* m_trace;
@@ -170,6 +177,7 @@ class HybridParallelMng
   bool m_is_initialized; //!< \a true si déjà initialisé
   Parallel::IStat* m_stat = nullptr;
   IThreadBarrier* m_thread_barrier = nullptr;
+  ThreadCombiningTree* m_combining_tree = nullptr;
   MpiParallelMng* m_mpi_parallel_mng = nullptr;
   MpiThreadAllDispatcher* m_all_dispatchers = nullptr;
   Array<HybridParallelMng*>* m_parallel_mng_list = nullptr;
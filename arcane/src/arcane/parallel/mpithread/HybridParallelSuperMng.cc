@@ -21,6 +21,8 @@
 #include "arcane/utils/ArgumentException.h"
 #include "arcane/utils/CommandLineArguments.h"
 
+#include "arccore/concurrency/ThreadCombiningTree.h"
+
 #include "arcane/parallel/IStat.h"
 
 #include "arcane/parallel/mpi/MpiAdapter.h"
@@ -28,6 +30,7 @@
 #include "arcane/parallel/mpi/MpiParallelDispatch.h"
 #include "arcane/parallel/mpi/MpiLock.h"
 #include "arcane/parallel/mpi/MpiErrorHandler.h"
+#include "arcane/parallel/mpi/MpiNodeCollective.h"
 
 #include "arcane/parallel/thread/SharedMemoryMessageQueue.h"
 #include "arcane/parallel/thread/SharedMemoryParallelMng.h"
@@ -82,6 +85,8 @@ class HybridParallelMngContainer
   MpiLock* m_mpi_lock = nullptr;
   ISharedMemoryMessageQueue* m_message_queue = nullptr;
   IThreadBarrier* m_thread_barrier = nullptr;
+  ThreadCombiningTree* m_combining_tree = nullptr;
+  MpiNodeCollective* m_node_collective = nullptr;
   Int32 m_local_nb_rank = -1;
   MpiThreadAllDispatcher* m_all_dispatchers = nullptr;
   // Cet objet est partagé par tous les HybridParallelMng.
@@ -123,6 +128,8 @@ HybridParallelMngContainer::
 {
   // TODO: regarder s'il faut détruire le communicateur
   m_thread_barrier->destroy();
+  delete m_combining_tree;
+  delete m_node_collective;
   delete m_message_queue;
   delete m_thread_mng;
   delete m_all_dispatchers;
@@ -149,6 +156,16 @@ build()
 
   m_thread_barrier = platform::getThreadImplementationService()->createBarrier();
   m_thread_barrier->init(m_local_nb_rank);
+
+  // Arité de l'arbre utilisé pour les opérations collectives entre rangs locaux.
+  Int32 arity = ThreadCombiningTree::DefaultArity;
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_THREAD_COLLECTIVE_TREE_ARITY", true))
+    arity = v.value();
+  m_combining_tree = new ThreadCombiningTree(m_local_nb_rank, arity);
+
+  // Opérations collectives MPI en deux niveaux partagées par tous les rangs locaux.
+  m_node_collective = MpiNodeCollective::createIfEnabled(m_application->traceMng(), m_mpi_communicator,
+                                                         m_mpi_lock, m_stat);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -196,6 +213,10 @@ _createParallelMng(Int32 local_rank,ITraceMng* tm)
   bi.thread_mng = m_thread_mng;
   bi.is_mpi_comm_owned = false;
   bi.mpi_lock = m_mpi_lock;
+  // Les MpiParallelMng des rangs locaux sont créés dans un ordre quelconque et
+  // ne doivent donc pas faire d'opérations collectives lors de leur construction.
+  bi.node_collective = m_node_collective;
+  bi.can_create_node_collective = false;
 
   if (m_mpi_lock)
     tm->info() << "MPI implementation need serialized threads : using locks";
@@ -214,6 +235,7 @@ _createParallelMng(Int32 local_rank,ITraceMng* tm)
   build_info.thread_mng = m_thread_mng;
   build_info.message_queue = m_message_queue;
   build_info.thread_barrier = m_thread_barrier;
+  build_info.combining_tree = m_combining_tree;
   build_info.parallel_mng_list = m_parallel_mng_list;
   build_info.all_dispatchers = m_all_dispatchers;
   build_info.sub_builder_factory = m_sub_builder_factory;
@@ -36,6 +36,7 @@
 #include "arcane/parallel/thread/ISharedMemoryMessageQueue.h"
 
 #include "arccore/message_passing/PointToPointMessageInfo.h"
+#include "arccore/concurrency/ThreadCombiningTree.h"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -47,6 +48,10 @@ namespace Arcane::MessagePassing
 /*---------------------------------------------------------------------------*/
 
 /*
+ * Les barrières, réductions et diffusions utilisent un ThreadCombiningTree
+ * commun à tous les rangs. Cela évite que chaque thread lise les valeurs de
+ * tous les autres et que tous les threads se synchronisent sur le même verrou.
+ *
  * TODO: pour simplifier le debug lorsqu'il y a un décalage des appels
  * collectifs entre les threads, il faudrait faire un type de barrière
  * par type d'appel collectif alors qu'actuellement tous les appels
@@ -78,6 +83,7 @@ SharedMemoryParallelDispatchBase(ITraceMng* tm,SharedMemoryParallelMng* parallel
 , m_rank(parallel_mng->commRank())
 , m_nb_rank(parallel_mng->commSize())
 , m_message_queue(message_queue)
+, m_combining_tree(parallel_mng->getCombiningTree())
 , m_all_dispatchs_base(all_dispatchs_base)
 {
 }
@@ -88,7 +94,7 @@ SharedMemoryParallelDispatchBase(ITraceMng* tm,SharedMemoryParallelMng* parallel
 void SharedMemoryParallelDispatchBase::
 _collectiveBarrier()
 {
-  m_parallel_mng->getThreadBarrier()->wait();
+  m_combining_tree->barrier(m_rank);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -213,6 +219,47 @@ _genericScatterVariable(ConstMemoryView send_buf,MutableMemoryView recv_buf,Int3
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void SharedMemoryParallelDispatchBase::
+_genericGather(ConstMemoryView send_buf,MutableMemoryView recv_buf,Int32 root)
+{
+  m_const_view = send_buf;
+  // Seul le rang \a root recopie les valeurs. Les rangs ont tous la même
+  // taille de message donc la position de chaque rang est connue.
+  const Int64 size = send_buf.nbElement();
+  m_combining_tree->gather(m_rank, root, [&](Int32 i) {
+    ConstMemoryView view(m_all_dispatchs_base[i]->m_const_view);
+    recv_buf.subView(size * i, size).copyHost(view);
+  });
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void SharedMemoryParallelDispatchBase::
+_genericGatherVariable(ConstMemoryView send_buf,IResizableArray* recv_buf,Int32 root)
+{
+  m_const_view = send_buf;
+  _collectiveBarrier();
+  if (m_rank==root){
+    Int64 total_size = 0;
+    for( Integer i=0; i<m_nb_rank; ++i )
+      total_size += m_all_dispatchs_base[i]->m_const_view.nbElement();
+    recv_buf->resize(total_size);
+    MutableMemoryView recv_mem_view(recv_buf->memoryView());
+    Int64 index = 0;
+    for( Integer i=0; i<m_nb_rank; ++i ){
+      ConstMemoryView view(m_all_dispatchs_base[i]->m_const_view);
+      Int64 size = view.nbElement();
+      recv_mem_view.subView(index,size).copyHost(view);
+      index += size;
+    }
+  }
+  _collectiveBarrier();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 Request SharedMemoryParallelDispatchBase::
 _genericSend(ConstMemoryView send_buffer,const PointToPointMessageInfo& message2)
 {
@@ -259,9 +306,9 @@ void SharedMemoryParallelDispatchBase::
 _genericBroadcast(MutableMemoryView send_buf,Int32 rank)
 {
   m_broadcast_view = send_buf;
-  _collectiveBarrier();
-  m_broadcast_view.copyHost(m_all_dispatchs_base[rank]->m_broadcast_view);
-  _collectiveBarrier();
+  m_combining_tree->broadcast(m_rank, rank, [&](Int32 parent) {
+    m_broadcast_view.copyHost(m_all_dispatchs_base[parent]->m_broadcast_view);
+  });
 }
 
 /*---------------------------------------------------------------------------*/
@@ -447,13 +494,7 @@ allGather(Span<const Type> send_buf,Span<Type> recv_buf)
 template<class Type> void SharedMemoryParallelDispatch<Type>::
 gather(Span<const Type> send_buf,Span<Type> recv_buf,Int32 root_rank)
 {
-  UniqueArray<Type> tmp_buf;
-  if (m_rank==root_rank)
-    allGather(send_buf,recv_buf);
-  else{
-    tmp_buf.resize(send_buf.size() * m_nb_rank);
-    allGather(send_buf,tmp_buf);
-  }
+  _genericGather(ConstMemoryView(send_buf),MutableMemoryView(recv_buf),root_rank);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -472,11 +513,8 @@ allGatherVariable(Span<const Type> send_buf,Array<Type>& recv_buf)
 template<class Type> void SharedMemoryParallelDispatch<Type>::
 gatherVariable(Span<const Type> send_buf,Array<Type>& recv_buf,Int32 root_rank)
 {
-  UniqueArray<Type> tmp_buf;
-  if (m_rank==root_rank)
-    allGatherVariable(send_buf,recv_buf);
-  else
-    allGatherVariable(send_buf,tmp_buf);
+  ResizableArrayRef recv_buf_ref(recv_buf);
+  _genericGatherVariable(ConstMemoryView(send_buf),&recv_buf_ref,root_rank);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -587,30 +625,66 @@ sendRecv(ConstArrayView<Type> send_buffer,ArrayView<Type> recv_buffer,Integer pr
 template<class Type> Type SharedMemoryParallelDispatch<Type>::
 allReduce(eReduceType op,Type send_buf)
 {
-  m_reduce_infos.reduce_value = send_buf;
-  //cout << "ALL REDUCE BEGIN RANk=" << m_rank << " TYPE=" << (int)op << " MY=" << send_buf << '\n';
-  cout.flush();
-  _collectiveBarrier();
-  Type ret = m_all_dispatchs[0]->m_reduce_infos.reduce_value;
-  switch(op){
+  _treeAllReduce(op, Span<Type>(&send_buf, 1));
+  return send_buf;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Applique l'opérateur \a op entre \a result et les valeurs des
+ * rangs \a first_rank à \a last_rank (inclus).
+ */
+template <class Type> void SharedMemoryParallelDispatch<Type>::
+_applyReduceOperator(eReduceType op, Span<Type> result, Int32 first_rank, Int32 last_rank)
+{
+  Int64 buf_size = result.size();
+  switch (op) {
   case Parallel::ReduceMin:
-    for( Integer i=1; i<m_nb_rank; ++i )
-      ret = math::min(ret,m_all_dispatchs[i]->m_reduce_infos.reduce_value);
+    for (Integer i = first_rank; i <= last_rank; ++i)
+      for (Int64 j = 0; j < buf_size; ++j)
+        result[j] = math::min(result[j], m_all_dispatchs[i]->m_reduce_infos.reduce_buf[j]);
     break;
   case Parallel::ReduceMax:
-    for( Integer i=1; i<m_nb_rank; ++i )
-      ret = math::max(ret,m_all_dispatchs[i]->m_reduce_infos.reduce_value);
+    for (Integer i = first_rank; i <= last_rank; ++i)
+      for (Int64 j = 0; j < buf_size; ++j)
+        result[j] = math::max(result[j], m_all_dispatchs[i]->m_reduce_infos.reduce_buf[j]);
     break;
   case Parallel::ReduceSum:
-    for( Integer i=1; i<m_nb_rank; ++i )
-      ret = (Type)(ret + m_all_dispatchs[i]->m_reduce_infos.reduce_value);
+    for (Integer i = first_rank; i <= last_rank; ++i)
+      for (Int64 j = 0; j < buf_size; ++j)
+        result[j] = static_cast<Type>(result[j] + m_all_dispatchs[i]->m_reduce_infos.reduce_buf[j]);
     break;
   default:
-    ARCANE_FATAL("Bad reduce type {0}",(int)op);
+    ARCANE_FATAL("Bad reduce type {0}", (int)op);
   }
-  //cout << "ALL REDUCE RANK=" << m_rank << " TYPE=" << (int)op << " MY=" << send_buf << " GLOBAL=" << ret << '\n';
-  _collectiveBarrier();
-  return ret;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Réduction via l'arbre de combinaison.
+ *
+ * Chaque rang combine dans \a send_buf ses valeurs avec celles de ses fils.
+ * Le résultat final est celui du rang 0 et il est ensuite recopié de père
+ * en fils. L'ordre des opérations est donc le même pour tous les rangs.
+ */
+template <class Type> void SharedMemoryParallelDispatch<Type>::
+_treeAllReduce(eReduceType op, Span<Type> send_buf)
+{
+  m_reduce_infos.reduce_buf = send_buf;
+  const Int32 my_index = ++m_reduce_infos.m_index;
+  auto combine_func = [&](Int32 child) {
+    Int32 child_index = m_all_dispatchs[child]->m_reduce_infos.m_index;
+    if (child_index != my_index)
+      ARCANE_FATAL("INTERNAL: incoherent all reduce i0={0} in={1} n={2}",
+                   my_index, child_index, child);
+    _applyReduceOperator(op, send_buf, child, child);
+  };
+  auto copy_func = [&](Int32 parent) {
+    send_buf.copy(m_all_dispatchs[parent]->m_reduce_infos.reduce_buf);
+  };
+  m_combining_tree->allReduce(m_rank, combine_func, copy_func);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -641,25 +715,7 @@ _allReduceOrScan(eReduceType op, Span<Type> send_buf, bool is_scan)
     nb_rank = m_rank + 1;
   for( Integer j=0; j<buf_size; ++j )
     ret[j] = m_all_dispatchs[0]->m_reduce_infos.reduce_buf[j];
-  switch(op){
-  case Parallel::ReduceMin:
-    for (Integer i = 1; i < nb_rank; ++i)
-      for( Integer j=0; j<buf_size; ++j )
-        ret[j] = math::min(ret[j],m_all_dispatchs[i]->m_reduce_infos.reduce_buf[j]);
-    break;
-  case Parallel::ReduceMax:
-    for (Integer i = 1; i < nb_rank; ++i)
-      for( Integer j=0; j<buf_size; ++j )
-        ret[j] = math::max(ret[j],m_all_dispatchs[i]->m_reduce_infos.reduce_buf[j]);
-    break;
-  case Parallel::ReduceSum:
-    for (Integer i = 1; i < nb_rank; ++i)
-      for( Integer j=0; j<buf_size; ++j )
-        ret[j] = (Type)(ret[j] + m_all_dispatchs[i]->m_reduce_infos.reduce_buf[j]);
-    break;
-  default:
-    ARCANE_FATAL("Bad reduce type");
-  }
+  _applyReduceOperator(op, ret, 1, nb_rank - 1);
   //cout << "ALL REDUCE RANK=" << m_rank << " TYPE=" << (int)op << " MY=" << send_buf << " GLOBAL=" << ret << '\n';
   _collectiveBarrier();
   for( Integer j=0; j<buf_size; ++j )
@@ -672,7 +728,7 @@ _allReduceOrScan(eReduceType op, Span<Type> send_buf, bool is_scan)
 template <class Type> void SharedMemoryParallelDispatch<Type>::
 allReduce(eReduceType op, Span<Type> send_buf)
 {
-  _allReduceOrScan(op, send_buf, false);
+  _treeAllReduce(op, send_buf);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -176,6 +176,8 @@ class SharedMemoryParallelDispatchBase
                                 MutableMemoryView recv_buf,
                                 Span<const Int32> recv_count, Span<const Int32> recv_index);
   void _genericScatterVariable(ConstMemoryView send_buf, MutableMemoryView recv_buf, Int32 root);
+  void _genericGather(ConstMemoryView send_buf, MutableMemoryView recv_buf, Int32 root);
+  void _genericGatherVariable(ConstMemoryView send_buf, IResizableArray* recv_buf, Int32 root);
   Request _genericSend(ConstMemoryView send_buffer, const PointToPointMessageInfo& message2);
   Request _genericReceive(MutableMemoryView recv_buffer, const PointToPointMessageInfo& message2);
   void _genericBroadcast(MutableMemoryView send_buf, Int32 rank);
@@ -197,6 +199,7 @@ class SharedMemoryParallelDispatchBase
   Int32 m_rank = -1;
   Int32 m_nb_rank = 0;
   ISharedMemoryMessageQueue* m_message_queue = nullptr;
+  ThreadCombiningTree* m_combining_tree = nullptr;
 
  protected:
 
@@ -385,6 +388,8 @@ class SharedMemoryParallelDispatch
  private:
 
   void _allReduceOrScan(eReduceType op, Span<Type> send_buf, bool is_scan);
+  void _treeAllReduce(eReduceType op, Span<Type> send_buf);
+  void _applyReduceOperator(eReduceType op, Span<Type> result, Int32 first_rank, Int32 last_rank);
 };
 
 /*---------------------------------------------------------------------------*/
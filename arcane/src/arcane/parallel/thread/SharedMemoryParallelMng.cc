@@ -42,6 +42,7 @@
 
 #include "arccore/message_passing/RequestListBase.h"
 #include "arccore/message_passing/SerializeMessageList.h"
+#include "arccore/concurrency/ThreadCombiningTree.h"
 
 #include <map>
 
@@ -109,6 +110,7 @@ SharedMemoryParallelMng(const SharedMemoryParallelMngBuildInfo& build_info)
 , m_is_initialized(false)
 , m_stat(Parallel::createDefaultStat())
 , m_thread_barrier(build_info.thread_barrier)
+, m_combining_tree(build_info.combining_tree)
 , m_all_dispatchers(build_info.all_dispatchers)
 , m_sub_builder_factory(build_info.sub_builder_factory)
 , m_parent_container_ref(build_info.container)
@@ -315,7 +317,7 @@ printStats()
 void SharedMemoryParallelMng::
 barrier()
 {
-  m_thread_barrier->wait();
+  m_combining_tree->barrier(m_rank);
 }
 
 /*---------------------------------------------------------------------------*/
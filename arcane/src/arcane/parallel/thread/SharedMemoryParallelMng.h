@@ -55,6 +55,7 @@ struct ARCANE_THREAD_EXPORT SharedMemoryParallelMngBuildInfo
   IParallelMng* world_parallel_mng = nullptr;
   ISharedMemoryMessageQueue* message_queue = nullptr;
   IThreadBarrier* thread_barrier = nullptr;
+  ThreadCombiningTree* combining_tree = nullptr;
   SharedMemoryAllDispatcher* all_dispatchers = nullptr;
   IParallelMngContainerFactory* sub_builder_factory = nullptr;
   Ref<IParallelMngContainer> container;
@@ -132,6 +133,12 @@ class ARCANE_THREAD_EXPORT SharedMemoryParallelMng
     return m_thread_barrier;
   }
 
+  //! Arbre de combinaison pour les opérations collectives
+  ThreadCombiningTree* getCombiningTree()
+  {
+    return m_combining_tree;
+  }
+
  public:
 
   //! Construit un message avec pour destinataire \a dest
@@ -175,6 +182,7 @@ class ARCANE_THREAD_EXPORT SharedMemoryParallelMng
   bool m_is_initialized; //!< \a true si déjà initialisé
   Parallel::IStat* m_stat;
   IThreadBarrier* m_thread_barrier;
+  ThreadCombiningTree* m_combining_tree;
   SharedMemoryAllDispatcher* m_all_dispatchers;
   IParallelMngContainerFactory* m_sub_builder_factory;
   Ref<IParallelMngContainer> m_parent_container_ref;
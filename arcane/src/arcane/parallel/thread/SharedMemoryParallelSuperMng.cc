@@ -25,6 +25,8 @@
 #include "arcane/utils/IThreadImplementation.h"
 #include "arcane/utils/Mutex.h"
 
+#include "arccore/concurrency/ThreadCombiningTree.h"
+
 #include "arcane/parallel/IStat.h"
 
 #include "arcane/parallel/thread/SharedMemoryParallelMng.h"
@@ -74,6 +76,7 @@ class SharedMemoryParallelMngContainer
   ISharedMemoryMessageQueue* m_message_queue = nullptr;
   Mutex* m_internal_create_mutex = nullptr;
   IThreadBarrier* m_thread_barrier = nullptr;
+  ThreadCombiningTree* m_combining_tree = nullptr;
   SharedMemoryAllDispatcher* m_all_dispatchers = nullptr;
   IParallelMngContainerFactory* m_sub_factory_builder = nullptr;
 
@@ -104,6 +107,7 @@ SharedMemoryParallelMngContainer::
 {
   if (m_thread_barrier)
     m_thread_barrier->destroy();
+  delete m_combining_tree;
   delete m_message_queue;
   delete m_thread_mng;
   delete m_all_dispatchers;
@@ -122,6 +126,12 @@ build()
   m_thread_barrier = platform::getThreadImplementationService()->createBarrier();
   m_thread_barrier->init(m_nb_local_rank);
 
+  // Arité de l'arbre utilisé pour les opérations collectives.
+  Int32 arity = ThreadCombiningTree::DefaultArity;
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_THREAD_COLLECTIVE_TREE_ARITY", true))
+    arity = v.value();
+  m_combining_tree = new ThreadCombiningTree(m_nb_local_rank, arity);
+
   m_all_dispatchers = new SharedMemoryAllDispatcher();
   m_all_dispatchers->resize(m_nb_local_rank);
 
@@ -151,6 +161,7 @@ _createParallelMng(Int32 local_rank,ITraceMng* tm)
   build_info.world_parallel_mng = nullptr;
   build_info.message_queue = m_message_queue;
   build_info.thread_barrier = m_thread_barrier;
+  build_info.combining_tree = m_combining_tree;
   build_info.all_dispatchers = m_all_dispatchers;
   build_info.sub_builder_factory = m_sub_factory_builder;
   build_info.container = makeRef<IParallelMngContainer>(this);
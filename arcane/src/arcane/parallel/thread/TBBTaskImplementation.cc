@@ -20,6 +20,7 @@
 #include "arcane/utils/IObservable.h"
 #include "arcane/utils/PlatformUtils.h"
 #include "arcane/utils/Profiling.h"
+#include "arcane/utils/ParallelLoopTuner.h"
 #include "arcane/utils/MemoryAllocator.h"
 
 #include "arcane/FactoryService.h"
@@ -1096,6 +1097,12 @@ _executeParallelFor(const ParallelFor1DLoopInfo& loop_info)
   true_options.mergeUnsetValues(TaskFactory::defaultParallelLoopOptions());
   true_options.setMaxThread(max_thread);
 
+  // Ajuste si besoin la taille de grain et le partitionneur pour ce site.
+  ParallelLoopTuner::Ticket tuner_ticket;
+  if (ParallelLoopTuner::isActive())
+    tuner_ticket = ParallelLoopTuner::_beginLoop(loop_info.runInfo().traceInfo(),loop_info.runInfo().options(),
+                                                 size,max_thread,true_options);
+
   ParallelForExecute pfe(this,true_options,begin,size,f,stat_info);
 
   tbb::task_arena* used_arena = nullptr;
@@ -1103,7 +1110,13 @@ _executeParallelFor(const ParallelFor1DLoopInfo& loop_info)
     used_arena = m_p->m_sub_arena_list[max_thread];
   if (!used_arena)
     used_arena = &(m_p->m_main_arena);
-  used_arena->execute(pfe);
+  if (tuner_ticket.isMeasured()){
+    Int64 tuner_begin_time = platform::getRealTimeNS();
+    used_arena->execute(pfe);
+    ParallelLoopTuner::_endLoop(tuner_ticket,platform::getRealTimeNS()-tuner_begin_time);
+  }
+  else
+    used_arena->execute(pfe);
 }
 
 /*---------------------------------------------------------------------------*/
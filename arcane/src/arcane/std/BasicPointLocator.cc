@@ -0,0 +1,515 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* BasicPointLocator.cc                                        (C) 2000-2024 */
+/*                                                                           */
+/* Service de localisation de points dans les mailles d'un maillage.         */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/Real3.h"
+#include "arcane/utils/ITraceMng.h"
+
+#include "arcane/core/AbstractService.h"
+#include "arcane/core/ServiceFactory.h"
+#include "arcane/core/IPointLocator.h"
+#include "arcane/core/IMesh.h"
+#include "arcane/core/IItemFamily.h"
+#include "arcane/core/IParallelMng.h"
+#include "arcane/core/IParallelExchanger.h"
+#include "arcane/core/ISerializeMessage.h"
+#include "arcane/core/ISerializer.h"
+#include "arcane/core/ParallelMngUtils.h"
+#include "arcane/core/ItemGroup.h"
+#include "arcane/core/VariableTypes.h"
+#include "arcane/core/BoundingVolumeHierarchy.h"
+#include "arcane/core/Concurrency.h"
+
+#include <map>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Service de localisation de points dans les mailles d'un maillage.
+ *
+ * Chaque sous-domaine construit une hiérarchie de boîtes englobantes
+ * (BoundingVolumeHierarchy) sur ses mailles propres. Les boîtes englobantes
+ * des sous-domaines sont ensuite échangées pour construire un index
+ * global grossier, lui aussi sous forme de hiérarchie de boîtes.
+ *
+ * Lors d'une localisation, chaque point n'est envoyé qu'aux sous-domaines
+ * dont la boîte le contient. L'échange des points est fait par un seul
+ * IParallelExchanger et les réponses sont renvoyées directement aux
+ * demandeurs sans nouvelle communication collective.
+ *
+ * Le test d'appartenance d'un point à une maille découpe chaque face en
+ * triangles (segments en 2D) à partir de son centre et vérifie que le point
+ * est du même côté que le centre de la maille pour chacun d'eux. Il est
+ * donc exact pour les mailles convexes.
+ */
+class BasicPointLocator
+: public AbstractService
+, public IPointLocator
+{
+ public:
+
+  explicit BasicPointLocator(const ServiceBuildInfo& sbi)
+  : AbstractService(sbi)
+  {}
+
+ public:
+
+  void setMesh(IMesh* mesh) override { m_mesh = mesh; }
+  IMesh* mesh() const override { return m_mesh; }
+  void build() override;
+  void update() override;
+  CellLocalId findLocalCell(Real3 point) const override;
+  void locate(ConstArrayView<Real3> points, ArrayView<Int32> owner_ranks,
+              ArrayView<Int64> cells_unique_id) override;
+
+ private:
+
+  IMesh* m_mesh = nullptr;
+  //! Valeur de IMesh::timestamp() lors du dernier appel à build()
+  Int64 m_mesh_timestamp = -1;
+  //! Numéros locaux des mailles propres
+  UniqueArray<Int32> m_cells;
+  UniqueArray<Real3> m_cells_min;
+  UniqueArray<Real3> m_cells_max;
+  //! Hiérarchie des boîtes des mailles propres
+  BoundingVolumeHierarchy m_cell_bvh;
+  //! Rangs des sous-domaines non vides
+  UniqueArray<Int32> m_ranks;
+  UniqueArray<Real3> m_ranks_min;
+  UniqueArray<Real3> m_ranks_max;
+  //! Hiérarchie des boîtes des sous-domaines
+  BoundingVolumeHierarchy m_rank_bvh;
+  //! Tolérance relative pour les tests géométriques
+  Real m_tolerance = 1.0e-10;
+
+ private:
+
+  void _checkMesh() const;
+  void _computeCellBoxes();
+  void _computeRankBoxes();
+  bool _isInCell(Cell cell, Real3 point) const;
+  Int32 _findLocalCellIndex(Real3 point) const;
+  Int64 _findLocalCellUniqueId(Real3 point) const;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void BasicPointLocator::
+_checkMesh() const
+{
+  if (!m_mesh)
+    ARCANE_FATAL("No mesh. You need to call setMesh() before");
+  Int32 dim = m_mesh->dimension();
+  if (dim != 2 && dim != 3)
+    ARCANE_FATAL("Invalid mesh dimension '{0}'. Only 2D and 3D meshes are supported", dim);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void BasicPointLocator::
+build()
+{
+  _checkMesh();
+  m_mesh_timestamp = m_mesh->timestamp();
+  m_cells.clear();
+  ENUMERATE_ (Cell, icell, m_mesh->ownCells())
+    m_cells.add(icell.itemLocalId());
+  _computeCellBoxes();
+  m_cell_bvh.build(m_cells_min, m_cells_max);
+  _computeRankBoxes();
+  info() << "PointLocator: build nb_own_cell=" << m_cells.size()
+         << " nb_non_empty_rank=" << m_ranks.size();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void BasicPointLocator::
+update()
+{
+  _checkMesh();
+  if (m_mesh->timestamp() != m_mesh_timestamp) {
+    build();
+    return;
+  }
+  _computeCellBoxes();
+  m_cell_bvh.refit(m_cells_min, m_cells_max);
+  _computeRankBoxes();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Calcule les boîtes englobantes des mailles propres.
+ *
+ * Les boîtes sont légèrement agrandies pour que les points situés
+ * sur les faces ne soient pas rejetés à cause des arrondis.
+ */
+void BasicPointLocator::
+_computeCellBoxes()
+{
+  const Int32 nb_cell = m_cells.size();
+  m_cells_min.resize(nb_cell);
+  m_cells_max.resize(nb_cell);
+  const VariableNodeReal3& nodes_coordinates(m_mesh->nodesCoordinates());
+  CellInfoListView cells(m_mesh->cellFamily());
+  const Real tolerance = m_tolerance;
+  arcaneParallelFor(0, nb_cell, [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); ++i) {
+      Cell cell = cells[m_cells[i]];
+      Real3 cell_min = nodes_coordinates[cell.node(0)];
+      Real3 cell_max = cell_min;
+      for (Node node : cell.nodes()) {
+        cell_min = math::min(cell_min, nodes_coordinates[node]);
+        cell_max = math::max(cell_max, nodes_coordinates[node]);
+      }
+      Real3 extent = cell_max - cell_min;
+      Real epsilon = tolerance * math::max(extent.x, math::max(extent.y, extent.z));
+      Real3 delta(epsilon, epsilon, epsilon);
+      m_cells_min[i] = cell_min - delta;
+      m_cells_max[i] = cell_max + delta;
+    }
+  });
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Récupère les boîtes englobantes de tous les sous-domaines.
+ *
+ * Les sous-domaines sans maille propre ne sont pas conservés.
+ */
+void BasicPointLocator::
+_computeRankBoxes()
+{
+  IParallelMng* pm = m_mesh->parallelMng();
+  const Int32 nb_rank = pm->commSize();
+
+  // Une boîte vide a un minimum supérieur à son maximum.
+  const Real max_value = FloatInfo<Real>::maxValue();
+  Real3 local_min(max_value, max_value, max_value);
+  Real3 local_max(-max_value, -max_value, -max_value);
+  ConstArrayView<BoundingVolumeHierarchy::Node> nodes = m_cell_bvh.nodes();
+  if (!nodes.empty()) {
+    local_min = nodes[0].m_min;
+    local_max = nodes[0].m_max;
+  }
+  Real local_box[6] = { local_min.x, local_min.y, local_min.z,
+                        local_max.x, local_max.y, local_max.z };
+  UniqueArray<Real> all_boxes(nb_rank * 6);
+  pm->allGather(ConstArrayView<Real>(6, local_box), all_boxes);
+
+  m_ranks.clear();
+  m_ranks_min.clear();
+  m_ranks_max.clear();
+  for (Int32 i = 0; i < nb_rank; ++i) {
+    const Real* b = &all_boxes[i * 6];
+    if (b[0] > b[3])
+      continue;
+    m_ranks.add(i);
+    m_ranks_min.add(Real3(b[0], b[1], b[2]));
+    m_ranks_max.add(Real3(b[3], b[4], b[5]));
+  }
+  m_rank_bvh.setMaxLeafSize(1);
+  m_rank_bvh.build(m_ranks_min, m_ranks_max);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Indique si \a point est dans la maille convexe \a cell.
+ *
+ * Chaque face est découpée en triangles (ou en un segment en 2D) qui
+ * s'appuient sur son centre. Le point est dans la maille s'il est
+ * du même côté que le centre de la maille pour tous ces éléments.
+ */
+bool BasicPointLocator::
+_isInCell(Cell cell, Real3 point) const
+{
+  const VariableNodeReal3& nodes_coordinates(m_mesh->nodesCoordinates());
+  Real3 cell_center;
+  for (Node node : cell.nodes())
+    cell_center += nodes_coordinates[node];
+  cell_center /= static_cast<Real>(cell.nbNode());
+
+  // Retourne faux si \a point et le centre sont de part et d'autre.
+  auto is_same_side = [this](Real v_point, Real v_center) {
+    if (v_center == 0.0)
+      return true;
+    return (v_point * v_center) >= -(m_tolerance * v_center * v_center);
+  };
+
+  const bool is_3d = (m_mesh->dimension() == 3);
+  for (Face face : cell.faces()) {
+    const Int32 nb_node = face.nbNode();
+    if (!is_3d) {
+      Real3 a = nodes_coordinates[face.node(0)];
+      Real3 b = nodes_coordinates[face.node(1)];
+      Real3 ab = b - a;
+      Real3 ap = point - a;
+      Real3 ac = cell_center - a;
+      Real v_point = ab.x * ap.y - ab.y * ap.x;
+      Real v_center = ab.x * ac.y - ab.y * ac.x;
+      if (!is_same_side(v_point, v_center))
+        return false;
+      continue;
+    }
+    Real3 face_center;
+    for (Node node : face.nodes())
+      face_center += nodes_coordinates[node];
+    face_center /= static_cast<Real>(nb_node);
+    for (Int32 k = 0; k < nb_node; ++k) {
+      Real3 a = nodes_coordinates[face.node(k)];
+      Real3 b = nodes_coordinates[face.node((k + 1) % nb_node)];
+      Real3 n = math::cross(b - a, face_center - a);
+      Real v_point = math::dot(n, point - a);
+      Real v_center = math::dot(n, cell_center - a);
+      if (!is_same_side(v_point, v_center))
+        return false;
+    }
+  }
+  return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Cherche la maille propre contenant \a point.
+ *
+ * Si plusieurs mailles contiennent le point, retourne celle de plus
+ * petit uniqueId().
+ *
+ * \return l'indice de la maille dans \a m_cells ou -1 si non trouvée.
+ */
+Int32 BasicPointLocator::
+_findLocalCellIndex(Real3 point) const
+{
+  CellInfoListView cells(m_mesh->cellFamily());
+  Int32 found_index = -1;
+  Int64 found_uid = NULL_ITEM_UNIQUE_ID;
+  m_cell_bvh.visitPoint(point, [&](Int32 index) {
+    Real3 cell_min = m_cells_min[index];
+    Real3 cell_max = m_cells_max[index];
+    if (point.x < cell_min.x || point.y < cell_min.y || point.z < cell_min.z ||
+        point.x > cell_max.x || point.y > cell_max.y || point.z > cell_max.z)
+      return false;
+    Cell cell = cells[m_cells[index]];
+    Int64 uid = cell.uniqueId();
+    if (found_uid != NULL_ITEM_UNIQUE_ID && uid >= found_uid)
+      return false;
+    if (_isInCell(cell, point)) {
+      found_uid = uid;
+      found_index = index;
+    }
+    return false;
+  });
+  return found_index;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Int64 BasicPointLocator::
+_findLocalCellUniqueId(Real3 point) const
+{
+  Int32 index = _findLocalCellIndex(point);
+  if (index < 0)
+    return NULL_ITEM_UNIQUE_ID;
+  CellInfoListView cells(m_mesh->cellFamily());
+  return cells[m_cells[index]].uniqueId();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+CellLocalId BasicPointLocator::
+findLocalCell(Real3 point) const
+{
+  Int32 found_index = _findLocalCellIndex(point);
+  if (found_index < 0)
+    return CellLocalId(NULL_ITEM_LOCAL_ID);
+  return CellLocalId(m_cells[found_index]);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Localise les points \a points.
+ *
+ * Les points sont d'abord recherchés dans le sous-domaine courant puis
+ * envoyés aux sous-domaines dont la boîte englobante les contient. Ces
+ * derniers renvoient pour chaque point l'uniqueId() de la maille trouvée
+ * (ou NULL_ITEM_UNIQUE_ID). Comme les rangs qui répondent sont connus,
+ * l'échange des réponses ne nécessite pas de communication collective.
+ */
+void BasicPointLocator::
+locate(ConstArrayView<Real3> points, ArrayView<Int32> owner_ranks,
+       ArrayView<Int64> cells_unique_id)
+{
+  _checkMesh();
+  const Int32 nb_point = points.size();
+  if (owner_ranks.size() != nb_point)
+    ARCANE_FATAL("Bad size for 'owner_ranks' v={0} expected={1}", owner_ranks.size(), nb_point);
+  if (cells_unique_id.size() != nb_point)
+    ARCANE_FATAL("Bad size for 'cells_unique_id' v={0} expected={1}", cells_unique_id.size(), nb_point);
+
+  IParallelMng* pm = m_mesh->parallelMng();
+  const Int32 my_rank = pm->commRank();
+
+  // Recherche locale.
+  arcaneParallelFor(0, nb_point, [&](Integer begin, Integer size) {
+    for (Integer i = begin; i < (begin + size); ++i) {
+      Int64 uid = _findLocalCellUniqueId(points[i]);
+      cells_unique_id[i] = uid;
+      owner_ranks[i] = (uid != NULL_ITEM_UNIQUE_ID) ? my_rank : A_NULL_RANK;
+    }
+  });
+  if (!pm->isParallel())
+    return;
+
+  // Liste des points à envoyer à chaque sous-domaine.
+  std::map<Int32, UniqueArray<Int32>> rank_points;
+  for (Int32 i = 0; i < nb_point; ++i) {
+    Real3 p = points[i];
+    m_rank_bvh.visitPoint(p, [&](Int32 index) {
+      Int32 rank = m_ranks[index];
+      if (rank == my_rank)
+        return false;
+      Real3 rank_min = m_ranks_min[index];
+      Real3 rank_max = m_ranks_max[index];
+      if (p.x < rank_min.x || p.y < rank_min.y || p.z < rank_min.z ||
+          p.x > rank_max.x || p.y > rank_max.y || p.z > rank_max.z)
+        return false;
+      rank_points[rank].add(i);
+      return false;
+    });
+  }
+
+  // Envoie les points.
+  auto query_exchanger = ParallelMngUtils::createExchangerRef(pm);
+  query_exchanger->setName("PointLocatorQuery");
+  for (const auto& x : rank_points)
+    query_exchanger->addSender(x.first);
+  if (query_exchanger->initializeCommunicationsMessages())
+    return;
+  for (Integer i = 0, n = query_exchanger->nbSender(); i < n; ++i) {
+    ISerializeMessage* sm = query_exchanger->messageToSend(i);
+    Int32 rank = sm->destination().value();
+    ConstArrayView<Int32> indexes = rank_points[rank];
+    const Int64 nb_send = indexes.size();
+    UniqueArray<Real> coords(nb_send * 3);
+    for (Int64 z = 0; z < nb_send; ++z) {
+      Real3 p = points[indexes[z]];
+      coords[z * 3] = p.x;
+      coords[z * 3 + 1] = p.y;
+      coords[z * 3 + 2] = p.z;
+    }
+    ISerializer* s = sm->serializer();
+    s->setMode(ISerializer::ModeReserve);
+    s->reserve(DT_Int64, 1);
+    s->reserveSpan(DT_Real, coords.size());
+    s->allocateBuffer();
+    s->setMode(ISerializer::ModePut);
+    s->putInt64(nb_send);
+    s->putSpan(coords);
+  }
+  query_exchanger->processExchange();
+
+  // Recherche les points reçus et renvoie les résultats.
+  auto reply_exchanger = ParallelMngUtils::createExchangerRef(pm);
+  reply_exchanger->setName("PointLocatorReply");
+  const Integer nb_query = query_exchanger->nbReceiver();
+  std::map<Int32, UniqueArray<Int64>> replies;
+  for (Integer i = 0; i < nb_query; ++i) {
+    ISerializeMessage* sm = query_exchanger->messageToReceive(i);
+    Int32 rank = sm->destination().value();
+    ISerializer* s = sm->serializer();
+    s->setMode(ISerializer::ModeGet);
+    Int64 nb_received = s->getInt64();
+    UniqueArray<Real> coords(nb_received * 3);
+    s->getSpan(coords);
+    UniqueArray<Int64>& reply = replies[rank];
+    reply.resize(nb_received);
+    arcaneParallelFor(0, static_cast<Integer>(nb_received), [&](Integer begin, Integer size) {
+      for (Integer z = begin; z < (begin + size); ++z)
+        reply[z] = _findLocalCellUniqueId(Real3(coords[z * 3], coords[z * 3 + 1], coords[z * 3 + 2]));
+    });
+    reply_exchanger->addSender(rank);
+  }
+  UniqueArray<Int32> reply_ranks;
+  for (const auto& x : rank_points)
+    reply_ranks.add(x.first);
+  reply_exchanger->initializeCommunicationsMessages(reply_ranks);
+  for (Integer i = 0, n = reply_exchanger->nbSender(); i < n; ++i) {
+    ISerializeMessage* sm = reply_exchanger->messageToSend(i);
+    ConstArrayView<Int64> reply = replies[sm->destination().value()];
+    ISerializer* s = sm->serializer();
+    s->setMode(ISerializer::ModeReserve);
+    s->reserve(DT_Int64, 1);
+    s->reserveSpan(DT_Int64, reply.size());
+    s->allocateBuffer();
+    s->setMode(ISerializer::ModePut);
+    s->putInt64(reply.size());
+    s->putSpan(reply);
+  }
+  reply_exchanger->processExchange();
+
+  // Conserve pour chaque point la maille de plus petit uniqueId().
+  for (Integer i = 0, n = reply_exchanger->nbReceiver(); i < n; ++i) {
+    ISerializeMessage* sm = reply_exchanger->messageToReceive(i);
+    Int32 rank = sm->destination().value();
+    ConstArrayView<Int32> indexes = rank_points[rank];
+    ISerializer* s = sm->serializer();
+    s->setMode(ISerializer::ModeGet);
+    Int64 nb_received = s->getInt64();
+    if (nb_received != indexes.size())
+      ARCANE_FATAL("Bad number of replies from rank '{0}' v={1} expected={2}",
+                   rank, nb_received, indexes.size());
+    UniqueArray<Int64> reply(nb_received);
+    s->getSpan(reply);
+    for (Int32 z = 0, nz = indexes.size(); z < nz; ++z) {
+      Int64 uid = reply[z];
+      if (uid == NULL_ITEM_UNIQUE_ID)
+        continue;
+      Int32 index = indexes[z];
+      Int64 current_uid = cells_unique_id[index];
+      if (current_uid == NULL_ITEM_UNIQUE_ID || uid < current_uid) {
+        cells_unique_id[index] = uid;
+        owner_ranks[index] = rank;
+      }
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_REGISTER_SERVICE(BasicPointLocator,
+                        ServiceProperty("BasicPointLocator", ST_SubDomain),
+                        ARCANE_SERVICE_INTERFACE(IPointLocator));
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -118,13 +118,13 @@ class LinuxPerfPerformanceCounterService
 
   Integer getCounters(Int64ArrayView counters, bool do_substract) override
   {
-    Int32 index = 0;
-    for (Int32 index = 0, n = m_events_file_descriptor.size(); index < n; ++index) {
+    Int32 n = m_events_file_descriptor.size();
+    for (Int32 index = 0; index < n; ++index) {
       Int64 value = _getOneCounter(index);
       Int64 current_value = counters[index];
       counters[index] = (do_substract) ? value - current_value : value;
     }
-    return index;
+    return n;
   }
 
   Int64 getCycles() override
@@ -177,8 +177,10 @@ class LinuxPerfPerformanceCounterService
     // pas toujours facile de savoir ceux qui sont disponibles pour une
     // plateforme donnée. On essaie dans l'ordre suivant:
     // 1. Nombre de défaut du dernier niveau de cache (en général le cache L3)
-    // 2. Nombre de cycles où le CPU est en attente de quelque chose.
-    // 3. Nombre de défauts de cache (a priori pour tous les caches)
+    // 2. Nombre de défauts de cache (en général aussi le dernier niveau)
+    // 3. Nombre de cycles où le CPU est en attente de quelque chose.
+    // Les deux premiers sont privilégiés car ils permettent d'estimer
+    // le volume de données lu en mémoire (voir impl::HardwareCounterStat).
     const bool is_optional = true;
     bool is_bad = true;
     {
@@ -186,9 +188,9 @@ class LinuxPerfPerformanceCounterService
       is_bad = _addEvent(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | cache_access, is_optional);
     }
     if (is_bad)
-      is_bad = _addEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND, is_optional);
+      is_bad = _addEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, is_optional);
     if (is_bad)
-      _addEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, is_optional);
+      _addEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND, is_optional);
 
     m_is_init = true;
   }
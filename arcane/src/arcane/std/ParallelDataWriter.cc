@@ -21,7 +21,7 @@
 #include "arcane/core/ISerializeMessage.h"
 #include "arcane/core/SerializeBuffer.h"
 #include "arcane/core/IData.h"
-#include "arcane/core/parallel/BitonicSortT.H"
+#include "arcane/core/parallel/SampleSortT.H"
 #include "arcane/core/ParallelMngUtils.h"
 #include "arcane/core/ItemGroup.h"
 #include "arcane/core/IItemFamily.h"
@@ -148,7 +148,7 @@ sort(Int32ConstArrayView local_ids,Int64ConstArrayView items_uid)
 {
   IParallelMng* pm = m_parallel_mng;
 
-  Parallel::BitonicSort<Int64> uid_sorter(pm);
+  Parallel::SampleSort<Int64> uid_sorter(pm);
   uid_sorter.sort(items_uid);
 
   ConstArrayView<Int32> key_indexes = uid_sorter.keyIndexes();
@@ -0,0 +1,212 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* TimelineProfilingService.cc                                 (C) 2000-2024 */
+/*                                                                           */
+/* Trace temporelle de l'exécution au format 'Trace Event' de Chrome.        */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/IMessagePassingProfilingService.h"
+#include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/Profiling.h"
+#include "arcane/utils/ValueConvert.h"
+#include "arcane/utils/Event.h"
+#include "arcane/utils/internal/TimelineRecorder.h"
+
+#include "arcane/core/AbstractService.h"
+#include "arcane/core/ServiceFactory.h"
+#include "arcane/core/ISubDomain.h"
+#include "arcane/core/ITimeLoopMng.h"
+#include "arcane/core/IEntryPoint.h"
+#include "arcane/core/IVariable.h"
+#include "arcane/core/IVariableMng.h"
+#include "arcane/core/IVariableSynchronizerMng.h"
+#include "arcane/core/VariableSynchronizerEventArgs.h"
+#include "arcane/core/ObserverPool.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Service de trace temporelle de l'exécution.
+ *
+ * Ce service enregistre via impl::TimelineRecorder les évènements suivants
+ * pour chaque thread:
+ * - les points d'entrée,
+ * - les boucles et les RunCommand si le profilage des boucles est actif
+ *   (par exemple via la variable d'environnement ARCANE_LOOP_PROFILING_LEVEL),
+ * - les synchronisations de variables,
+ * - les opérations de message passing (via les statistiques de IParallelMng),
+ * - les lectures et écritures de protections.
+ *
+ * La trace est écrite au format 'Trace Event' de Chrome par printInfos().
+ * Elle peut être visualisée avec https://ui.perfetto.dev ou chrome://tracing.
+ * Le script 'merge_timeline_traces.py' permet de fusionner les fichiers
+ * de chaque sous-domaine.
+ */
+class TimelineProfilingService
+: public AbstractService
+, public IMessagePassingProfilingService
+{
+ public:
+
+  explicit TimelineProfilingService(const ServiceBuildInfo& sbi)
+  : AbstractService(sbi)
+  , m_sub_domain(sbi.subDomain())
+  {}
+
+ public:
+
+  void startProfiling() override;
+  void stopProfiling() override;
+  void printInfos(std::ostream& output) override;
+  String implName() override { return "TimelineProfiling"; }
+
+ private:
+
+  ISubDomain* m_sub_domain = nullptr;
+  ObserverPool m_observer;
+  EventObserverPool m_event_observer_pool;
+  Int64 m_entry_point_begin_time = 0;
+  bool m_is_started = false;
+
+ private:
+
+  void _updateFromBeginEntryPointEvt();
+  void _updateFromEndEntryPointEvt();
+  void _updateFromSynchronizeEvt(const VariableSynchronizerEventArgs& args);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_REGISTER_SERVICE(TimelineProfilingService,
+                        ServiceProperty("TimelineProfiling", ST_SubDomain),
+                        ARCANE_SERVICE_INTERFACE(IMessagePassingProfilingService));
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineProfilingService::
+startProfiling()
+{
+  // En mode mémoire partagée, chaque sous-domaine est exécuté par son
+  // propre thread. Il faut donc associer ce thread au sous-domaine.
+  // Le nombre maximum d'évènements doit être positionné avant, car il
+  // n'est pris en compte qu'à la création du tampon du thread.
+  if (auto v = Convert::Type<Int64>::tryParseFromEnvironment("ARCANE_TIMELINE_MAX_EVENT_PER_THREAD", true))
+    impl::TimelineRecorder::setMaxNbEventPerThread(v.value());
+  impl::TimelineRecorder::setThreadRank(m_sub_domain->subDomainId());
+  if (!m_is_started)
+    impl::TimelineRecorder::enable();
+  m_is_started = true;
+
+  // Les évènements des boucles sont issus des statistiques de profilage.
+  // On ne l'active pas ici car cela changerait le comportement de toutes
+  // les boucles du processus.
+  if (!ProfilingRegistry::hasProfiling())
+    info() << "TimelineProfiling: loop profiling is not active, loops will not be recorded"
+           << " (use ARCANE_LOOP_PROFILING_LEVEL to activate it)";
+
+  ITimeLoopMng* tm = m_sub_domain->timeLoopMng();
+  m_observer.addObserver(this, &TimelineProfilingService::_updateFromBeginEntryPointEvt,
+                         tm->observable(eTimeLoopEventType::BeginEntryPoint));
+  m_observer.addObserver(this, &TimelineProfilingService::_updateFromEndEntryPointEvt,
+                         tm->observable(eTimeLoopEventType::EndEntryPoint));
+
+  auto sync_handler = [this](const VariableSynchronizerEventArgs& args) {
+    _updateFromSynchronizeEvt(args);
+  };
+  m_sub_domain->variableMng()->synchronizerMng()->onSynchronized().attach(m_event_observer_pool, sync_handler);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineProfilingService::
+stopProfiling()
+{
+  m_observer.detachAll();
+  m_event_observer_pool.clear();
+  // Ne désactive l'enregistrement que pour ce sous-domaine: les autres
+  // sous-domaines du processus peuvent encore être en cours d'exécution.
+  if (m_is_started)
+    impl::TimelineRecorder::disable();
+  m_is_started = false;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineProfilingService::
+printInfos(std::ostream& output)
+{
+  impl::TimelineRecorder::writeChromeTrace(output, m_sub_domain->subDomainId());
+  Int64 nb_dropped = impl::TimelineRecorder::nbDroppedEvent();
+  if (nb_dropped > 0)
+    warning() << "TimelineProfiling: " << nb_dropped << " events have been dropped because"
+              << " the maximum number of events per thread ("
+              << impl::TimelineRecorder::maxNbEventPerThread() << ") has been reached."
+              << " Use ARCANE_TIMELINE_MAX_EVENT_PER_THREAD to change it";
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineProfilingService::
+_updateFromBeginEntryPointEvt()
+{
+  m_entry_point_begin_time = platform::getRealTimeNS();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineProfilingService::
+_updateFromEndEntryPointEvt()
+{
+  IEntryPoint* ep = m_sub_domain->timeLoopMng()->currentEntryPoint();
+  if (!ep)
+    return;
+  impl::TimelineRecorder::addEvent(impl::TimelineRecorder::eCategory::EntryPoint, ep->fullName(),
+                                   m_entry_point_begin_time, platform::getRealTimeNS());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineProfilingService::
+_updateFromSynchronizeEvt(const VariableSynchronizerEventArgs& args)
+{
+  // On n'utilise que l'évènement de fin qui contient le temps écoulé.
+  if (args.state() != VariableSynchronizerEventArgs::State::EndSynchronize)
+    return;
+  ConstArrayView<IVariable*> vars = args.variables();
+  String name;
+  if (vars.size() == 1)
+    name = "Synchronize " + vars[0]->name();
+  else
+    name = String::format("Synchronize ({0} variables)", vars.size());
+  Int64 end_time = platform::getRealTimeNS();
+  Int64 begin_time = end_time - static_cast<Int64>(args.elapsedTime() * 1.0e9);
+  impl::TimelineRecorder::addEvent(impl::TimelineRecorder::eCategory::Synchronize, name,
+                                   begin_time, end_time);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -33,8 +33,10 @@ set(ARCANE_SOURCES
   FileHashDatabase.cc
   RedisHashDatabase.cc
   HashAlgorithmServices.cc
+  BasicPointLocator.cc
   JsonMessagePassingProfilingService.h
   JsonMessagePassingProfilingService.cc
+  TimelineProfilingService.cc
   MeshGeneratorService.cc
   SodMeshGenerator.cc
   SodMeshGenerator.h
@@ -11,11 +11,17 @@
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/ValueConvert.h"
+
 #include "arcane/core/BasicUnitTest.h"
 #include "arcane/core/FactoryService.h"
 #include "arcane/core/CaseTable.h"
 #include "arcane/core/ICaseMng.h"
 
+#include <thread>
+#include <vector>
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -48,6 +54,9 @@ class CaseFunctionUnitTest
 
   void _testLinearReal();
   void _testBigTable();
+  void _testBatchValues(CaseTable* table, SmallSpan<const Real> params);
+  void _testSameParams(CaseTable* table, SmallSpan<const Real> params);
+  void _testConcurrentValues(CaseTable* table, SmallSpan<const Real> params);
   void _checkValue(ICaseFunction* f, Real x, Real expected_y);
   void _checkValueEpsilon(ICaseFunction* f, Real x, Real expected_y);
 };
@@ -138,6 +147,18 @@ _testLinearReal()
   _checkValueEpsilon(func, 8.0 + 1.0 / 3.0, 20.25);
   _checkValue(func, 9.0, 11.75);
   _checkValue(func, 12.0, -2);
+
+  auto* table = dynamic_cast<CaseTable*>(func);
+  if (table) {
+    UniqueArray<Real> params;
+    for (Int32 i = 0; i < 100; ++i)
+      params.add(-3.0 + 0.19 * static_cast<Real>(i));
+    params.add(8.2);
+    params.add(-2.0);
+    _testBatchValues(table, params);
+    _testSameParams(table, params);
+    _testConcurrentValues(table, params);
+  }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -175,6 +196,116 @@ _testBigTable()
       _checkValueEpsilon(func, v.x, v.y);
     }
   }
+
+  UniqueArray<Real> params;
+  for (Int32 i = 0; i < nb; i += 7)
+    params.add(values_to_test[i].x);
+  for (Int32 i = 0; i < nb; i += 13)
+    params.add(xend - static_cast<Real>(i) * (xend - xbegin) / nb + 0.001);
+  _testBatchValues(func, params);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie que CaseTable::values() et CaseTable::realView() donnent
+ * les mêmes valeurs que CaseTable::value().
+ */
+void CaseFunctionUnitTest::
+_testBatchValues(CaseTable* table, SmallSpan<const Real> params)
+{
+  info() << "Test batch values table=" << table->name() << " nb_param=" << params.size();
+  const Int32 n = params.size();
+  UniqueArray<Real> batch_values(n);
+  table->values(params, batch_values.view());
+  CaseTableView view = table->realView();
+  for (Int32 i = 0; i < n; ++i) {
+    Real x = params[i];
+    Real y = 0.0;
+    table->value(x, y);
+    if (batch_values[i] != y)
+      ARCANE_FATAL("Bad batch value func={0} x={1} y={2} expected={3}",
+                   table->name(), x, batch_values[i], y);
+    Real view_y = view.value(x);
+    if (view_y != y)
+      ARCANE_FATAL("Bad view value func={0} x={1} y={2} expected={3}",
+                   table->name(), x, view_y, y);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie que CaseTable::values() et CaseTable::realView() donnent
+ * les mêmes valeurs que CaseTable::value() lorsque deux paramètres
+ * consécutifs sont identiques.
+ *
+ * Une telle table est valide et correspond à une discontinuité.
+ */
+void CaseFunctionUnitTest::
+_testSameParams(CaseTable* table, SmallSpan<const Real> params)
+{
+  info() << "Test same params table=" << table->name();
+  // Duplique l'élément 1 et change la valeur du doublon ce qui donne
+  // une discontinuité pour ce paramètre.
+  table->insertElement(1);
+  table->setValue(2, "20.0");
+  String param_str;
+  table->paramToString(1, param_str);
+  Real same_param = 0.0;
+  if (builtInGetValue(same_param, param_str))
+    ARCANE_FATAL("Can not convert param '{0}' to real", param_str);
+
+  UniqueArray<Real> all_params(params);
+  all_params.add(same_param);
+  all_params.add(same_param - 0.25);
+  all_params.add(same_param + 0.25);
+  all_params.add(same_param - 1.0e-10);
+  all_params.add(same_param + 1.0e-10);
+  _testBatchValues(table, all_params);
+
+  // Vérifie que la discontinuité est bien prise en compte.
+  Real y_after = 0.0;
+  table->value(same_param + 1.0e-10, y_after);
+  if (!math::isNearlyEqualWithEpsilon(y_after, 20.0, 1.0e-6))
+    ARCANE_FATAL("Bad value after discontinuity y={0} expected=20.0", y_after);
+
+  table->removeElement(2);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie que CaseTable::values() peut être appelé simultanément
+ * par plusieurs threads lorsque les valeurs converties ne sont pas encore
+ * calculées.
+ */
+void CaseFunctionUnitTest::
+_testConcurrentValues(CaseTable* table, SmallSpan<const Real> params)
+{
+  info() << "Test concurrent values table=" << table->name();
+  const Int32 nb_thread = 4;
+  const Int32 n = params.size();
+  // Invalide les valeurs converties sans changer la table.
+  String value_str;
+  table->valueToString(0, value_str);
+  table->setValue(0, value_str);
+
+  std::vector<UniqueArray<Real>> thread_values(nb_thread, UniqueArray<Real>(n));
+  std::vector<std::thread> threads;
+  for (Int32 t = 0; t < nb_thread; ++t)
+    threads.emplace_back([&, t]() { table->values(params, thread_values[t].view()); });
+  for (auto& th : threads)
+    th.join();
+
+  for (Int32 t = 0; t < nb_thread; ++t)
+    for (Int32 i = 0; i < n; ++i) {
+      Real y = 0.0;
+      table->value(params[i], y);
+      if (thread_values[t][i] != y)
+        ARCANE_FATAL("Bad concurrent value func={0} thread={1} x={2} y={3} expected={4}",
+                     table->name(), t, params[i], thread_values[t][i], y);
+    }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,217 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* LoadImbalanceReportUnitTest.cc                              (C) 2000-2024 */
+/*                                                                           */
+/* Service de test du rapport sur le déséquilibre de charge.                 */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/List.h"
+#include "arcane/utils/Math.h"
+#include "arcane/utils/ValueChecker.h"
+
+#include "arcane/core/BasicUnitTest.h"
+#include "arcane/core/FactoryService.h"
+#include "arcane/core/IMesh.h"
+#include "arcane/core/IParallelMng.h"
+#include "arcane/core/ITimeLoopMng.h"
+#include "arcane/core/MeshVariableScalarRef.h"
+#include "arcane/core/VariableTypes.h"
+
+#include "arcane/impl/internal/LoadImbalanceReport.h"
+
+#include "arcane/tests/ArcaneTestGlobal.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace ArcaneTest
+{
+
+using namespace Arcane;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Test du rapport sur le déséquilibre de charge.
+ *
+ * Vérifie que le temps des synchronisations est bien réparti par
+ * synchronizer, que les valeurs min/moyenne/max sont cohérentes et que
+ * le coût des mailles est disponible dès l'initialisation.
+ */
+class LoadImbalanceReportUnitTest
+: public BasicUnitTest
+{
+ public:
+
+  explicit LoadImbalanceReportUnitTest(const ServiceBuildInfo& sbi)
+  : BasicUnitTest(sbi)
+  {}
+
+ public:
+
+  void initializeTest() override {}
+  void executeTest() override;
+
+ private:
+
+  Int32 _findName(const LoadImbalanceReport::ReportValues& report, const String& name);
+  void _checkReport(const LoadImbalanceReport::ReportValues& report);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_REGISTER_CASE_OPTIONS_NOAXL_FACTORY(LoadImbalanceReportUnitTest,
+                                           IUnitTest, LoadImbalanceReportUnitTest);
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void LoadImbalanceReportUnitTest::
+executeTest()
+{
+  ValueChecker vc(A_FUNCINFO);
+  IMesh* mesh = this->mesh();
+  IParallelMng* pm = mesh->parallelMng();
+  EntryPointCollection entry_points = subDomain()->timeLoopMng()->loopEntryPoints();
+
+  LoadImbalanceReport report(subDomain());
+  report.setPeriod(1);
+  report.setExportCellCost(true);
+  report.initialize();
+  report.initializeCellCost();
+
+  // Le coût des mailles doit exister avant le premier rapport pour
+  // être pris en compte par les équilibrages précédant ce rapport.
+  VariableCellReal* cell_cost = report.cellCost();
+  if (!cell_cost)
+    ARCANE_FATAL("Cell cost variable is not created by initializeCellCost()");
+  ENUMERATE_ (Cell, icell, mesh->ownCells()) {
+    vc.areEqual((*cell_cost)[icell], 1.0, "InitialCellCost");
+  }
+
+  VariableCellReal cell_values(VariableBuildInfo(mesh, "TestLoadImbalanceCellValues"));
+  VariableNodeReal node_values(VariableBuildInfo(mesh, "TestLoadImbalanceNodeValues"));
+  const Int32 nb_sync = 5;
+  for (Int32 i = 0; i < nb_sync; ++i) {
+    cell_values.fill(static_cast<Real>(i));
+    node_values.fill(static_cast<Real>(i));
+    cell_values.synchronize();
+    node_values.synchronize();
+  }
+
+  report.notifyEndIteration(1, entry_points);
+  const LoadImbalanceReport::ReportValues& values = report.lastReport();
+  _checkReport(values);
+
+  // Les synchronisations ne sont notifiées qu'en parallèle.
+  const bool has_sync = pm->isParallel();
+  String cell_sync_name = String("(Synchronize ") + mesh->allCells().fullName() + ")";
+  String node_sync_name = String("(Synchronize ") + mesh->allNodes().fullName() + ")";
+  if (has_sync) {
+    vc.areEqual(_findName(values, cell_sync_name) >= 0, true, "HasCellSynchronizer");
+    vc.areEqual(_findName(values, node_sync_name) >= 0, true, "HasNodeSynchronizer");
+  }
+
+  const Int32 nb_line = values.m_names.size();
+  const Int32 sync_index = _findName(values, "(Synchronize)");
+  const Int32 total_index = _findName(values, "(Total)");
+  if (sync_index < 0 || total_index < 0)
+    ARCANE_FATAL("Missing '(Synchronize)' or '(Total)' line in report");
+
+  // Le coût exporté correspond au temps local hors synchronisations.
+  Real local_cost = math::max(values.m_local_values[total_index] - values.m_local_values[sync_index], 0.0);
+  Real cost_sum = 0.0;
+  ENUMERATE_ (Cell, icell, mesh->ownCells()) {
+    cost_sum += (*cell_cost)[icell];
+  }
+  if (math::abs(cost_sum - local_cost) > 1.0e-10 * math::max(local_cost, 1.0))
+    ARCANE_FATAL("Bad exported cell cost sum={0} expected={1}", cost_sum, local_cost);
+
+  // Sans synchronisation, le rapport suivant conserve les mêmes lignes
+  // avec des temps nuls pour les synchronizers.
+  report.notifyEndIteration(2, entry_points);
+  const LoadImbalanceReport::ReportValues& values2 = report.lastReport();
+  _checkReport(values2);
+  vc.areEqual(values2.m_names.size(), nb_line, "NbLine");
+  for (Int32 i = 0; i < nb_line; ++i) {
+    const String& name = values2.m_names[i];
+    vc.areEqual(name, values.m_names[i], "SameName");
+    if (name.startsWith("(Synchronize"))
+      vc.areEqual(values2.m_local_values[i], 0.0, String("NoSyncTime ") + name);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Int32 LoadImbalanceReportUnitTest::
+_findName(const LoadImbalanceReport::ReportValues& report, const String& name)
+{
+  for (Int32 i = 0, n = report.m_names.size(); i < n; ++i)
+    if (report.m_names[i] == name)
+      return i;
+  return (-1);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie la cohérence d'un rapport.
+ *
+ * La somme des temps de chaque synchronizer doit être égale au temps
+ * total des synchronisations et la valeur locale doit être comprise entre
+ * le minimum et le maximum.
+ */
+void LoadImbalanceReportUnitTest::
+_checkReport(const LoadImbalanceReport::ReportValues& report)
+{
+  const Real epsilon = 1.0e-12;
+  const Int32 n = report.m_names.size();
+  if (report.m_local_values.size() != n || report.m_min_values.size() != n ||
+      report.m_mean_values.size() != n || report.m_max_values.size() != n)
+    ARCANE_FATAL("Bad sizes in report");
+
+  Real sum_sync = 0.0;
+  Int32 nb_synchronizer = 0;
+  Int32 sync_index = -1;
+  for (Int32 i = 0; i < n; ++i) {
+    const String& name = report.m_names[i];
+    Real local_value = report.m_local_values[i];
+    Real min_value = report.m_min_values[i];
+    Real mean_value = report.m_mean_values[i];
+    Real max_value = report.m_max_values[i];
+    info() << "Report line name=" << name << " local=" << local_value
+           << " min=" << min_value << " mean=" << mean_value << " max=" << max_value;
+    if (min_value > mean_value + epsilon || mean_value > max_value + epsilon)
+      ARCANE_FATAL("Bad min/mean/max for '{0}' min={1} mean={2} max={3}", name, min_value, mean_value, max_value);
+    if (local_value < min_value - epsilon || local_value > max_value + epsilon)
+      ARCANE_FATAL("Local value for '{0}' not in [min,max] value={1} min={2} max={3}", name, local_value, min_value, max_value);
+    if (name == "(Synchronize)")
+      sync_index = i;
+    else if (name.startsWith("(Synchronize ")) {
+      sum_sync += local_value;
+      ++nb_synchronizer;
+    }
+  }
+  if (sync_index < 0)
+    ARCANE_FATAL("Missing '(Synchronize)' line in report");
+  Real sync_time = report.m_local_values[sync_index];
+  if (nb_synchronizer > 0 && math::abs(sum_sync - sync_time) > 1.0e-10 * math::max(sync_time, 1.0))
+    ARCANE_FATAL("Sum of synchronizer times ({0}) differs from synchronize time ({1})", sum_sync, sync_time);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace ArcaneTest
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
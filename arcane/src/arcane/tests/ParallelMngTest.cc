@@ -101,6 +101,7 @@ class ParallelMngTest
   void _testSerializerWithMessageInfo(Integer nb_value,bool use_wait);
   template<typename DataType> void _testParallelBasic(DataType data);
   void _testReduce2();
+  void _testCollectiveResults();
   void _launchTest(const String& test_name,void (ParallelMngTest::*func)());
   void _testBarrier();
   void _testProcessMessages();
@@ -166,6 +167,7 @@ execute()
   _launchTest("send_receive_nb3",&ParallelMngTest::_testSendRecvNonBlocking3);
 
   _launchTest("reduce2",&ParallelMngTest::_testReduce2);
+  _launchTest("collective_results",&ParallelMngTest::_testCollectiveResults);
 
   if (m_test_broadcast_serializer){
     _launchTest("broadcast_serializer",&ParallelMngTest::_testBroadcastSerializer);
@@ -911,6 +913,76 @@ _testReduce2()
 }
 
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie les valeurs obtenues par les réductions, diffusions et
+ * rassemblements.
+ *
+ * Ce test permet notamment de valider les opérations collectives
+ * en deux niveaux (ARCANE_MPI_NODE_AWARE_COLLECTIVE).
+ */
+void ParallelMngTest::
+_testCollectiveResults()
+{
+  IParallelMng* pm = m_parallel_mng;
+  const Int32 my_rank = pm->commRank();
+  const Int64 nb_rank = pm->commSize();
+  ValueChecker vc(A_FUNCINFO);
+  info() << "Testing results of collective operations";
+
+  // Réductions sur une valeur
+  {
+    const Int64 v = my_rank + 1;
+    vc.areEqual(pm->reduce(Parallel::ReduceSum, v), (nb_rank * (nb_rank + 1)) / 2, "Bad scalar sum");
+    vc.areEqual(pm->reduce(Parallel::ReduceMin, v), Int64(1), "Bad scalar min");
+    vc.areEqual(pm->reduce(Parallel::ReduceMax, v), nb_rank, "Bad scalar max");
+    const Real rv = static_cast<Real>(v);
+    vc.areEqual(pm->reduce(Parallel::ReduceMax, rv), static_cast<Real>(nb_rank), "Bad real scalar max");
+  }
+
+  // Réductions sur un tableau
+  {
+    const Int32 n = 1057;
+    UniqueArray<Int64> values(n);
+    UniqueArray<Int64> expected_values(n);
+    for (Int32 i = 0; i < n; ++i) {
+      values[i] = i * nb_rank + my_rank;
+      expected_values[i] = i * nb_rank * nb_rank + (nb_rank * (nb_rank - 1)) / 2;
+    }
+    pm->reduce(Parallel::ReduceSum, values);
+    vc.areEqualArray(values.constSpan(), expected_values.constSpan(), "Bad array sum");
+  }
+
+  // Diffusion depuis chaque rang
+  for (Int32 root = 0; root < nb_rank; ++root) {
+    const Int32 n = 211;
+    UniqueArray<Int64> values(n);
+    UniqueArray<Int64> expected_values(n);
+    for (Int32 i = 0; i < n; ++i) {
+      values[i] = (my_rank == root) ? (root * 1000 + i) : -1;
+      expected_values[i] = root * 1000 + i;
+    }
+    pm->broadcast(values, root);
+    vc.areEqualArray(values.constSpan(), expected_values.constSpan(), String::format("Bad broadcast root={0}", root));
+  }
+
+  // Rassemblement
+  {
+    const Int32 n = 3;
+    UniqueArray<Int64> send_values(n);
+    for (Int32 i = 0; i < n; ++i)
+      send_values[i] = my_rank * 10 + i;
+    UniqueArray<Int64> recv_values(n * nb_rank);
+    UniqueArray<Int64> expected_values(n * nb_rank);
+    for (Int32 r = 0; r < nb_rank; ++r)
+      for (Int32 i = 0; i < n; ++i)
+        expected_values[r * n + i] = r * 10 + i;
+    pm->allGather(send_values, recv_values);
+    vc.areEqualArray(recv_values.constSpan(), expected_values.constSpan(), "Bad allGather");
+  }
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -15,6 +15,8 @@
 #include "arcane/utils/ScopedPtr.h"
 #include "arcane/utils/CheckedConvert.h"
 #include "arcane/utils/ValueChecker.h"
+#include "arcane/utils/ValueConvert.h"
+#include "arcane/utils/PlatformUtils.h"
 #include "arcane/utils/Event.h"
 
 #include "arcane/core/MeshVariableInfo.h"
@@ -48,6 +50,7 @@
 #include "arcane/core/ParallelMngUtils.h"
 #include "arcane/core/IVariableMng.h"
 #include "arcane/core/IVariableSynchronizerMng.h"
+#include "arcane/core/parallel/IStat.h"
 
 #include "arcane/SerializeBuffer.h"
 
@@ -58,12 +61,14 @@
 #include "arcane/tests/ParallelTester_axl.h"
 
 #include "arcane/parallel/BitonicSortT.H"
+#include "arcane/core/parallel/SampleSortT.H"
 #include "arcane/IParallelExchanger.h"
 #include "arcane/ISerializeMessage.h"
 
 #include "arcane/IApplication.h"
 #include "arcane/IMainFactory.h"
 
+#include <algorithm>
 #include <map>
 #include <set>
 
@@ -316,6 +321,7 @@ class ParallelTesterModule
  private:
 
   void _testSynchronize();
+  void _checkSharedMemorySynchronize();
   void _testPartialSynchronize();
   void _testMultiSynchronize();
   void _testPartialMultiSynchronize();
@@ -330,6 +336,11 @@ class ParallelTesterModule
   void _doInit();
   void _checkEnd();
   void _testBitonicSort();
+  void _testSampleSort();
+  void _checkParallelSort(Parallel::IParallelSort<Int64>& sorter, Int64ConstArrayView keys,
+                          Int64ConstArrayView ref_sorted_keys, const String& name);
+  void _benchParallelSort(Parallel::IParallelSort<Int64>& sorter, Int64ConstArrayView keys,
+                          Int32 nb_repeat, const String& name);
   void _testPartialVariables();
   void _initParticleFamily(IItemFamily* family);
 };
@@ -588,6 +599,7 @@ testLoop()
       _testAccumulate();
       _testGhostItemsReduceOperation();
       _testBitonicSort();
+      _testSampleSort();
       _testLoadBalance();
       _testGetVariableValues();
       _testGhostItemsReduceOperation();
@@ -721,6 +733,40 @@ _testSynchronize()
         ARCANE_FATAL("Error in synchronize test: n={0}",nb_error);
     }
   }
+
+  if (platform::getEnvironmentVariable("ARCANE_SYNCHRONIZE_VERSION")=="6")
+    _checkSharedMemorySynchronize();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie que les synchronisations sont passées par la mémoire partagée.
+ *
+ * Les tests sont exécutés sur un seul noeud. Toutes les valeurs doivent
+ * donc passer par la fenêtre en mémoire partagée, y compris celles des
+ * variables tableaux qui nécessitent d'agrandir la fenêtre.
+ */
+void ParallelTesterModule::
+_checkSharedMemorySynchronize()
+{
+  IParallelMng* pm = parallelMng();
+  // L'implémentation en mémoire partagée n'est utilisée qu'en MPI pur.
+  if (!pm->isParallel() || pm->isThreadImplementation() || pm->isHybridImplementation())
+    return;
+  Int64 shared_size = 0;
+  Int64 nb_fallback = 0;
+  for (const auto& s : pm->stat()->toArccoreStat()->statList()) {
+    if (s.name()=="SyncSharedSend")
+      shared_size = s.cumulativeTotalSize();
+    else if (s.name()=="SyncSharedFallback")
+      nb_fallback = s.cumulativeNbMessage();
+  }
+  info() << "SharedMemorySynchronize size=" << shared_size << " nb_fallback=" << nb_fallback;
+  if (shared_size==0)
+    ARCANE_FATAL("No value has been synchronized through shared memory");
+  if (nb_fallback!=0)
+    ARCANE_FATAL("Shared memory has not been used for {0} synchronizations",nb_fallback);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -1629,6 +1675,165 @@ _testBitonicSort()
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Teste Parallel::SampleSort et compare ses performances avec
+ * Parallel::BitonicSort.
+ *
+ * Le nombre de clés par rang peut être changé via la variable
+ * d'environnement ARCANE_TEST_PARALLEL_SORT_SIZE et le nombre de tris
+ * effectués pour mesurer les performances via la variable
+ * d'environnement ARCANE_TEST_PARALLEL_SORT_NB_REPEAT.
+ */
+void ParallelTesterModule::
+_testSampleSort()
+{
+  info() << "SAMPLE SORT !!!";
+  IParallelMng* pm = subDomain()->parallelMng();
+  Int32 my_rank = pm->commRank();
+  Int32 nb_key = 10000;
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_TEST_PARALLEL_SORT_SIZE", true))
+    nb_key = v.value();
+  Int32 nb_repeat = 5;
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_TEST_PARALLEL_SORT_NB_REPEAT", true))
+    nb_repeat = v.value();
+  // Fait varier le nombre de clés suivant le rang pour tester le
+  // déséquilibre et génère volontairement des doublons.
+  nb_key += (my_rank % 3) * (nb_key / 4);
+  Int64UniqueArray keys(nb_key);
+  for (Int32 i = 0; i < nb_key; ++i) {
+    Int64 v = (static_cast<Int64>(i) * 7919 + static_cast<Int64>(my_rank) * 104729) % 1000003;
+    keys[i] = v / 2;
+  }
+
+  // Référence: toutes les clés triées
+  Int64UniqueArray ref_sorted_keys;
+  pm->allGatherVariable(keys, ref_sorted_keys);
+  std::sort(ref_sorted_keys.begin(), ref_sorted_keys.end());
+
+  {
+    Parallel::BitonicSort<Int64> bitonic_sorter(pm);
+    _checkParallelSort(bitonic_sorter, keys, ref_sorted_keys, "BitonicSort");
+    _benchParallelSort(bitonic_sorter, keys, nb_repeat, "BitonicSort");
+  }
+  {
+    Parallel::SampleSort<Int64> sample_sorter(pm);
+    _checkParallelSort(sample_sorter, keys, ref_sorted_keys, "SampleSort");
+    _benchParallelSort(sample_sorter, keys, nb_repeat, "SampleSort");
+  }
+  // Teste l'échange des clés en plusieurs étapes.
+  {
+    Parallel::SampleSort<Int64> sample_sorter(pm);
+    sample_sorter.setMaxMessageSize(64 * 1024);
+    _checkParallelSort(sample_sorter, keys, ref_sorted_keys, "SampleSortMultiStep");
+  }
+  // Teste avec peu de clés pour vérifier que les rangs sans clés sont
+  // les derniers.
+  {
+    Int64UniqueArray few_keys;
+    if ((my_rank % 2) == 0)
+      few_keys.add(5 + (my_rank / 4));
+    Int64UniqueArray ref_few_keys;
+    pm->allGatherVariable(few_keys, ref_few_keys);
+    std::sort(ref_few_keys.begin(), ref_few_keys.end());
+    Parallel::SampleSort<Int64> sample_sorter(pm);
+    _checkParallelSort(sample_sorter, few_keys, ref_few_keys, "SampleSortFewKeys");
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Trie \a keys avec \a sorter et vérifie le résultat.
+ *
+ * Vérifie que la concaténation des clés de tous les rangs est égale à
+ * \a ref_sorted_keys, que les rangs et indices d'origine sont cohérents
+ * et que les rangs sans clés sont les derniers.
+ */
+void ParallelTesterModule::
+_checkParallelSort(Parallel::IParallelSort<Int64>& sorter, Int64ConstArrayView keys,
+                   Int64ConstArrayView ref_sorted_keys, const String& name)
+{
+  IParallelMng* pm = subDomain()->parallelMng();
+  Int32 nb_rank = pm->commSize();
+
+  sorter.sort(keys);
+
+  Int64ConstArrayView sorted_keys = sorter.keys();
+  Int32ConstArrayView key_ranks = sorter.keyRanks();
+  Int32ConstArrayView key_indexes = sorter.keyIndexes();
+  Int64 nb_sorted = sorted_keys.size();
+  Int64 max_nb_sorted = pm->reduce(Parallel::ReduceMax, nb_sorted);
+  Int64 total_nb_key = pm->reduce(Parallel::ReduceSum, keys.size());
+  info() << "PARALLEL_SORT name=" << name << " nb_rank=" << nb_rank
+         << " total_nb_key=" << total_nb_key << " max_nb_sorted_key=" << max_nb_sorted;
+
+  Int64UniqueArray all_sorted_keys;
+  pm->allGatherVariable(sorted_keys, all_sorted_keys);
+  ValueChecker vc(A_FUNCINFO);
+  vc.areEqualArray(all_sorted_keys.constView(), ref_sorted_keys, String("SortedKeys_") + name);
+
+  // Vérifie les rangs et indices d'origine.
+  Int64UniqueArray all_keys;
+  pm->allGatherVariable(keys, all_keys);
+  Int32UniqueArray nb_key_per_rank(nb_rank);
+  Int32 nb_key = keys.size();
+  pm->allGather(Int32ConstArrayView(1, &nb_key), nb_key_per_rank);
+  Int32UniqueArray rank_offsets(nb_rank, 0);
+  for (Int32 r = 1; r < nb_rank; ++r)
+    rank_offsets[r] = rank_offsets[r - 1] + nb_key_per_rank[r - 1];
+  for (Int64 i = 0; i < nb_sorted; ++i) {
+    Int32 rank = key_ranks[i];
+    Int32 index = key_indexes[i];
+    Int64 orig_key = all_keys[rank_offsets[rank] + index];
+    if (orig_key != sorted_keys[i])
+      ARCANE_FATAL("Bad rank or index for sort '{0}' i={1} key={2} rank={3} index={4} orig_key={5}",
+                   name, i, sorted_keys[i], rank, index, orig_key);
+  }
+
+  // Vérifie que les rangs sans clés sont à la fin
+  Int32UniqueArray nb_sorted_per_rank(nb_rank);
+  Int32 nb_sorted_as_int32 = CheckedConvert::toInt32(nb_sorted);
+  pm->allGather(Int32ConstArrayView(1, &nb_sorted_as_int32), nb_sorted_per_rank);
+  for (Int32 r = 1; r < nb_rank; ++r)
+    if (nb_sorted_per_rank[r] != 0 && nb_sorted_per_rank[r - 1] == 0)
+      ARCANE_FATAL("Empty rank before a non-empty rank for sort '{0}' rank={1} sizes={2}",
+                   name, r, nb_sorted_per_rank);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Mesure le temps de \a nb_repeat tris de \a keys avec \a sorter.
+ *
+ * Seuls les appels à IParallelSort::sort() sont mesurés. Chaque tri est
+ * précédé d'une barrière et le temps d'un tri est le maximum sur tous
+ * les rangs. On affiche le minimum et la moyenne de ces temps.
+ */
+void ParallelTesterModule::
+_benchParallelSort(Parallel::IParallelSort<Int64>& sorter, Int64ConstArrayView keys,
+                   Int32 nb_repeat, const String& name)
+{
+  IParallelMng* pm = subDomain()->parallelMng();
+  nb_repeat = math::max(nb_repeat, 1);
+  Real total_time = 0.0;
+  Real min_time = 0.0;
+  for (Int32 i = 0; i < nb_repeat; ++i) {
+    pm->barrier();
+    Real begin_time = platform::getRealTime();
+    sorter.sort(keys);
+    Real sort_time = platform::getRealTime() - begin_time;
+    sort_time = pm->reduce(Parallel::ReduceMax, sort_time);
+    total_time += sort_time;
+    min_time = (i == 0) ? sort_time : math::min(min_time, sort_time);
+  }
+  Int64 total_nb_key = pm->reduce(Parallel::ReduceSum, keys.size());
+  info() << "PARALLEL_SORT_BENCH name=" << name << " nb_rank=" << pm->commSize()
+         << " total_nb_key=" << total_nb_key << " nb_repeat=" << nb_repeat
+         << " min_time=" << min_time << " average_time=" << (total_time / nb_repeat);
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -88,6 +88,8 @@ class ParticleUnitTest
   void _doTest(Integer iteration);
   void _doTest2(Integer iteration,bool allow_no_cell_particle);
   void _doTest3(Integer iteration);
+  void _testCellSorted();
+  void _checkParticleValues(const String& step);
 };
 
 /*---------------------------------------------------------------------------*/
@@ -105,6 +107,7 @@ ParticleUnitTest(const ServiceBuildInfo& sbi)
   m_particle_family_with_ghost = sbi.mesh()->createItemFamily(IK_Particle,"ArcaneParticlesWithGhost");
   m_particle_family_with_ghost->toParticleFamily()->setEnableGhostItems(true) ;
   m_particle_temperature.fill(0);
+  m_particle_uid_value.fill(0);
   m_particle_temperature_with_ghost.fill(0);
 }
 
@@ -167,12 +170,84 @@ executeTest()
     _doTest2(i,true);
   }
 
+  _testCellSorted();
+
   mesh()->modifier()->removeExtraGhostParticlesBuilder(this);
 }
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+/*!
+ * \brief Teste le tri des particules par maille et l'index maille->particules.
+ */
+void ParticleUnitTest::
+_testCellSorted()
+{
+  IParticleFamily* pf = m_particle_family->toParticleFamily();
+  // Conserve pour chaque particule sa maille et une valeur de variable
+  // pour vérifier que le tri ne les modifie pas.
+  std::map<Int64,std::pair<Int64,Real>> particles_infos;
+  Int32 nb_particle_with_cell = 0;
+  ENUMERATE_PARTICLE(ipart,m_particle_family->allItems()){
+    Particle p = *ipart;
+    m_particle_temperature[p] = static_cast<Real>(p.uniqueId().asInt64());
+    Int64 cell_uid = NULL_ITEM_UNIQUE_ID;
+    if (p.hasCell()){
+      cell_uid = p.cell().uniqueId();
+      ++nb_particle_with_cell;
+    }
+    particles_infos[p.uniqueId()] = std::make_pair(cell_uid,m_particle_temperature[p]);
+  }
+
+  pf->setCellSortedMode(true);
+  pf->sortParticlesByCell();
+  info() << "Test cell sorted particles nb_particle=" << m_particle_family->nbItem()
+         << " nb_with_cell=" << nb_particle_with_cell;
+
+  Integer nb_error = 0;
+  ENUMERATE_PARTICLE(ipart,m_particle_family->allItems()){
+    Particle p = *ipart;
+    auto x = particles_infos.find(p.uniqueId());
+    if (x==particles_infos.end()){
+      ++nb_error;
+      continue;
+    }
+    Int64 cell_uid = (p.hasCell()) ? p.cell().uniqueId().asInt64() : NULL_ITEM_UNIQUE_ID;
+    if (cell_uid!=x->second.first || m_particle_temperature[p]!=x->second.second)
+      ++nb_error;
+  }
+
+  // Après le tri, les particules d'une maille doivent avoir des numéros
+  // locaux consécutifs et les mailles doivent être rangées par ordre croissant.
+  CellParticleIndexView index_view = pf->cellParticleIndexView();
+  if (index_view.nbCell()!=mesh()->cellFamily()->maxLocalId())
+    ARCANE_FATAL("Bad number of cell in index n={0} expected={1}",
+                 index_view.nbCell(),mesh()->cellFamily()->maxLocalId());
+  Int32 nb_indexed = 0;
+  Int32 expected_lid = 0;
+  ParticleInfoListView particles(m_particle_family);
+  for( Int32 c=0, nc=index_view.nbCell(); c<nc; ++c ){
+    CellLocalId cid(c);
+    for( ParticleLocalId plid : index_view.particles(cid) ){
+      Particle p = particles[plid];
+      if (plid.localId()!=expected_lid || !p.hasCell() || p.cellId()!=cid)
+        ++nb_error;
+      ++expected_lid;
+      ++nb_indexed;
+    }
+  }
+  if (nb_indexed!=nb_particle_with_cell)
+    ARCANE_FATAL("Bad number of indexed particles n={0} expected={1}",nb_indexed,nb_particle_with_cell);
+  if (nb_error!=0)
+    ARCANE_FATAL("Errors in cell sorted particles nb_error={0}",nb_error);
+
+  pf->setCellSortedMode(false);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void ParticleUnitTest::
 _doTest2(Integer iteration,bool allow_no_cell_particle)
 {
@@ -251,7 +326,10 @@ _doTest2(Integer iteration,bool allow_no_cell_particle)
             pf->setParticleCell(p,Cell());
           else
             pf->setParticleCell(p,boundary_cells[icell]);
-          m_particle_temperature[p] = 1.0;
+          // Positionne des valeurs dépendantes de la particule pour
+          // vérifier qu'elles sont correctement échangées.
+          m_particle_temperature[p] = static_cast<Real>(p.uniqueId().asInt64());
+          m_particle_uid_value[p] = p.uniqueId().asInt64() * 3;
           //m_particle_energy[p].fill(2.0);
           ++particle_index;
           if (particle_index>=nb_created_particle)
@@ -345,6 +423,7 @@ _doTest2(Integer iteration,bool allow_no_cell_particle)
     }
   }
   pm->barrier();
+  _checkParticleValues("exchange");
   {
     // Supprime la moitié des particules créées
     particles_local_id.clear();
@@ -371,7 +450,35 @@ _doTest2(Integer iteration,bool allow_no_cell_particle)
     info() << "Compacting particle family";
     m_particle_family->compactItems(true);
     info() << "MemoryUsed = " << platform::getMemoryUsed();
+    _checkParticleValues("compact");
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie que les valeurs des variables des particules correspondent
+ * à celles positionnées lors de leur création.
+ */
+void ParticleUnitTest::
+_checkParticleValues(const String& step)
+{
+  Integer nb_error = 0;
+  ENUMERATE_PARTICLE(ipart,m_particle_family->allItems()){
+    Particle p = *ipart;
+    Int64 uid = p.uniqueId().asInt64();
+    Real expected_temperature = static_cast<Real>(uid);
+    Int64 expected_uid_value = uid * 3;
+    if (m_particle_temperature[p]!=expected_temperature || m_particle_uid_value[p]!=expected_uid_value){
+      if (nb_error<10)
+        info() << "Bad particle values step=" << step << " uid=" << uid
+               << " temperature=" << m_particle_temperature[p] << " expected=" << expected_temperature
+               << " uid_value=" << m_particle_uid_value[p] << " expected=" << expected_uid_value;
+      ++nb_error;
+    }
   }
+  if (nb_error!=0)
+    ARCANE_FATAL("Bad particle values after '{0}' nb_error={1}",step,nb_error);
 }
 
 /*---------------------------------------------------------------------------*/
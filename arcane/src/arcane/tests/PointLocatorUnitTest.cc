@@ -0,0 +1,199 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* PointLocatorUnitTest.cc                                     (C) 2000-2024 */
+/*                                                                           */
+/* Service de test de la localisation de points dans le maillage.            */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/Real3.h"
+
+#include "arcane/core/BasicUnitTest.h"
+#include "arcane/core/ServiceFactory.h"
+#include "arcane/core/ServiceBuilder.h"
+#include "arcane/core/IPointLocator.h"
+#include "arcane/core/IMesh.h"
+#include "arcane/core/IParallelMng.h"
+#include "arcane/core/ItemGroup.h"
+#include "arcane/core/VariableTypes.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace ArcaneTest
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+using namespace Arcane;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Service de test du service 'BasicPointLocator'.
+ */
+class PointLocatorUnitTest
+: public BasicUnitTest
+{
+ public:
+
+  explicit PointLocatorUnitTest(const ServiceBuildInfo& sbi);
+
+ public:
+
+  void initializeTest() override {}
+  void executeTest() override;
+
+ private:
+
+  Integer m_nb_error = 0;
+
+ private:
+
+  void _checkLocate(IPointLocator* locator);
+  void _translateNodes(Real3 offset);
+  Real3 _cellCenter(Cell cell);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_REGISTER_SERVICE(PointLocatorUnitTest,
+                        ServiceProperty("PointLocatorUnitTest", ST_CaseOption),
+                        ARCANE_SERVICE_INTERFACE(IUnitTest));
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+PointLocatorUnitTest::
+PointLocatorUnitTest(const ServiceBuildInfo& sbi)
+: BasicUnitTest(sbi)
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void PointLocatorUnitTest::
+executeTest()
+{
+  ServiceBuilder<IPointLocator> sb(subDomain());
+  Ref<IPointLocator> locator = sb.createReference("BasicPointLocator");
+  locator->setMesh(mesh());
+  locator->build();
+  _checkLocate(locator.get());
+
+  // Vérifie la mise à jour après déplacement des noeuds.
+  Real3 offset(1.5, -0.5, 0.25);
+  if (mesh()->dimension() == 2)
+    offset.z = 0.0;
+  _translateNodes(offset);
+  locator->update();
+  _checkLocate(locator.get());
+  _translateNodes(-offset);
+  locator->update();
+  _checkLocate(locator.get());
+
+  if (m_nb_error != 0)
+    ARCANE_FATAL("Errors in point location nb_error={0}", m_nb_error);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie la localisation des centres des mailles.
+ *
+ * Chaque sous-domaine recherche les centres de toutes ses mailles (y compris
+ * les mailles fantômes qui sont localisées par un autre sous-domaine) ainsi
+ * qu'un point en dehors du maillage.
+ */
+void PointLocatorUnitTest::
+_checkLocate(IPointLocator* locator)
+{
+  UniqueArray<Real3> points;
+  UniqueArray<Int64> expected_uids;
+  UniqueArray<Int32> expected_ranks;
+  ENUMERATE_ (Cell, icell, allCells()) {
+    Cell cell = *icell;
+    points.add(_cellCenter(cell));
+    expected_uids.add(cell.uniqueId());
+    expected_ranks.add(cell.owner());
+  }
+  // Ajoute un point en dehors du maillage.
+  const VariableNodeReal3& nodes_coordinates(mesh()->nodesCoordinates());
+  Real3 max_coord(-1.0e30, -1.0e30, -1.0e30);
+  ENUMERATE_ (Node, inode, allNodes())
+    max_coord = math::max(max_coord, nodes_coordinates[inode]);
+  max_coord = mesh()->parallelMng()->reduce(Parallel::ReduceMax, max_coord);
+  points.add(max_coord + Real3(1.0, 1.0, 1.0));
+  expected_uids.add(NULL_ITEM_UNIQUE_ID);
+  expected_ranks.add(A_NULL_RANK);
+
+  const Int32 nb_point = points.size();
+  UniqueArray<Int32> owner_ranks(nb_point);
+  UniqueArray<Int64> cells_uid(nb_point);
+  locator->locate(points, owner_ranks, cells_uid);
+  Int32 nb_local_error = 0;
+  for (Int32 i = 0; i < nb_point; ++i) {
+    if (owner_ranks[i] != expected_ranks[i] || cells_uid[i] != expected_uids[i]) {
+      if (nb_local_error < 10)
+        info() << "Bad location for point=" << points[i]
+               << " rank=" << owner_ranks[i] << " expected=" << expected_ranks[i]
+               << " uid=" << cells_uid[i] << " expected=" << expected_uids[i];
+      ++nb_local_error;
+    }
+  }
+
+  // Vérifie la recherche locale.
+  CellInfoListView cells(mesh()->cellFamily());
+  ENUMERATE_ (Cell, icell, ownCells()) {
+    Cell cell = *icell;
+    CellLocalId lid = locator->findLocalCell(_cellCenter(cell));
+    if (lid.isNull() || cells[lid].uniqueId() != cell.uniqueId()) {
+      if (nb_local_error < 10)
+        info() << "Bad local location for cell uid=" << cell.uniqueId();
+      ++nb_local_error;
+    }
+  }
+  info() << "Check point location nb_point=" << nb_point << " nb_error=" << nb_local_error;
+  m_nb_error += nb_local_error;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void PointLocatorUnitTest::
+_translateNodes(Real3 offset)
+{
+  VariableNodeReal3& nodes_coordinates(mesh()->nodesCoordinates());
+  ENUMERATE_ (Node, inode, allNodes())
+    nodes_coordinates[inode] += offset;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Real3 PointLocatorUnitTest::
+_cellCenter(Cell cell)
+{
+  const VariableNodeReal3& nodes_coordinates(mesh()->nodesCoordinates());
+  Real3 center;
+  for (Node node : cell.nodes())
+    center += nodes_coordinates[node];
+  return center / static_cast<Real>(cell.nbNode());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace ArcaneTest
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
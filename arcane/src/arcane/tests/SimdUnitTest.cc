@@ -266,6 +266,7 @@ class SimdTester
     _doCopyTest(st);
     _doOperatorTest(st);
     _doFMATest(st);
+    _doGatherScatterTest(st);
   }
 
  private:
@@ -335,6 +336,7 @@ class SimdTester
     vc.throwIfError();
   }
   static void _doFMATest(const SimdUnitTest& st);
+  static void _doGatherScatterTest(const SimdUnitTest& st);
 };
 
 /*---------------------------------------------------------------------------*/
@@ -360,6 +362,59 @@ _doFMATest(const SimdUnitTest& st)
   st.info() << "PrintD=" << d;
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Teste la lecture et l'écriture indirecte et compare les
+ * opérations à celles effectuées sur les scalaires.
+ *
+ * Les valeurs sont choisies pour que les opérations soient exactes, ce qui
+ * permet de comparer les résultats sans tolérance même si le compilateur
+ * utilise un FMA.
+ */
+template<typename SimdInfoType>
+void SimdTester<SimdInfoType>::
+_doGatherScatterTest(const SimdUnitTest& st)
+{
+  ValueChecker vc(A_FUNCINFO);
+  const Integer n = SimdRealType::BLOCK_SIZE;
+  const Integer nb_value = 3 * n;
+  UniqueArray<Real> a(nb_value);
+  UniqueArray<Real> b(nb_value);
+  UniqueArray<Real> c(nb_value);
+  UniqueArray<Int32> indexes(n);
+  for( Integer i=0; i<nb_value; ++i ){
+    a[i] = 0.5 * (Real)(i+1);
+    b[i] = (Real)((i*7) % 11);
+    c[i] = (Real)(i*i);
+  }
+  for( Integer z=0; z<n; ++z )
+    indexes[z] = (z*5 + 2) % nb_value;
+
+  SimdRealType sa(a.data(),indexes.data());
+  SimdRealType sb(b.data(),indexes.data());
+  SimdRealType sc(c.data(),indexes.data());
+
+  UniqueArray<Real> result(nb_value,-1.0);
+  SimdRealType sr = sa * sb + sc;
+  sr.set(result.data(),indexes.data());
+  for( Integer z=0; z<n; ++z ){
+    Int32 i = indexes[z];
+    vc.areEqual(result[i],a[i]*b[i]+c[i],"Gather/Scatter FMA");
+  }
+
+  SimdRealType smin = math::min(sa,sb);
+  SimdRealType smax = math::max(sa,sb);
+  SimdRealType ssqrt = math::sqrt(sc);
+  for( Integer z=0; z<n; ++z ){
+    Int32 i = indexes[z];
+    vc.areEqual(smin[z],math::min(a[i],b[i]),"Min");
+    vc.areEqual(smax[z],math::max(a[i],b[i]),"Max");
+    vc.areEqual(ssqrt[z],math::sqrt(c[i]),"Sqrt");
+  }
+  st.info() << "GatherScatter min=" << smin << " max=" << smax;
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -548,6 +603,11 @@ executeTest()
 #endif
 #ifdef ARCANE_HAS_SSE
   SimdTester<SSESimdInfo>::test(*this);
+#endif
+#ifdef ARCANE_HAS_SIMD_VEC
+  SimdTester<VECSimdInfoT<2>>::test(*this);
+  SimdTester<VECSimdInfoT<4>>::test(*this);
+  SimdTester<VECSimdInfoT<8>>::test(*this);
 #endif
   _testSimdArray();
   _testSimdRealN<Real2>();
@@ -17,6 +17,7 @@
 #include "arcane/utils/Mutex.h"
 #include "arcane/utils/ValueChecker.h"
 #include "arcane/utils/TestLogger.h"
+#include "arcane/utils/ParallelLoopTuner.h"
 
 #include "arcane/BasicUnitTest.h"
 #include "arcane/IMesh.h"
@@ -698,6 +699,7 @@ public:
   {
     info() << "OBSERVER THREAD CALLBACK !";
   }
+  void _testLoopTuner();
 
  private:
 
@@ -775,6 +777,70 @@ executeTest()
   { TaskTest::Test6 t6(traceMng(),1023,4097,50); t6.exec(); }
   { TaskTest::Test6 t6(traceMng(),0,4000,100); t6.exec(); }
   { TaskTest::Test6 t6(traceMng(),0,200000,2000); t6.exec(); }
+
+  if (ParallelLoopTuner::isEnabled() && TaskFactory::nbAllowedThread() > 1)
+    _testLoopTuner();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TaskUnitTest::
+_testLoopTuner()
+{
+  info() << "Test ParallelLoopTuner nb_trial=" << ParallelLoopTuner::nbTrial();
+  ValueChecker vc(A_FUNCINFO);
+  const Int32 n = 100000;
+  UniqueArray<Int64> values(n);
+  ForLoopTraceInfo trace_info(A_FUNCINFO, "TestLoopTuner");
+  // Il faut au moins 9 combinaisons fois le nombre d'essais pour que
+  // l'ajustement soit terminé.
+  const Int32 nb_loop = 9 * ParallelLoopTuner::nbTrial() + 5;
+  for (Int32 iter = 0; iter < nb_loop; ++iter) {
+    values.fill(0);
+    arcaneParallelFor(0, n, ForLoopRunInfo(trace_info), [&](Int32 begin, Int32 size) {
+      for (Int32 i = begin; i < (begin + size); ++i)
+        values[i] += i + iter;
+    });
+    Int64 total = 0;
+    for (Int64 v : values)
+      total += v;
+    Int64 expected = (static_cast<Int64>(n) * (n - 1)) / 2 + static_cast<Int64>(n) * iter;
+    vc.areEqual(total, expected, "LoopTunerSum");
+  }
+
+  std::optional<ParallelLoopOptions> tuned = ParallelLoopTuner::tunedOptions(trace_info, n);
+  if (!tuned)
+    ARCANE_FATAL("Loop 'TestLoopTuner' has not been tuned");
+  info() << "Tuned options partitioner=" << (int)tuned->partitioner()
+         << " grain_size=" << tuned->grainSize();
+
+  // Vérifie qu'on relit bien les options sauvegardées.
+  String filename = "test_loop_tuning.json";
+  ParallelLoopTuner::exportTuning(filename);
+  ParallelLoopTuner::reset();
+  if (ParallelLoopTuner::tunedOptions(trace_info, n))
+    ARCANE_FATAL("Tuning should have been reset");
+  ParallelLoopTuner::importTuning(filename);
+  std::optional<ParallelLoopOptions> read_tuned = ParallelLoopTuner::tunedOptions(trace_info, n);
+  if (!read_tuned)
+    ARCANE_FATAL("Loop 'TestLoopTuner' not found in tuning file");
+  vc.areEqual((int)read_tuned->partitioner(), (int)tuned->partitioner(), "Partitioner");
+  vc.areEqual(read_tuned->grainSize(), tuned->grainSize(), "GrainSize");
+
+  // Vérifie que les boucles dont les options sont explicites ne sont pas ajustées.
+  ParallelLoopOptions static_options;
+  static_options.setPartitioner(ParallelLoopOptions::Partitioner::Static);
+  static_options.setGrainSize(n / 2);
+  ForLoopTraceInfo static_trace_info(A_FUNCINFO, "TestLoopTunerStatic");
+  for (Int32 iter = 0; iter < nb_loop; ++iter) {
+    arcaneParallelFor(0, n, ForLoopRunInfo(static_options, static_trace_info), [&](Int32 begin, Int32 size) {
+      for (Int32 i = begin; i < (begin + size); ++i)
+        values[i] = i;
+    });
+  }
+  if (ParallelLoopTuner::tunedOptions(static_trace_info, n))
+    ARCANE_FATAL("Loop 'TestLoopTunerStatic' with explicit options should not be tuned");
 }
 
 /*---------------------------------------------------------------------------*/
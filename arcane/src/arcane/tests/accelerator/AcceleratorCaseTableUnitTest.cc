@@ -0,0 +1,156 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* AcceleratorCaseTableUnitTest.cc                             (C) 2000-2024 */
+/*                                                                           */
+/* Service de test de 'CaseTableView' sur accélérateur.                      */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/NumArray.h"
+#include "arcane/utils/FatalErrorException.h"
+
+#include "arcane/core/BasicUnitTest.h"
+#include "arcane/core/ServiceFactory.h"
+#include "arcane/core/CaseTable.h"
+#include "arcane/core/ICaseMng.h"
+
+#include "arcane/accelerator/core/Runner.h"
+#include "arcane/accelerator/core/IAcceleratorMng.h"
+
+#include "arcane/accelerator/RunCommandLoop.h"
+#include "arcane/accelerator/NumArrayViews.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace ArcaneTest
+{
+using namespace Arcane;
+namespace ax = Arcane::Accelerator;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Service de test de CaseTableView sur accélérateur.
+ *
+ * Vérifie que les valeurs calculées dans une commande avec la vue
+ * retournée par CaseTable::realView() sont identiques à celles
+ * retournées par CaseTable::value().
+ */
+class AcceleratorCaseTableUnitTest
+: public BasicUnitTest
+{
+ public:
+
+  explicit AcceleratorCaseTableUnitTest(const ServiceBuildInfo& cb);
+
+ public:
+
+  void initializeTest() override;
+  void executeTest() override;
+
+ private:
+
+  ax::Runner m_runner;
+
+ public:
+
+  void _executeTest(const String& func_name);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_REGISTER_CASE_OPTIONS_NOAXL_FACTORY(AcceleratorCaseTableUnitTest, IUnitTest,
+                                           AcceleratorCaseTableUnitTest);
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+AcceleratorCaseTableUnitTest::
+AcceleratorCaseTableUnitTest(const ServiceBuildInfo& sb)
+: BasicUnitTest(sb)
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void AcceleratorCaseTableUnitTest::
+initializeTest()
+{
+  m_runner = *(subDomain()->acceleratorMng()->defaultRunner());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void AcceleratorCaseTableUnitTest::
+executeTest()
+{
+  _executeTest("test-real-linear");
+  _executeTest("test-real-constant");
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void AcceleratorCaseTableUnitTest::
+_executeTest(const String& func_name)
+{
+  info() << "Test CaseTableView on accelerator function=" << func_name
+         << " policy=" << m_runner.executionPolicy();
+  ICaseMng* cm = subDomain()->caseMng();
+  auto* table = dynamic_cast<CaseTable*>(cm->findFunction(func_name));
+  if (!table)
+    ARCANE_FATAL("CaseTable '{0}' not found", func_name);
+
+  // Paramètres avant, dans et après l'intervalle de la table, avec
+  // les paramètres exacts de la table.
+  const Int32 nb_value = 200;
+  NumArray<Real, MDDim1> params(nb_value);
+  for (Int32 i = 0; i < nb_value; ++i)
+    params[i] = -3.0 + 0.1 * static_cast<Real>(i);
+
+  NumArray<Real, MDDim1> results(nb_value);
+  CaseTableView table_view = table->realView();
+  auto queue = makeQueue(m_runner);
+  {
+    auto command = makeCommand(queue);
+    auto in_params = viewIn(command, params);
+    auto out_results = viewOut(command, results);
+    command << RUNCOMMAND_LOOP1(iter, nb_value)
+    {
+      auto [i] = iter();
+      out_results[i] = table_view.value(in_params[i]);
+    };
+  }
+
+  Int32 nb_error = 0;
+  for (Int32 i = 0; i < nb_value; ++i) {
+    Real expected = 0.0;
+    table->value(params[i], expected);
+    // Le calcul sur accélérateur peut utiliser des instructions FMA.
+    if (!math::isNearlyEqualWithEpsilon(results[i], expected, 1.0e-12)) {
+      ++nb_error;
+      if (nb_error < 10)
+        info() << "Bad value func=" << func_name << " x=" << params[i]
+               << " y=" << results[i] << " expected=" << expected;
+    }
+  }
+  if (nb_error != 0)
+    ARCANE_FATAL("Bad values for function '{0}' nb_error={1}", func_name, nb_error);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace ArcaneTest
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -68,6 +68,8 @@ class AcceleratorViewsUnitTest
   PartialVariableCellReal3 m_partial_cell2_real3;
   PartialVariableCellArrayReal m_partial_cell_array1;
   PartialVariableCellArrayReal m_partial_cell_array2;
+  VariableCellReal m_cell1_real;
+  VariableCellReal m_cell2_real;
 
  private:
 
@@ -90,6 +92,7 @@ class AcceleratorViewsUnitTest
   void _checkResultReal2x2(Real to_add);
   void _checkResultReal3x3(Real to_add);
   void _executeTestGroupIndexTable();
+  void _executeTestSimdEnumerate();
 };
 
 /*---------------------------------------------------------------------------*/
@@ -116,6 +119,8 @@ AcceleratorViewsUnitTest(const ServiceBuildInfo& sb)
 , m_partial_cell2_real3(VariableBuildInfo(sb.mesh(), "PartialCell2Real3", "Cell", "MyPartialGroup"))
 , m_partial_cell_array1(VariableBuildInfo(sb.mesh(), "PartialCellArray1", "Cell", "MyPartialGroup"))
 , m_partial_cell_array2(VariableBuildInfo(sb.mesh(), "PartialCellArray2", "Cell", "MyPartialGroup"))
+, m_cell1_real(VariableBuildInfo(sb.mesh(), "Cell1Real"))
+, m_cell2_real(VariableBuildInfo(sb.mesh(), "Cell2Real"))
 {
 }
 
@@ -207,6 +212,49 @@ executeTest()
   _executeTestMemoryCopy();
   _executeTestVariableCopy();
   _executeTestVariableFill();
+  _executeTestSimdEnumerate();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void AcceleratorViewsUnitTest::
+_executeTestSimdEnumerate()
+{
+  info() << "TestSimdEnumerate";
+  ValueChecker vc(A_FUNCINFO);
+  auto queue = makeQueue(m_runner);
+
+  ENUMERATE_ (Cell, icell, allCells()) {
+    m_cell1_real[icell] = static_cast<Real>(icell.itemLocalId() + 1);
+  }
+  m_cell2_real.fill(-1.0);
+  {
+    auto command = makeCommand(queue);
+    auto in_cell1 = ax::viewIn(command, m_cell1_real);
+    auto out_cell2 = ax::viewOut(command, m_cell2_real);
+    command << RUNCOMMAND_ENUMERATE_SIMD(CellLocalId, vi, allCells())
+    {
+      // Le type de 'vi' dépend du paquet (SIMD ou scalaire) donc on
+      // n'utilise que des opérations disponibles pour les deux types.
+      out_cell2[vi] = in_cell1[vi] + in_cell1[vi];
+    };
+  }
+  {
+    auto command = makeCommand(queue);
+    auto in_cell2 = ax::viewIn(command, m_cell2_real);
+    auto out_cell1 = ax::viewOut(command, m_cell1_real);
+    command << RUNCOMMAND_ENUMERATE_SIMD(CellLocalId, vi, allCells())
+    {
+      out_cell1[vi] = in_cell2[vi] * in_cell2[vi];
+    };
+  }
+  ENUMERATE_ (Cell, icell, allCells()) {
+    Real v = static_cast<Real>(icell.itemLocalId() + 1) * 2.0;
+    vc.areEqual(m_cell2_real[icell], v, "SimdValue1");
+    Real expected = v * v;
+    vc.areEqual(m_cell1_real[icell], expected, "SimdValue2");
+  }
 }
 
 /*---------------------------------------------------------------------------*/
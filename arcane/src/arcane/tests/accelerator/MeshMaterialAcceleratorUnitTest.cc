@@ -112,6 +112,11 @@ class MeshMaterialAcceleratorUnitTest
   EnvironmentVariableCellReal m_env_b;
   EnvironmentVariableCellReal m_env_c;
 
+  MaterialVariableCellReal m_lazy_source;
+  MaterialVariableCellReal m_lazy_computed;
+  //! Nombre d'appels à la fonction de calcul de m_lazy_computed par matériau
+  UniqueArray<Int32> m_nb_lazy_compute;
+
   UniqueArray<Int32> m_env1_pure_value_index;
   UniqueArray<Int32> m_env1_partial_value_index;
   CellGroup m_sub_env_group1;
@@ -129,6 +134,11 @@ class MeshMaterialAcceleratorUnitTest
   void _executeTest4(Integer nb_z);
   void _executeTest5(Integer nb_z, MatCellVectorView mat);
   void _executeTest6();
+  void _executeTest7();
+  void _computeLazyValues(IMeshMaterial* mat);
+  void _writeLazySource(RunQueue& queue, Real value);
+  void _readLazyValues(RunQueue& queue, const char* message, ConstArrayView<Int32> expected_nb_compute,
+                       IMeshComponent* component = nullptr);
   void _checkEnvValues1();
   void _checkMatValues1();
   void _checkEnvironmentValues();
@@ -161,6 +171,8 @@ MeshMaterialAcceleratorUnitTest(const ServiceBuildInfo& sb)
 , m_env_a(VariableBuildInfo(mesh(),"EnvA"))
 , m_env_b(VariableBuildInfo(mesh(),"EnvB"))
 , m_env_c(VariableBuildInfo(mesh(),"EnvC"))
+, m_lazy_source(VariableBuildInfo(mesh(),"LazySource"))
+, m_lazy_computed(VariableBuildInfo(mesh(),"LazyComputed"))
 {
 }
 
@@ -347,6 +359,9 @@ executeTest()
   {
     _executeTest6();
   }
+  {
+    _executeTest7();
+  }
 }
 
 /*---------------------------------------------------------------------------*/
@@ -946,6 +961,164 @@ _checkEnvironmentValues()
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Test du recalcul automatique des variables matériaux.
+ *
+ * Vérifie que la création d'une vue en lecture ne recalcule que les
+ * matériaux qui ne sont plus à jour suite à une écriture dans une
+ * dépendance ou à une modification des mailles des constituants.
+ * Vérifie aussi qu'une vue créée pour un constituant ne recalcule ou ne
+ * modifie que les matériaux de ce constituant.
+ */
+void MeshMaterialAcceleratorUnitTest::
+_executeTest7()
+{
+  info() << "Execute Test 7";
+  const Int32 nb_mat = m_mm_mng->materials().size();
+  m_nb_lazy_compute.resize(nb_mat);
+  m_nb_lazy_compute.fill(0);
+  m_lazy_computed.setMaterialComputeFunction(this, &MeshMaterialAcceleratorUnitTest::_computeLazyValues);
+  m_lazy_computed.addMaterialDepend(m_lazy_source);
+
+  auto queue = makeQueue(m_runner);
+  UniqueArray<Int32> expected_nb_compute(nb_mat, 0);
+
+  // Écrit la source: tous les matériaux doivent être recalculés.
+  _writeLazySource(queue, 1.0);
+  for (Int32 i = 0; i < nb_mat; ++i)
+    ++expected_nb_compute[i];
+  _readLazyValues(queue, "AfterWrite", expected_nb_compute);
+
+  // Aucune modification: pas de recalcul
+  _readLazyValues(queue, "NoChange", expected_nb_compute);
+
+  // Supprime des mailles d'un matériau du deuxième milieu: seuls les
+  // matériaux de ce milieu doivent être recalculés.
+  IMeshEnvironment* env2 = m_mm_mng->environments()[1];
+  IMeshMaterial* mat_to_modify = env2->materials()[1];
+  {
+    UniqueArray<Int32> ids_to_remove;
+    ENUMERATE_MATCELL (imc, mat_to_modify) {
+      if ((imc.index() % 3) == 0)
+        ids_to_remove.add((*imc).globalCell().localId());
+    }
+    info() << "Removing nb_cell=" << ids_to_remove.size() << " from mat=" << mat_to_modify->name();
+    MeshMaterialModifier modifier(m_mm_mng);
+    modifier.removeCells(mat_to_modify, ids_to_remove);
+  }
+  for (IMeshMaterial* mat : env2->materials())
+    ++expected_nb_compute[mat->id()];
+  _readLazyValues(queue, "AfterRemove", expected_nb_compute);
+
+  // Écrit de nouveau la source via une vue en lecture/écriture.
+  {
+    auto cmd = makeCommand(queue);
+    auto inout_source = ax::viewInOut(cmd, m_lazy_source);
+    ENUMERATE_MAT (imat, m_mm_mng) {
+      IMeshMaterial* mat = *imat;
+      cmd << RUNCOMMAND_MAT_ENUMERATE(MatCell, mvi, mat)
+      {
+        inout_source[mvi] = inout_source[mvi] + 1.0;
+      };
+    }
+  }
+  for (Int32 i = 0; i < nb_mat; ++i)
+    ++expected_nb_compute[i];
+  _readLazyValues(queue, "AfterInOut", expected_nb_compute);
+
+  // Écrit la source pour un seul matériau: seul ce matériau doit être
+  // recalculé.
+  {
+    auto cmd = makeCommand(queue);
+    auto out_source = ax::viewOut(cmd, m_lazy_source, mat_to_modify);
+    cmd << RUNCOMMAND_MAT_ENUMERATE(MatCell, mvi, mat_to_modify)
+    {
+      out_source[mvi] = 5.0;
+    };
+  }
+  ++expected_nb_compute[mat_to_modify->id()];
+  _readLazyValues(queue, "AfterWriteOneMat", expected_nb_compute);
+
+  // Écrit la source pour tous les matériaux puis lit uniquement un
+  // matériau, puis un milieu puis toutes les valeurs. Chaque lecture ne
+  // doit recalculer que les matériaux concernés qui ne sont pas à jour.
+  _writeLazySource(queue, 3.0);
+  IMeshMaterial* mat_to_read = m_mm_mng->materials()[0];
+  ++expected_nb_compute[mat_to_read->id()];
+  _readLazyValues(queue, "ReadOneMat", expected_nb_compute, mat_to_read);
+  for (IMeshMaterial* mat : env2->materials())
+    if (mat != mat_to_read)
+      ++expected_nb_compute[mat->id()];
+  _readLazyValues(queue, "ReadOneEnv", expected_nb_compute, env2);
+  for (IMeshMaterial* mat : m_mm_mng->materials())
+    if (mat != mat_to_read && mat->environment() != env2)
+      ++expected_nb_compute[mat->id()];
+  _readLazyValues(queue, "ReadAll", expected_nb_compute);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialAcceleratorUnitTest::
+_computeLazyValues(IMeshMaterial* mat)
+{
+  info() << "Compute lazy values mat=" << mat->name();
+  ++m_nb_lazy_compute[mat->id()];
+  auto queue = makeQueue(m_runner);
+  auto cmd = makeCommand(queue);
+  auto in_source = ax::viewIn(cmd, m_lazy_source);
+  auto out_computed = ax::viewOut(cmd, m_lazy_computed, mat);
+  cmd << RUNCOMMAND_MAT_ENUMERATE(MatCell, mvi, mat)
+  {
+    out_computed[mvi] = 2.0 * in_source[mvi];
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialAcceleratorUnitTest::
+_writeLazySource(RunQueue& queue, Real value)
+{
+  auto cmd = makeCommand(queue);
+  auto out_source = ax::viewOut(cmd, m_lazy_source);
+  ENUMERATE_MAT (imat, m_mm_mng) {
+    IMeshMaterial* mat = *imat;
+    Real mat_value = value + static_cast<Real>(mat->id());
+    cmd << RUNCOMMAND_MAT_ENUMERATE(MatCell, mvi, mat)
+    {
+      out_source[mvi] = mat_value;
+    };
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialAcceleratorUnitTest::
+_readLazyValues(RunQueue& queue, const char* message, ConstArrayView<Int32> expected_nb_compute,
+                IMeshComponent* component)
+{
+  {
+    auto cmd = makeCommand(queue);
+    auto in_computed = ax::viewIn(cmd, m_lazy_computed, component);
+  }
+  info() << "Lazy compute (" << message << ") nb_compute=" << m_nb_lazy_compute;
+  ValueChecker vc(A_FUNCINFO);
+  vc.areEqualArray(m_nb_lazy_compute.constView(), expected_nb_compute, String("NbLazyCompute_") + message);
+  // Seules les valeurs des matériaux de component sont à jour.
+  ENUMERATE_MAT (imat, m_mm_mng) {
+    IMeshMaterial* mat = *imat;
+    if (component && component != mat && component != mat->environment())
+      continue;
+    ENUMERATE_MATCELL (imc, mat) {
+      _checkOneValue(m_lazy_computed[imc], 2.0 * m_lazy_source[imc], "Test7_lazy_computed");
+    }
+  }
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
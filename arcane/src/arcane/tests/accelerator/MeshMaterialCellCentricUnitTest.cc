@@ -0,0 +1,505 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MeshMaterialCellCentricUnitTest.cc                          (C) 2000-2024 */
+/*                                                                           */
+/* Service de test du rangement des valeurs matériaux par maille.            */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/ValueConvert.h"
+
+#include "arcane/core/BasicUnitTest.h"
+#include "arcane/core/ServiceFactory.h"
+#include "arcane/core/IMesh.h"
+#include "arcane/core/ItemGroup.h"
+
+#include "arcane/materials/IMeshMaterialMng.h"
+#include "arcane/materials/IMeshMaterial.h"
+#include "arcane/materials/IMeshEnvironment.h"
+#include "arcane/materials/MeshEnvironmentBuildInfo.h"
+#include "arcane/materials/MeshMaterialModifier.h"
+#include "arcane/materials/MatItemEnumerator.h"
+#include "arcane/materials/MeshMaterialVariableRef.h"
+#include "arcane/materials/CellToAllEnvCellConverter.h"
+#include "arcane/materials/CellCentricMaterialLayout.h"
+#include "arcane/materials/CellCentricMaterialVariableScalar.h"
+
+#include "arcane/accelerator/core/Runner.h"
+#include "arcane/accelerator/core/IAcceleratorMng.h"
+#include "arcane/accelerator/core/RunQueue.h"
+#include "arcane/accelerator/RunCommandEnumerate.h"
+#include "arcane/accelerator/MaterialVariableViews.h"
+
+#include "arcane/tests/ArcaneTestGlobal.h"
+
+#include <cmath>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace ArcaneTest
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+using namespace Arcane;
+using namespace Arcane::Materials;
+namespace ax = Arcane::Accelerator;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Service de test du rangement des valeurs matériaux par maille.
+ *
+ * Compare une loi de fermeture des mailles mixtes utilisant le rangement
+ * classique des variables matériaux avec la même loi utilisant
+ * CellCentricMaterialLayout. Le cas contient 12 matériaux répartis dans
+ * 4 milieux.
+ *
+ * Les deux versions utilisent la même file d'exécution. Le temps de la
+ * version par maille inclut la recopie des valeurs (gather() et scatter()).
+ * Le test affiche aussi le nombre d'exécutions de la loi de fermeture
+ * entre gather() et scatter() à partir duquel la version par maille est
+ * plus rapide que la version classique.
+ */
+class MeshMaterialCellCentricUnitTest
+: public BasicUnitTest
+{
+ public:
+
+  explicit MeshMaterialCellCentricUnitTest(const ServiceBuildInfo& sbi);
+
+ public:
+
+  void initializeTest() override;
+  void executeTest() override;
+
+ private:
+
+  ax::Runner* m_runner = nullptr;
+  IMeshMaterialMng* m_mm_mng = nullptr;
+
+  MaterialVariableCellReal m_volume_fraction;
+  MaterialVariableCellReal m_pressure_ref;
+  MaterialVariableCellReal m_pressure;
+
+ private:
+
+  void _initializeVariables();
+  void _checkLayout(CellCentricMaterialLayout& layout);
+  void _checkValues();
+
+ public:
+
+  //! Temps de la version par maille
+  class CellCentricTime
+  {
+   public:
+
+    //! Temps des recopies (gather() et scatter())
+    Real m_copy_time = 0.0;
+    //! Temps des exécutions de la loi de fermeture
+    Real m_compute_time = 0.0;
+  };
+
+ public:
+
+  Real _computeReference(RunQueue& queue, Int32 nb_z);
+  CellCentricTime _computeCellCentric(RunQueue& queue, CellCentricMaterialLayout& layout, Int32 nb_z);
+
+ private:
+
+  void _printComparison(Int32 nb_z, Real reference_time, const CellCentricTime& cell_centric_time);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_REGISTER_CASE_OPTIONS_NOAXL_FACTORY(MeshMaterialCellCentricUnitTest,
+                                           IUnitTest, MeshMaterialCellCentricUnitTest);
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+MeshMaterialCellCentricUnitTest::
+MeshMaterialCellCentricUnitTest(const ServiceBuildInfo& sbi)
+: BasicUnitTest(sbi)
+, m_volume_fraction(VariableBuildInfo(sbi.mesh(), "CellCentricVolumeFraction"))
+, m_pressure_ref(VariableBuildInfo(sbi.mesh(), "CellCentricPressureRef"))
+, m_pressure(VariableBuildInfo(sbi.mesh(), "CellCentricPressure"))
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialCellCentricUnitTest::
+initializeTest()
+{
+  m_runner = subDomain()->acceleratorMng()->defaultRunner();
+  m_mm_mng = IMeshMaterialMng::getReference(mesh());
+
+  const Int32 nb_env = 4;
+  const Int32 nb_mat_per_env = 3;
+  for (Int32 i = 0; i < nb_env * nb_mat_per_env; ++i)
+    m_mm_mng->registerMaterialInfo(String("MAT") + String::fromNumber(i));
+  for (Int32 e = 0; e < nb_env; ++e) {
+    MeshEnvironmentBuildInfo env_build(String("ENV") + String::fromNumber(e));
+    for (Int32 m = 0; m < nb_mat_per_env; ++m)
+      env_build.addMaterial(String("MAT") + String::fromNumber(e * nb_mat_per_env + m));
+    m_mm_mng->createEnvironment(env_build);
+  }
+  m_mm_mng->endCreate(false);
+
+  // Répartit les mailles pour avoir entre 1 et 3 milieux par maille
+  // et entre 1 et 3 matériaux par milieu.
+  UniqueArray<UniqueArray<Int32>> mat_cells(nb_env * nb_mat_per_env);
+  ENUMERATE_ (Cell, icell, allCells()) {
+    Int64 uid = (*icell).uniqueId();
+    Int64 nb_env_in_cell = 1 + (uid % 3);
+    for (Int32 e = 0; e < nb_env; ++e) {
+      if (((e + uid) % nb_env) >= nb_env_in_cell)
+        continue;
+      for (Int32 m = 0; m < nb_mat_per_env; ++m)
+        if (((m + uid / 4) % nb_mat_per_env) <= ((uid / 12) % nb_mat_per_env))
+          mat_cells[e * nb_mat_per_env + m].add(icell.itemLocalId());
+    }
+  }
+  {
+    MeshMaterialModifier modifier(m_mm_mng);
+    for (Int32 i = 0, n = mat_cells.size(); i < n; ++i)
+      modifier.addCells(m_mm_mng->materials()[i], mat_cells[i]);
+  }
+
+  Int32 nb_pure = 0;
+  Int32 nb_mixed = 0;
+  ENUMERATE_ALLENVCELL (iallenvcell, m_mm_mng, allCells()) {
+    AllEnvCell all_env_cell = *iallenvcell;
+    Int32 nb_mat = 0;
+    ENUMERATE_CELL_ENVCELL (ienvcell, all_env_cell) {
+      nb_mat += (*ienvcell).nbMaterial();
+    }
+    if (nb_mat == 1)
+      ++nb_pure;
+    else if (nb_mat > 1)
+      ++nb_mixed;
+  }
+  info() << "CellCentric nb_pure=" << nb_pure << " nb_mixed=" << nb_mixed;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialCellCentricUnitTest::
+executeTest()
+{
+  Int32 nb_z = 20;
+  if (arcaneIsDebug())
+    nb_z = 2;
+  if (auto v = Convert::Type<Int32>::tryParseFromEnvironment("ARCANE_TEST_CELLCENTRIC_NB_LOOP", true))
+    nb_z = v.value();
+
+  CellCentricMaterialLayout layout(m_mm_mng);
+  {
+    Real t0 = platform::getRealTime();
+    layout.update();
+    Real t1 = platform::getRealTime();
+    info() << "CellCentric layout build time=" << (t1 - t0) << " nb_value=" << layout.nbValue();
+  }
+  _checkLayout(layout);
+
+  auto queue = makeQueue(m_runner);
+  info() << "CellCentric execution policy=" << queue.executionPolicy();
+  _initializeVariables();
+  Real reference_time = _computeReference(queue, nb_z);
+  CellCentricTime cell_centric_time = _computeCellCentric(queue, layout, nb_z);
+  _printComparison(nb_z, reference_time, cell_centric_time);
+  _checkValues();
+
+  // Modifie les matériaux et vérifie que le rangement est recalculé.
+  {
+    IMeshMaterial* mat0 = m_mm_mng->materials()[0];
+    UniqueArray<Int32> removed_cells;
+    ENUMERATE_MATCELL (imatcell, mat0) {
+      if ((imatcell.index() % 2) == 0)
+        removed_cells.add((*imatcell).globalCell().localId());
+    }
+    {
+      MeshMaterialModifier modifier(m_mm_mng);
+      modifier.removeCells(mat0, removed_cells);
+    }
+    if (layout.isUpToDate())
+      ARCANE_FATAL("Layout should not be up to date after material modification");
+    layout.update();
+    _checkLayout(layout);
+    _initializeVariables();
+    _computeReference(queue, 1);
+    _computeCellCentric(queue, layout, 1);
+    _checkValues();
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialCellCentricUnitTest::
+_initializeVariables()
+{
+  ENUMERATE_ALLENVCELL (iallenvcell, m_mm_mng, allCells()) {
+    AllEnvCell all_env_cell = *iallenvcell;
+    Cell cell = all_env_cell.globalCell();
+    Int32 nb_mat = 0;
+    ENUMERATE_CELL_ENVCELL (ienvcell, all_env_cell) {
+      nb_mat += (*ienvcell).nbMaterial();
+    }
+    m_volume_fraction[cell] = 1.0;
+    m_pressure[cell] = 0.0;
+    m_pressure_ref[cell] = 0.0;
+    ENUMERATE_CELL_ENVCELL (ienvcell, all_env_cell) {
+      EnvCell env_cell = *ienvcell;
+      m_pressure[env_cell] = 0.0;
+      m_pressure_ref[env_cell] = 0.0;
+      ENUMERATE_CELL_MATCELL (imatcell, env_cell) {
+        MatCell mat_cell = *imatcell;
+        Real p = 1.0 + static_cast<Real>((cell.uniqueId().asInt64() + 7 * mat_cell.materialId()) % 101);
+        m_volume_fraction[mat_cell] = 1.0 / static_cast<Real>(nb_mat);
+        m_pressure[mat_cell] = p;
+        m_pressure_ref[mat_cell] = p;
+      }
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Vérifie que le rangement référence toutes les valeurs matériaux
+ * et milieux.
+ */
+void MeshMaterialCellCentricUnitTest::
+_checkLayout(CellCentricMaterialLayout& layout)
+{
+  CellCentricMaterialLayoutView v = layout.view();
+  ENUMERATE_ALLENVCELL (iallenvcell, m_mm_mng, allCells()) {
+    AllEnvCell all_env_cell = *iallenvcell;
+    CellLocalId cid(all_env_cell.globalCell().localId());
+    Int32 begin = v.cellBegin(cid);
+    Int32 end = v.cellEnd(cid);
+    if (v.position(cid) != begin || !v.valueInfo(begin).isGlobal())
+      ARCANE_FATAL("Bad global position for cell '{0}'", cid);
+    ENUMERATE_CELL_ENVCELL (ienvcell, all_env_cell) {
+      EnvCell env_cell = *ienvcell;
+      Int32 pos = v.position(ComponentItemLocalId(env_cell));
+      if (pos < begin || pos >= end)
+        ARCANE_FATAL("Bad position for env_cell mvi={0} pos={1}", env_cell._varIndex(), pos);
+      CellCentricValueInfo vi = v.valueInfo(pos);
+      if (!vi.isEnvironment() || vi.environmentId() != env_cell.environmentId() || v.matVarIndex(pos) != env_cell._varIndex())
+        ARCANE_FATAL("Bad value info for env_cell mvi={0} pos={1}", env_cell._varIndex(), pos);
+      ENUMERATE_CELL_MATCELL (imatcell, env_cell) {
+        MatCell mat_cell = *imatcell;
+        Int32 mpos = v.position(ComponentItemLocalId(mat_cell));
+        if (mpos < begin || mpos >= end)
+          ARCANE_FATAL("Bad position for mat_cell mvi={0} pos={1}", mat_cell._varIndex(), mpos);
+        CellCentricValueInfo mvi = v.valueInfo(mpos);
+        if (!mvi.isMaterial() || mvi.materialId() != mat_cell.materialId() || mvi.environmentId() != env_cell.environmentId())
+          ARCANE_FATAL("Bad value info for mat_cell mvi={0} pos={1}", mat_cell._varIndex(), mpos);
+      }
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Loi de fermeture avec le rangement classique.
+ *
+ * La pression milieu est la moyenne des pressions matériaux pondérée par
+ * la fraction volumique et la pression globale la somme des contributions
+ * des matériaux.
+ *
+ * Retourne le temps d'exécution.
+ */
+Real MeshMaterialCellCentricUnitTest::
+_computeReference(RunQueue& queue, Int32 nb_z)
+{
+  CellToAllEnvCellConverter allenvcell_converter(m_mm_mng);
+
+  Real t0 = platform::getRealTime();
+  for (Int32 z = 0; z < nb_z; ++z) {
+    auto command = makeCommand(queue);
+    auto in_frac = ax::viewIn(command, m_volume_fraction);
+    auto inout_p = ax::viewInOut(command, m_pressure_ref);
+    command << RUNCOMMAND_ENUMERATE (CellLocalId, cid, allCells())
+    {
+      AllEnvCell all_env_cell = allenvcell_converter[cid];
+      Real global_p = 0.0;
+      ENUMERATE_CELL_ENVCELL (ienvcell, all_env_cell) {
+        EnvCell env_cell = *ienvcell;
+        Real sum_p = 0.0;
+        Real sum_frac = 0.0;
+        ENUMERATE_CELL_MATCELL (imatcell, env_cell) {
+          ComponentItemLocalId mat_lid(*imatcell);
+          Real frac = in_frac[mat_lid];
+          sum_p += frac * inout_p[mat_lid];
+          sum_frac += frac;
+        }
+        inout_p[ComponentItemLocalId(env_cell)] = sum_p / sum_frac;
+        global_p += sum_p;
+      }
+      inout_p[cid] = global_p;
+    };
+  }
+  queue.barrier();
+  Real t1 = platform::getRealTime();
+  info() << "CellCentric reference closure time=" << (t1 - t0) << " nb_z=" << nb_z;
+  return t1 - t0;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Loi de fermeture avec le rangement par maille.
+ *
+ * Les valeurs d'une maille étant contigües, on les parcourt directement
+ * dans l'ordre du rangement: chaque valeur milieu est suivie des valeurs
+ * de ses matériaux.
+ *
+ * Retourne le temps d'exécution de la loi de fermeture et celui des
+ * recopies des valeurs depuis et vers le rangement classique.
+ */
+auto MeshMaterialCellCentricUnitTest::
+_computeCellCentric(RunQueue& queue, CellCentricMaterialLayout& layout, Int32 nb_z) -> CellCentricTime
+{
+  CellCentricMaterialVariableScalar<Real> cc_frac(&layout, m_volume_fraction);
+  CellCentricMaterialVariableScalar<Real> cc_pressure(&layout, m_pressure);
+
+  Real t0 = platform::getRealTime();
+  cc_frac.gather(queue);
+  cc_pressure.gather(queue);
+  queue.barrier();
+  Real t1 = platform::getRealTime();
+
+  for (Int32 z = 0; z < nb_z; ++z) {
+    auto command = makeCommand(queue);
+    auto in_frac = cc_frac.constView();
+    auto inout_p = cc_pressure.view();
+    CellCentricMaterialLayoutView lv = layout.view();
+    command << RUNCOMMAND_ENUMERATE (CellLocalId, cid, allCells())
+    {
+      const Int32 begin = lv.cellBegin(cid);
+      const Int32 end = lv.cellEnd(cid);
+      Real global_p = 0.0;
+      Real sum_p = 0.0;
+      Real sum_frac = 0.0;
+      Int32 env_pos = -1;
+      for (Int32 pos = begin; pos < end; ++pos) {
+        CellCentricValueInfo vi = lv.valueInfo(pos);
+        if (vi.isEnvironment()) {
+          if (env_pos >= 0) {
+            inout_p.value(env_pos) = sum_p / sum_frac;
+            global_p += sum_p;
+          }
+          env_pos = pos;
+          sum_p = 0.0;
+          sum_frac = 0.0;
+        }
+        if (vi.isMaterial()) {
+          Real frac = in_frac.value(pos);
+          sum_p += frac * inout_p.value(pos);
+          sum_frac += frac;
+        }
+      }
+      if (env_pos >= 0) {
+        inout_p.value(env_pos) = sum_p / sum_frac;
+        global_p += sum_p;
+      }
+      inout_p[cid] = global_p;
+    };
+  }
+  queue.barrier();
+  Real t2 = platform::getRealTime();
+
+  cc_pressure.scatter(queue);
+  queue.barrier();
+  Real t3 = platform::getRealTime();
+  info() << "CellCentric closure time=" << (t2 - t1) << " nb_z=" << nb_z
+         << " gather_time=" << (t1 - t0) << " scatter_time=" << (t3 - t2)
+         << " total_time=" << (t3 - t0);
+  CellCentricTime times;
+  times.m_copy_time = (t1 - t0) + (t3 - t2);
+  times.m_compute_time = t2 - t1;
+  return times;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Affiche la comparaison des deux versions.
+ *
+ * La version par maille est plus rapide si le gain sur chaque exécution
+ * de la loi de fermeture compense le coût des recopies. On affiche le
+ * nombre minimum d'exécutions entre gather() et scatter() pour cela.
+ */
+void MeshMaterialCellCentricUnitTest::
+_printComparison(Int32 nb_z, Real reference_time, const CellCentricTime& cell_centric_time)
+{
+  const Real total_time = cell_centric_time.m_copy_time + cell_centric_time.m_compute_time;
+  info() << "CellCentric comparison nb_z=" << nb_z << " reference_time=" << reference_time
+         << " cell_centric_time=" << total_time
+         << " ratio=" << ((total_time > 0.0) ? (reference_time / total_time) : 0.0);
+  if (nb_z <= 0)
+    return;
+  const Real reference_kernel_time = reference_time / nb_z;
+  const Real cell_centric_kernel_time = cell_centric_time.m_compute_time / nb_z;
+  const Real gain = reference_kernel_time - cell_centric_kernel_time;
+  info() << "CellCentric kernel reference_time=" << reference_kernel_time
+         << " cell_centric_time=" << cell_centric_kernel_time
+         << " copy_time=" << cell_centric_time.m_copy_time;
+  if (gain > 0.0)
+    info() << "CellCentric is faster than the classic layout for at least "
+           << static_cast<Int64>(std::ceil(cell_centric_time.m_copy_time / gain))
+           << " kernel executions between gather() and scatter()";
+  else
+    info() << "CellCentric is never faster than the classic layout for this kernel";
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void MeshMaterialCellCentricUnitTest::
+_checkValues()
+{
+  auto check = [](Real value, Real ref_value, MatVarIndex mvi) {
+    if (!math::isNearlyEqualWithEpsilon(value, ref_value, 1.0e-14))
+      ARCANE_FATAL("Bad value mvi={0} ref={1} v={2}", mvi, ref_value, value);
+  };
+  ENUMERATE_ALLENVCELL (iallenvcell, m_mm_mng, allCells()) {
+    AllEnvCell all_env_cell = *iallenvcell;
+    Cell cell = all_env_cell.globalCell();
+    check(m_pressure[cell], m_pressure_ref[cell], MatVarIndex(0, cell.localId()));
+    ENUMERATE_CELL_ENVCELL (ienvcell, all_env_cell) {
+      EnvCell env_cell = *ienvcell;
+      check(m_pressure[env_cell], m_pressure_ref[env_cell], env_cell._varIndex());
+      ENUMERATE_CELL_MATCELL (imatcell, env_cell) {
+        MatCell mat_cell = *imatcell;
+        check(m_pressure[mat_cell], m_pressure_ref[mat_cell], mat_cell._varIndex());
+      }
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace ArcaneTest
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
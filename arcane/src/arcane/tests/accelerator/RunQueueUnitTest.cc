@@ -17,6 +17,8 @@
 
 #include "arcane/core/BasicUnitTest.h"
 #include "arcane/core/ServiceFactory.h"
+#include "arcane/core/IMesh.h"
+#include "arcane/core/IItemFamily.h"
 
 #include "arcane/accelerator/core/RunQueueBuildInfo.h"
 #include "arcane/accelerator/core/Runner.h"
@@ -26,6 +28,7 @@
 #include "arcane/accelerator/NumArrayViews.h"
 #include "arcane/accelerator/SpanViews.h"
 #include "arcane/accelerator/RunCommandLoop.h"
+#include "arcane/accelerator/HostRunCommandGraph.h"
 
 #include <thread>
 #include <chrono>
@@ -67,6 +70,7 @@ class RunQueueUnitTest
   void _executeTest2();
   void _executeTest3();
   void _executeTest4();
+  void _executeTestHostGraph();
 };
 
 /*---------------------------------------------------------------------------*/
@@ -118,6 +122,7 @@ executeTest()
   _executeTest3();
   _executeTest4();
   m_runner->setConcurrentQueueCreation(old_v);
+  _executeTestHostGraph();
 }
 
 /*---------------------------------------------------------------------------*/
@@ -355,6 +360,80 @@ _executeTest4()
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void RunQueueUnitTest::
+_executeTestHostGraph()
+{
+  using namespace Arcane::Accelerator;
+  ValueChecker vc(A_FUNCINFO);
+
+  auto queue = makeQueue(*m_runner);
+  if (queue.isAcceleratorPolicy()) {
+    info() << "Skipping HostRunCommandGraph test on accelerator";
+    return;
+  }
+  info() << "Test HostRunCommandGraph";
+
+  const Int32 nb_value = 100000;
+  const Int32 nb_half = nb_value / 2;
+  NumArray<Real, MDDim1> array1(nb_value);
+  NumArray<Real, MDDim1> array2(nb_value);
+  NumArray<Real, MDDim1> array3(nb_half);
+  Span<Real> s1 = array1.to1DSpan();
+  Span<Real> s2 = array2.to1DSpan();
+  Span<Real> s3 = array3.to1DSpan();
+
+  HostRunCommandGraph graph(queue);
+  graph.command() << RUNCOMMAND_LOOP1(iter, nb_value)
+  {
+    auto [i] = iter();
+    s1[i] = static_cast<Real>(i);
+  };
+  // Même intervalle et dépendance sur la même itération: même phase.
+  graph.command(eHostCommandDependency::SameIndex) << RUNCOMMAND_LOOP1(iter, nb_value)
+  {
+    auto [i] = iter();
+    s2[i] = s1[i] * 2.0;
+  };
+  // Intervalle différent: nouvelle phase.
+  graph.command(eHostCommandDependency::SameIndex) << RUNCOMMAND_LOOP1(iter, nb_half)
+  {
+    auto [i] = iter();
+    s3[i] = s2[i] + 1.0;
+  };
+  // Dépendance sur toutes les itérations: nouvelle phase.
+  graph.command() << RUNCOMMAND_LOOP1(iter, nb_half)
+  {
+    auto [i] = iter();
+    s3[i] += s2[nb_value - 1 - i];
+  };
+
+  // Commande sur les entités.
+  CellGroup all_cells = allCells();
+  NumArray<Int32, MDDim1> cells_value(mesh()->cellFamily()->maxLocalId());
+  Span<Int32> cells_span = cells_value.to1DSpan();
+  graph.command() << RUNCOMMAND_ENUMERATE(Cell, cid, all_cells)
+  {
+    cells_span[cid.localId()] += 1;
+  };
+
+  cells_value.fill(0);
+  const Int32 nb_launch = 3;
+  for (Int32 k = 0; k < nb_launch; ++k)
+    graph.launch();
+
+  vc.areEqual(graph.nbCommand(), 5, "NbCommand");
+  vc.areEqual(graph.nbPhase(), 4, "NbPhase");
+  for (Int32 i = 0; i < nb_value; ++i)
+    vc.areEqual(s2[i], static_cast<Real>(i) * 2.0, "Array2");
+  for (Int32 i = 0; i < nb_half; ++i)
+    vc.areEqual(s3[i], static_cast<Real>(i) * 2.0 + 1.0 + static_cast<Real>(nb_value - 1 - i) * 2.0, "Array3");
+  ENUMERATE_ (Cell, icell, all_cells)
+    vc.areEqual(cells_value[icell.itemLocalId()], nb_launch, "CellValue");
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 } // End namespace ArcaneTest
 
 /*---------------------------------------------------------------------------*/
@@ -19,6 +19,7 @@ set(ARCANE_SOURCES
   ModuleSimpleHydroDepend.cc
   MeshMergeBoundariesUnitTest.cc
   MeshMergeNodesUnitTest.cc
+  PointLocatorUnitTest.cc
   MeshUnitTest.cc
   MultipleMeshUnitTest.cc
   ThreadUnitTest.cc
@@ -45,6 +46,7 @@ set(ARCANE_SOURCES
   ArrayUnitTest.cc
   PropertiesUnitTest.cc
   ItemVectorUnitTest.cc
+  LoadImbalanceReportUnitTest.cc
   ConfigurationUnitTest.cc
   VoronoiTest.cc
   UtilsUnitTest.cc
@@ -177,6 +177,29 @@ copy(SmallSpan<DataType> destination, SmallSpan<const DataType> source, const Ru
   copy(Span<DataType>(destination), Span<const DataType>(source), queue);
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Nombre de noeuds NUMA de la machine.
+ *
+ * Retourne 1 si cette information n'est pas disponible.
+ */
+extern "C++" ARCANE_UTILS_EXPORT Int32
+getNbNumaNode();
+
+/*!
+ * \brief Calcule le placement sur les noeuds NUMA des pages de \a view.
+ *
+ * En retour, \a nb_page_per_node est redimensionné à getNbNumaNode() et
+ * contient pour chaque noeud le nombre de pages de \a view qui s'y trouvent.
+ *
+ * \return le nombre de pages dont le placement n'est pas connu (par exemple
+ * parce qu'elles n'ont pas encore été accédées ou parce que la plateforme
+ * ne fournit pas cette information).
+ */
+extern "C++" ARCANE_UTILS_EXPORT Int64
+computeNumaPagePlacement(ConstMemoryView view, Array<Int64>& nb_page_per_node);
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
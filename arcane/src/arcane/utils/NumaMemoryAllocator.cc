@@ -0,0 +1,290 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* NumaMemoryAllocator.cc                                      (C) 2000-2024 */
+/*                                                                           */
+/* Allocateur mémoire hôte tenant compte des noeuds NUMA.                    */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/internal/NumaMemoryAllocator.h"
+
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/String.h"
+#include "arcane/utils/Array.h"
+#include "arcane/utils/MemoryUtils.h"
+#include "arcane/utils/ConcurrencyUtils.h"
+#include "arcane/utils/RangeFunctor.h"
+#include "arcane/utils/IMemoryRessourceMng.h"
+#include "arcane/utils/internal/IMemoryRessourceMngInternal.h"
+
+#include <fstream>
+#include <cstdint>
+#include <limits>
+
+#if defined(ARCANE_OS_LINUX)
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace
+{
+  // Valeur de MPOL_INTERLEAVE dans <linux/mempolicy.h>. On utilise directement
+  // les appels système pour ne pas dépendre de 'libnuma'.
+  constexpr int ARCANE_MPOL_INTERLEAVE = 3;
+
+  Int64 _pageSize()
+  {
+#if defined(ARCANE_OS_LINUX)
+    long v = ::sysconf(_SC_PAGESIZE);
+    if (v > 0)
+      return v;
+#endif
+    return 4096;
+  }
+
+  /*!
+   * \brief Lit le nombre de noeuds NUMA.
+   *
+   * Le fichier '/sys/devices/system/node/online' contient la liste des noeuds
+   * sous la forme '0-3' ou '0,2-3'. On retourne le plus grand numéro plus 1.
+   */
+  Int32 _readNbNumaNode()
+  {
+#if defined(ARCANE_OS_LINUX)
+    std::ifstream ifile("/sys/devices/system/node/online");
+    std::string line;
+    if (!ifile || !std::getline(ifile, line))
+      return 1;
+    Int32 max_node = 0;
+    Int32 current = 0;
+    bool has_digit = false;
+    for (char c : line) {
+      if (c >= '0' && c <= '9') {
+        current = current * 10 + (c - '0');
+        has_digit = true;
+      }
+      else {
+        if (has_digit && current > max_node)
+          max_node = current;
+        current = 0;
+        has_digit = false;
+      }
+    }
+    if (has_digit && current > max_node)
+      max_node = current;
+    return max_node + 1;
+#else
+    return 1;
+#endif
+  }
+
+  NumaMemoryAllocator global_first_touch_allocator(NumaMemoryAllocator::ePolicy::FirstTouch);
+  NumaMemoryAllocator global_interleave_allocator(NumaMemoryAllocator::ePolicy::Interleave);
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+NumaMemoryAllocator::
+NumaMemoryAllocator(ePolicy policy)
+: Arccore::AlignedMemoryAllocator3(Arccore::AlignedMemoryAllocator3::simdAlignment())
+, m_policy(policy)
+{
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+AllocatedMemoryInfo NumaMemoryAllocator::
+allocate(MemoryAllocationArgs args, Int64 new_size)
+{
+  AllocatedMemoryInfo mem_info = AlignedMemoryAllocator3::allocate(args, new_size);
+  void* ptr = mem_info.baseAddress();
+  if (!ptr || new_size < minimalParallelSize())
+    return mem_info;
+  if (m_policy == ePolicy::Interleave)
+    _interleave(ptr, new_size);
+  else
+    _touch(ptr, new_size);
+  return mem_info;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Répartit cycliquement sur les noeuds NUMA les pages de [ptr,ptr+size[.
+ *
+ * Seules les pages entièrement contenues dans la zone sont concernées pour
+ * ne pas modifier le placement des allocations voisines.
+ */
+void NumaMemoryAllocator::
+_interleave([[maybe_unused]] void* ptr, [[maybe_unused]] Int64 size)
+{
+#if defined(ARCANE_OS_LINUX) && defined(SYS_mbind)
+  const Int32 nb_node = MemoryUtils::getNbNumaNode();
+  if (nb_node < 2)
+    return;
+  const std::uintptr_t page_size = _pageSize();
+  std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(ptr);
+  std::uintptr_t begin = ((addr + page_size - 1) / page_size) * page_size;
+  std::uintptr_t end = ((addr + size) / page_size) * page_size;
+  if (end <= begin)
+    return;
+  constexpr Int32 nb_bit = 8 * sizeof(unsigned long);
+  UniqueArray<unsigned long> node_mask((nb_node + nb_bit - 1) / nb_bit, 0);
+  for (Int32 i = 0; i < nb_node; ++i)
+    node_mask[i / nb_bit] |= (1UL << (i % nb_bit));
+  // Le noyau considère que 'maxnode' inclut un bit supplémentaire.
+  unsigned long max_node = static_cast<unsigned long>(node_mask.size()) * nb_bit + 1;
+  // En cas d'échec, on garde simplement le placement par défaut.
+  ::syscall(SYS_mbind, reinterpret_cast<void*>(begin), end - begin, ARCANE_MPOL_INTERLEAVE,
+            node_mask.data(), max_node, 0);
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Touche en parallèle les pages de [ptr,ptr+size[.
+ *
+ * Le découpage est le même que celui d'une boucle TaskFactory::executeParallelFor()
+ * utilisant le partitionnement statique. Pour la première page qui
+ * peut être partagée avec une autre allocation, on ne touche que la partie
+ * qui appartient à la zone.
+ */
+void NumaMemoryAllocator::
+_touch(void* ptr, Int64 size)
+{
+  if (!TaskFactory::isActive())
+    return;
+  const std::uintptr_t page_size = _pageSize();
+  const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(ptr);
+  const std::uintptr_t first_page = addr / page_size;
+  const std::uintptr_t last_page = (addr + size - 1) / page_size;
+  const Int64 nb_page = static_cast<Int64>(last_page - first_page + 1);
+  if (nb_page > std::numeric_limits<Integer>::max())
+    return;
+
+  ParallelLoopOptions options(TaskFactory::defaultParallelLoopOptions());
+  options.setPartitioner(ParallelLoopOptions::Partitioner::Static);
+  auto func = [=](Integer begin, Integer n) {
+    for (Integer i = begin; i < (begin + n); ++i) {
+      std::uintptr_t page_addr = (first_page + i) * page_size;
+      if (page_addr < addr)
+        page_addr = addr;
+      // Il faut une écriture: une lecture projette la page nulle
+      // partagée sans allouer de page physique.
+      *reinterpret_cast<volatile std::byte*>(page_addr) = std::byte{ 0 };
+    }
+  };
+  LambdaRangeFunctorT<decltype(func)> functor(func);
+  TaskFactory::executeParallelFor(0, static_cast<Integer>(nb_page), options, &functor);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+NumaMemoryAllocator* NumaMemoryAllocator::
+installFromEnvironment()
+{
+  String policy_name = platform::getEnvironmentVariable("ARCANE_NUMA_POLICY");
+  if (policy_name.null())
+    return nullptr;
+  // Avec un accélérateur, la mémoire hôte des données est gérée par le runtime.
+  if (platform::getAcceleratorHostMemoryAllocator())
+    return nullptr;
+  NumaMemoryAllocator* allocator = nullptr;
+  if (policy_name == "FirstTouch")
+    allocator = &global_first_touch_allocator;
+  else if (policy_name == "Interleave")
+    allocator = &global_interleave_allocator;
+  else
+    ARCANE_FATAL("Invalid value '{0}' for environment variable ARCANE_NUMA_POLICY."
+                 " Valid values are 'FirstTouch' or 'Interleave'",
+                 policy_name);
+  IMemoryRessourceMng* mrm = platform::getDataMemoryRessourceMng();
+  mrm->_internal()->setAllocator(eMemoryRessource::Host, allocator);
+  return allocator;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Int32 MemoryUtils::
+getNbNumaNode()
+{
+  static Int32 nb_node = _readNbNumaNode();
+  return nb_node;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Int64 MemoryUtils::
+computeNumaPagePlacement(ConstMemoryView view, Array<Int64>& nb_page_per_node)
+{
+  const Int32 nb_node = getNbNumaNode();
+  nb_page_per_node.resize(nb_node);
+  nb_page_per_node.fill(0);
+  Span<const std::byte> bytes = view.bytes();
+  if (bytes.empty())
+    return 0;
+  const std::uintptr_t page_size = _pageSize();
+  const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(bytes.data());
+  const std::uintptr_t first_page = addr / page_size;
+  const std::uintptr_t last_page = (addr + bytes.size() - 1) / page_size;
+  const Int64 nb_page = static_cast<Int64>(last_page - first_page + 1);
+  Int64 nb_unknown = 0;
+#if defined(ARCANE_OS_LINUX) && defined(SYS_move_pages)
+  // Avec un tableau de destination nul, 'move_pages' ne déplace rien et
+  // retourne dans 'status' le noeud de chaque page (ou un code d'erreur
+  // négatif si la page n'est pas encore allouée).
+  const Int64 chunk_size = 4096;
+  UniqueArray<void*> pages(chunk_size);
+  UniqueArray<int> status(chunk_size);
+  for (Int64 begin = 0; begin < nb_page; begin += chunk_size) {
+    Int64 n = std::min(chunk_size, nb_page - begin);
+    for (Int64 i = 0; i < n; ++i)
+      pages[i] = reinterpret_cast<void*>((first_page + begin + i) * page_size);
+    long r = ::syscall(SYS_move_pages, 0, static_cast<unsigned long>(n), pages.data(),
+                       nullptr, status.data(), 0);
+    if (r < 0) {
+      nb_unknown += n;
+      continue;
+    }
+    for (Int64 i = 0; i < n; ++i) {
+      int node = status[i];
+      if (node >= 0 && node < nb_node)
+        ++nb_page_per_node[node];
+      else
+        ++nb_unknown;
+    }
+  }
+#else
+  nb_unknown = nb_page;
+#endif
+  return nb_unknown;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
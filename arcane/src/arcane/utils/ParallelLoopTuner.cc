@@ -0,0 +1,413 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* ParallelLoopTuner.cc                                        (C) 2000-2024 */
+/*                                                                           */
+/* Ajustement automatique des options des boucles parallèles.                */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/ParallelLoopTuner.h"
+
+#include "arcane/utils/ForLoopTraceInfo.h"
+#include "arcane/utils/FatalErrorException.h"
+#include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/JSONWriter.h"
+#include "arcane/utils/JSONReader.h"
+#include "arcane/utils/Array.h"
+
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace
+{
+  using Partitioner = ParallelLoopOptions::Partitioner;
+
+  //! Combinaison essayée lors de l'ajustement
+  struct Candidate
+  {
+    Partitioner m_partitioner;
+    //! Nombre de blocs par thread (0 pour garder la taille de grain par défaut)
+    Int32 m_nb_block_per_thread;
+  };
+
+  const Candidate all_candidates[] = {
+    { Partitioner::Auto, 0 },
+    { Partitioner::Auto, 4 },
+    { Partitioner::Auto, 16 },
+    { Partitioner::Static, 0 },
+    { Partitioner::Static, 4 },
+    { Partitioner::Static, 16 },
+    { Partitioner::Deterministic, 0 },
+    { Partitioner::Deterministic, 4 },
+    { Partitioner::Deterministic, 16 }
+  };
+  constexpr Int32 nb_candidate = static_cast<Int32>(std::size(all_candidates));
+
+  Int32 _grainSize(const Candidate& c, Int32 loop_size, Int32 nb_thread)
+  {
+    if (c.m_nb_block_per_thread <= 0 || nb_thread <= 0)
+      return 0;
+    Int32 grain_size = loop_size / (nb_thread * c.m_nb_block_per_thread);
+    return (grain_size > 1) ? grain_size : 1;
+  }
+
+  // Classe de taille: partie entière du logarithme en base 2 de la taille.
+  Int32 _sizeClass(Int32 loop_size)
+  {
+    Int32 size_class = 0;
+    while (loop_size > 1) {
+      loop_size >>= 1;
+      ++size_class;
+    }
+    return size_class;
+  }
+
+  // Le nom du fichier est utilisé pour distinguer les boucles ayant
+  // le même nom ou les fonctions de même nom dans des fichiers différents.
+  String _siteName(const ForLoopTraceInfo& trace_info)
+  {
+    const TraceInfo& ti = trace_info.traceInfo();
+    const char* file = ti.file();
+    if (!file)
+      file = "Unknown";
+    const String& loop_name = trace_info.loopName();
+    if (!loop_name.empty())
+      return String::format("{0}:{1}", file, loop_name);
+    const char* name = ti.name();
+    return String::format("{0}:{1}:{2}", file, ti.line(), (name ? name : "Unknown"));
+  }
+
+  const char* _partitionerName(Partitioner p)
+  {
+    switch (p) {
+    case Partitioner::Static:
+      return "static";
+    case Partitioner::Deterministic:
+      return "deterministic";
+    case Partitioner::Auto:
+      return "auto";
+    }
+    ARCANE_FATAL("Bad value {0} for partitioner", (int)p);
+  }
+
+  Partitioner _partitionerFromName(StringView str)
+  {
+    if (str == "static")
+      return Partitioner::Static;
+    if (str == "deterministic")
+      return Partitioner::Deterministic;
+    if (str == "auto")
+      return Partitioner::Auto;
+    ARCANE_FATAL("Bad value '{0}' for partitioner in tuning file", str);
+  }
+
+  //! Informations d'ajustement pour un site et une classe de taille
+  class SiteInfo
+  {
+   public:
+
+    SiteInfo()
+    : m_min_times(nb_candidate, -1)
+    , m_nb_started(nb_candidate, 0)
+    , m_nb_done(nb_candidate, 0)
+    {}
+
+   public:
+
+    bool m_is_tuned = false;
+    Partitioner m_partitioner = Partitioner::Auto;
+    Int32 m_grain_size = 0;
+    Int64 m_best_time = 0;
+    std::vector<Int64> m_min_times;
+    std::vector<Int32> m_nb_started;
+    std::vector<Int32> m_nb_done;
+  };
+
+  class TunerImpl
+  {
+   public:
+
+    using KeyType = std::pair<String, Int32>;
+
+   public:
+
+    std::mutex m_mutex;
+    std::map<KeyType, SiteInfo> m_sites;
+    bool m_is_enabled = false;
+    bool m_has_imported = false;
+    Int32 m_nb_trial = 3;
+
+   public:
+
+    //! Choisit la prochaine combinaison à essayer (-1 si aucune)
+    Int32 nextCandidate(SiteInfo& site) const
+    {
+      for (Int32 i = 0; i < nb_candidate; ++i)
+        if (site.m_nb_started[i] < m_nb_trial)
+          return i;
+      return -1;
+    }
+
+    //! Retient la meilleure combinaison si toutes ont été essayées.
+    void tryLock(SiteInfo& site, Int32 loop_size, Int32 nb_thread) const
+    {
+      Int32 best = -1;
+      for (Int32 i = 0; i < nb_candidate; ++i) {
+        if (site.m_nb_done[i] < m_nb_trial)
+          return;
+        if (best < 0 || site.m_min_times[i] < site.m_min_times[best])
+          best = i;
+      }
+      const Candidate& c = all_candidates[best];
+      site.m_is_tuned = true;
+      site.m_partitioner = c.m_partitioner;
+      site.m_grain_size = _grainSize(c, loop_size, nb_thread);
+      site.m_best_time = site.m_min_times[best];
+    }
+  };
+
+  TunerImpl global_tuner;
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+std::atomic<bool> ParallelLoopTuner::m_is_active = false;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ParallelLoopTuner::
+setEnabled(bool v)
+{
+  std::lock_guard<std::mutex> lk(global_tuner.m_mutex);
+  global_tuner.m_is_enabled = v;
+  m_is_active = v || global_tuner.m_has_imported;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+bool ParallelLoopTuner::
+isEnabled()
+{
+  return global_tuner.m_is_enabled;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ParallelLoopTuner::
+setNbTrial(Int32 v)
+{
+  std::lock_guard<std::mutex> lk(global_tuner.m_mutex);
+  global_tuner.m_nb_trial = (v > 0) ? v : 1;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Int32 ParallelLoopTuner::
+nbTrial()
+{
+  return global_tuner.m_nb_trial;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Int32 ParallelLoopTuner::
+nbTunedSite()
+{
+  std::lock_guard<std::mutex> lk(global_tuner.m_mutex);
+  Int32 n = 0;
+  for (const auto& x : global_tuner.m_sites)
+    if (x.second.m_is_tuned)
+      ++n;
+  return n;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+std::optional<ParallelLoopOptions> ParallelLoopTuner::
+tunedOptions(const ForLoopTraceInfo& trace_info, Int32 loop_size)
+{
+  if (!trace_info.isValid())
+    return std::nullopt;
+  std::lock_guard<std::mutex> lk(global_tuner.m_mutex);
+  auto iter = global_tuner.m_sites.find({ _siteName(trace_info), _sizeClass(loop_size) });
+  if (iter == global_tuner.m_sites.end() || !iter->second.m_is_tuned)
+    return std::nullopt;
+  ParallelLoopOptions options;
+  options.setPartitioner(iter->second.m_partitioner);
+  options.setGrainSize(iter->second.m_grain_size);
+  return options;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ParallelLoopTuner::Ticket ParallelLoopTuner::
+_beginLoop(const ForLoopTraceInfo& trace_info,
+           const std::optional<ParallelLoopOptions>& loop_options,
+           Int32 loop_size, Int32 nb_thread, ParallelLoopOptions& options)
+{
+  Ticket ticket;
+  if (!trace_info.isValid())
+    return ticket;
+  // Ne modifie pas les options positionnées explicitement pour la boucle.
+  if (loop_options && (loop_options->hasPartitioner() || loop_options->hasGrainSize()))
+    return ticket;
+  if (options.partitioner() == Partitioner::Deterministic)
+    return ticket;
+
+  std::lock_guard<std::mutex> lk(global_tuner.m_mutex);
+  TunerImpl::KeyType key(_siteName(trace_info), _sizeClass(loop_size));
+  SiteInfo* site = nullptr;
+  if (global_tuner.m_is_enabled)
+    site = &global_tuner.m_sites[key];
+  else {
+    auto iter = global_tuner.m_sites.find(key);
+    if (iter == global_tuner.m_sites.end())
+      return ticket;
+    site = &iter->second;
+  }
+
+  if (site->m_is_tuned) {
+    options.setPartitioner(site->m_partitioner);
+    options.setGrainSize(site->m_grain_size);
+    return ticket;
+  }
+  if (!global_tuner.m_is_enabled)
+    return ticket;
+
+  // Si toutes les combinaisons sont en cours d'essai par d'autres threads,
+  // on garde les options de l'appelant.
+  Int32 candidate = global_tuner.nextCandidate(*site);
+  if (candidate < 0)
+    return ticket;
+  ++site->m_nb_started[candidate];
+  const Candidate& c = all_candidates[candidate];
+  options.setPartitioner(c.m_partitioner);
+  Int32 grain_size = _grainSize(c, loop_size, nb_thread);
+  if (grain_size > 0)
+    options.setGrainSize(grain_size);
+  ticket.m_site = site;
+  ticket.m_candidate = candidate;
+  ticket.m_loop_size = loop_size;
+  ticket.m_nb_thread = nb_thread;
+  return ticket;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ParallelLoopTuner::
+_endLoop(const Ticket& ticket, Int64 exec_time)
+{
+  if (!ticket.isMeasured())
+    return;
+  std::lock_guard<std::mutex> lk(global_tuner.m_mutex);
+  auto* site = reinterpret_cast<SiteInfo*>(ticket.m_site);
+  Int32 candidate = ticket.m_candidate;
+  Int64& min_time = site->m_min_times[candidate];
+  if (min_time < 0 || exec_time < min_time)
+    min_time = exec_time;
+  ++site->m_nb_done[candidate];
+  if (!site->m_is_tuned)
+    global_tuner.tryLock(*site, ticket.m_loop_size, ticket.m_nb_thread);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ParallelLoopTuner::
+exportTuning(const String& filename)
+{
+  JSONWriter json_writer(JSONWriter::FormatFlags::None);
+  {
+    JSONWriter::Object jo(json_writer);
+    JSONWriter::Array ja(json_writer, "LoopTuning");
+    std::lock_guard<std::mutex> lk(global_tuner.m_mutex);
+    for (const auto& x : global_tuner.m_sites) {
+      const SiteInfo& site = x.second;
+      if (!site.m_is_tuned)
+        continue;
+      JSONWriter::Object jo2(json_writer);
+      json_writer.write("Site", x.first.first);
+      json_writer.write("SizeClass", x.first.second);
+      json_writer.write("Partitioner", _partitionerName(site.m_partitioner));
+      json_writer.write("GrainSize", site.m_grain_size);
+      json_writer.write("Time", site.m_best_time);
+    }
+  }
+  std::ofstream ofile(filename.localstr());
+  if (!ofile)
+    ARCANE_FATAL("Can not open file '{0}' for writing", filename);
+  ofile << json_writer.getBuffer();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ParallelLoopTuner::
+importTuning(const String& filename)
+{
+  UniqueArray<Byte> bytes;
+  if (platform::readAllFile(filename, false, bytes))
+    ARCANE_FATAL("Can not read tuning file '{0}'", filename);
+  JSONDocument jdoc;
+  jdoc.parse(bytes, filename);
+  JSONValueList entries = jdoc.root().expectedChild("LoopTuning").valueAsArray();
+
+  std::lock_guard<std::mutex> lk(global_tuner.m_mutex);
+  for (const JSONValue& v : entries) {
+    TunerImpl::KeyType key(v.expectedChild("Site").value(), v.expectedChild("SizeClass").valueAsInt32());
+    SiteInfo& site = global_tuner.m_sites[key];
+    site.m_is_tuned = true;
+    site.m_partitioner = _partitionerFromName(v.expectedChild("Partitioner").valueAsStringView());
+    site.m_grain_size = v.expectedChild("GrainSize").valueAsInt32();
+    JSONValue time_value = v.child("Time");
+    site.m_best_time = (time_value.null()) ? 0 : time_value.valueAsInt64();
+    global_tuner.m_has_imported = true;
+  }
+  m_is_active = global_tuner.m_is_enabled || global_tuner.m_has_imported;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ParallelLoopTuner::
+reset()
+{
+  std::lock_guard<std::mutex> lk(global_tuner.m_mutex);
+  global_tuner.m_sites.clear();
+  global_tuner.m_has_imported = false;
+  m_is_active = global_tuner.m_is_enabled;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,176 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* ParallelLoopTuner.h                                         (C) 2000-2024 */
+/*                                                                           */
+/* Ajustement automatique des options des boucles parallèles.                */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_UTILS_PARALLELLOOPTUNER_H
+#define ARCANE_UTILS_PARALLELLOOPTUNER_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/ParallelLoopOptions.h"
+
+#include <atomic>
+#include <optional>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Ajustement automatique de la taille de grain et du partitionneur
+ * des boucles parallèles.
+ *
+ * Lorsque l'ajustement est actif (setEnabled()), chaque boucle parallèle
+ * ayant une information de trace valide (ForLoopTraceInfo) est considérée
+ * comme un site. Pour un site et une classe de taille d'intervalle
+ * d'itération (la partie entière du logarithme en base 2 de la taille),
+ * les premières exécutions essaient successivement plusieurs combinaisons
+ * de partitionneur (auto, static et deterministic) et de taille de grain.
+ * Chaque combinaison est exécutée nbTrial() fois et on conserve le temps
+ * minimum. Une fois toutes les combinaisons essayées, la meilleure est
+ * conservée pour les exécutions suivantes du site.
+ *
+ * Les combinaisons retenues peuvent être sauvegardées via exportTuning()
+ * puis relues via importTuning() lors d'une exécution ultérieure. Les
+ * combinaisons relues sont utilisées même si l'ajustement n'est pas actif.
+ *
+ * Seules les boucles qui ne spécifient ni partitionneur ni taille de grain
+ * sont ajustées. Les boucles pour lesquelles ces options sont positionnées
+ * explicitement (par exemple celles de HostRunCommandGraph) ne sont pas
+ * modifiées. Si le partitionneur utilisé pour une boucle est
+ * ParallelLoopOptions::Partitioner::Deterministic, la boucle n'est pas
+ * ajustée car l'ordonnancement peut être nécessaire à la reproductibilité.
+ *
+ * Un site est identifié par le nom du fichier et le nom de la boucle
+ * s'il existe, ou sinon par le nom du fichier, la ligne et le nom de la
+ * fonction contenant la boucle.
+ *
+ * Les méthodes de cette classe peuvent être appelées simultanément par
+ * plusieurs threads.
+ */
+class ARCANE_UTILS_EXPORT ParallelLoopTuner
+{
+ public:
+
+  /*!
+   * \internal
+   * \brief Informations sur une exécution de boucle en cours d'ajustement.
+   */
+  class Ticket
+  {
+    friend class ParallelLoopTuner;
+
+   public:
+
+    //! Indique s'il faut appeler ParallelLoopTuner::_endLoop()
+    bool isMeasured() const { return m_candidate >= 0; }
+
+   private:
+
+    void* m_site = nullptr;
+    Int32 m_candidate = -1;
+    Int32 m_loop_size = 0;
+    Int32 m_nb_thread = 0;
+  };
+
+ public:
+
+  //! Active ou désactive l'ajustement des boucles
+  static void setEnabled(bool v);
+
+  //! Indique si l'ajustement des boucles est actif
+  static bool isEnabled();
+
+  //! Positionne le nombre d'exécutions pour chaque combinaison essayée
+  static void setNbTrial(Int32 v);
+
+  //! Nombre d'exécutions pour chaque combinaison essayée
+  static Int32 nbTrial();
+
+  /*!
+   * \brief Indique s'il faut appeler _beginLoop() pour les boucles.
+   *
+   * C'est le cas si l'ajustement est actif ou si des combinaisons ont été
+   * importées.
+   */
+  static bool isActive() { return m_is_active.load(std::memory_order_relaxed); }
+
+  //! Nombre de sites pour lesquels une combinaison a été retenue
+  static Int32 nbTunedSite();
+
+  /*!
+   * \brief Options retenues pour la boucle \a trace_info de taille \a loop_size.
+   *
+   * Retourne std::nullopt si aucune combinaison n'a encore été retenue.
+   */
+  static std::optional<ParallelLoopOptions>
+  tunedOptions(const ForLoopTraceInfo& trace_info, Int32 loop_size);
+
+  /*!
+   * \brief Sauvegarde les combinaisons retenues au format JSON dans \a filename.
+   *
+   * Cette méthode ne doit pas être appelée s'il y a des boucles en cours d'exécution.
+   */
+  static void exportTuning(const String& filename);
+
+  /*!
+   * \brief Lit les combinaisons sauvegardées par exportTuning().
+   *
+   * Les combinaisons lues remplacent celles éventuellement déjà retenues
+   * pour les mêmes sites. Cette méthode ne doit pas être appelée s'il y a
+   * des boucles en cours d'exécution.
+   */
+  static void importTuning(const String& filename);
+
+  //! Supprime toutes les informations d'ajustement
+  static void reset();
+
+ public:
+
+  // API publique mais réservée à Arcane.
+
+  /*!
+   * \internal
+   * \brief Début d'exécution d'une boucle.
+   *
+   * Modifie si besoin \a options pour la boucle \a trace_info de taille
+   * \a loop_size exécutée avec \a nb_thread threads. \a loop_options
+   * contient les options spécifiées pour la boucle avant fusion avec les
+   * options par défaut. Si le ticket retourné vérifie Ticket::isMeasured(),
+   * il faut appeler _endLoop() avec le temps d'exécution de la boucle.
+   */
+  static Ticket _beginLoop(const ForLoopTraceInfo& trace_info,
+                           const std::optional<ParallelLoopOptions>& loop_options,
+                           Int32 loop_size, Int32 nb_thread, ParallelLoopOptions& options);
+
+  /*!
+   * \internal
+   * \brief Fin d'exécution d'une boucle ayant duré \a exec_time nanosecondes.
+   */
+  static void _endLoop(const Ticket& ticket, Int64 exec_time);
+
+ private:
+
+  static std::atomic<bool> m_is_active;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
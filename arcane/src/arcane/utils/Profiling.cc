@@ -15,9 +15,12 @@
 
 #include "arcane/utils/ForLoopTraceInfo.h"
 #include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/IPerformanceCounterService.h"
 
 #include "arcane/utils/internal/ProfilingInternal.h"
+#include "arcane/utils/internal/TimelineRecorder.h"
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <vector>
@@ -64,6 +67,8 @@ ScopedStatLoop(ForLoopOneExecStat* s)
 : m_stat_info(s)
 {
   if (m_stat_info) {
+    if (HardwareCounterStat::isEnabled())
+      m_has_counters = HardwareCounterStat::readCounters(m_begin_counters);
     m_begin_time = platform::getRealTimeNS();
   }
 }
@@ -78,6 +83,13 @@ impl::ScopedStatLoop::
     Int64 end_time = platform::getRealTimeNS();
     m_stat_info->setBeginTime(m_begin_time);
     m_stat_info->setEndTime(end_time);
+    if (m_has_counters) {
+      HardwareCounterStat::CounterValues end_counters;
+      if (HardwareCounterStat::readCounters(end_counters)) {
+        HardwareCounterStat::substract(m_begin_counters, end_counters);
+        m_stat_info->setHardwareCounters(end_counters);
+      }
+    }
   }
 }
 
@@ -177,6 +189,7 @@ thread_local ThreadLocalStatInfo thread_local_stat_info;
 /*---------------------------------------------------------------------------*/
 
 Int32 ProfilingRegistry::m_profiling_level = 0;
+std::atomic<bool> impl::HardwareCounterStat::m_is_enabled = false;
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -253,6 +266,26 @@ add(const ForLoopOneExecStat& s)
   ++m_nb_call;
   m_nb_chunk += s.nbChunk();
   m_exec_time += s.execTime();
+  if (s.hasHardwareCounters())
+    m_hardware_counter_stat.add(s.hardwareCounters());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+bool impl::HardwareCounterStat::
+readCounters(CounterValues& values)
+{
+  values = CounterValues();
+  IPerformanceCounterService* service = platform::getPerformanceCounterService();
+  if (!service || !service->isStarted())
+    return false;
+  FixedArray<Int64, IPerformanceCounterService::MIN_COUNTER_SIZE> all_values;
+  Int32 n = service->getCounters(all_values.view(), false);
+  n = std::min(n, NB_COUNTER);
+  for (Int32 i = 0; i < n; ++i)
+    values[i] = all_values[i];
+  return true;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -272,6 +305,9 @@ merge(const ForLoopOneExecStat& loop_stat_info, const ForLoopTraceInfo& loop_tra
       loop_name = loop_trace_info.traceInfo().name();
   }
   m_p->m_stat_map[loop_name].add(loop_stat_info);
+  if (TimelineRecorder::isEnabled())
+    TimelineRecorder::addEvent(TimelineRecorder::eCategory::Loop, loop_name,
+                               loop_stat_info.beginTime(), loop_stat_info.endTime());
 }
 
 /*---------------------------------------------------------------------------*/
@@ -17,6 +17,7 @@
 #include "arcane/utils/UtilsTypes.h"
 
 #include "arcane/utils/String.h"
+#include "arcane/utils/FixedArray.h"
 
 #include <atomic>
 #include <functional>
@@ -45,6 +46,9 @@ class ARCANE_UTILS_EXPORT ScopedStatLoop
 
   Int64 m_begin_time = 0.0;
   ForLoopOneExecStat* m_stat_info = nullptr;
+  //! Valeurs des compteurs matériels au début de la boucle
+  FixedArray<Int64, 3> m_begin_counters;
+  bool m_has_counters = false;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -91,6 +95,16 @@ namespace Arcane
  */
 class ARCANE_UTILS_EXPORT ForLoopOneExecStat
 {
+ public:
+
+  /*!
+   * \brief Nombre de compteurs matériels conservés.
+   *
+   * Il s'agit dans l'ordre du nombre de cycles, du nombre d'instructions
+   * et du nombre de défauts de cache (en général du dernier niveau).
+   */
+  static constexpr Int32 NB_HARDWARE_COUNTER = 3;
+
  public:
 
   /*!
@@ -109,6 +123,12 @@ class ARCANE_UTILS_EXPORT ForLoopOneExecStat
   //! Nombre de chunks
   Int64 nbChunk() const { return m_nb_chunk; }
 
+  //! Temps de début de la boucle (en nanoseconde)
+  Int64 beginTime() const { return m_begin_time; }
+
+  //! Temps de fin de la boucle (en nanoseconde)
+  Int64 endTime() const { return m_end_time; }
+
   /*!
    * \brief Temps d'exécution (en nanoseconde).
    *
@@ -117,11 +137,30 @@ class ARCANE_UTILS_EXPORT ForLoopOneExecStat
    */
   Int64 execTime() const { return m_end_time - m_begin_time; }
 
+  /*!
+   * \brief Positionne les valeurs des compteurs matériels pendant la boucle.
+   *
+   * \a values doit contenir la différence des compteurs entre la fin
+   * et le début de la boucle.
+   */
+  void setHardwareCounters(const FixedArray<Int64, NB_HARDWARE_COUNTER>& values)
+  {
+    m_hardware_counters = values;
+    m_has_hardware_counters = true;
+  }
+
+  //! Indique si les compteurs matériels ont été positionnés
+  bool hasHardwareCounters() const { return m_has_hardware_counters; }
+
+  //! Valeurs des compteurs matériels (valide si hasHardwareCounters() est vrai)
+  const FixedArray<Int64, NB_HARDWARE_COUNTER>& hardwareCounters() const { return m_hardware_counters; }
+
   void reset()
   {
     m_nb_chunk = 0;
     m_begin_time = 0;
     m_end_time = 0;
+    m_has_hardware_counters = false;
   }
 
  private:
@@ -134,6 +173,10 @@ class ARCANE_UTILS_EXPORT ForLoopOneExecStat
 
   // Temps de fin d'exécution
   Int64 m_end_time = 0;
+
+  // Compteurs matériels
+  FixedArray<Int64, NB_HARDWARE_COUNTER> m_hardware_counters;
+  bool m_has_hardware_counters = false;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -67,6 +67,29 @@ operator<<(std::ostream& o,const AVXSimdReal& s)
 }
 #endif
 
+#ifdef ARCANE_HAS_SIMD_VEC
+std::ostream&
+operator<<(std::ostream& o,const VECSimdXNReal<2>& s)
+{
+  _printSimd(o,s);
+  return o;
+}
+
+std::ostream&
+operator<<(std::ostream& o,const VECSimdXNReal<4>& s)
+{
+  _printSimd(o,s);
+  return o;
+}
+
+std::ostream&
+operator<<(std::ostream& o,const VECSimdXNReal<8>& s)
+{
+  _printSimd(o,s);
+  return o;
+}
+#endif
+
 #ifdef ARCANE_HAS_SSE
 std::ostream&
 operator<<(std::ostream& o,const SSESimdReal& s)
@@ -46,6 +46,14 @@
  * - SSE. Ce mode est disponible par défaut car il existe sur toutes les
  * plateformes x64. La aussi il existe plusieurs versions et on se limite
  * à la version 2. La taille des vecteurs est de 2 dans ce mode
+ * - VEC. Ce mode utilise les extensions vectorielles de GCC et Clang
+ * (attribut 'vector_size') et ne dépend donc pas de l'architecture. Il est
+ * utilisé par défaut avec ces compilateurs si aucun des modes précédents
+ * n'est disponible (par exemple sur ARM ou POWER). La taille des vecteurs
+ * vaut 4 par défaut (8 si l'AVX512 est disponible) et peut être changée via
+ * la macro ARCANE_SIMD_VEC_SIZE. Il est possible de forcer l'utilisation
+ * de ce mode en définissant la macro ARCANE_SIMD_USE_VEC ou de le désactiver
+ * via la macro ARCANE_NO_SIMD_VEC.
  * - aucun mode. Dans ce cas il n'y a pas de vectorisation spécifique.
  * Néanmoins pour tester le code, on permet une émulation avec 
  * des vecteurs de taille de 2.
@@ -93,6 +101,12 @@
 #include "arcane/utils/SimdAVX512.h"
 #endif
 
+// Ajoute support des extensions vectorielles du compilateur si dispo
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(ARCANE_NO_SIMD_VEC)
+#define ARCANE_HAS_SIMD_VEC
+#include "arcane/utils/SimdVEC.h"
+#endif
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
@@ -114,12 +128,16 @@ ARCANE_BEGIN_NAMESPACE
  * Définit le type SimdInfo en fonction de la vectorisation disponible.
  * On prend le type qui permet le plus de vectorisation.
  */
-#if defined(ARCANE_HAS_AVX512)
+#if defined(ARCANE_SIMD_USE_VEC) && defined(ARCANE_HAS_SIMD_VEC)
+typedef VECSimdInfo SimdInfo;
+#elif defined(ARCANE_HAS_AVX512)
 typedef AVX512SimdInfo SimdInfo;
 #elif defined(ARCANE_HAS_AVX)
 typedef AVXSimdInfo SimdInfo;
 #elif defined(ARCANE_HAS_SSE)
 typedef SSESimdInfo SimdInfo;
+#elif defined(ARCANE_HAS_SIMD_VEC)
+typedef VECSimdInfo SimdInfo;
 #else
 typedef EMULSimdInfo SimdInfo;
 #endif
@@ -34,6 +34,9 @@ namespace Arcane
 #if defined(ARCANE_HAS_SSE)
 #include "arcane/utils/SimdSSEGenerated.h"
 #endif
+#if defined(ARCANE_HAS_SIMD_VEC)
+#include "arcane/utils/SimdVECOperation.h"
+#endif
 
 #include "arcane/utils/SimdEMULGenerated.h"
 
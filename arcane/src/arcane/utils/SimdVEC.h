@@ -0,0 +1,286 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SimdVEC.h                                                   (C) 2000-2024 */
+/*                                                                           */
+/* Vectorisation via les extensions vectorielles des compilateurs.           */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_UTILS_SIMDVEC_H
+#define ARCANE_UTILS_SIMDVEC_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*
+ * Ce fichier ne doit pas être inclus directement.
+ * Utiliser 'Simd.h' à la place.
+ */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Taille par défaut des vecteurs. Elle peut être positionnée à 2, 4 ou 8
+ * lors de la compilation. Le compilateur découpe les vecteurs plus grands
+ * que les registres de la machine cible donc une taille de 4 est un bon
+ * compromis sur la plupart des architectures.
+ */
+#ifndef ARCANE_SIMD_VEC_SIZE
+#if defined(__AVX512F__)
+#define ARCANE_SIMD_VEC_SIZE 8
+#else
+#define ARCANE_SIMD_VEC_SIZE 4
+#endif
+#endif
+
+ARCANE_BEGIN_NAMESPACE
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \internal
+ * \brief Types vectoriels pour les vecteurs de taille \a N.
+ *
+ * Ces types sont définis par spécialisation car GCC ignore l'attribut
+ * 'vector_size' lorsque la taille dépend d'un paramètre template.
+ */
+template <int N>
+class VECSimdVectorTypes;
+
+#define ARCANE_SIMD_VEC_DECLARE_TYPES(N) \
+  template <> \
+  class VECSimdVectorTypes<N> \
+  { \
+   public: \
+\
+    typedef Real RealType __attribute__((vector_size(N * sizeof(Real)))); \
+    typedef Real UnalignedRealType __attribute__((vector_size(N * sizeof(Real)), aligned(sizeof(Real)))); \
+    typedef Int32 Int32Type __attribute__((vector_size(N * sizeof(Int32)), aligned(sizeof(Int32)))); \
+  }
+
+ARCANE_SIMD_VEC_DECLARE_TYPES(2);
+ARCANE_SIMD_VEC_DECLARE_TYPES(4);
+ARCANE_SIMD_VEC_DECLARE_TYPES(8);
+
+#undef ARCANE_SIMD_VEC_DECLARE_TYPES
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \ingroup ArcaneSimd
+ * \brief Vectorisation des entiers via les extensions vectorielles du compilateur.
+ *
+ * Le type n'a pas de contrainte d'alignement particulière pour pouvoir
+ * être construit directement à partir d'un tableau d'indices locaux.
+ */
+template <int N>
+class VECSimdXNInt32
+{
+ public:
+
+  static const int BLOCK_SIZE = N;
+  enum
+  {
+    Length = N,
+    Alignment = 4
+  };
+  typedef typename VECSimdVectorTypes<N>::Int32Type VectorType;
+
+ public:
+
+  VectorType v0;
+  VECSimdXNInt32() {}
+  VECSimdXNInt32(const VectorType& _v0)
+  : v0(_v0)
+  {}
+  explicit VECSimdXNInt32(Int32 a)
+  : v0(VectorType{} + a)
+  {}
+
+ public:
+
+  VECSimdXNInt32(const Int32* base, const Int32* idx)
+  {
+    for (int i = 0; i < N; ++i)
+      v0[i] = base[idx[i]];
+  }
+  explicit VECSimdXNInt32(const Int32* base)
+  : v0(*reinterpret_cast<const VectorType*>(base))
+  {}
+
+  Int32 operator[](Integer i) const { return v0[i]; }
+  Int32& operator[](Integer i) { return reinterpret_cast<Int32*>(&v0)[i]; }
+
+  void set(ARCANE_RESTRICT Int32* base, const ARCANE_RESTRICT Int32* idx) const
+  {
+    for (int i = 0; i < N; ++i)
+      base[idx[i]] = v0[i];
+  }
+
+  void set(ARCANE_RESTRICT Int32* base) const
+  {
+    *reinterpret_cast<VectorType*>(base) = v0;
+  }
+
+  template <typename... Int32Type> static VECSimdXNInt32
+  fromScalar(Int32Type... a)
+  {
+    static_assert(sizeof...(a) == N, "Bad number of arguments");
+    return VECSimdXNInt32(VectorType{ a... });
+  }
+
+ private:
+
+  void operator=(Int32 _v);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \ingroup ArcaneSimd
+ * \brief Vectorisation des réels via les extensions vectorielles du compilateur.
+ *
+ * Cette implémentation utilise l'attribut 'vector_size' de GCC et Clang.
+ * Elle ne dépend donc pas du jeu d'instructions de la machine cible et le
+ * compilateur génère les instructions adaptées à l'architecture demandée
+ * (SSE, AVX, AVX512, Neon, SVE, VSX, ...). Le nombre d'éléments \a N du
+ * vecteur doit être 2, 4 ou 8.
+ *
+ * Les accès directs à la mémoire (constructeur et set() prenant uniquement
+ * un pointeur) n'exigent pas d'alignement particulier.
+ */
+template <int N>
+class VECSimdXNReal
+{
+  static_assert(N == 2 || N == 4 || N == 8, "Invalid size for VECSimdXNReal (valid values are 2, 4 or 8)");
+
+ public:
+
+  static const int BLOCK_SIZE = N;
+  enum
+  {
+    Length = N
+  };
+  typedef VECSimdXNInt32<N> Int32IndexType;
+  typedef typename VECSimdVectorTypes<N>::RealType VectorType;
+  //! Type vectoriel pour les accès mémoire non alignés
+  typedef typename VECSimdVectorTypes<N>::UnalignedRealType UnalignedVectorType;
+
+ public:
+
+  VectorType v0;
+  //NOTE: il est normal que ce constructeur ne fasse pas d'initialisation.
+  VECSimdXNReal() {}
+  VECSimdXNReal(const VectorType& _v0)
+  : v0(_v0)
+  {}
+  explicit VECSimdXNReal(Real r)
+  : v0(VectorType{} + r)
+  {}
+
+ public:
+
+  VECSimdXNReal(const Real* base, const Int32* idx)
+  {
+    for (int i = 0; i < N; ++i)
+      v0[i] = base[idx[i]];
+  }
+  VECSimdXNReal(const Real* base, const Int32IndexType* simd_idx)
+  : VECSimdXNReal(base, reinterpret_cast<const Int32*>(simd_idx))
+  {}
+  VECSimdXNReal(const Real* base, const Int32IndexType& simd_idx)
+  : VECSimdXNReal(base, reinterpret_cast<const Int32*>(&simd_idx))
+  {}
+  VECSimdXNReal(const Real* base)
+  : v0(*reinterpret_cast<const UnalignedVectorType*>(base))
+  {}
+
+  Real operator[](Integer i) const { return v0[i]; }
+  Real& operator[](Integer i) { return reinterpret_cast<Real*>(&v0)[i]; }
+
+  void set(ARCANE_RESTRICT Real* base, const ARCANE_RESTRICT Int32* idx) const
+  {
+    for (int i = 0; i < N; ++i)
+      base[idx[i]] = v0[i];
+  }
+
+  void set(ARCANE_RESTRICT Real* base, const ARCANE_RESTRICT Int32IndexType& simd_idx) const
+  {
+    this->set(base, reinterpret_cast<const Int32*>(&simd_idx));
+  }
+
+  void set(ARCANE_RESTRICT Real* base, const ARCANE_RESTRICT Int32IndexType* simd_idx) const
+  {
+    this->set(base, reinterpret_cast<const Int32*>(simd_idx));
+  }
+
+  void set(ARCANE_RESTRICT Real* base) const
+  {
+    *reinterpret_cast<UnalignedVectorType*>(base) = v0;
+  }
+
+  template <typename... RealType> static VECSimdXNReal
+  fromScalar(RealType... a)
+  {
+    static_assert(sizeof...(a) == N, "Bad number of arguments");
+    return VECSimdXNReal(VectorType{ static_cast<Real>(a)... });
+  }
+
+  // Unary operation operator-
+  VECSimdXNReal operator-() const
+  {
+    return VECSimdXNReal(-v0);
+  }
+
+ private:
+
+  void operator=(Real _v);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+//! Vecteur de 'double' utilisant les extensions vectorielles du compilateur.
+typedef VECSimdXNReal<ARCANE_SIMD_VEC_SIZE> VECSimdReal;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Informations de vectorisation pour les vecteurs de taille \a N.
+ */
+template <int N>
+class VECSimdInfoT
+{
+ public:
+
+  static const char* name() { return "VEC"; }
+  enum
+  {
+    Int32IndexSize = N
+  };
+  typedef VECSimdXNReal<N> SimdReal;
+  typedef typename VECSimdXNReal<N>::Int32IndexType SimdInt32IndexType;
+};
+
+typedef VECSimdInfoT<ARCANE_SIMD_VEC_SIZE> VECSimdInfo;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_UTILS_EXPORT std::ostream&
+operator<<(std::ostream& o, const VECSimdXNReal<2>& s);
+ARCANE_UTILS_EXPORT std::ostream&
+operator<<(std::ostream& o, const VECSimdXNReal<4>& s);
+ARCANE_UTILS_EXPORT std::ostream&
+operator<<(std::ostream& o, const VECSimdXNReal<8>& s);
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_END_NAMESPACE
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
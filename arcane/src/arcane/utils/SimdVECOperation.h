@@ -0,0 +1,191 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SimdVECOperation.h                                          (C) 2000-2024 */
+/*                                                                           */
+/* Opérations sur les types Simd utilisant les extensions vectorielles.      */
+/*---------------------------------------------------------------------------*/
+/*
+ * Ce fichier ne doit pas être inclus directement.
+ * Utiliser 'SimdOperation.h' à la place.
+ */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace impl
+{
+  /*!
+   * \brief Sélectionne élément par élément \a if_true si a<b et \a if_false sinon.
+   *
+   * Le masque retourné par la comparaison est un vecteur d'entiers dont
+   * les éléments valent -1 ou 0 et de même taille que les réels. La sélection
+   * se fait donc par des opérations bit à bit sans branchement.
+   *
+   * Les types vectoriels bruts ne sont manipulés qu'à l'intérieur de cette
+   * fonction: passer ou retourner par valeur un vecteur de 32 ou 64 octets
+   * dépend des jeux d'instructions activés (avertissement -Wpsabi de GCC).
+   */
+  template <int N> inline VECSimdXNReal<N>
+  vecSelectIfLess(const VECSimdXNReal<N>& a, const VECSimdXNReal<N>& b,
+                  const VECSimdXNReal<N>& if_true, const VECSimdXNReal<N>& if_false)
+  {
+    using VectorType = typename VECSimdXNReal<N>::VectorType;
+    auto mask = (a.v0 < b.v0);
+    using MaskType = decltype(mask);
+    return VECSimdXNReal<N>((VectorType)(((MaskType)if_true.v0 & mask) | ((MaskType)if_false.v0 & ~mask)));
+  }
+} // namespace impl
+
+// Binary operation operator-
+template <int N> inline VECSimdXNReal<N>
+operator-(VECSimdXNReal<N> a, VECSimdXNReal<N> b)
+{
+  return VECSimdXNReal<N>(a.v0 - b.v0);
+}
+
+template <int N> inline VECSimdXNReal<N>
+operator-(VECSimdXNReal<N> a, Real b)
+{
+  return VECSimdXNReal<N>(a.v0 - b);
+}
+
+template <int N> inline VECSimdXNReal<N>
+operator-(Real b, VECSimdXNReal<N> a)
+{
+  return VECSimdXNReal<N>(b - a.v0);
+}
+
+// Binary operation operator+
+template <int N> inline VECSimdXNReal<N>
+operator+(VECSimdXNReal<N> a, VECSimdXNReal<N> b)
+{
+  return VECSimdXNReal<N>(a.v0 + b.v0);
+}
+
+template <int N> inline VECSimdXNReal<N>
+operator+(VECSimdXNReal<N> a, Real b)
+{
+  return VECSimdXNReal<N>(a.v0 + b);
+}
+
+template <int N> inline VECSimdXNReal<N>
+operator+(Real b, VECSimdXNReal<N> a)
+{
+  return VECSimdXNReal<N>(b + a.v0);
+}
+
+// Binary operation operator*
+template <int N> inline VECSimdXNReal<N>
+operator*(VECSimdXNReal<N> a, VECSimdXNReal<N> b)
+{
+  return VECSimdXNReal<N>(a.v0 * b.v0);
+}
+
+template <int N> inline VECSimdXNReal<N>
+operator*(VECSimdXNReal<N> a, Real b)
+{
+  return VECSimdXNReal<N>(a.v0 * b);
+}
+
+template <int N> inline VECSimdXNReal<N>
+operator*(Real b, VECSimdXNReal<N> a)
+{
+  return VECSimdXNReal<N>(b * a.v0);
+}
+
+// Binary operation operator/
+template <int N> inline VECSimdXNReal<N>
+operator/(VECSimdXNReal<N> a, VECSimdXNReal<N> b)
+{
+  return VECSimdXNReal<N>(a.v0 / b.v0);
+}
+
+template <int N> inline VECSimdXNReal<N>
+operator/(VECSimdXNReal<N> a, Real b)
+{
+  return VECSimdXNReal<N>(a.v0 / b);
+}
+
+template <int N> inline VECSimdXNReal<N>
+operator/(Real b, VECSimdXNReal<N> a)
+{
+  return VECSimdXNReal<N>(b / a.v0);
+}
+
+namespace math
+{
+  // Binary operation min
+  template <int N> inline VECSimdXNReal<N>
+  min(VECSimdXNReal<N> a, VECSimdXNReal<N> b)
+  {
+    return impl::vecSelectIfLess(a, b, a, b);
+  }
+
+  template <int N> inline VECSimdXNReal<N>
+  min(VECSimdXNReal<N> a, Real b)
+  {
+    return math::min(a, VECSimdXNReal<N>(b));
+  }
+
+  template <int N> inline VECSimdXNReal<N>
+  min(Real b, VECSimdXNReal<N> a)
+  {
+    return math::min(VECSimdXNReal<N>(b), a);
+  }
+
+  // Binary operation max
+  template <int N> inline VECSimdXNReal<N>
+  max(VECSimdXNReal<N> a, VECSimdXNReal<N> b)
+  {
+    return impl::vecSelectIfLess(a, b, b, a);
+  }
+
+  template <int N> inline VECSimdXNReal<N>
+  max(VECSimdXNReal<N> a, Real b)
+  {
+    return math::max(a, VECSimdXNReal<N>(b));
+  }
+
+  template <int N> inline VECSimdXNReal<N>
+  max(Real b, VECSimdXNReal<N> a)
+  {
+    return math::max(VECSimdXNReal<N>(b), a);
+  }
+
+  // Unary operation sqrt
+  template <int N> inline VECSimdXNReal<N>
+  sqrt(VECSimdXNReal<N> a)
+  {
+    VECSimdXNReal<N> r;
+    for (int i = 0; i < N; ++i)
+      r[i] = math::sqrt(a[i]);
+    return r;
+  }
+
+  // Unary operation exp
+  template <int N> inline VECSimdXNReal<N>
+  exp(VECSimdXNReal<N> a)
+  {
+    VECSimdXNReal<N> r;
+    for (int i = 0; i < N; ++i)
+      r[i] = math::exp(a[i]);
+    return r;
+  }
+
+  // Unary operation log10
+  template <int N> inline VECSimdXNReal<N>
+  log10(VECSimdXNReal<N> a)
+  {
+    VECSimdXNReal<N> r;
+    for (int i = 0; i < N; ++i)
+      r[i] = math::log10(a[i]);
+    return r;
+  }
+} // namespace math
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
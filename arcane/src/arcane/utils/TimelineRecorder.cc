@@ -0,0 +1,419 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* TimelineRecorder.cc                                         (C) 2000-2024 */
+/*                                                                           */
+/* Enregistrement des évènements pour une trace temporelle d'exécution.      */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/internal/TimelineRecorder.h"
+
+#include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/JSONWriter.h"
+
+#include <ostream>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::impl
+{
+
+namespace
+{
+  class TimelineEvent
+  {
+   public:
+
+    Int64 m_begin_time = 0;
+    Int64 m_end_time = 0;
+    Int32 m_name_id = -1;
+    TimelineRecorder::eCategory m_category = TimelineRecorder::eCategory::Other;
+  };
+
+  /*!
+   * \brief Tampon des évènements d'un thread.
+   *
+   * Seul le thread propriétaire ajoute des évènements. Les évènements sont
+   * rangés par blocs de taille fixe pour éviter les recopies lors des
+   * agrandissements. Le tableau des blocs est alloué une fois pour toute
+   * pour le nombre maximum d'évènements afin que writeChromeTrace() puisse
+   * le parcourir pendant que le propriétaire ajoute des évènements.
+   *
+   * Un évènement est écrit avant que \a m_nb_event ne soit incrémenté
+   * (avec la sémantique 'release'). Le lecteur qui lit \a m_nb_event avec
+   * la sémantique 'acquire' voit donc des évènements complets.
+   */
+  class ThreadEventBuffer
+  {
+   public:
+
+    static constexpr Int64 BlockSize = 4096;
+
+   public:
+
+    ThreadEventBuffer(Int32 index, Int64 max_nb_event)
+    : m_thread_index(index)
+    , m_max_nb_event(max_nb_event)
+    , m_nb_block((max_nb_event + BlockSize - 1) / BlockSize)
+    , m_blocks(std::make_unique<std::atomic<TimelineEvent*>[]>(m_nb_block))
+    {
+      for (Int64 i = 0; i < m_nb_block; ++i)
+        m_blocks[i].store(nullptr, std::memory_order_relaxed);
+    }
+    ~ThreadEventBuffer()
+    {
+      for (Int64 i = 0; i < m_nb_block; ++i)
+        delete[] m_blocks[i].load(std::memory_order_relaxed);
+    }
+
+   public:
+
+    //! Ajoute un évènement. Ne doit être appelé que par le thread propriétaire.
+    void add(TimelineRecorder::eCategory category, Int32 name_id, Int64 begin_time, Int64 end_time)
+    {
+      const Int64 n = m_nb_event.load(std::memory_order_relaxed);
+      if (n >= m_max_nb_event) {
+        m_nb_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      std::atomic<TimelineEvent*>& block_ref = m_blocks[n / BlockSize];
+      TimelineEvent* block = block_ref.load(std::memory_order_relaxed);
+      if (!block) {
+        block = new TimelineEvent[BlockSize];
+        block_ref.store(block, std::memory_order_relaxed);
+      }
+      block[n % BlockSize] = TimelineEvent{ begin_time, end_time, name_id, category };
+      m_nb_event.store(n + 1, std::memory_order_release);
+    }
+
+    //! Évènement d'indice \a i (qui doit être inférieur à une valeur lue de \a m_nb_event)
+    const TimelineEvent& event(Int64 i) const
+    {
+      return m_blocks[i / BlockSize].load(std::memory_order_relaxed)[i % BlockSize];
+    }
+
+   public:
+
+    Int32 m_thread_index = 0;
+    //! Rang du sous-domaine associé (-1 si aucun)
+    std::atomic<Int32> m_rank = -1;
+    std::atomic<Int64> m_nb_event = 0;
+    std::atomic<Int64> m_nb_dropped = 0;
+    //! Cache des indices des noms (uniquement utilisé par le thread propriétaire)
+    std::map<String, Int32> m_name_ids;
+
+   private:
+
+    Int64 m_max_nb_event = 0;
+    Int64 m_nb_block = 0;
+    std::unique_ptr<std::atomic<TimelineEvent*>[]> m_blocks;
+  };
+
+  //! Table des noms des évènements.
+  class NameTable
+  {
+   public:
+
+    Int32 add(const String& name)
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      auto x = m_ids.find(name);
+      if (x != m_ids.end())
+        return x->second;
+      Int32 id = static_cast<Int32>(m_names.size());
+      m_names.push_back(name);
+      m_ids.insert(std::make_pair(name, id));
+      return id;
+    }
+
+   public:
+
+    std::mutex m_mutex;
+    std::vector<String> m_names;
+    std::map<String, Int32> m_ids;
+  };
+
+  class AllThreadEventBuffers
+  {
+   public:
+
+    ThreadEventBuffer* create()
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      Int32 index = static_cast<Int32>(m_buffers.size());
+      Int64 max_nb_event = m_max_nb_event_per_thread.load(std::memory_order_relaxed);
+      m_buffers.push_back(std::make_unique<ThreadEventBuffer>(index, max_nb_event));
+      return m_buffers.back().get();
+    }
+
+   public:
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadEventBuffer>> m_buffers;
+    NameTable m_name_table;
+    std::atomic<Int64> m_max_nb_event_per_thread = 1 << 20;
+    //! Origine des temps
+    Int64 m_origin_time = 0;
+    //! Indique si les évènements sans sous-domaine ont déjà été écrits
+    bool m_is_unowned_written = false;
+  };
+
+  AllThreadEventBuffers global_buffers;
+  thread_local ThreadEventBuffer* thread_local_buffer = nullptr;
+
+  ThreadEventBuffer* _threadBuffer()
+  {
+    if (!thread_local_buffer)
+      thread_local_buffer = global_buffers.create();
+    return thread_local_buffer;
+  }
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+std::atomic<bool> TimelineRecorder::m_is_enabled = false;
+Int32 TimelineRecorder::m_nb_enable = 0;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineRecorder::
+enable()
+{
+  std::lock_guard<std::mutex> lk(global_buffers.m_mutex);
+  if (global_buffers.m_origin_time == 0)
+    global_buffers.m_origin_time = platform::getRealTimeNS();
+  ++m_nb_enable;
+  m_is_enabled.store(true);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineRecorder::
+disable()
+{
+  std::lock_guard<std::mutex> lk(global_buffers.m_mutex);
+  if (m_nb_enable > 0)
+    --m_nb_enable;
+  m_is_enabled.store(m_nb_enable > 0);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Int32 TimelineRecorder::
+nameId(const String& name)
+{
+  // Le cache local au thread évite de verrouiller la table globale
+  // sauf lors de la première utilisation d'un nom par ce thread.
+  std::map<String, Int32>& name_ids = _threadBuffer()->m_name_ids;
+  auto x = name_ids.find(name);
+  if (x != name_ids.end())
+    return x->second;
+  Int32 id = global_buffers.m_name_table.add(name);
+  name_ids.insert(std::make_pair(name, id));
+  return id;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineRecorder::
+addEvent(eCategory category, Int32 name_id, Int64 begin_time_ns, Int64 end_time_ns)
+{
+  if (!isEnabled())
+    return;
+  _threadBuffer()->add(category, name_id, begin_time_ns, end_time_ns);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineRecorder::
+addEvent(eCategory category, const String& name, Int64 begin_time_ns, Int64 end_time_ns)
+{
+  if (!isEnabled())
+    return;
+  _threadBuffer()->add(category, nameId(name), begin_time_ns, end_time_ns);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineRecorder::
+setMaxNbEventPerThread(Int64 v)
+{
+  global_buffers.m_max_nb_event_per_thread.store((v > 0) ? v : 0);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Int64 TimelineRecorder::
+maxNbEventPerThread()
+{
+  return global_buffers.m_max_nb_event_per_thread.load();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Int64 TimelineRecorder::
+nbDroppedEvent()
+{
+  std::lock_guard<std::mutex> lk(global_buffers.m_mutex);
+  Int64 n = 0;
+  for (const auto& buffer : global_buffers.m_buffers)
+    n += buffer->m_nb_dropped.load();
+  return n;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineRecorder::
+setThreadRank(Int32 rank)
+{
+  _threadBuffer()->m_rank.store(rank);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+const char* TimelineRecorder::
+categoryName(eCategory c)
+{
+  switch (c) {
+  case eCategory::EntryPoint:
+    return "EntryPoint";
+  case eCategory::Loop:
+    return "Loop";
+  case eCategory::Synchronize:
+    return "Synchronize";
+  case eCategory::MessagePassing:
+    return "MessagePassing";
+  case eCategory::Checkpoint:
+    return "Checkpoint";
+  case eCategory::Other:
+    return "Other";
+  }
+  return "Unknown";
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void TimelineRecorder::
+writeChromeTrace(std::ostream& o, Int32 rank)
+{
+  std::lock_guard<std::mutex> lk(global_buffers.m_mutex);
+  bool write_unowned = !global_buffers.m_is_unowned_written;
+  global_buffers.m_is_unowned_written = true;
+  const Int64 origin = global_buffers.m_origin_time;
+  // Les indices des noms des évènements publiés sont dans la table des noms
+  // car ils sont ajoutés avant les évènements.
+  NameTable& name_table = global_buffers.m_name_table;
+  std::lock_guard<std::mutex> names_lk(name_table.m_mutex);
+  Int64 nb_dropped = 0;
+
+  JSONWriter writer(JSONWriter::FormatFlags::None);
+  writer.beginObject();
+  {
+    JSONWriter::Array events(writer, "traceEvents");
+    {
+      JSONWriter::Object x(writer);
+      writer.write("name", "process_name");
+      writer.write("ph", "M");
+      writer.write("pid", rank);
+      {
+        JSONWriter::Object args(writer, "args");
+        writer.write("name", String::format("Rank {0}", rank));
+      }
+    }
+    for (const auto& buffer : global_buffers.m_buffers) {
+      Int32 buffer_rank = buffer->m_rank.load();
+      if (buffer_rank != rank && !(buffer_rank < 0 && write_unowned))
+        continue;
+      const Int32 tid = buffer->m_thread_index;
+      // Le thread propriétaire peut continuer à ajouter des évènements :
+      // on n'écrit que ceux publiés avant cette lecture.
+      const Int64 nb_event = buffer->m_nb_event.load(std::memory_order_acquire);
+      nb_dropped += buffer->m_nb_dropped.load(std::memory_order_relaxed);
+      {
+        JSONWriter::Object x(writer);
+        writer.write("name", "thread_name");
+        writer.write("ph", "M");
+        writer.write("pid", rank);
+        writer.write("tid", tid);
+        {
+          JSONWriter::Object args(writer, "args");
+          writer.write("name", String::format("Thread {0}", tid));
+        }
+      }
+      for (Int64 i = 0; i < nb_event; ++i) {
+        const TimelineEvent& e = buffer->event(i);
+        JSONWriter::Object x(writer);
+        writer.write("name", name_table.m_names[e.m_name_id]);
+        writer.write("cat", categoryName(e.m_category));
+        writer.write("ph", "X");
+        // Les temps sont en microsecondes dans ce format.
+        writer.write("ts", static_cast<Real>(e.m_begin_time - origin) / 1.0e3);
+        writer.write("dur", static_cast<Real>(e.m_end_time - e.m_begin_time) / 1.0e3);
+        writer.write("pid", rank);
+        writer.write("tid", tid);
+      }
+    }
+  }
+  {
+    JSONWriter::Object other(writer, "otherData");
+    writer.write("origin_ns", origin);
+    writer.write("rank", rank);
+    writer.write("nb_dropped_event", nb_dropped);
+  }
+  writer.write("displayTimeUnit", "ms");
+  writer.endObject();
+  o << writer.getBuffer();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TimelineRecorder::ScopedEvent::
+ScopedEvent(eCategory category, const String& name)
+: m_category(category)
+{
+  if (TimelineRecorder::isEnabled()) {
+    m_name_id = TimelineRecorder::nameId(name);
+    m_begin_time = platform::getRealTimeNS();
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TimelineRecorder::ScopedEvent::
+~ScopedEvent()
+{
+  if (m_begin_time != 0)
+    TimelineRecorder::addEvent(m_category, m_name_id, m_begin_time, platform::getRealTimeNS());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane::impl
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
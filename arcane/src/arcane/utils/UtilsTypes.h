@@ -119,6 +119,7 @@ using Arccore::ThreadImpl;
 using Arccore::MutexImpl;
 using Arccore::NullThreadImplementation;
 using Arccore::NullThreadBarrier;
+using Arccore::ThreadCombiningTree;
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,121 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* NumaMemoryAllocator.h                                       (C) 2000-2024 */
+/*                                                                           */
+/* Allocateur mémoire hôte tenant compte des noeuds NUMA.                    */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_UTILS_INTERNAL_NUMAMEMORYALLOCATOR_H
+#define ARCANE_UTILS_INTERNAL_NUMAMEMORYALLOCATOR_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arcane/utils/UtilsTypes.h"
+#include "arcane/utils/MemoryAllocator.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Allocateur mémoire hôte tenant compte des noeuds NUMA.
+ *
+ * Sous Linux, la page physique associée à une adresse est allouée sur le
+ * noeud NUMA du thread qui y accède en premier (\a first-touch). Avec
+ * l'allocateur par défaut, c'est en général le thread principal qui
+ * initialise les tableaux et toute la mémoire se retrouve sur son noeud.
+ * Les boucles multi-threads accèdent alors toutes à la mémoire d'un seul
+ * noeud.
+ *
+ * Cet allocateur se comporte comme AlignedMemoryAllocator3::Simd() et
+ * modifie le placement des pages des grandes allocations suivant la
+ * politique choisie:
+ * - avec ePolicy::FirstTouch, les pages sont touchées via
+ *   TaskFactory::executeParallelFor() avec un partitionnement statique.
+ *   Chaque page est donc placée sur le noeud du thread qui traitera la partie
+ *   correspondante du tableau dans une boucle utilisant
+ *   ParallelLoopOptions::Partitioner::Static. Cette initialisation
+ *   parallèle n'est faite qu'avec cette politique.
+ * - avec ePolicy::Interleave, les pages sont réparties cycliquement sur tous
+ *   les noeuds via mbind(). Elles ne sont pas touchées et le noyau
+ *   les place lors de leur premier accès. Cela est utile pour les tableaux
+ *   dont l'accès n'est pas partitionné comme les boucles (par exemple
+ *   les connectivités accédées de manière indirecte).
+ *
+ * Cet allocateur n'est utilisé que si la variable d'environnement
+ * ARCANE_NUMA_POLICY est positionnée et s'il n'y a pas de runtime
+ * accélérateur (voir installFromEnvironment()).
+ */
+class ARCANE_UTILS_EXPORT NumaMemoryAllocator
+: public Arccore::AlignedMemoryAllocator3
+{
+ public:
+
+  //! Politique de placement des pages
+  enum class ePolicy
+  {
+    //! Initialisation parallèle des pages (first-touch)
+    FirstTouch,
+    //! Répartition cyclique des pages sur les noeuds
+    Interleave
+  };
+
+ public:
+
+  explicit NumaMemoryAllocator(ePolicy policy);
+
+ public:
+
+  using AlignedMemoryAllocator3::allocate;
+
+  AllocatedMemoryInfo allocate(MemoryAllocationArgs args, Int64 new_size) override;
+
+ public:
+
+  //! Politique de placement
+  ePolicy policy() const { return m_policy; }
+
+  /*!
+   * \brief Taille minimale (en octets) d'une allocation pour que ses pages
+   * soient initialisées en parallèle.
+   */
+  static constexpr Int64 minimalParallelSize() { return 1 << 20; }
+
+  /*!
+   * \brief Positionne l'allocateur hôte en fonction de ARCANE_NUMA_POLICY.
+   *
+   * Les valeurs possibles sont 'FirstTouch' et 'Interleave'. Si la variable
+   * n'est pas positionnée ou si un runtime accélérateur est utilisé,
+   * aucune opération n'est effectuée.
+   *
+   * \retval l'allocateur utilisé ou \a nullptr si aucun.
+   */
+  static NumaMemoryAllocator* installFromEnvironment();
+
+ private:
+
+  ePolicy m_policy;
+
+ private:
+
+  void _interleave(void* ptr, Int64 size);
+  void _touch(void* ptr, Int64 size);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -19,6 +19,7 @@
 
 #include "arcane/utils/String.h"
 #include "arcane/utils/FixedArray.h"
+#include "arcane/utils/Profiling.h"
 
 #include <map>
 #include <atomic>
@@ -29,6 +30,95 @@
 namespace Arcane::impl
 {
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Statistiques sur les compteurs matériels.
+ *
+ * Les compteurs sont lus via le service IPerformanceCounterService
+ * enregistré dans platform::getPerformanceCounterService(). Ils sont
+ * cumulés pour tous les threads du processus. Les valeurs conservées sont
+ * celles décrites dans ForLoopOneExecStat::NB_HARDWARE_COUNTER.
+ *
+ * La lecture des compteurs n'est faite que si isEnabled() est vrai. Cela
+ * est le cas si la variable d'environnement ARCANE_HARDWARE_COUNTERS
+ * est positionnée.
+ */
+class ARCANE_UTILS_EXPORT HardwareCounterStat
+{
+ public:
+
+  static constexpr Int32 NB_COUNTER = ForLoopOneExecStat::NB_HARDWARE_COUNTER;
+  //! Taille d'une ligne de cache pour estimer le volume de données lu en mémoire
+  static constexpr Int64 CACHE_LINE_SIZE = 64;
+  using CounterValues = FixedArray<Int64, NB_COUNTER>;
+
+ public:
+
+  //! Indique si la lecture des compteurs est active
+  static bool isEnabled() { return m_is_enabled.load(std::memory_order_relaxed); }
+
+  //! Active ou désactive la lecture des compteurs
+  static void setEnabled(bool v) { m_is_enabled.store(v); }
+
+  /*!
+   * \brief Lit les valeurs courantes des compteurs.
+   *
+   * Retourne \a false si aucun service de compteurs n'est disponible
+   * ou s'il n'a pas démarré. Dans ce cas, \a values est remis à zéro.
+   */
+  static bool readCounters(CounterValues& values);
+
+  //! Calcule \a end - \a begin dans \a end
+  static void substract(const CounterValues& begin, CounterValues& end)
+  {
+    for (Int32 i = 0; i < NB_COUNTER; ++i)
+      end[i] -= begin[i];
+  }
+
+ public:
+
+  //! Ajoute les valeurs d'une exécution
+  void add(const CounterValues& values)
+  {
+    ++m_nb_sample;
+    for (Int32 i = 0; i < NB_COUNTER; ++i)
+      m_values[i] += values[i];
+  }
+
+  Int64 nbSample() const { return m_nb_sample; }
+  Int64 nbCycle() const { return m_values[0]; }
+  Int64 nbInstruction() const { return m_values[1]; }
+  Int64 nbCacheMiss() const { return m_values[2]; }
+
+  //! Nombre d'instructions par cycle
+  Real instructionPerCycle() const { return _ratio(nbInstruction(), nbCycle()); }
+
+  /*!
+   * \brief Estimation du nombre d'octets lus en mémoire par cycle.
+   *
+   * On suppose que chaque défaut de cache entraîne la lecture d'une ligne
+   * de cache de CACHE_LINE_SIZE octets.
+   */
+  Real bytePerCycle() const { return _ratio(nbCacheMiss() * CACHE_LINE_SIZE, nbCycle()); }
+
+  //! Nombre de défauts de cache pour 1000 instructions
+  Real cacheMissPerKiloInstruction() const { return _ratio(nbCacheMiss() * 1000, nbInstruction()); }
+
+ private:
+
+  Int64 m_nb_sample = 0;
+  CounterValues m_values;
+  static std::atomic<bool> m_is_enabled;
+
+ private:
+
+  static Real _ratio(Int64 a, Int64 b)
+  {
+    return (b == 0) ? 0.0 : static_cast<Real>(a) / static_cast<Real>(b);
+  }
+};
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
@@ -45,11 +135,15 @@ struct ARCANE_UTILS_EXPORT ForLoopProfilingStat
   Int64 nbChunk() const { return m_nb_chunk; }
   Int64 execTime() const { return m_exec_time; }
 
+  //! Statistiques sur les compteurs matériels
+  const HardwareCounterStat& hardwareCounterStat() const { return m_hardware_counter_stat; }
+
  private:
 
   Int64 m_nb_call = 0;
   Int64 m_nb_chunk = 0;
   Int64 m_exec_time = 0;
+  HardwareCounterStat m_hardware_counter_stat;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -0,0 +1,186 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* TimelineRecorder.h                                          (C) 2000-2024 */
+/*                                                                           */
+/* Enregistrement des évènements pour une trace temporelle d'exécution.      */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCANE_UTILS_INTERNAL_TIMELINERECORDER_H
+#define ARCANE_UTILS_INTERNAL_TIMELINERECORDER_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+// Note: ce fichier n'est pas disponible pour les utilisateurs de Arcane.
+// Il ne faut donc pas l'inclure dans un fichier d'en-tête public.
+
+#include "arcane/utils/String.h"
+
+#include <atomic>
+#include <iosfwd>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::impl
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Enregistrement des évènements pour une trace temporelle d'exécution.
+ *
+ * Chaque évènement possède un nom, une catégorie et des temps de début et
+ * de fin (en nanosecondes, donnés par platform::getRealTimeNS()).
+ *
+ * Les évènements sont conservés dans un tampon propre à chaque thread.
+ * Seul ce thread écrit dans son tampon et l'ajout d'un évènement ne prend
+ * aucun verrou : le nombre d'évènements est publié de manière atomique et
+ * writeChromeTrace() ne lit que les évènements publiés. Il est donc possible
+ * d'écrire la trace d'un sous-domaine alors que les threads des autres
+ * sous-domaines continuent d'ajouter des évènements.
+ *
+ * Pour ne pas copier le nom de chaque évènement, les noms sont conservés
+ * dans une table globale et les évènements ne contiennent que l'indice du
+ * nom dans cette table (voir nameId()). Chaque thread conserve un cache
+ * des indices qu'il a déjà utilisés et la table globale n'est verrouillée
+ * que lors de la première utilisation d'un nom par un thread et lors de
+ * l'écriture de la trace.
+ *
+ * Le nombre d'évènements d'un thread est limité à maxNbEventPerThread().
+ * Les évènements au delà de cette limite sont ignorés et comptabilisés
+ * dans nbDroppedEvent().
+ *
+ * Les évènements sont écrits au format 'Trace Event' de Chrome
+ * (lisible par https://ui.perfetto.dev ou chrome://tracing) via
+ * writeChromeTrace().
+ *
+ * L'enregistrement est actif tant qu'il y a eu plus d'appels à enable()
+ * qu'à disable(). Chaque sous-domaine d'un même processus peut donc
+ * l'activer et le désactiver indépendamment des autres.
+ *
+ * Lorsque plusieurs sous-domaines sont dans le même processus (mode
+ * mémoire partagée), chaque thread qui exécute un sous-domaine doit appeler
+ * setThreadRank() pour que ses évènements soient associés à ce sous-domaine.
+ * Les évènements des autres threads (par exemple ceux des tâches) sont
+ * écrits par le premier sous-domaine qui appelle writeChromeTrace().
+ */
+class ARCANE_UTILS_EXPORT TimelineRecorder
+{
+ public:
+
+  //! Catégorie d'un évènement
+  enum class eCategory
+  {
+    EntryPoint = 0,
+    Loop = 1,
+    Synchronize = 2,
+    MessagePassing = 3,
+    Checkpoint = 4,
+    Other = 5
+  };
+
+  /*!
+   * \brief Enregistre un évènement entre l'appel au constructeur et
+   * celui au destructeur.
+   */
+  class ARCANE_UTILS_EXPORT ScopedEvent
+  {
+   public:
+
+    ScopedEvent(eCategory category, const String& name);
+    ~ScopedEvent();
+
+   public:
+
+    ScopedEvent(const ScopedEvent&) = delete;
+    ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+   private:
+
+    eCategory m_category;
+    Int32 m_name_id = -1;
+    Int64 m_begin_time = 0;
+  };
+
+ public:
+
+  //! Indique si l'enregistrement est actif
+  static bool isEnabled() { return m_is_enabled.load(std::memory_order_relaxed); }
+
+  //! Incrémente le nombre de demandes d'activation de l'enregistrement
+  static void enable();
+
+  /*!
+   * \brief Décrémente le nombre de demandes d'activation de l'enregistrement.
+   *
+   * L'enregistrement est désactivé lorsque ce nombre devient nul.
+   */
+  static void disable();
+
+  /*!
+   * \brief Indice du nom \a name dans la table des noms.
+   *
+   * Le nom est ajouté à la table s'il n'y est pas encore.
+   */
+  static Int32 nameId(const String& name);
+
+  /*!
+   * \brief Ajoute un évènement pour le thread courant.
+   *
+   * \a name_id est l'indice du nom retourné par nameId().
+   * Ne fait rien si l'enregistrement n'est pas actif.
+   */
+  static void addEvent(eCategory category, Int32 name_id, Int64 begin_time_ns, Int64 end_time_ns);
+
+  //! Ajoute un évènement de nom \a name pour le thread courant.
+  static void addEvent(eCategory category, const String& name, Int64 begin_time_ns, Int64 end_time_ns);
+
+  /*!
+   * \brief Positionne le nombre maximum d'évènements par thread.
+   *
+   * Cette valeur n'est prise en compte que pour les threads qui n'ont pas
+   * encore ajouté d'évènement.
+   */
+  static void setMaxNbEventPerThread(Int64 v);
+
+  //! Nombre maximum d'évènements par thread
+  static Int64 maxNbEventPerThread();
+
+  //! Nombre d'évènements ignorés car un thread a atteint maxNbEventPerThread()
+  static Int64 nbDroppedEvent();
+
+  //! Associe les évènements du thread courant au sous-domaine \a rank
+  static void setThreadRank(Int32 rank);
+
+  /*!
+   * \brief Écrit au format 'Trace Event' de Chrome les évènements du sous-domaine \a rank.
+   *
+   * Le champ 'otherData.origin_ns' contient l'origine des temps en nanosecondes.
+   * Les temps des évènements sont relatifs à cette origine. Le champ
+   * 'otherData.nb_dropped_event' contient le nombre d'évènements ignorés
+   * pour les threads écrits.
+   */
+  static void writeChromeTrace(std::ostream& o, Int32 rank);
+
+  //! Nom de la catégorie \a c
+  static const char* categoryName(eCategory c);
+
+ private:
+
+  static std::atomic<bool> m_is_enabled;
+  static Int32 m_nb_enable;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arcane::impl
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
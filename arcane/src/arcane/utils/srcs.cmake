@@ -92,6 +92,7 @@ set(ARCANE_SOURCES
   MemoryRessourceMng.cc
   MemoryUtils.h
   MemoryUtils.cc
+  NumaMemoryAllocator.cc
   Numeric.cc
   Numeric.h
   NumericTypes.h
@@ -111,6 +112,8 @@ set(ARCANE_SOURCES
   ParallelFatalErrorException.h
   ParallelLoopOptions.h
   ParallelLoopOptions.cc
+  ParallelLoopTuner.h
+  ParallelLoopTuner.cc
   PerfCounterMng.cc
   PerfCounterMng.h
   PlatformUtils.cc
@@ -119,6 +122,7 @@ set(ARCANE_SOURCES
   Process.h
   Profiling.h
   Profiling.cc
+  TimelineRecorder.cc
   Property.cc
   Property.h
   PropertyDeclarations.h
@@ -294,6 +298,8 @@ set(ARCANE_SOURCES
   SimdAVX512Generated.h
   SimdSSE.h
   SimdSSEGenerated.h
+  SimdVEC.h
+  SimdVECOperation.h
   SimdOperation.h
   SpinLock.h
   SharedArray.h
@@ -335,6 +341,8 @@ set(ARCANE_SOURCES
   internal/ValueConvertInternal.h
   internal/SpecificMemoryCopyList.h
   internal/MemoryBuffer.h
+  internal/NumaMemoryAllocator.h
+  internal/TimelineRecorder.h
   )
 
 if (ARCANE_HAS_CXX20)
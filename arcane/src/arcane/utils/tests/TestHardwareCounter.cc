@@ -0,0 +1,153 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "arcane/utils/IPerformanceCounterService.h"
+#include "arcane/utils/PlatformUtils.h"
+#include "arcane/utils/Profiling.h"
+#include "arcane/utils/internal/ProfilingInternal.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+using namespace Arcane;
+using impl::HardwareCounterStat;
+
+namespace
+{
+// Service de compteurs dont les valeurs augmentent d'une quantité fixe
+// à chaque lecture.
+class TestPerformanceCounterService
+: public IPerformanceCounterService
+{
+ public:
+
+  void initialize() override {}
+  void start() override { m_is_started = true; }
+  void stop() override { m_is_started = false; }
+  bool isStarted() const override { return m_is_started; }
+  Int32 getCounters(Int64ArrayView counters, bool do_substract) override
+  {
+    ++m_nb_read;
+    for (Int32 i = 0; i < m_nb_counter; ++i) {
+      Int64 value = m_nb_read * m_increments[i];
+      counters[i] = (do_substract) ? value - counters[i] : value;
+    }
+    return m_nb_counter;
+  }
+  Int64 getCycles() override { return m_nb_read * m_increments[0]; }
+
+ public:
+
+  bool m_is_started = false;
+  Int32 m_nb_counter = 3;
+  Int64 m_nb_read = 0;
+  Int64 m_increments[3] = { 1000, 1500, 20 };
+};
+
+// Positionne le service de compteurs et active leur lecture.
+class ScopedCounterService
+{
+ public:
+
+  explicit ScopedCounterService(IPerformanceCounterService* s)
+  {
+    m_old_service = platform::setPerformanceCounterService(s);
+    HardwareCounterStat::setEnabled(true);
+  }
+  ~ScopedCounterService()
+  {
+    HardwareCounterStat::setEnabled(false);
+    platform::setPerformanceCounterService(m_old_service);
+  }
+
+ private:
+
+  IPerformanceCounterService* m_old_service = nullptr;
+};
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(TestHardwareCounter, Ratios)
+{
+  HardwareCounterStat stat;
+  // Aucune valeur: les ratios doivent être nuls et pas infinis.
+  ASSERT_EQ(stat.instructionPerCycle(), 0.0);
+  ASSERT_EQ(stat.bytePerCycle(), 0.0);
+  ASSERT_EQ(stat.cacheMissPerKiloInstruction(), 0.0);
+
+  HardwareCounterStat::CounterValues v;
+  v[0] = 1000;
+  v[1] = 2500;
+  v[2] = 10;
+  stat.add(v);
+  stat.add(v);
+  ASSERT_EQ(stat.nbSample(), 2);
+  ASSERT_EQ(stat.nbCycle(), 2000);
+  ASSERT_EQ(stat.nbInstruction(), 5000);
+  ASSERT_EQ(stat.nbCacheMiss(), 20);
+  ASSERT_DOUBLE_EQ(stat.instructionPerCycle(), 2.5);
+  ASSERT_DOUBLE_EQ(stat.bytePerCycle(), (20.0 * HardwareCounterStat::CACHE_LINE_SIZE) / 2000.0);
+  ASSERT_DOUBLE_EQ(stat.cacheMissPerKiloInstruction(), 4.0);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(TestHardwareCounter, ScopedStatLoop)
+{
+  TestPerformanceCounterService service;
+  ScopedCounterService scoped_service(&service);
+
+  // Service non démarré: pas de compteurs.
+  {
+    ForLoopOneExecStat exec_stat;
+    {
+      impl::ScopedStatLoop sl(&exec_stat);
+    }
+    ASSERT_FALSE(exec_stat.hasHardwareCounters());
+  }
+
+  // Service démarré: les compteurs sont la différence entre deux lectures.
+  service.start();
+  {
+    ForLoopOneExecStat exec_stat;
+    {
+      impl::ScopedStatLoop sl(&exec_stat);
+    }
+    ASSERT_TRUE(exec_stat.hasHardwareCounters());
+    for (Int32 i = 0; i < ForLoopOneExecStat::NB_HARDWARE_COUNTER; ++i)
+      ASSERT_EQ(exec_stat.hardwareCounters()[i], service.m_increments[i]);
+
+    impl::ForLoopProfilingStat profiling_stat;
+    profiling_stat.add(exec_stat);
+    exec_stat.reset();
+    ASSERT_FALSE(exec_stat.hasHardwareCounters());
+    profiling_stat.add(exec_stat);
+    const HardwareCounterStat& hw = profiling_stat.hardwareCounterStat();
+    ASSERT_EQ(profiling_stat.nbCall(), 2);
+    ASSERT_EQ(hw.nbSample(), 1);
+    ASSERT_EQ(hw.nbInstruction(), service.m_increments[1]);
+  }
+
+  // Lecture désactivée: pas de compteurs même si le service est démarré.
+  HardwareCounterStat::setEnabled(false);
+  {
+    ForLoopOneExecStat exec_stat;
+    {
+      impl::ScopedStatLoop sl(&exec_stat);
+    }
+    ASSERT_FALSE(exec_stat.hasHardwareCounters());
+  }
+  service.stop();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
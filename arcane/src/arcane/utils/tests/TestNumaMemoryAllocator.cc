@@ -0,0 +1,127 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "arcane/utils/Array.h"
+#include "arcane/utils/MemoryUtils.h"
+#include "arcane/utils/MemoryView.h"
+#include "arcane/utils/internal/NumaMemoryAllocator.h"
+
+#include <cstring>
+#include <cstdint>
+
+#if defined(ARCANE_OS_LINUX)
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+using namespace Arcane;
+
+namespace
+{
+// Nombre de pages de la zone [ptr,ptr+size[.
+Int64 _nbPage(const std::byte* ptr, Int64 size)
+{
+  const std::uintptr_t page_size = ::sysconf(_SC_PAGESIZE);
+  const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(ptr);
+  return static_cast<Int64>((addr + size - 1) / page_size - addr / page_size + 1);
+}
+
+Int64 _computePlacement(const std::byte* ptr, Int64 size, UniqueArray<Int64>& nb_page_per_node)
+{
+  return MemoryUtils::computeNumaPagePlacement(ConstMemoryView(Span<const std::byte>(ptr, size)), nb_page_per_node);
+}
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(TestNumaMemoryAllocator, PagePlacement)
+{
+#if !defined(ARCANE_OS_LINUX)
+  GTEST_SKIP() << "Page placement is only available on Linux";
+#else
+  const Int64 size = 4 * NumaMemoryAllocator::minimalParallelSize();
+  UniqueArray<std::byte> values(size);
+  std::memset(values.data(), 1, size);
+  const Int64 nb_page = _nbPage(values.data(), size);
+
+  UniqueArray<Int64> nb_page_per_node;
+  Int64 nb_unknown = _computePlacement(values.data(), size, nb_page_per_node);
+  ASSERT_EQ(nb_page_per_node.size(), MemoryUtils::getNbNumaNode());
+  if (nb_unknown == nb_page)
+    GTEST_SKIP() << "move_pages() is not available";
+  // Toutes les pages ont été touchées et ont donc un noeud.
+  ASSERT_EQ(nb_unknown, 0);
+  Int64 total = 0;
+  for (Int64 n : nb_page_per_node)
+    total += n;
+  ASSERT_EQ(total, nb_page);
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(TestNumaMemoryAllocator, Interleave)
+{
+#if !defined(ARCANE_OS_LINUX) || !defined(SYS_get_mempolicy)
+  GTEST_SKIP() << "NUMA policies are only available on Linux";
+#else
+  const Int32 nb_node = MemoryUtils::getNbNumaNode();
+  NumaMemoryAllocator allocator(NumaMemoryAllocator::ePolicy::Interleave);
+  const Int64 size = 4 * NumaMemoryAllocator::minimalParallelSize();
+  MemoryAllocationArgs args;
+  AllocatedMemoryInfo mem_info = allocator.allocate(args, size);
+  auto* ptr = static_cast<std::byte*>(mem_info.baseAddress());
+  ASSERT_NE(ptr, nullptr);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % Arccore::AlignedMemoryAllocator3::simdAlignment(), 0);
+  const Int64 nb_page = _nbPage(ptr, size);
+
+  // Avec cette politique, l'allocateur ne doit pas toucher les pages.
+  UniqueArray<Int64> nb_page_per_node;
+  Int64 nb_unknown = _computePlacement(ptr, size, nb_page_per_node);
+  bool has_move_pages = true;
+  if (nb_unknown == nb_page) {
+    // Soit 'move_pages' n'est pas disponible, soit aucune page n'est allouée.
+    std::memset(ptr, 1, size);
+    has_move_pages = (_computePlacement(ptr, size, nb_page_per_node) != nb_page);
+  }
+  else
+    // Seules la première et la dernière page, partagées avec d'autres
+    // allocations, peuvent déjà avoir été touchées.
+    ASSERT_GE(nb_unknown, nb_page - 2);
+
+  if (nb_node > 1) {
+    // Vérifie la politique associée à une page au milieu de la zone.
+    constexpr int mpol_f_addr = 2;
+    constexpr int mpol_interleave = 3;
+    int mode = -1;
+    long r = ::syscall(SYS_get_mempolicy, &mode, nullptr, 0, ptr + size / 2, mpol_f_addr);
+    ASSERT_EQ(r, 0);
+    ASSERT_EQ(mode, mpol_interleave);
+
+    if (has_move_pages) {
+      std::memset(ptr, 1, size);
+      _computePlacement(ptr, size, nb_page_per_node);
+      Int32 nb_used_node = 0;
+      for (Int64 n : nb_page_per_node)
+        if (n > 0)
+          ++nb_used_node;
+      ASSERT_GT(nb_used_node, 1);
+    }
+  }
+  allocator.deallocate(args, mem_info);
+#endif
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,199 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "arcane/utils/JSONReader.h"
+#include "arcane/utils/String.h"
+#include "arcane/utils/internal/TimelineRecorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+using namespace Arcane;
+using impl::TimelineRecorder;
+
+namespace
+{
+class TraceEvent
+{
+ public:
+
+  String m_name;
+  Real m_begin = 0.0;
+  Real m_end = 0.0;
+};
+
+// Lit la trace et retourne les évènements de type 'X' par thread.
+std::map<Int32, std::vector<TraceEvent>>
+_readTrace(const std::string& trace)
+{
+  JSONDocument doc;
+  auto bytes = asBytes(Span<const char>(trace.data(), trace.size()));
+  doc.parse(bytes);
+  JSONValue root = doc.root();
+  std::map<Int32, std::vector<TraceEvent>> events;
+  for (JSONValue v : root.expectedChild("traceEvents").valueAsArray()) {
+    if (v.expectedChild("ph").value() != "X")
+      continue;
+    TraceEvent e;
+    e.m_name = v.expectedChild("name").value();
+    e.m_begin = v.expectedChild("ts").valueAsReal();
+    Real duration = v.expectedChild("dur").valueAsReal();
+    EXPECT_GE(duration, 0.0);
+    e.m_end = e.m_begin + duration;
+    events[v.expectedChild("tid").valueAsInt32()].push_back(e);
+  }
+  return events;
+}
+
+// Vérifie que les évènements d'un thread sont correctement imbriqués.
+void _checkNested(std::vector<TraceEvent>& events)
+{
+  const Real epsilon = 1.0e-3;
+  std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+    if (a.m_begin != b.m_begin)
+      return a.m_begin < b.m_begin;
+    return a.m_end > b.m_end;
+  });
+  std::vector<const TraceEvent*> stack;
+  for (const TraceEvent& e : events) {
+    while (!stack.empty() && stack.back()->m_end <= e.m_begin + epsilon)
+      stack.pop_back();
+    if (!stack.empty())
+      ASSERT_LE(e.m_end, stack.back()->m_end + epsilon) << "Event '" << e.m_name << "' overlaps '" << stack.back()->m_name << "'";
+    stack.push_back(&e);
+  }
+}
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(TestTimelineRecorder, EnableCount)
+{
+  ASSERT_FALSE(TimelineRecorder::isEnabled());
+  TimelineRecorder::enable();
+  TimelineRecorder::enable();
+  ASSERT_TRUE(TimelineRecorder::isEnabled());
+  // Un sous-domaine qui s'arrête ne désactive pas les autres.
+  TimelineRecorder::disable();
+  ASSERT_TRUE(TimelineRecorder::isEnabled());
+  TimelineRecorder::disable();
+  ASSERT_FALSE(TimelineRecorder::isEnabled());
+  TimelineRecorder::disable();
+  ASSERT_FALSE(TimelineRecorder::isEnabled());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(TestTimelineRecorder, ConcurrentWrite)
+{
+  const Int32 rank = 17;
+  const Int32 nb_thread = 4;
+  const Int32 nb_iteration = 500;
+
+  TimelineRecorder::enable();
+  std::atomic<Int32> nb_started = 0;
+  std::vector<std::thread> threads;
+  for (Int32 t = 0; t < nb_thread; ++t) {
+    threads.emplace_back([&]() {
+      TimelineRecorder::setThreadRank(rank);
+      ++nb_started;
+      for (Int32 i = 0; i < nb_iteration; ++i) {
+        TimelineRecorder::ScopedEvent outer(TimelineRecorder::eCategory::EntryPoint, "Outer");
+        TimelineRecorder::ScopedEvent inner(TimelineRecorder::eCategory::Loop, "Inner");
+      }
+    });
+  }
+  // Écrit la trace pendant que les threads ajoutent des évènements.
+  while (nb_started.load() != nb_thread)
+    std::this_thread::yield();
+  for (Int32 i = 0; i < 5; ++i) {
+    std::ostringstream ostr;
+    TimelineRecorder::writeChromeTrace(ostr, rank);
+    auto partial_events = _readTrace(ostr.str());
+    for (auto& [tid, events] : partial_events)
+      _checkNested(events);
+  }
+  for (auto& t : threads)
+    t.join();
+  TimelineRecorder::disable();
+
+  std::ostringstream ostr;
+  TimelineRecorder::writeChromeTrace(ostr, rank);
+  auto all_events = _readTrace(ostr.str());
+  ASSERT_EQ(all_events.size(), static_cast<size_t>(nb_thread));
+  for (auto& [tid, events] : all_events) {
+    Int32 nb_outer = 0;
+    Int32 nb_inner = 0;
+    for (const TraceEvent& e : events) {
+      if (e.m_name == "Outer")
+        ++nb_outer;
+      else if (e.m_name == "Inner")
+        ++nb_inner;
+    }
+    ASSERT_EQ(nb_outer, nb_iteration);
+    ASSERT_EQ(nb_inner, nb_iteration);
+    _checkNested(events);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+TEST(TestTimelineRecorder, MaxNbEvent)
+{
+  const Int32 rank = 23;
+  const Int64 max_nb_event = 100;
+  const Int32 nb_event = 250;
+  const Int64 old_max_nb_event = TimelineRecorder::maxNbEventPerThread();
+  const Int64 old_nb_dropped = TimelineRecorder::nbDroppedEvent();
+
+  // La limite n'est prise en compte que pour les nouveaux threads.
+  TimelineRecorder::setMaxNbEventPerThread(max_nb_event);
+  TimelineRecorder::enable();
+  std::thread thread([&]() {
+    TimelineRecorder::setThreadRank(rank);
+    Int32 name_id = TimelineRecorder::nameId("Capped");
+    ASSERT_EQ(TimelineRecorder::nameId("Capped"), name_id);
+    for (Int32 i = 0; i < nb_event; ++i)
+      TimelineRecorder::addEvent(TimelineRecorder::eCategory::Other, name_id, 1000 + i, 1001 + i);
+  });
+  thread.join();
+  TimelineRecorder::disable();
+  TimelineRecorder::setMaxNbEventPerThread(old_max_nb_event);
+
+  ASSERT_EQ(TimelineRecorder::nbDroppedEvent() - old_nb_dropped, nb_event - max_nb_event);
+
+  std::ostringstream ostr;
+  TimelineRecorder::writeChromeTrace(ostr, rank);
+  auto all_events = _readTrace(ostr.str());
+  ASSERT_EQ(all_events.size(), static_cast<size_t>(1));
+  for (auto& [tid, events] : all_events) {
+    ASSERT_EQ(static_cast<Int64>(events.size()), max_nb_event);
+    for (const TraceEvent& e : events)
+      ASSERT_EQ(e.m_name, "Capped");
+  }
+
+  JSONDocument doc;
+  std::string trace = ostr.str();
+  doc.parse(asBytes(Span<const char>(trace.data(), trace.size())));
+  JSONValue other = doc.root().expectedChild("otherData");
+  ASSERT_EQ(other.expectedChild("nb_dropped_event").valueAsInt64(), nb_event - max_nb_event);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
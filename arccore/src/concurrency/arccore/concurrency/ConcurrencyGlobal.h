@@ -39,6 +39,7 @@ class GlobalMutex;
 class IThreadBarrier;
 class NullThreadImplementation;
 class NullThreadBarrier;
+class ThreadCombiningTree;
 
 //! Classe opaque encapsulant l'implementation des threads
 class ThreadImpl;
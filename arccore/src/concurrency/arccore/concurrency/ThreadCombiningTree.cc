@@ -0,0 +1,83 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* ThreadCombiningTree.cc                                      (C) 2000-2024 */
+/*                                                                           */
+/* Arbre de combinaison pour les opérations collectives entre threads.       */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arccore/concurrency/ThreadCombiningTree.h"
+
+#include "arccore/base/ArgumentException.h"
+
+#include <thread>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arccore
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ThreadCombiningTree::
+ThreadCombiningTree(Int32 nb_thread, Int32 arity)
+: m_nb_thread(nb_thread)
+, m_arity(arity)
+, m_nodes(nb_thread)
+{
+  if (nb_thread <= 0)
+    ARCCORE_THROW(ArgumentException, "Bad number of thread '{0}'", nb_thread);
+  if (arity < 2)
+    ARCCORE_THROW(ArgumentException, "Bad arity '{0}' (should be greater than 1)", arity);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void ThreadCombiningTree::
+barrier(Int32 rank)
+{
+  Node& node = m_nodes[rank];
+  const Int64 epoch = ++node.m_epoch;
+  for (Int32 child : _children(rank, 0))
+    _waitEpoch(m_nodes[child].m_up_epoch, epoch);
+  node.m_up_epoch.store(epoch, std::memory_order_release);
+  if (rank != 0)
+    _waitEpoch(m_nodes[_parent(rank, 0)].m_down_epoch, epoch);
+  node.m_down_epoch.store(epoch, std::memory_order_release);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Attente active jusqu'à ce que \a v atteigne \a epoch.
+ *
+ * Si l'attente dure trop longtemps, on rend la main au système pour le cas
+ * où il y a plus de threads que de coeurs.
+ */
+void ThreadCombiningTree::
+_doWaitEpoch(const std::atomic<Int64>& v, Int64 epoch)
+{
+  Int32 nb_spin = 0;
+  while (v.load(std::memory_order_acquire) < epoch) {
+    if (nb_spin < 2000)
+      ++nb_spin;
+    else
+      std::this_thread::yield();
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arccore
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
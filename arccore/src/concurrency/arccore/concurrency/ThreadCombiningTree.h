@@ -0,0 +1,289 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* ThreadCombiningTree.h                                       (C) 2000-2024 */
+/*                                                                           */
+/* Arbre de combinaison pour les opérations collectives entre threads.       */
+/*---------------------------------------------------------------------------*/
+#ifndef ARCCORE_CONCURRENCY_THREADCOMBININGTREE_H
+#define ARCCORE_CONCURRENCY_THREADCOMBININGTREE_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "arccore/concurrency/ConcurrencyGlobal.h"
+
+#include <atomic>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arccore
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Arbre de combinaison pour les opérations collectives entre threads.
+ *
+ * Cette classe permet de réaliser des barrières, réductions, diffusions et
+ * regroupements entre \a nb_thread threads en mémoire partagée sans que
+ * chaque thread ait besoin de lire les données de tous les autres.
+ *
+ * Les threads sont organisés en un arbre d'arité arity(). Chaque thread
+ * possède un noeud aligné sur une ligne de cache et n'écrit que dans son
+ * propre noeud. Une opération se fait en une phase montante où chaque noeud
+ * attend ses fils puis prévient son père, et une phase descendante où chaque
+ * noeud attend son père puis prévient ses fils. Le nombre de lignes de cache
+ * lues par thread est donc en O(arity()) au lieu de O(nb_thread) et le temps
+ * d'une opération est en O(log(nb_thread)).
+ *
+ * Les noeuds contiennent un numéro d'époque incrémenté à chaque opération.
+ * Tous les threads doivent donc appeler les mêmes opérations dans le même
+ * ordre. L'attente est active (avec rendu de la main au système si elle
+ * dure trop longtemps).
+ *
+ * Les méthodes de cette classe ne gèrent que la synchronisation: l'échange
+ * des données est fait par les fonctions passées en argument qui reçoivent
+ * le rang du thread dont il faut lire les données. Ces données restent
+ * valides tant que l'opération n'est pas terminée.
+ */
+class ARCCORE_CONCURRENCY_EXPORT ThreadCombiningTree
+{
+ public:
+
+  //! Arité par défaut de l'arbre
+  static constexpr Int32 DefaultArity = 4;
+
+ private:
+
+  //! Noeud d'un thread. Chaque noeud est sur sa propre ligne de cache.
+  struct alignas(64) Node
+  {
+    //! Époque de la dernière phase montante terminée par ce noeud
+    std::atomic<Int64> m_up_epoch = 0;
+    //! Époque de la dernière phase descendante terminée par ce noeud
+    std::atomic<Int64> m_down_epoch = 0;
+    //! Époque courante (uniquement accédée par le thread propriétaire)
+    Int64 m_epoch = 0;
+  };
+
+ public:
+
+  explicit ThreadCombiningTree(Int32 nb_thread, Int32 arity = DefaultArity);
+  ThreadCombiningTree(const ThreadCombiningTree&) = delete;
+  ThreadCombiningTree& operator=(const ThreadCombiningTree&) = delete;
+
+ public:
+
+  //! Nombre de threads
+  Int32 nbThread() const { return m_nb_thread; }
+
+  //! Arité de l'arbre
+  Int32 arity() const { return m_arity; }
+
+  //! Barrière pour le thread de rang \a rank
+  void barrier(Int32 rank);
+
+  /*!
+   * \brief Réduction suivie d'une diffusion du résultat à tous les threads.
+   *
+   * Lors de la phase montante, \a combine_func(child_rank) est appelée
+   * pour chaque fils dont le résultat partiel est disponible. Ce dernier
+   * doit être combiné avec celui du thread courant. Le résultat final est
+   * celui du rang 0. Lors de la phase descendante, \a copy_func(parent_rank)
+   * est appelée pour recopier le résultat final du père dans celui du
+   * thread courant.
+   */
+  template <typename CombineFunc, typename CopyFunc> void
+  allReduce(Int32 rank, const CombineFunc& combine_func, const CopyFunc& copy_func)
+  {
+    allReduce(rank, combine_func, [] {}, copy_func);
+  }
+
+  /*!
+   * \brief Réduction avec traitement sur la racine suivie d'une diffusion.
+   *
+   * Cette méthode est identique à allReduce(Int32,const CombineFunc&,const CopyFunc&)
+   * mais \a root_func() est appelée sur le rang 0 entre la phase montante
+   * et la phase descendante. Cela permet par exemple de compléter la réduction
+   * avec d'autres processus avant de diffuser le résultat.
+   */
+  template <typename CombineFunc, typename RootFunc, typename CopyFunc> void
+  allReduce(Int32 rank, const CombineFunc& combine_func, const RootFunc& root_func,
+            const CopyFunc& copy_func)
+  {
+    Node& node = m_nodes[rank];
+    const Int64 epoch = ++node.m_epoch;
+    for (Int32 child : _children(rank, 0)) {
+      _waitEpoch(m_nodes[child].m_up_epoch, epoch);
+      combine_func(child);
+    }
+    node.m_up_epoch.store(epoch, std::memory_order_release);
+    if (rank == 0)
+      root_func();
+    else {
+      Int32 parent = _parent(rank, 0);
+      _waitEpoch(m_nodes[parent].m_down_epoch, epoch);
+      copy_func(parent);
+    }
+    node.m_down_epoch.store(epoch, std::memory_order_release);
+    _waitChildrenDown(rank, 0, epoch);
+  }
+
+  /*!
+   * \brief Diffusion depuis le rang \a root.
+   *
+   * Pour tous les rangs sauf \a root, \a copy_func(parent_rank) est appelée
+   * pour recopier les valeurs du père (qui les a déjà reçues) dans celles
+   * du thread courant.
+   */
+  template <typename CopyFunc> void
+  broadcast(Int32 rank, Int32 root, const CopyFunc& copy_func)
+  {
+    Node& node = m_nodes[rank];
+    const Int64 epoch = ++node.m_epoch;
+    if (rank != root) {
+      Int32 parent = _parent(rank, root);
+      _waitEpoch(m_nodes[parent].m_down_epoch, epoch);
+      copy_func(parent);
+    }
+    node.m_down_epoch.store(epoch, std::memory_order_release);
+    _waitChildrenDown(rank, root, epoch);
+  }
+
+  /*!
+   * \brief Regroupement sur le rang \a root.
+   *
+   * Sur le rang \a root, \a copy_func(i) est appelée pour chaque rang \a i
+   * (y compris \a root) dès que les valeurs de ce rang sont disponibles.
+   * Les autres rangs attendent que \a root ait terminé avant de rendre la main.
+   */
+  template <typename CopyFunc> void
+  gather(Int32 rank, Int32 root, const CopyFunc& copy_func)
+  {
+    Node& node = m_nodes[rank];
+    const Int64 epoch = ++node.m_epoch;
+    node.m_up_epoch.store(epoch, std::memory_order_release);
+    if (rank == root) {
+      for (Int32 i = 0; i < m_nb_thread; ++i) {
+        _waitEpoch(m_nodes[i].m_up_epoch, epoch);
+        copy_func(i);
+      }
+    }
+    else {
+      Int32 parent = _parent(rank, root);
+      _waitEpoch(m_nodes[parent].m_down_epoch, epoch);
+    }
+    node.m_down_epoch.store(epoch, std::memory_order_release);
+  }
+
+ private:
+
+  //! Liste des fils d'un noeud
+  class ChildRange
+  {
+   public:
+
+    class Iterator
+    {
+     public:
+
+      Iterator(Int32 vrank, Int32 root, Int32 nb_thread)
+      : m_vrank(vrank)
+      , m_root(root)
+      , m_nb_thread(nb_thread)
+      {}
+      Int32 operator*() const
+      {
+        Int32 r = m_vrank + m_root;
+        return (r >= m_nb_thread) ? (r - m_nb_thread) : r;
+      }
+      Iterator& operator++()
+      {
+        ++m_vrank;
+        return *this;
+      }
+      friend bool operator!=(const Iterator& a, const Iterator& b) { return a.m_vrank != b.m_vrank; }
+
+     private:
+
+      Int32 m_vrank;
+      Int32 m_root;
+      Int32 m_nb_thread;
+    };
+
+   public:
+
+    ChildRange(Int32 begin, Int32 end, Int32 root, Int32 nb_thread)
+    : m_begin(begin)
+    , m_end(end)
+    , m_root(root)
+    , m_nb_thread(nb_thread)
+    {}
+    Iterator begin() const { return { m_begin, m_root, m_nb_thread }; }
+    Iterator end() const { return { m_end, m_root, m_nb_thread }; }
+
+   private:
+
+    Int32 m_begin;
+    Int32 m_end;
+    Int32 m_root;
+    Int32 m_nb_thread;
+  };
+
+ private:
+
+  Int32 m_nb_thread = 0;
+  Int32 m_arity = DefaultArity;
+  std::vector<Node> m_nodes;
+
+ private:
+
+  // Les rangs sont renumérotés pour que \a root soit la racine de l'arbre.
+  Int32 _virtualRank(Int32 rank, Int32 root) const
+  {
+    Int32 v = rank - root;
+    return (v < 0) ? (v + m_nb_thread) : v;
+  }
+  Int32 _parent(Int32 rank, Int32 root) const
+  {
+    Int32 r = (_virtualRank(rank, root) - 1) / m_arity + root;
+    return (r >= m_nb_thread) ? (r - m_nb_thread) : r;
+  }
+  ChildRange _children(Int32 rank, Int32 root) const
+  {
+    Int64 first = static_cast<Int64>(_virtualRank(rank, root)) * m_arity + 1;
+    Int64 last = first + m_arity;
+    if (first > m_nb_thread)
+      first = m_nb_thread;
+    if (last > m_nb_thread)
+      last = m_nb_thread;
+    return { static_cast<Int32>(first), static_cast<Int32>(last), root, m_nb_thread };
+  }
+  void _waitChildrenDown(Int32 rank, Int32 root, Int64 epoch)
+  {
+    for (Int32 child : _children(rank, root))
+      _waitEpoch(m_nodes[child].m_down_epoch, epoch);
+  }
+  static void _waitEpoch(const std::atomic<Int64>& v, Int64 epoch)
+  {
+    if (v.load(std::memory_order_acquire) < epoch)
+      _doWaitEpoch(v, epoch);
+  }
+  static void _doWaitEpoch(const std::atomic<Int64>& v, Int64 epoch);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // End namespace Arccore
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -9,10 +9,16 @@
 #include "arccore/base/PlatformUtils.h"
 #include "arccore/base/Functor.h"
 #include "arccore/base/Ref.h"
+#include "arccore/base/String.h"
 
 #include "arccore/concurrency/SpinLock.h"
 #include "arccore/concurrency/Mutex.h"
 #include "arccore/concurrency/IThreadBarrier.h"
+#include "arccore/concurrency/ThreadCombiningTree.h"
+
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
 
 using namespace Arccore;
 
@@ -232,3 +238,157 @@ TEST(Concurrency, StdMutexLock)
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
+
+namespace
+{
+template <typename Func> void
+_runThreads(Int32 nb_thread, const Func& func)
+{
+  std::vector<std::thread> threads;
+  for (Int32 i = 0; i < nb_thread; ++i)
+    threads.emplace_back(func, i);
+  for (auto& t : threads)
+    t.join();
+}
+
+//! Valeur d'un thread alignée sur une ligne de cache
+struct alignas(64) PaddedValue
+{
+  Int64 value = 0;
+};
+
+void _doCombiningTreeTest(Int32 nb_thread, Int32 arity)
+{
+  ThreadCombiningTree tree(nb_thread, arity);
+  const Int32 nb_iter = 50;
+  const Int32 n = 3;
+  std::vector<std::vector<Int64>> values(nb_thread, std::vector<Int64>(n));
+  std::vector<PaddedValue> bcast_values(nb_thread);
+  std::vector<Int64> gather_values(nb_thread);
+  std::atomic<Int32> nb_error = 0;
+  _runThreads(nb_thread, [&](Int32 rank) {
+    for (Int32 iter = 0; iter < nb_iter; ++iter) {
+      std::vector<Int64>& my_values = values[rank];
+      for (Int32 j = 0; j < n; ++j)
+        my_values[j] = rank * iter + j;
+      tree.allReduce(
+      rank,
+      [&](Int32 child) {
+        for (Int32 j = 0; j < n; ++j)
+          my_values[j] += values[child][j];
+      },
+      [&](Int32 parent) { my_values = values[parent]; });
+      for (Int32 j = 0; j < n; ++j) {
+        Int64 expected = static_cast<Int64>(iter) * (nb_thread * (nb_thread - 1) / 2) + j * nb_thread;
+        if (my_values[j] != expected)
+          ++nb_error;
+      }
+
+      const Int32 root = iter % nb_thread;
+      bcast_values[rank].value = (rank == root) ? (iter + 5) : -1;
+      tree.broadcast(rank, root, [&](Int32 parent) { bcast_values[rank].value = bcast_values[parent].value; });
+      if (bcast_values[rank].value != (iter + 5))
+        ++nb_error;
+
+      tree.barrier(rank);
+
+      std::vector<PaddedValue>& gather_src = bcast_values;
+      gather_src[rank].value = rank + iter;
+      tree.gather(rank, root, [&](Int32 i) { gather_values[i] = gather_src[i].value; });
+      if (rank == root) {
+        for (Int32 i = 0; i < nb_thread; ++i)
+          if (gather_values[i] != (i + iter))
+            ++nb_error;
+      }
+    }
+  });
+  ASSERT_EQ(nb_error.load(), 0) << "Bad values nb_thread=" << nb_thread << " arity=" << arity;
+}
+} // namespace
+
+TEST(Concurrency, CombiningTree)
+{
+  for (Int32 nb_thread : { 1, 2, 3, 7, 16, 33 })
+    for (Int32 arity : { 2, 4, 8 })
+      _doCombiningTreeTest(nb_thread, arity);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compare le temps des opérations collectives entre threads.
+ *
+ * Compare une barrière avec verrou suivie d'une lecture des valeurs de
+ * tous les threads (ce qui était fait dans SharedMemoryParallelDispatch)
+ * avec ThreadCombiningTree pour un nombre de threads allant de 2 au nombre
+ * de coeurs de la machine. Comme les temps n'ont pas de sens si les threads
+ * sont plus nombreux que les coeurs, le nombre maximum de threads n'est
+ * pas plus grand par défaut. Il peut être changé via la variable
+ * d'environnement ARCCORE_TEST_COLLECTIVE_MAX_THREAD.
+ */
+TEST(Concurrency, BenchCombiningTree)
+{
+  Int32 max_thread = std::max(static_cast<Int32>(std::thread::hardware_concurrency()), 2);
+  String max_thread_str = Platform::getEnvironmentVariable("ARCCORE_TEST_COLLECTIVE_MAX_THREAD");
+  if (!max_thread_str.null())
+    max_thread = std::atoi(max_thread_str.localstr());
+
+  Ref<IThreadImplementation> timpl(Concurrency::createStdThreadImplementation());
+  for (Int32 nb_thread = 2; nb_thread <= max_thread; nb_thread *= 2) {
+    const Int32 nb_iter = std::max(20, 20000 / nb_thread);
+    std::vector<PaddedValue> values(nb_thread);
+    std::vector<Int64> results(nb_thread);
+
+    // Barrière avec verrou et lecture des valeurs de tous les threads.
+    IThreadBarrier* barrier = timpl->createBarrier();
+    barrier->init(nb_thread);
+    Real t0 = Platform::getRealTime();
+    _runThreads(nb_thread, [&](Int32 rank) {
+      for (Int32 iter = 0; iter < nb_iter; ++iter) {
+        values[rank].value = rank + iter;
+        barrier->wait();
+        Int64 sum = 0;
+        for (Int32 i = 0; i < nb_thread; ++i)
+          sum += values[i].value;
+        barrier->wait();
+        results[rank] = sum;
+      }
+    });
+    Real legacy_time = Platform::getRealTime() - t0;
+    barrier->destroy();
+
+    // Réduction via l'arbre de combinaison.
+    ThreadCombiningTree tree(nb_thread);
+    t0 = Platform::getRealTime();
+    _runThreads(nb_thread, [&](Int32 rank) {
+      for (Int32 iter = 0; iter < nb_iter; ++iter) {
+        values[rank].value = rank + iter;
+        tree.allReduce(
+        rank, [&](Int32 child) { values[rank].value += values[child].value; },
+        [&](Int32 parent) { values[rank].value = values[parent].value; });
+        results[rank] = values[rank].value;
+      }
+    });
+    Real tree_time = Platform::getRealTime() - t0;
+    Int64 expected = static_cast<Int64>(nb_thread) * (nb_thread - 1) / 2 + static_cast<Int64>(nb_thread) * (nb_iter - 1);
+    for (Int32 i = 0; i < nb_thread; ++i)
+      ASSERT_EQ(results[i], expected);
+
+    // Barrière seule via l'arbre de combinaison.
+    t0 = Platform::getRealTime();
+    _runThreads(nb_thread, [&](Int32 rank) {
+      for (Int32 iter = 0; iter < nb_iter; ++iter)
+        tree.barrier(rank);
+    });
+    Real tree_barrier_time = Platform::getRealTime() - t0;
+
+    Real to_us = 1.0e6 / nb_iter;
+    std::cout << "BENCH_THREAD_COLLECTIVE nb_thread=" << nb_thread << " nb_iter=" << nb_iter
+              << " legacy_allreduce_us=" << legacy_time * to_us
+              << " tree_allreduce_us=" << tree_time * to_us
+              << " tree_barrier_us=" << tree_barrier_time * to_us << "\n";
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/